@@ -0,0 +1,700 @@
+/**
+ * @file AnalysisBench.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Benchmarks
+ * @brief Throughput benchmark of the silence scans over deterministic audio corpora.
+ *
+ * @details The `analysis_bench` target generates a corpus of files, scans each of them for
+ *          its In and Out points the way SilenceAnalysisWorker does, and reports frames per
+ *          second, storage MB/s and per-file latency as a table and as JSON, so results of
+ *          different builds and machines can be compared over time.
+ *
+ *          The corpus is the cross product of:
+ *          - **Formats**: WAV 16-bit, 24-bit and 32-bit float, FLAC 24-bit, Ogg Vorbis, and
+ *            MP3 when a LAME encoder is on the `PATH` (or given with `--lame`).
+ *          - **Channels**: mono to 8 channels (MP3 stops at stereo).
+ *          - **Durations**: 1 s and 60 s by default; multi-hour files via `--durations`.
+ *          - **Placement**: a one-second tone burst at the start, middle or end of otherwise
+ *            near-silent noise, so both scan directions see their best and worst case.
+ *
+ *          Every file is a pure function of its parameters (fixed-seed noise, fixed tone),
+ *          so generated files are cached in the corpus directory and reused across runs.
+ *
+ *          With `--filter highpass` or `--filter band`, every scan is timed a second time
+ *          through the Auto-Cut PreFilter, and the cost of the filtered scan relative to the
+ *          plain one is reported next to it.
+ *
+ *          The `kernels` suite times the scan kernels in isolation: the pre-kernel
+ *          per-sample loop against every supported PeakScanKernels instruction set on an
+ *          in-memory chunk, raw 16-bit PcmScanKernels scans against conversion plus the
+ *          float scan, and findSilenceIn/Out end-to-end over a synthetic
+ *          LargeFileMockReader. Each timing is the fastest of `--repeats` runs.
+ *
+ *          The `compressed` suite times, for every FLAC, Ogg and MP3 corpus file, the In
+ *          scan, the backward Out crawl and the forward tail-window Out scan that
+ *          SilenceAnalysisAlgorithms::findLastAbove() uses for compressed formats, and
+ *          flags any file where the two Out scans disagree.
+ *
+ *          Usage:
+ *          `analysis_bench [--corpus DIR] [--json FILE] [--durations 1,60,3600]
+ *                          [--channels 1,2,8] [--formats wav16,flac,...] [--repeats N]
+ *                          [--threshold LINEAR] [--lame PATH] [--filter off|highpass|band]
+ *                          [--suites corpus,kernels,compressed]`
+ */
+
+#include "LargeFileMockReader.h"
+#include "Utils/Config.h"
+#include "Workers/AnalysisProgress.h"
+#include "Workers/MappedPcmReader.h"
+#include "Workers/PcmScanKernels.h"
+#include "Workers/PeakScanKernels.h"
+#include "Workers/ScanContext.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr double kSampleRate = 48000.0;
+constexpr double kBurstSeconds = 1.0;
+constexpr float kToneLevel = 0.5f;
+constexpr float kNoiseLevel = 0.0005f;
+constexpr int kWriteBlock = 1 << 16;
+
+enum class Placement { Start, Middle, End };
+
+const char *getPlacementName(Placement placement) {
+    switch (placement) {
+    case Placement::Start:
+        return "start";
+    case Placement::Middle:
+        return "middle";
+    default:
+        return "end";
+    }
+}
+
+/** @brief One encodable corpus format. */
+struct FormatSpec {
+    juce::String id;
+    int bitsPerSample;
+    int maxChannels;
+    int qualityOption;
+    std::function<std::unique_ptr<juce::AudioFormat>()> create;
+};
+
+/** @brief One corpus file. */
+struct CorpusEntry {
+    const FormatSpec *format;
+    int channels;
+    double seconds;
+    Placement placement;
+    juce::File file;
+};
+
+/** @brief One timed scan direction of one corpus file. */
+struct Measurement {
+    juce::int64 result = -1;
+    juce::int64 framesScanned = 0;
+    juce::int64 bytesRead = 0;
+    double medianLatencyMs = 0.0;
+    double minLatencyMs = 0.0;
+    double scanSeconds = 0.0;
+};
+
+struct Options {
+    juce::File corpusDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                               .getChildFile("audiofiler_bench_corpus");
+    juce::File jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(
+        "analysis_bench.json");
+    juce::Array<double> durations{1.0, 60.0};
+    juce::Array<int> channels{1, 2, 8};
+    juce::StringArray formats;
+    int repeats = 3;
+    float threshold = 0.01f;
+    juce::File lame;
+    MainDomain::FilterMode filter = MainDomain::FilterMode::Off;
+    juce::StringArray suites{"corpus", "kernels", "compressed"};
+};
+
+juce::File findOnPath(const juce::String &name) {
+    const auto separator = juce::File::getSeparatorChar() == '\\' ? ";" : ":";
+    for (const auto &dir : juce::StringArray::fromTokens(
+             juce::SystemStats::getEnvironmentVariable("PATH", {}), separator, {})) {
+        const auto directory = juce::File::getCurrentWorkingDirectory().getChildFile(dir);
+        for (const auto &candidate : {name, name + ".exe"})
+            if (directory.getChildFile(candidate).existsAsFile())
+                return directory.getChildFile(candidate);
+    }
+    return {};
+}
+
+bool parseOptions(int argc, char *argv[], Options &options) {
+    const juce::StringArray args(argv + 1, argc - 1);
+    for (int i = 0; i < args.size(); ++i) {
+        const auto &arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+        const auto value = hasValue ? args[i + 1] : juce::String();
+        if (arg == "--corpus" && hasValue)
+            options.corpusDir = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        else if (arg == "--json" && hasValue)
+            options.jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        else if (arg == "--durations" && hasValue) {
+            options.durations.clear();
+            for (const auto &token : juce::StringArray::fromTokens(value, ",", {}))
+                options.durations.add(token.getDoubleValue());
+        } else if (arg == "--channels" && hasValue) {
+            options.channels.clear();
+            for (const auto &token : juce::StringArray::fromTokens(value, ",", {}))
+                options.channels.add(juce::jlimit(1, 8, token.getIntValue()));
+        } else if (arg == "--formats" && hasValue)
+            options.formats = juce::StringArray::fromTokens(value, ",", {});
+        else if (arg == "--repeats" && hasValue)
+            options.repeats = std::max(1, value.getIntValue());
+        else if (arg == "--threshold" && hasValue)
+            options.threshold = value.getFloatValue();
+        else if (arg == "--lame" && hasValue)
+            options.lame = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        else if (arg == "--filter" && hasValue && (value == "off" || value == "highpass" ||
+                                                   value == "band"))
+            options.filter = value == "highpass" ? MainDomain::FilterMode::HighPass
+                             : value == "band"   ? MainDomain::FilterMode::BandLimit
+                                                 : MainDomain::FilterMode::Off;
+        else if (arg == "--suites" && hasValue)
+            options.suites = juce::StringArray::fromTokens(value, ",", {});
+        else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            return false;
+        }
+        ++i; // every option takes a value
+    }
+    if (options.lame == juce::File())
+        options.lame = findOnPath("lame");
+    return true;
+}
+
+std::vector<FormatSpec> makeFormats(const Options &options) {
+    std::vector<FormatSpec> formats;
+    formats.push_back({"wav16", 16, 8, 0, [] { return std::make_unique<juce::WavAudioFormat>(); }});
+    formats.push_back({"wav24", 24, 8, 0, [] { return std::make_unique<juce::WavAudioFormat>(); }});
+    formats.push_back(
+        {"wav32f", 32, 8, 0, [] { return std::make_unique<juce::WavAudioFormat>(); }});
+    formats.push_back(
+        {"flac", 24, 8, 0, [] { return std::make_unique<juce::FlacAudioFormat>(); }});
+    formats.push_back(
+        {"ogg", 16, 8, 4, [] { return std::make_unique<juce::OggVorbisAudioFormat>(); }});
+#if JUCE_USE_LAME_AUDIO_FORMAT
+    if (options.lame.existsAsFile()) {
+        const auto lame = options.lame;
+        formats.push_back({"mp3", 16, 2, 10, [lame] {
+                               return std::make_unique<juce::LAMEEncoderAudioFormat>(lame);
+                           }});
+    }
+#endif
+
+    if (!options.formats.isEmpty())
+        formats.erase(std::remove_if(formats.begin(), formats.end(),
+                                     [&options](const FormatSpec &format) {
+                                         return !options.formats.contains(format.id);
+                                     }),
+                      formats.end());
+    return formats;
+}
+
+juce::String getExtension(const FormatSpec &format) {
+    if (format.id.startsWith("wav"))
+        return ".wav";
+    return "." + format.id;
+}
+
+/** @brief The cross product of formats, channel counts, durations and placements. */
+std::vector<CorpusEntry> makeCorpus(const Options &options,
+                                    const std::vector<FormatSpec> &formats) {
+    std::vector<CorpusEntry> corpus;
+    for (const auto &format : formats)
+        for (const int channels : options.channels)
+            for (const double seconds : options.durations)
+                for (const auto placement : {Placement::Start, Placement::Middle, Placement::End}) {
+                    if (channels > format.maxChannels || seconds <= 0.0)
+                        continue;
+                    const auto name = format.id + "_" + juce::String(channels) + "ch_" +
+                                      juce::String((juce::int64)std::llround(seconds)) + "s_" +
+                                      getPlacementName(placement) + getExtension(format);
+                    corpus.push_back({&format, channels, seconds, placement,
+                                      options.corpusDir.getChildFile(name)});
+                }
+    return corpus;
+}
+
+/**
+ * @brief Writes one corpus file: fixed-seed noise below any sensible Threshold with a
+ *        one-second tone burst at the requested placement.
+ */
+bool writeCorpusFile(const CorpusEntry &entry) {
+    const auto format = entry.format->create();
+    const auto numFrames = (juce::int64)std::llround(entry.seconds * kSampleRate);
+    const auto burst = std::min(numFrames, (juce::int64)(kBurstSeconds * kSampleRate));
+    const juce::int64 burstStart = entry.placement == Placement::Start    ? 0
+                                   : entry.placement == Placement::Middle ? (numFrames - burst) / 2
+                                                                          : numFrames - burst;
+
+    const auto partial = entry.file.withFileExtension(".partial");
+    partial.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(partial);
+    if (!stream->openedOk())
+        return false;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        format->createWriterFor(stream.get(), kSampleRate, (unsigned int)entry.channels,
+                                entry.format->bitsPerSample, {}, entry.format->qualityOption));
+    if (writer == nullptr)
+        return false;
+    stream.release(); // now owned by the writer
+
+    juce::Random random(entry.file.getFileName().hashCode64());
+    juce::AudioBuffer<float> block(entry.channels, kWriteBlock);
+    for (juce::int64 pos = 0; pos < numFrames; pos += kWriteBlock) {
+        const int frames = (int)std::min((juce::int64)kWriteBlock, numFrames - pos);
+        for (int ch = 0; ch < entry.channels; ++ch) {
+            auto *out = block.getWritePointer(ch);
+            for (int i = 0; i < frames; ++i) {
+                const auto frame = pos + i;
+                float value = (random.nextFloat() * 2.0f - 1.0f) * kNoiseLevel;
+                if (frame >= burstStart && frame < burstStart + burst)
+                    value += kToneLevel * std::sin(2.0f * juce::MathConstants<float>::pi *
+                                                   440.0f * (float)(frame % 48000) /
+                                                   (float)kSampleRate);
+                out[i] = value;
+            }
+        }
+        if (!writer->writeFromAudioSampleBuffer(block, 0, frames))
+            return false;
+    }
+    writer.reset();
+    return partial.moveFileTo(entry.file);
+}
+
+/** @brief Opens a reader the way SilenceAnalysisWorker does, preferring the mapped path. */
+std::unique_ptr<juce::AudioFormatReader> openScanReader(juce::AudioFormatManager &formatManager,
+                                                        const juce::File &file) {
+    std::unique_ptr<juce::AudioFormatReader> decoded(formatManager.createReaderFor(file));
+    if (decoded == nullptr)
+        return nullptr;
+    if (auto mapped = MappedPcmReader::createFor(file, *decoded))
+        return mapped;
+    return decoded;
+}
+
+Measurement measure(juce::AudioFormatManager &formatManager, const juce::File &file,
+                    bool detectingIn, const Options &options, MainDomain::FilterMode filter) {
+    Measurement measurement;
+    std::vector<double> latencies;
+    AnalysisProgress progress(1);
+
+    for (int run = 0; run < options.repeats; ++run) {
+        const auto start = juce::Time::getHighResolutionTicks();
+        auto reader = openScanReader(formatManager, file);
+        if (reader == nullptr)
+            return measurement;
+
+        double scanSeconds = 0.0;
+        {
+            AnalysisProgress::Job job(progress, file, detectingIn ? "In" : "Out",
+                                      reader->lengthInSamples,
+                                      AnalysisProgress::storageBytesPerFrame(file, *reader));
+            ScanContext context;
+            context.progress = &job;
+            const auto scanStart = juce::Time::getHighResolutionTicks();
+            measurement.result =
+                detectingIn ? SilenceAnalysisAlgorithms::findSilenceIn(
+                                  *reader, options.threshold, MainDomain::DetectionMode::Peak,
+                                  context, filter)
+                            : SilenceAnalysisAlgorithms::findSilenceOut(
+                                  *reader, options.threshold, MainDomain::DetectionMode::Peak,
+                                  context, filter);
+            scanSeconds = juce::Time::highResolutionTicksToSeconds(
+                juce::Time::getHighResolutionTicks() - scanStart);
+        }
+        latencies.push_back(1000.0 * juce::Time::highResolutionTicksToSeconds(
+                                         juce::Time::getHighResolutionTicks() - start));
+
+        const auto record = progress.getHistory().front();
+        measurement.framesScanned = record.samples;
+        measurement.bytesRead = record.bytes;
+        measurement.scanSeconds =
+            run == 0 ? scanSeconds : std::min(measurement.scanSeconds, scanSeconds);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    measurement.medianLatencyMs = latencies[latencies.size() / 2];
+    measurement.minLatencyMs = latencies.front();
+    return measurement;
+}
+
+/** @brief Filtered scan time per frame over plain scan time per frame. */
+double getCostRatio(const Measurement &plain, const Measurement &filtered) {
+    if (plain.scanSeconds <= 0.0 || plain.framesScanned <= 0 || filtered.framesScanned <= 0)
+        return 0.0;
+    return (filtered.scanSeconds / (double)filtered.framesScanned) /
+           (plain.scanSeconds / (double)plain.framesScanned);
+}
+
+juce::var toJson(const CorpusEntry &entry, bool detectingIn, const Measurement &m,
+                 const Measurement *filtered) {
+    auto *object = new juce::DynamicObject();
+    object->setProperty("file", entry.file.getFileName());
+    object->setProperty("format", entry.format->id);
+    object->setProperty("channels", entry.channels);
+    object->setProperty("seconds", entry.seconds);
+    object->setProperty("placement", getPlacementName(entry.placement));
+    object->setProperty("direction", detectingIn ? "in" : "out");
+    object->setProperty("fileBytes", entry.file.getSize());
+    object->setProperty("result", m.result);
+    object->setProperty("framesScanned", m.framesScanned);
+    object->setProperty("bytesRead", m.bytesRead);
+    object->setProperty("latencyMedianMs", m.medianLatencyMs);
+    object->setProperty("latencyMinMs", m.minLatencyMs);
+    object->setProperty("framesPerSecond",
+                        m.scanSeconds > 0.0 ? (double)m.framesScanned / m.scanSeconds : 0.0);
+    object->setProperty("megabytesPerSecond",
+                        m.scanSeconds > 0.0 ? (double)m.bytesRead / 1.0e6 / m.scanSeconds : 0.0);
+    if (filtered != nullptr) {
+        object->setProperty("filteredResult", filtered->result);
+        object->setProperty("filteredFramesPerSecond",
+                            filtered->scanSeconds > 0.0
+                                ? (double)filtered->framesScanned / filtered->scanSeconds
+                                : 0.0);
+        object->setProperty("filterCostRatio", getCostRatio(m, *filtered));
+    }
+    return juce::var(object);
+}
+
+juce::var describeMachine(const Options &options) {
+    auto *object = new juce::DynamicObject();
+    object->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    object->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    object->setProperty("cpu", juce::SystemStats::getCpuModel());
+    object->setProperty("physicalCpus", juce::SystemStats::getNumPhysicalCpus());
+    object->setProperty("chunkSize", SilenceAnalysisAlgorithms::chunkSize);
+    object->setProperty("threshold", options.threshold);
+    object->setProperty("repeats", options.repeats);
+    object->setProperty("corpus", options.corpusDir.getFullPathName());
+    object->setProperty("filter", options.filter == MainDomain::FilterMode::HighPass ? "highpass"
+                                  : options.filter == MainDomain::FilterMode::BandLimit ? "band"
+                                                                                        : "off");
+    return juce::var(object);
+}
+
+/** @brief Seconds elapsed since a high-resolution tick count, never zero. */
+double elapsedSince(juce::int64 startTicks) {
+    return std::max(1.0e-9, juce::Time::highResolutionTicksToSeconds(
+                                juce::Time::getHighResolutionTicks() - startTicks));
+}
+
+/** @brief The fastest of `repeats` timed calls of a function, in seconds. */
+template <typename Function> double timeBest(int repeats, Function &&function) {
+    double best = 0.0;
+    for (int run = 0; run < repeats; ++run) {
+        const auto start = juce::Time::getHighResolutionTicks();
+        function();
+        const double seconds = elapsedSince(start);
+        best = run == 0 ? seconds : std::min(best, seconds);
+    }
+    return best;
+}
+
+/**
+ * @brief Prints one kernel timing and returns it as a JSON object.
+ * @param baselineSeconds The time the speed-up is reported against, or 0 for none.
+ * @param correct Whether the timed code produced the expected result.
+ */
+juce::var reportKernel(const juce::String &name, double samples, double seconds,
+                       double baselineSeconds, bool correct) {
+    const double rate = samples / seconds / 1.0e6;
+    const double speedup = baselineSeconds > 0.0 ? baselineSeconds / seconds : 0.0;
+    std::cout << name.paddedRight(' ', 40) << juce::String(rate, 1).paddedLeft(' ', 10)
+              << " Msamples/s";
+    if (speedup > 0.0)
+        std::cout << "  " << juce::String(speedup, 1) << "x";
+    if (!correct)
+        std::cout << "  WRONG RESULT";
+    std::cout << "\n";
+
+    auto *object = new juce::DynamicObject();
+    object->setProperty("name", name);
+    object->setProperty("megasamplesPerSecond", rate);
+    object->setProperty("speedup", speedup);
+    object->setProperty("correct", correct);
+    return juce::var(object);
+}
+
+/** @brief The per-sample loop SilenceAnalysisAlgorithms used before the kernels existed. */
+int legacyFirstAbove(const juce::AudioBuffer<float> &buffer, float threshold) {
+    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            if (std::abs(buffer.getSample(channel, sample)) > threshold)
+                return sample;
+    return -1;
+}
+
+/** @brief Times the legacy loop and every supported kernel over one in-memory chunk. */
+void benchmarkChunkScan(const Options &options, juce::Array<juce::var> &results) {
+    constexpr int numSamples = 65536;
+    constexpr int iterations = 200;
+    juce::AudioBuffer<float> buffer(2, numSamples);
+    buffer.clear();
+    buffer.setSample(1, numSamples - 1, 1.0f);
+    const double totalSamples = (double)numSamples * iterations;
+
+    int result = -1;
+    const double legacySeconds = timeBest(options.repeats, [&] {
+        for (int i = 0; i < iterations; ++i)
+            result = legacyFirstAbove(buffer, options.threshold);
+    });
+    results.add(reportKernel("chunk: legacy loop", totalSamples, legacySeconds, 0.0,
+                             result == numSamples - 1));
+
+    using Kernel = PeakScanKernels::Kernel;
+    for (auto kernel : {Kernel::Scalar, Kernel::Sse2, Kernel::Avx2}) {
+        if (!PeakScanKernels::isSupported(kernel))
+            continue;
+        result = -1;
+        const double seconds = timeBest(options.repeats, [&] {
+            for (int i = 0; i < iterations; ++i)
+                result = PeakScanKernels::findFirstAbove(kernel, buffer.getArrayOfReadPointers(),
+                                                         2, numSamples, options.threshold);
+        });
+        results.add(reportKernel(juce::String("chunk: ") + PeakScanKernels::getKernelName(kernel),
+                                 totalSamples, seconds, legacySeconds, result == numSamples - 1));
+    }
+}
+
+/**
+ * @brief Times the raw 16-bit integer scan against conversion to float plus the float scan,
+ *        i.e. what a mapped PCM chunk cost before PcmScanKernels existed.
+ */
+void benchmarkPcmScan(const Options &options, juce::Array<juce::var> &results) {
+    constexpr int numFrames = 65536;
+    constexpr int iterations = 200;
+    MappedPcmReader::Layout layout;
+    layout.numChannels = 2;
+
+    std::vector<char> raw; // little-endian, near-silent apart from one full-scale sample
+    for (int i = 0; i < numFrames * 2; ++i) {
+        const int value = i == numFrames * 2 - 1 ? 32767 : 3;
+        raw.push_back((char)(value & 0xff));
+        raw.push_back((char)(value >> 8));
+    }
+    juce::AudioBuffer<float> buffer(2, numFrames);
+    const auto limit =
+        PcmScanKernels::toIntegerLimit(options.threshold, MappedPcmReader::Encoding::Int16);
+    const double totalSamples = (double)numFrames * iterations;
+
+    int result = -1;
+    const double floatSeconds = timeBest(options.repeats, [&] {
+        for (int i = 0; i < iterations; ++i) {
+            MappedPcmReader::convertFrames(layout, raw.data(), numFrames,
+                                           buffer.getArrayOfWritePointers(), 2, 0);
+            result = PeakScanKernels::findFirstAbove(buffer.getArrayOfReadPointers(), 2,
+                                                     numFrames, options.threshold);
+        }
+    });
+    results.add(reportKernel("pcm16: convert + float scan", totalSamples, floatSeconds, 0.0,
+                             result == numFrames - 1));
+
+    result = -1;
+    const double rawSeconds = timeBest(options.repeats, [&] {
+        for (int i = 0; i < iterations; ++i)
+            result = PcmScanKernels::findFirstAbove(layout, raw.data(), numFrames, limit);
+    });
+    results.add(reportKernel("pcm16: raw integer scan", totalSamples, rawSeconds, floatSeconds,
+                             result == numFrames - 1));
+}
+
+/** @brief Times findSilenceIn/Out end-to-end over a synthetic reader with one impulse. */
+void benchmarkReaderScan(const Options &options, juce::Array<juce::var> &results) {
+    constexpr juce::int64 length = 1 << 25;
+    LargeFileMockReader reader(length, 2, kSampleRate, length / 2);
+
+    juce::int64 result = -1;
+    double seconds = timeBest(options.repeats, [&] {
+        result = SilenceAnalysisAlgorithms::findSilenceIn(reader, options.threshold);
+    });
+    results.add(reportKernel("reader: findSilenceIn", (double)(length / 2), seconds, 0.0,
+                             result == length / 2));
+
+    result = -1;
+    seconds = timeBest(options.repeats, [&] {
+        result = SilenceAnalysisAlgorithms::findSilenceOut(reader, options.threshold);
+    });
+    results.add(reportKernel("reader: findSilenceOut", (double)(length / 2), seconds, 0.0,
+                             result == length / 2));
+}
+
+/** @brief Runs the `kernels` suite. */
+void runKernelSuite(const Options &options, juce::Array<juce::var> &results) {
+    std::cout << "kernel                                  throughput\n";
+    benchmarkChunkScan(options, results);
+    benchmarkPcmScan(options, results);
+    benchmarkReaderScan(options, results);
+}
+
+/** @brief Runs the `corpus` suite; false if the corpus directory cannot be created. */
+bool runCorpusSuite(const Options &options, juce::Array<juce::var> &results) {
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto formats = makeFormats(options);
+    if (!options.corpusDir.createDirectory()) {
+        std::cerr << "Cannot create corpus directory " << options.corpusDir.getFullPathName()
+                  << "\n";
+        return false;
+    }
+
+    const auto corpus = makeCorpus(options, formats);
+    const bool filtering = options.filter != MainDomain::FilterMode::Off;
+    std::cout << "file                                    dir  frames/s        MB/s  latency ms"
+              << (filtering ? "  filter x" : "") << "\n";
+    for (const auto &entry : corpus) {
+        if (!entry.file.existsAsFile() && !writeCorpusFile(entry)) {
+            std::cerr << "Skipping " << entry.file.getFileName() << ": cannot encode\n";
+            continue;
+        }
+        for (const bool detectingIn : {true, false}) {
+            const auto m = measure(formatManager, entry.file, detectingIn, options,
+                                   MainDomain::FilterMode::Off);
+            Measurement filtered;
+            if (filtering)
+                filtered = measure(formatManager, entry.file, detectingIn, options, options.filter);
+            results.add(toJson(entry, detectingIn, m, filtering ? &filtered : nullptr));
+
+            const double rate = m.scanSeconds > 0.0 ? (double)m.framesScanned / m.scanSeconds
+                                                    : 0.0;
+            const double mbps =
+                m.scanSeconds > 0.0 ? (double)m.bytesRead / 1.0e6 / m.scanSeconds : 0.0;
+            std::cout << entry.file.getFileName().paddedRight(' ', 40)
+                      << (detectingIn ? "in   " : "out  ")
+                      << juce::String((juce::int64)std::llround(rate)).paddedLeft(' ', 14) << "  "
+                      << juce::String(mbps, 1).paddedLeft(' ', 10) << "  "
+                      << juce::String(m.medianLatencyMs, 2).paddedLeft(' ', 10);
+            if (filtering)
+                std::cout << "  " << juce::String(getCostRatio(m, filtered), 2).paddedLeft(' ', 8);
+            std::cout << "\n";
+        }
+    }
+    return true;
+}
+
+/** @brief The fastest of `repeats` scans of a file, each on a freshly opened reader. */
+double timeFreshScan(juce::AudioFormatManager &formatManager, const juce::File &file,
+                     int repeats, const std::function<void(juce::AudioFormatReader &)> &scan) {
+    double best = 0.0;
+    for (int run = 0; run < repeats; ++run) {
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr)
+            return 0.0;
+        const auto start = juce::Time::getHighResolutionTicks();
+        scan(*reader);
+        const double seconds = elapsedSince(start);
+        best = run == 0 ? seconds : std::min(best, seconds);
+    }
+    return best;
+}
+
+/**
+ * @brief Runs the `compressed` suite: for every compressed corpus file, the In scan, the
+ *        backward Out crawl and the forward tail-window Out scan.
+ * @return False if the corpus directory cannot be created.
+ */
+bool runCompressedSuite(const Options &options, juce::Array<juce::var> &results) {
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    const auto formats = makeFormats(options);
+    if (!options.corpusDir.createDirectory()) {
+        std::cerr << "Cannot create corpus directory " << options.corpusDir.getFullPathName()
+                  << "\n";
+        return false;
+    }
+
+    const ScanContext context;
+    std::cout << "file                                        in ms  backward ms   tail ms\n";
+    for (const auto &entry : makeCorpus(options, formats)) {
+        if (entry.format->id.startsWith("wav"))
+            continue; // WAV Out scans crawl backwards already
+        if (!entry.file.existsAsFile() && !writeCorpusFile(entry)) {
+            std::cerr << "Skipping " << entry.file.getFileName() << ": cannot encode\n";
+            continue;
+        }
+
+        juce::int64 in = -1, backward = -1, tail = -1;
+        const double inSeconds =
+            timeFreshScan(formatManager, entry.file, options.repeats, [&](auto &reader) {
+                in = SilenceAnalysisAlgorithms::findFirstAboveInRange(
+                    reader, 0, reader.lengthInSamples, options.threshold, context);
+            });
+        const double backwardSeconds =
+            timeFreshScan(formatManager, entry.file, options.repeats, [&](auto &reader) {
+                backward = SilenceAnalysisAlgorithms::findLastAboveInRange(
+                    reader, 0, reader.lengthInSamples, options.threshold, context);
+            });
+        const double tailSeconds =
+            timeFreshScan(formatManager, entry.file, options.repeats, [&](auto &reader) {
+                tail = SilenceAnalysisAlgorithms::findLastAbove(reader, 0, reader.lengthInSamples,
+                                                                options.threshold, context);
+            });
+
+        std::cout << entry.file.getFileName().paddedRight(' ', 40)
+                  << juce::String(inSeconds * 1000.0, 1).paddedLeft(' ', 9) << "  "
+                  << juce::String(backwardSeconds * 1000.0, 1).paddedLeft(' ', 11) << "  "
+                  << juce::String(tailSeconds * 1000.0, 1).paddedLeft(' ', 8)
+                  << (tail == backward ? "" : "  RESULTS DIFFER") << "\n";
+
+        auto *object = new juce::DynamicObject();
+        object->setProperty("file", entry.file.getFileName());
+        object->setProperty("format", entry.format->id);
+        object->setProperty("channels", entry.channels);
+        object->setProperty("seconds", entry.seconds);
+        object->setProperty("placement", getPlacementName(entry.placement));
+        object->setProperty("in", in);
+        object->setProperty("out", tail);
+        object->setProperty("inMs", inSeconds * 1000.0);
+        object->setProperty("outBackwardMs", backwardSeconds * 1000.0);
+        object->setProperty("outTailWindowsMs", tailSeconds * 1000.0);
+        object->setProperty("outResultsAgree", tail == backward);
+        results.add(juce::var(object));
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    juce::Array<juce::var> results, kernelResults, compressedResults;
+    if (options.suites.contains("corpus") && !runCorpusSuite(options, results))
+        return 1;
+    if (options.suites.contains("kernels"))
+        runKernelSuite(options, kernelResults);
+    if (options.suites.contains("compressed") && !runCompressedSuite(options, compressedResults))
+        return 1;
+
+    auto *report = new juce::DynamicObject();
+    report->setProperty("benchmark", "analysis_bench");
+    report->setProperty("schema", 1);
+    report->setProperty("machine", describeMachine(options));
+    report->setProperty("results", results);
+    report->setProperty("kernels", kernelResults);
+    report->setProperty("compressed", compressedResults);
+    if (!options.jsonFile.replaceWithText(juce::JSON::toString(juce::var(report)))) {
+        std::cerr << "Cannot write " << options.jsonFile.getFullPathName() << "\n";
+        return 1;
+    }
+    std::cout << "JSON written to " << options.jsonFile.getFullPathName() << "\n";
+    return 0;
+}
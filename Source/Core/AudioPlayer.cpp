@@ -10,7 +10,7 @@
 
 AudioPlayer::AudioPlayer(SessionState &state)
 #if !defined(JUCE_HEADLESS)
-    : waveformManager(formatManager),
+    : waveformManager(formatManager, ioGovernor),
 #else
     :
 #endif
@@ -64,13 +64,15 @@ juce::Result AudioPlayer::loadFile(const juce::File &file) {
         {
             std::lock_guard<std::mutex> lock(readerMutex);
             auto newSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
-            transportSource.setSource(newSource.get(), Config::Audio::readAheadBufferSize,
+            auto newProbe = std::make_unique<ReadAheadProbe>(*newSource, playbackHealth);
+            transportSource.setSource(newProbe.get(), Config::Audio::readAheadBufferSize,
                                       &readAheadThread, reader->sampleRate);
 #if !defined(JUCE_HEADLESS)
             waveformManager.loadFile(file);
 #endif
             cachedSampleRate = reader->sampleRate;
             cachedTotalSamples = reader->lengthInSamples;
+            readAheadProbe = std::move(newProbe);
             readerSource.reset(newSource.release());
         }
         transportSource.setGain(sessionState.getVolume());
@@ -112,7 +114,7 @@ void AudioPlayer::setRepeating(bool shouldRepeat) {
 }
 
 #if !defined(JUCE_HEADLESS)
-juce::AudioThumbnail &AudioPlayer::getThumbnail() {
+PeakMipmap &AudioPlayer::getThumbnail() {
     return waveformManager.getThumbnail();
 }
 
@@ -143,9 +145,20 @@ juce::AudioFormatManager &AudioPlayer::getFormatManager() {
 }
 
 void AudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    playbackHealth.prepare(sampleRate, Config::Audio::readAheadBufferSize);
     transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
 }
 
+void AudioPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) {
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+    renderNextBlock(bufferToFill);
+
+    const auto playPosition =
+        (juce::int64)(transportSource.getCurrentPosition() * cachedSampleRate.load());
+    playbackHealth.recordCallback(startTicks, bufferToFill.numSamples, transportSource.isPlaying(),
+                                  playPosition, cachedTotalSamples.load());
+}
+
 /**
  * @details This method is the performance-critical heart of the audio engine. It operates 
  *          under strict "Lock-Free Deterministic" constraints to ensure jitter-free 
@@ -171,7 +184,7 @@ void AudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
  *             we rely on the underlying transport's gain-ramping (if applicable) 
  *             to prevent pops, while maintaining mathematical frame-accuracy.
  */
-void AudioPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) {
+void AudioPlayer::renderNextBlock(const juce::AudioSourceChannelInfo &bufferToFill) {
     if (readerSource.get() == nullptr) {
         bufferToFill.clearActiveBufferRegion();
         return;
@@ -11,9 +11,11 @@
 #include <JuceHeader.h>
 #endif
 
+#include "Core/PlaybackHealth.h"
 #include "Core/SessionState.h"
 #include "MainDomain.h"
 #include "Utils/Config.h"
+#include "Workers/IoGovernor.h"
 #if !defined(JUCE_HEADLESS)
 #include "Core/WaveformManager.h"
 #endif
@@ -39,6 +41,8 @@
  *            sample stream to the hardware device, enforcing cut boundaries in real-time.
  *          - **State Synchronization**: Observes `SessionState` to react to user 
  *            adjustments (volume, boundaries, locks) without UI thread intervention.
+ *          - **Playback Health**: Publishes its callback load and read-ahead fill in a
+ *            PlaybackHealth, from which the IoGovernor paces background analysis.
  * 
  *          The AudioPlayer maintains an internal "air gap" via mutexes and atomics 
  *          between the high-priority Audio Thread and the lower-priority Message Thread.
@@ -47,6 +51,7 @@
  * @see MainComponent
  * @see WaveformManager
  * @see AudioSource
+ * @see IoGovernor
  */
 class AudioPlayer : public juce::AudioSource,
                     public juce::ChangeListener,
@@ -114,10 +119,10 @@ class AudioPlayer : public juce::AudioSource,
 #if !defined(JUCE_HEADLESS)
 
     /** 
-     * @brief Returns the audio thumbnail for waveform rendering. 
-     * @return Reference to the internal AudioThumbnail.
+     * @brief Returns the waveform data for rendering. 
+     * @return Reference to the WaveformManager's PeakMipmap.
      */
-    juce::AudioThumbnail &getThumbnail();
+    PeakMipmap &getThumbnail();
 
     /** 
      * @brief Provides access to the WaveformManager for thumbnail updates. 
@@ -150,6 +155,22 @@ class AudioPlayer : public juce::AudioSource,
      */
     juce::AudioFormatManager &getFormatManager();
 
+    /**
+     * @brief Provides the governor that paces background analysis against playback.
+     * @return Reference to the internal IoGovernor.
+     */
+    IoGovernor &getIoGovernor() {
+        return ioGovernor;
+    }
+
+    /**
+     * @brief Provides read-only access to the playback gauges.
+     * @return Const reference to the internal PlaybackHealth.
+     */
+    const PlaybackHealth &getPlaybackHealth() const {
+        return playbackHealth;
+    }
+
     /** 
      * @brief Returns the underlying audio format reader for the loaded file. 
      * @return Pointer to the current reader, or nullptr if no file is loaded.
@@ -184,6 +205,8 @@ class AudioPlayer : public juce::AudioSource,
      *             - If not, stop playback and notify listeners.
      *          6. If the current block crosses the `cutOut` boundary, the player 
      *             truncates the buffer to prevent audio leakage past the marker.
+     *          7. The block's duration and the read-ahead lead are recorded in
+     *             PlaybackHealth with relaxed atomic stores.
      *
      * @param bufferToFill The buffer structure to populate with audio data.
      * @warning Do NOT perform any I/O, memory allocation, or UI updates here.
@@ -258,8 +281,18 @@ class AudioPlayer : public juce::AudioSource,
 #endif
 
   private:
+    /**
+     * @brief The cut-aware rendering behind getNextAudioBlock(), which only adds timing.
+     * @param bufferToFill The buffer structure to populate with audio data.
+     */
+    void renderNextBlock(const juce::AudioSourceChannelInfo &bufferToFill);
+
     juce::AudioFormatManager formatManager;              /**< Manages decoding for WAV, AIFF, MP3, etc. */
+    // Declared ahead of the members whose threads report to or are paced by them.
+    PlaybackHealth playbackHealth;                       /**< Lock-free load and buffer gauges. */
+    IoGovernor ioGovernor{&playbackHealth};              /**< Paces analysis I/O from playbackHealth. */
     std::unique_ptr<juce::AudioFormatReaderSource> readerSource; /**< Direct stream from the file on disk. */
+    std::unique_ptr<ReadAheadProbe> readAheadProbe;      /**< Reports read-ahead progress to playbackHealth. */
     juce::TimeSliceThread readAheadThread;               /**< Background thread for disk I/O pre-buffering. */
     juce::AudioTransportSource transportSource;          /**< JUCE transport for seek/play/pause control. */
 
@@ -1,6 +1,12 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include <memory>
+
+class CutPointCurves;
+class LevelStats;
+class NoiseFloorHistogram;
+class SilenceGapMap;
 
 /**
  * @file FileMetadata.h
@@ -24,6 +30,18 @@ struct FileMetadata {
     /** @brief True if the file has undergone a complete silence analysis pass. */
     bool isAnalyzed{false};
 
-    /** @brief Unique hash (e.g., MD5) used to verify file identity across sessions. */
+    /** @brief FileIdentity fingerprint; keys the persistent PeakPyramid cache across sessions. */
     juce::String hash;
+
+    /** @brief Threshold-to-cut mapping, once built; lets cut markers follow the Threshold live. */
+    std::shared_ptr<const CutPointCurves> cutCurves;
+
+    /** @brief Internal silent gaps at the In Threshold, once scanned; drives overlays and jumps. */
+    std::shared_ptr<const SilenceGapMap> gapMap;
+
+    /** @brief Block-peak level histogram, once built; suggests the Auto Threshold. */
+    std::shared_ptr<const NoiseFloorHistogram> noiseFloor;
+
+    /** @brief Exact per-channel peak, RMS, DC offset and clip count, once gathered. */
+    std::shared_ptr<const LevelStats> levelStats;
 };
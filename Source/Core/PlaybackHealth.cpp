@@ -0,0 +1,44 @@
+#include "Core/PlaybackHealth.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+
+void PlaybackHealth::prepare(double deviceSampleRate, int readAheadCapacity) {
+    deviceRate.store(deviceSampleRate, std::memory_order_relaxed);
+    capacity.store(std::max(1, readAheadCapacity), std::memory_order_relaxed);
+    callbackLoad.store(0.0f, std::memory_order_relaxed);
+}
+
+/**
+ * @details The load is an exponential moving average so a single slow block (e.g. the
+ *          first one after a seek) does not slam the governor, while a sustained overload
+ *          shows up within a few dozen callbacks. The read-ahead lead is taken against the
+ *          playhead at callback time; once the file end has been buffered the lead can
+ *          only shrink, which is not a risk, so it counts as a full buffer.
+ */
+void PlaybackHealth::recordCallback(juce::int64 startTicks, int numSamples, bool isRolling,
+                                    juce::int64 playPosition, juce::int64 totalLength) noexcept {
+    playing.store(isRolling, std::memory_order_relaxed);
+
+    const double rate = deviceRate.load(std::memory_order_relaxed);
+    if (rate > 0.0 && numSamples > 0) {
+        const double elapsed = juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - startTicks);
+        const auto load = (float)(elapsed * rate / numSamples);
+        const float previous = callbackLoad.load(std::memory_order_relaxed);
+        callbackLoad.store(previous + Config::Audio::playbackLoadSmoothing * (load - previous),
+                           std::memory_order_relaxed);
+    }
+
+    const juce::int64 end = readAheadEnd.load(std::memory_order_relaxed);
+    float fill = 1.0f;
+    if (end < totalLength) {
+        const auto lead = (float)std::max((juce::int64)0, end - playPosition);
+        fill = std::min(1.0f, lead / (float)capacity.load(std::memory_order_relaxed));
+    }
+    readAheadFill.store(fill, std::memory_order_relaxed);
+}
+
+void PlaybackHealth::recordReadAhead(juce::int64 readEnd) noexcept {
+    readAheadEnd.store(readEnd, std::memory_order_relaxed);
+}
@@ -0,0 +1,140 @@
+#ifndef AUDIOFILER_PLAYBACKHEALTH_H
+#define AUDIOFILER_PLAYBACKHEALTH_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+
+/**
+ * @file PlaybackHealth.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Lock-free gauges of how close playback is to glitching.
+ *
+ * @details Architecturally, PlaybackHealth is the AudioPlayer's outward-facing
+ *          "vital signs" panel. It is written from the two real-time-adjacent threads
+ *          of the engine and read by anyone who competes with them for CPU or disk,
+ *          chiefly the IoGovernor that paces background analysis.
+ *
+ *          Two gauges are kept, both as plain atomics so neither writer can block:
+ *          - **Callback load**: the smoothed fraction of each audio block's real-time
+ *            budget spent inside `AudioPlayer::getNextAudioBlock()`. Values near 1.0
+ *            mean the device is about to miss a deadline.
+ *          - **Read-ahead fill**: how far the `readAheadThread` has decoded beyond the
+ *            playhead, as a fraction of `Config::Audio::readAheadBufferSize`. A draining
+ *            buffer means disk or decoder cannot keep up.
+ *
+ * @see AudioPlayer
+ * @see IoGovernor
+ * @see ReadAheadProbe
+ */
+class PlaybackHealth final {
+  public:
+    /**
+     * @brief Sets the real-time budget used to turn callback durations into load.
+     * @param deviceSampleRate The output device's sample rate in Hz.
+     * @param readAheadCapacity The read-ahead buffer size in file samples.
+     */
+    void prepare(double deviceSampleRate, int readAheadCapacity);
+
+    /**
+     * @brief Records one audio callback. Audio Thread only; lock- and allocation-free.
+     * @param startTicks `juce::Time::getHighResolutionTicks()` taken on entry.
+     * @param numSamples The block size, in device samples.
+     * @param isRolling True if the transport is playing.
+     * @param playPosition The playhead, in file samples.
+     * @param totalLength The file length, in file samples.
+     */
+    void recordCallback(juce::int64 startTicks, int numSamples, bool isRolling,
+                        juce::int64 playPosition, juce::int64 totalLength) noexcept;
+
+    /**
+     * @brief Records how far the read-ahead thread has decoded. Read-ahead thread only.
+     * @param readEnd The file sample just past the last one handed to the buffer.
+     */
+    void recordReadAhead(juce::int64 readEnd) noexcept;
+
+    /** @return True if the transport was rolling at the last callback. */
+    bool isPlaying() const noexcept {
+        return playing.load(std::memory_order_relaxed);
+    }
+
+    /** @return The smoothed callback load, where 1.0 is the whole real-time budget. */
+    float getCallbackLoad() const noexcept {
+        return callbackLoad.load(std::memory_order_relaxed);
+    }
+
+    /** @return The read-ahead buffer fill in [0, 1]; 1.0 when the file end is buffered. */
+    float getReadAheadFill() const noexcept {
+        return readAheadFill.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<double> deviceRate{0.0};
+    std::atomic<int> capacity{1};
+    std::atomic<bool> playing{false};
+    std::atomic<float> callbackLoad{0.0f};
+    std::atomic<float> readAheadFill{1.0f};
+    std::atomic<juce::int64> readAheadEnd{0};
+};
+
+/**
+ * @class ReadAheadProbe
+ * @brief Transparent source between the file reader and the transport's read-ahead buffer.
+ * @details `juce::AudioTransportSource` hides its internal buffering source, so the
+ *          only way to see how far ahead it has decoded is to sit underneath it: every
+ *          block the `readAheadThread` pulls passes through here and its end position
+ *          is reported to PlaybackHealth.
+ */
+class ReadAheadProbe final : public juce::PositionableAudioSource {
+  public:
+    ReadAheadProbe(juce::PositionableAudioSource &sourceToWrap, PlaybackHealth &healthToFeed)
+        : source(sourceToWrap), health(healthToFeed) {
+    }
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override {
+        source.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    }
+
+    void releaseResources() override {
+        source.releaseResources();
+    }
+
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo &bufferToFill) override {
+        source.getNextAudioBlock(bufferToFill);
+        health.recordReadAhead(source.getNextReadPosition());
+    }
+
+    void setNextReadPosition(juce::int64 newPosition) override {
+        source.setNextReadPosition(newPosition);
+    }
+
+    juce::int64 getNextReadPosition() const override {
+        return source.getNextReadPosition();
+    }
+
+    juce::int64 getTotalLength() const override {
+        return source.getTotalLength();
+    }
+
+    bool isLooping() const override {
+        return source.isLooping();
+    }
+
+    void setLooping(bool shouldLoop) override {
+        source.setLooping(shouldLoop);
+    }
+
+  private:
+    juce::PositionableAudioSource &source;
+    PlaybackHealth &health;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReadAheadProbe)
+};
+
+#endif
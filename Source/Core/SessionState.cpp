@@ -106,6 +106,46 @@ void SessionState::setThresholdOut(float threshold) {
     }
 }
 
+void SessionState::setDetectionModeIn(MainDomain::DetectionMode mode) {
+    const juce::ScopedLock lock(stateLock);
+    if (cutPrefs.autoCut.modeIn != mode) {
+        cutPrefs.autoCut.modeIn = mode;
+        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+    }
+}
+
+void SessionState::setDetectionModeOut(MainDomain::DetectionMode mode) {
+    const juce::ScopedLock lock(stateLock);
+    if (cutPrefs.autoCut.modeOut != mode) {
+        cutPrefs.autoCut.modeOut = mode;
+        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+    }
+}
+
+void SessionState::setFilterModeIn(MainDomain::FilterMode filter) {
+    const juce::ScopedLock lock(stateLock);
+    if (cutPrefs.autoCut.filterIn != filter) {
+        cutPrefs.autoCut.filterIn = filter;
+        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+    }
+}
+
+void SessionState::setFilterModeOut(MainDomain::FilterMode filter) {
+    const juce::ScopedLock lock(stateLock);
+    if (cutPrefs.autoCut.filterOut != filter) {
+        cutPrefs.autoCut.filterOut = filter;
+        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+    }
+}
+
+void SessionState::setAutoThresholdActive(bool active) {
+    const juce::ScopedLock lock(stateLock);
+    if (cutPrefs.autoCut.autoThreshold != active) {
+        cutPrefs.autoCut.autoThreshold = active;
+        listeners.call([this](Listener &l) { l.cutPreferenceChanged(cutPrefs); });
+    }
+}
+
 void SessionState::setCutIn(double value) {
     const juce::ScopedLock lock(stateLock);
     if (cutPrefs.inLocked) return;
@@ -201,6 +241,38 @@ FileMetadata SessionState::getCurrentMetadata() const {
     return getMetadataForFile(currentFilePath);
 }
 
+void SessionState::setCutCurvesForFile(const juce::String &filePath,
+                                       std::shared_ptr<const CutPointCurves> curves) {
+    const juce::ScopedLock lock(stateLock);
+    const auto it = metadataCache.find(filePath);
+    if (it != metadataCache.end())
+        it->second.cutCurves = std::move(curves);
+}
+
+void SessionState::setGapMapForFile(const juce::String &filePath,
+                                    std::shared_ptr<const SilenceGapMap> gapMap) {
+    const juce::ScopedLock lock(stateLock);
+    const auto it = metadataCache.find(filePath);
+    if (it != metadataCache.end())
+        it->second.gapMap = std::move(gapMap);
+}
+
+void SessionState::setNoiseFloorForFile(const juce::String &filePath,
+                                        std::shared_ptr<const NoiseFloorHistogram> noiseFloor) {
+    const juce::ScopedLock lock(stateLock);
+    const auto it = metadataCache.find(filePath);
+    if (it != metadataCache.end())
+        it->second.noiseFloor = std::move(noiseFloor);
+}
+
+void SessionState::setLevelStatsForFile(const juce::String &filePath,
+                                        std::shared_ptr<const LevelStats> levelStats) {
+    const juce::ScopedLock lock(stateLock);
+    const auto it = metadataCache.find(filePath);
+    if (it != metadataCache.end())
+        it->second.levelStats = std::move(levelStats);
+}
+
 bool SessionState::hasMetadataForFile(const juce::String &filePath) const {
     const juce::ScopedLock lock(stateLock);
     return metadataCache.find(filePath) != metadataCache.end();
@@ -194,6 +194,36 @@ class SessionState {
      */
     void setThresholdOut(float threshold);
 
+    /**
+     * @brief Selects how the 'In' scan decides that the silence has ended.
+     * @param mode The detection criterion.
+     */
+    void setDetectionModeIn(MainDomain::DetectionMode mode);
+
+    /**
+     * @brief Selects how the 'Out' scan decides where the silence begins.
+     * @param mode The detection criterion.
+     */
+    void setDetectionModeOut(MainDomain::DetectionMode mode);
+
+    /**
+     * @brief Selects the pre-filter the 'In' scan listens through.
+     * @param filter The band the scan considers.
+     */
+    void setFilterModeIn(MainDomain::FilterMode filter);
+
+    /**
+     * @brief Selects the pre-filter the 'Out' scan listens through.
+     * @param filter The band the scan considers.
+     */
+    void setFilterModeOut(MainDomain::FilterMode filter);
+
+    /**
+     * @brief Toggles whether both Thresholds follow each file's suggested noise floor.
+     * @param active True to enable the Auto Threshold.
+     */
+    void setAutoThresholdActive(bool active);
+
     /**
      * @brief Manually sets the 'In' boundary point.
      * @param value Position in seconds.
@@ -250,6 +280,47 @@ class SessionState {
      */
     void setMetadataForFile(const juce::String &filePath, const FileMetadata &newMetadata);
 
+    /**
+     * @brief Attaches cut-point curves to a file's cached metadata.
+     * @details Silent update: no listener is notified, since neither the cut points nor
+     *          the preferences change. Files without cached metadata are ignored,
+     *          since AudioPlayer seeds their defaults on load.
+     * @param filePath Absolute path to the audio file.
+     * @param curves The curves to attach.
+     */
+    void setCutCurvesForFile(const juce::String &filePath,
+                             std::shared_ptr<const CutPointCurves> curves);
+
+    /**
+     * @brief Attaches a silence gap map to a file's cached metadata.
+     * @details Silent update, like setCutCurvesForFile(); views pick the map up on their
+     *          next refresh.
+     * @param filePath Absolute path to the audio file.
+     * @param gapMap The map to attach.
+     */
+    void setGapMapForFile(const juce::String &filePath,
+                          std::shared_ptr<const SilenceGapMap> gapMap);
+
+    /**
+     * @brief Attaches a level histogram to a file's cached metadata.
+     * @details Silent update, like setCutCurvesForFile(); the worker tells its client
+     *          separately, so the Auto Threshold can be applied.
+     * @param filePath Absolute path to the audio file.
+     * @param noiseFloor The histogram to attach.
+     */
+    void setNoiseFloorForFile(const juce::String &filePath,
+                              std::shared_ptr<const NoiseFloorHistogram> noiseFloor);
+
+    /**
+     * @brief Attaches level statistics to a file's cached metadata.
+     * @details Silent update, like setCutCurvesForFile(); the stats overlay picks them up
+     *          on its next refresh.
+     * @param filePath Absolute path to the audio file.
+     * @param levelStats The statistics to attach.
+     */
+    void setLevelStatsForFile(const juce::String &filePath,
+                              std::shared_ptr<const LevelStats> levelStats);
+
     /**
      * @brief Checks if analysis metadata exists for the given file.
      * @param filePath Path to check.
@@ -3,74 +3,541 @@
 #include "Core/SilenceAnalysisWorker.h"
 #include "Core/FileMetadata.h"
 #include "Core/SessionState.h"
+#include "Workers/AnalysisPipeline.h"
+#include "Workers/BoundaryHistory.h"
+#include "Workers/CutPointCurves.h"
+#include "Workers/EnvelopeStore.h"
+#include "Workers/FusedSilenceScan.h"
+#include "Workers/LevelStats.h"
+#include "Workers/MappedPcmReader.h"
+#include "Workers/NoiseFloorHistogram.h"
+#include "Workers/ParallelSilenceScan.h"
+#include "Workers/PeakPyramid.h"
+#include "Workers/ReaderPool.h"
 #include "Workers/SilenceAnalysisAlgorithms.h"
 #include "Workers/SilenceDetectionLogger.h"
+#include "Workers/SilenceGapMap.h"
 #include "Utils/Config.h"
+#include "Utils/FileIdentity.h"
 #include "Utils/TimeUtils.h"
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <mutex>
+#include <optional>
+
+namespace {
+/**
+ * @class GapMapFeed
+ * @brief Pipeline stage that builds a SilenceGapMap until its scan is superseded.
+ * @details Without a builder the stage is inert, so envelope-only passes share the
+ *          pipeline type of combined ones.
+ */
+class GapMapFeed final {
+  public:
+    GapMapFeed(std::unique_ptr<SilenceGapMap::Builder> gapBuilder,
+               const std::atomic<bool> *cancelFlag)
+        : builder(std::move(gapBuilder)), cancelled(cancelFlag) {
+    }
+
+    void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+        if (builder != nullptr && !isCancelled())
+            builder->addChunk(buffer, numSamples);
+    }
+
+    /** @return The finished map, or null if none was asked for or the scan was superseded. */
+    std::unique_ptr<SilenceGapMap> finish() {
+        if (builder == nullptr || isCancelled())
+            return nullptr;
+        return builder->finish();
+    }
+
+  private:
+    bool isCancelled() const {
+        return cancelled != nullptr && cancelled->load();
+    }
+
+    std::unique_ptr<SilenceGapMap::Builder> builder;
+    const std::atomic<bool> *cancelled;
+};
+
+/**
+ * @class FilePassJob
+ * @brief Low-priority pool job that streams a whole file once through an AnalysisPipeline.
+ * @details A pass serves up to three consumers: the file's envelope (PeakPyramid,
+ *          CutPointCurves, NoiseFloorHistogram and LevelStats, kept by the EnvelopeStore),
+ *          a SilenceGapMap at the current gap Threshold and the waveform's PeakMipmap,
+ *          through a MipmapHandoff::Feed. A gap scan of a file whose envelope is neither
+ *          cached nor being built takes the envelope along, and the file-open scan also
+ *          takes the waveform, so opening a file decodes it once for all three. Only the
+ *          latest gap scan matters, so a newer request raises the previous job's cancel
+ *          flag; a pass that also builds the envelope or the waveform then finishes them
+ *          without the map. The job opens its own reader.
+ */
+class FilePassJob final : public juce::ThreadPoolJob {
+  public:
+    using EnvelopeCallback = std::function<void(std::shared_ptr<const CutPointCurves>,
+                                                std::shared_ptr<const NoiseFloorHistogram>,
+                                                std::shared_ptr<const LevelStats>)>;
+    using GapMapCallback = std::function<void(std::shared_ptr<const SilenceGapMap>)>;
+
+    /** @brief The gap map a pass should also produce. */
+    struct GapRequest {
+        float threshold = 0.0f;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        GapMapCallback onMap;
+    };
+
+    /**
+     * @param claimedHash The hash whose build the caller already claimed with
+     *        EnvelopeStore::tryBeginBuild(), or empty to decide in the job.
+     */
+    FilePassJob(const juce::File &sourceFile, ReaderPool &pool, EnvelopeStore &target,
+                const juce::String &claimedHash, std::optional<GapRequest> gapRequest,
+                MipmapHandoff::Feed waveformFeed, IoGovernor &ioGovernor,
+                AnalysisProgress &analysisProgress, EnvelopeCallback envelopeReady)
+        : juce::ThreadPoolJob("FilePass"), file(sourceFile), readers(pool), store(target),
+          hash(claimedHash), buildsEnvelope(claimedHash.isNotEmpty()), gap(std::move(gapRequest)),
+          waveform(std::move(waveformFeed)), governor(ioGovernor), progress(analysisProgress),
+          onEnvelope(std::move(envelopeReady)) {
+    }
+
+    JobStatus runJob() override {
+        if (!buildsEnvelope)
+            claimEnvelope();
+
+        const auto reader = readers.acquire(file);
+        if (reader && SilenceAnalysisAlgorithms::isScannable(*reader) &&
+            reader->lengthInSamples > 0)
+            run(*reader);
+
+        if (buildsEnvelope)
+            store.endBuild(hash);
+        return jobHasFinished;
+    }
+
+  private:
+    void claimEnvelope() {
+        hash = FileIdentity::computeHash(file);
+        buildsEnvelope = hash.isNotEmpty() && !isEnvelopeCached() && store.tryBeginBuild(hash);
+    }
+
+    bool isEnvelopeCached() {
+        return store.findPyramid(hash) != nullptr && store.findCurves(hash) != nullptr &&
+               store.findNoiseFloor(hash) != nullptr && store.findLevelStats(hash) != nullptr;
+    }
+
+    void run(juce::AudioFormatReader &reader) {
+        const juce::int64 length = reader.lengthInSamples;
+        const juce::String &kind = buildsEnvelope ? Config::Labels::analysisKindEnvelope
+                                                  : Config::Labels::analysisKindGaps;
+        AnalysisProgress::Job progressJob(progress, file, kind, length,
+                                          AnalysisProgress::storageBytesPerFrame(file, reader));
+        ScanContext context;
+        context.job = this;
+        context.governor = &governor;
+        context.progress = &progressJob;
+        const bool buildsWaveform = waveform.waitForLookup(*this);
+        // Without an envelope or a waveform to finish, a superseded gap scan has nothing
+        // left to do.
+        if (!buildsEnvelope && !buildsWaveform && gap.has_value())
+            context.cancelled = gap->cancelled.get();
+
+        GapMapFeed gapFeed(gap.has_value() ? std::make_unique<SilenceGapMap::Builder>(
+                                                 gap->threshold, length, reader.sampleRate)
+                                           : nullptr,
+                           gap.has_value() ? gap->cancelled.get() : nullptr);
+
+        bool complete = false;
+        if (buildsEnvelope) {
+            AnalysisPipeline<GapMapFeed, MipmapHandoff::Feed, PeakPyramid::Builder,
+                             CutPointCurves::Builder, NoiseFloorHistogram::Builder,
+                             LevelStats::Builder>
+                pipeline(std::move(gapFeed), std::move(waveform),
+                         PeakPyramid::Builder(length, (int)reader.numChannels),
+                         CutPointCurves::Builder(length, reader.sampleRate),
+                         NoiseFloorHistogram::Builder(length, reader.sampleRate),
+                         LevelStats::Builder(length, (int)reader.numChannels));
+            complete = pipeline.run(reader, context);
+            if (complete) {
+                pipeline.get<MipmapHandoff::Feed>().finish();
+                deliverGapMap(pipeline.get<GapMapFeed>());
+                std::shared_ptr<const CutPointCurves> curves =
+                    pipeline.get<CutPointCurves::Builder>().finish();
+                std::shared_ptr<const NoiseFloorHistogram> noiseFloor =
+                    pipeline.get<NoiseFloorHistogram::Builder>().finish();
+                std::shared_ptr<const LevelStats> levelStats =
+                    pipeline.get<LevelStats::Builder>().finish();
+                store.store(hash, pipeline.get<PeakPyramid::Builder>().finish(), curves,
+                            noiseFloor, levelStats);
+                onEnvelope(std::move(curves), std::move(noiseFloor), std::move(levelStats));
+            }
+        } else {
+            AnalysisPipeline<GapMapFeed, MipmapHandoff::Feed> pipeline(std::move(gapFeed),
+                                                                       std::move(waveform));
+            complete = pipeline.run(reader, context);
+            if (complete) {
+                pipeline.get<MipmapHandoff::Feed>().finish();
+                deliverGapMap(pipeline.get<GapMapFeed>());
+            }
+        }
+
+        if (!complete)
+            progressJob.markCancelled();
+    }
+
+    void deliverGapMap(GapMapFeed &feed) {
+        if (auto map = feed.finish())
+            gap->onMap(std::move(map));
+    }
+
+    const juce::File file;
+    ReaderPool &readers;
+    EnvelopeStore &store;
+    juce::String hash;
+    bool buildsEnvelope;
+    const std::optional<GapRequest> gap;
+    MipmapHandoff::Feed waveform;
+    IoGovernor &governor;
+    AnalysisProgress &progress;
+    const EnvelopeCallback onEnvelope;
+};
+} // namespace
+
+/**
+ * @class SilenceAnalysisWorker::Runner
+ * @brief Pool job that drains the analysis queue until it is empty.
+ */
+class SilenceAnalysisWorker::Runner final : public juce::ThreadPoolJob {
+  public:
+    explicit Runner(SilenceAnalysisWorker &owner)
+        : juce::ThreadPoolJob("SilenceAnalysisRunner"), worker(owner) {
+    }
+
+    JobStatus runJob() override {
+        while (!shouldExit()) {
+            const auto tickets = worker.takeNextTickets();
+            if (tickets.empty())
+                break;
+            worker.analyse(tickets, *this);
+        }
+        return jobHasFinished;
+    }
+
+  private:
+    SilenceAnalysisWorker &worker;
+};
 
 SilenceAnalysisWorker::SilenceAnalysisWorker(SilenceWorkerClient &owner, SessionState &state,
-                                               juce::AudioFormatManager &fm)
-    : Thread("SilenceWorker"), client(owner), sessionState(state), formatManager(fm) {
+                                               juce::AudioFormatManager &fm, IoGovernor &governor)
+    : client(owner), sessionState(state), formatManager(fm), ioGovernor(governor),
+      queue(Config::Audio::analysisQueueCapacity),
+      progress(Config::Audio::analysisTimingHistory) {
     lifeToken = std::make_shared<bool>(true);
+    readerPool = std::make_unique<ReaderPool>(
+        [this](const juce::File &file) { return createScanReader(file); },
+        Config::Audio::readerPoolMaxIdle, Config::Audio::readerPoolMaxOpen);
+    boundaryHistory = std::make_unique<BoundaryHistory>(Config::Audio::boundaryHistoryFiles,
+                                                        Config::Audio::boundaryHistoryRecords);
+    envelopeStore = std::make_unique<EnvelopeStore>(EnvelopeStore::getDefaultDirectory(),
+                                                    Config::Audio::peakCacheMaxBytes);
+
+    const int scanThreads = juce::jlimit(1, Config::Audio::parallelScanMaxThreads,
+                                         juce::SystemStats::getNumPhysicalCpus());
+    scanPool = std::make_unique<juce::ThreadPool>(juce::ThreadPoolOptions{}
+                                                      .withThreadName("SilenceScan")
+                                                      .withNumberOfThreads(scanThreads)
+                                                      .withDesiredThreadPriority(
+                                                          juce::Thread::Priority::low));
+    analysisPool = std::make_unique<juce::ThreadPool>(
+        juce::ThreadPoolOptions{}
+            .withThreadName("SilenceWorker")
+            .withNumberOfThreads(Config::Audio::analysisWorkerThreads)
+            .withDesiredThreadPriority(juce::Thread::Priority::low));
 }
 
 SilenceAnalysisWorker::~SilenceAnalysisWorker() {
-    stopThread(4000);
+    queue.cancelAll();
+    if (gapScanCancelled != nullptr)
+        gapScanCancelled->store(true);
+    analysisPool.reset(); // runners scan through scanPool
+    scanPool.reset();     // envelope jobs reference envelopeStore
 }
 
 bool SilenceAnalysisWorker::isBusy() const {
-    return busy.load() || isThreadRunning();
+    return !queue.isIdle();
 }
 
-void SilenceAnalysisWorker::startAnalysis(float thresholdVal, bool isIn,
-                                          const juce::String &filePath) {
-    if (isBusy())
+bool SilenceAnalysisWorker::isAnalyzing(bool detectingIn) const {
+    return queue.isActive(detectingIn);
+}
+
+void SilenceAnalysisWorker::startAnalysis(float threshold, bool detectingIn,
+                                          const juce::String &filePath,
+                                          AnalysisJobQueue::Priority priority,
+                                          MainDomain::DetectionMode mode,
+                                          MainDomain::FilterMode filter) {
+    const auto admission =
+        queue.push({filePath, detectingIn, threshold, priority, mode, filter});
+    if (admission == AnalysisJobQueue::Admission::Rejected) {
+        client.logStatusMessage(Config::Labels::analysisQueueFull, true);
         return;
+    }
+
+    // One runner per admitted request, up to the pool size; idle runners retire.
+    const juce::ScopedLock sl(runnerLock);
+    if (activeRunners < analysisPool->getNumThreads()) {
+        ++activeRunners;
+        analysisPool->addJob(new Runner(*this), true);
+    }
+}
+
+void SilenceAnalysisWorker::cancelAnalysis(const juce::String &filePath, bool detectingIn) {
+    queue.cancel(filePath, detectingIn);
+}
+
+void SilenceAnalysisWorker::cancelGapScan() {
+    if (gapScanCancelled != nullptr)
+        gapScanCancelled->store(true);
+}
 
-    threshold.store(thresholdVal);
-    detectingIn.store(isIn);
-    assignedFilePath = filePath;
+void SilenceAnalysisWorker::startGapScan(const juce::String &filePath, float threshold,
+                                         MipmapHandoff::Feed waveform) {
+    cancelGapScan();
+    gapScanCancelled = std::make_shared<std::atomic<bool>>(false);
 
-    startThread();
+    std::weak_ptr<bool> weakToken = lifeToken;
+    const auto cancelled = gapScanCancelled;
+    auto deliverMap = [this, weakToken, filePath,
+                       cancelled](std::shared_ptr<const SilenceGapMap> gapMap) {
+        juce::MessageManager::callAsync([this, weakToken, filePath, cancelled, gapMap]() {
+            if (auto token = weakToken.lock())
+                if (!cancelled->load())
+                    sessionState.setGapMapForFile(filePath, gapMap);
+        });
+    };
+
+    FilePassJob::GapRequest request;
+    request.threshold = threshold;
+    request.cancelled = gapScanCancelled;
+    request.onMap = std::move(deliverMap);
+    scanPool->addJob(new FilePassJob(juce::File(filePath), *readerPool, *envelopeStore, {},
+                                     std::move(request), std::move(waveform), ioGovernor,
+                                     progress, makeEnvelopeCallback(filePath)),
+                     true);
 }
 
-void SilenceAnalysisWorker::run() {
-    busy.store(true);
+/**
+ * @details The decoding reader is still opened first: it validates the file and supplies
+ *          the properties the mapped reader has to agree with. Its stream is released as
+ *          soon as the mapping takes over.
+ */
+std::unique_ptr<juce::AudioFormatReader>
+SilenceAnalysisWorker::createScanReader(const juce::File &file) const {
+    std::unique_ptr<juce::AudioFormatReader> decoded(formatManager.createReaderFor(file));
+    if (decoded == nullptr)
+        return nullptr;
+
+    if (auto mapped = MappedPcmReader::createFor(file, *decoded))
+        return mapped;
+    return decoded;
+}
 
-    const juce::String filePath = assignedFilePath;
+std::vector<AnalysisJobQueue::Ticket> SilenceAnalysisWorker::takeNextTickets() {
+    // Popping and retiring under one lock means a concurrent startAnalysis() either
+    // sees this runner still active (and its request gets popped here) or retired.
+    const juce::ScopedLock sl(runnerLock);
+    std::vector<AnalysisJobQueue::Ticket> tickets;
+    auto ticket = queue.pop();
+    if (!ticket.has_value()) {
+        --activeRunners;
+        return tickets;
+    }
 
-    juce::File fileToAnalyze(filePath);
+    tickets.push_back(*ticket);
+    if (auto companion = queue.popCompanion(*ticket))
+        tickets.push_back(*companion);
+    return tickets;
+}
 
-    std::unique_ptr<juce::AudioFormatReader> localReader(
-        formatManager.createReaderFor(fileToAnalyze));
+/**
+ * @details All tickets share one reader and one FileIdentity hash. A lone Peak ticket
+ *          takes the pyramid or the segmented ParallelSilenceScan; a Peak In/Out pair
+ *          without a pyramid takes a FusedSilenceScan so the file is opened and streamed
+ *          once. Rms and PeakHold tickets stream through a WindowedDetector. Each ticket
+ *          keeps its own cancel flag, so superseding one direction does not stop the other.
+ */
+void SilenceAnalysisWorker::analyse(const std::vector<AnalysisJobQueue::Ticket> &tickets,
+                                    juce::ThreadPoolJob &job) {
+    const juce::File fileToAnalyze(tickets.front().request.filePath);
+    const juce::String hash = FileIdentity::computeHash(fileToAnalyze);
 
-    juce::int64 result = -1;
-    bool success = false;
-    juce::int64 sampleRate = 0;
-    juce::int64 lengthInSamples = 0;
+    const ReaderPool::Lease localReader = readerPool->acquire(fileToAnalyze);
 
-    if (localReader != nullptr) {
-        sampleRate = (juce::int64)localReader->sampleRate;
-        lengthInSamples = localReader->lengthInSamples;
+    if (!localReader) {
+        for (const auto &ticket : tickets)
+            deliver(ticket, -1, false, 0, 0, hash, nullptr, nullptr, nullptr);
+        return;
+    }
 
-        if (detectingIn.load()) {
-            result = SilenceAnalysisAlgorithms::findSilenceIn(*localReader, threshold.load(), this);
-        } else {
-            result =
-                SilenceAnalysisAlgorithms::findSilenceOut(*localReader, threshold.load(), this);
+    const auto sampleRate = (juce::int64)localReader->sampleRate;
+    const juce::int64 lengthInSamples = localReader->lengthInSamples;
+    const double bytesPerFrame =
+        AnalysisProgress::storageBytesPerFrame(fileToAnalyze, *localReader);
+    const auto curves = envelopeStore->findCurves(hash);
+    const auto noiseFloor = envelopeStore->findNoiseFloor(hash);
+    const auto levelStats = envelopeStore->findLevelStats(hash);
+    const auto pyramid = envelopeStore->findPyramid(hash);
+    const bool hasPyramid = pyramid != nullptr && pyramid->matches(*localReader);
+
+    const auto orMissing = [](juce::int64 value) {
+        return value == SilenceAnalysisAlgorithms::aborted ? (juce::int64)-1 : value;
+    };
+    const auto isPlainPeak = [](const AnalysisJobQueue::Request &request) {
+        return request.mode == MainDomain::DetectionMode::Peak &&
+               request.filter == MainDomain::FilterMode::Off;
+    };
+    const bool allPeak = std::all_of(tickets.begin(), tickets.end(), [&](const auto &ticket) {
+        return isPlainPeak(ticket.request);
+    });
+
+    // Plain Peak results at earlier Thresholds bound where the new boundary can be, so a
+    // nudged Threshold only reads between them. The pyramid answers from one leaf anyway.
+    std::vector<std::optional<BoundaryHistory::Window>> windows(tickets.size());
+    if (!hasPyramid)
+        for (size_t i = 0; i < tickets.size(); ++i)
+            if (isPlainPeak(tickets[i].request))
+                windows[i] = boundaryHistory->narrow(hash, lengthInSamples,
+                                                     tickets[i].request.detectingIn,
+                                                     tickets[i].request.threshold);
+    const bool anyWindow = std::any_of(windows.begin(), windows.end(),
+                                       [](const auto &window) { return window.has_value(); });
+    const auto remember = [&](const AnalysisJobQueue::Request &request, juce::int64 result) {
+        boundaryHistory->record(hash, lengthInSamples, request.detectingIn, request.threshold,
+                                result);
+    };
+
+    std::vector<juce::int64> results(tickets.size(), -1);
+    if (tickets.size() == 2 && allPeak && !hasPyramid && !anyWindow) {
+        const bool firstIsIn = tickets[0].request.detectingIn;
+        const auto &inTicket = tickets[firstIsIn ? 0 : 1];
+        const auto &outTicket = tickets[firstIsIn ? 1 : 0];
+        // One pass over one reader, so one progress job covers both directions.
+        AnalysisProgress::Job progressJob(progress, fileToAnalyze,
+                                          Config::Labels::analysisKindInOut, lengthInSamples,
+                                          bytesPerFrame);
+        const ScanContext inContext{nullptr, inTicket.cancelled.get(), &ioGovernor, &job,
+                                    &progressJob};
+        const ScanContext outContext{nullptr, outTicket.cancelled.get(), &ioGovernor, &job,
+                                     &progressJob};
+
+        const auto boundaries =
+            FusedSilenceScan::findBoundaries(*localReader, inTicket.request.threshold,
+                                             outTicket.request.threshold, inContext, outContext);
+        if (inContext.shouldStop() || outContext.shouldStop())
+            progressJob.markCancelled();
+        if (boundaries.in != SilenceAnalysisAlgorithms::aborted && !inContext.shouldStop())
+            remember(inTicket.request, boundaries.in);
+        if (boundaries.out != SilenceAnalysisAlgorithms::aborted && !outContext.shouldStop())
+            remember(outTicket.request, boundaries.out);
+        results[firstIsIn ? 0 : 1] = orMissing(boundaries.in);
+        results[firstIsIn ? 1 : 0] = orMissing(boundaries.out);
+    } else {
+        for (size_t i = 0; i < tickets.size(); ++i) {
+            const auto &request = tickets[i].request;
+            AnalysisProgress::Job progressJob(
+                progress, fileToAnalyze,
+                request.detectingIn ? Config::Labels::analysisKindIn
+                                    : Config::Labels::analysisKindOut,
+                lengthInSamples, bytesPerFrame);
+            const ScanContext context{nullptr, tickets[i].cancelled.get(), &ioGovernor, &job,
+                                      &progressJob};
+            if (!isPlainPeak(request)) {
+                // The windowed modes and the pre-filter carry state across chunks, so they
+                // stream sequentially; the pyramid only knows unfiltered peaks.
+                results[i] = orMissing(
+                    request.detectingIn
+                        ? SilenceAnalysisAlgorithms::findSilenceIn(*localReader, request.threshold,
+                                                                   request.mode, context,
+                                                                   request.filter)
+                        : SilenceAnalysisAlgorithms::findSilenceOut(*localReader,
+                                                                    request.threshold,
+                                                                    request.mode, context,
+                                                                    request.filter));
+            } else if (windows[i].has_value()) {
+                const auto &window = *windows[i];
+                juce::int64 found = -1;
+                if (!window.isEmpty())
+                    found = request.detectingIn
+                                ? SilenceAnalysisAlgorithms::findFirstAboveInRange(
+                                      *localReader, window.start, window.end, request.threshold,
+                                      context)
+                                : SilenceAnalysisAlgorithms::findLastAbove(
+                                      *localReader, window.start, window.end, request.threshold,
+                                      context);
+                if (found == -1)
+                    found = window.fallback;
+                if (found != SilenceAnalysisAlgorithms::aborted && !context.shouldStop())
+                    remember(request, found);
+                results[i] = orMissing(found);
+            } else if (hasPyramid) {
+                results[i] = request.detectingIn
+                                 ? SilenceAnalysisAlgorithms::findSilenceIn(
+                                       *pyramid, *localReader, request.threshold)
+                                 : SilenceAnalysisAlgorithms::findSilenceOut(
+                                       *pyramid, *localReader, request.threshold);
+                // -1 here may also be a failed leaf read, so only crossings are kept.
+                if (results[i] >= 0)
+                    remember(request, results[i]);
+            } else {
+                const ParallelSilenceScan::ReaderFactory openReader = [this, fileToAnalyze] {
+                    return readerPool->acquire(fileToAnalyze);
+                };
+                results[i] =
+                    request.detectingIn
+                        ? ParallelSilenceScan::findSilenceIn(*localReader, openReader, *scanPool,
+                                                             request.threshold, context)
+                        : ParallelSilenceScan::findSilenceOut(*localReader, openReader,
+                                                              *scanPool, request.threshold,
+                                                              context);
+                // -1 here may also be a cancelled or failed segment, so only crossings are kept.
+                if (results[i] >= 0 && !context.shouldStop())
+                    remember(request, results[i]);
+            }
+            if (context.shouldStop())
+                progressJob.markCancelled();
         }
-        success = true;
     }
 
+    if ((!hasPyramid || curves == nullptr || noiseFloor == nullptr || levelStats == nullptr) &&
+        !job.shouldExit())
+        scheduleEnvelopeBuild(fileToAnalyze, hash);
+
+    for (size_t i = 0; i < tickets.size(); ++i)
+        deliver(tickets[i], results[i], true, sampleRate, lengthInSamples, hash, curves,
+                noiseFloor, levelStats);
+}
+
+void SilenceAnalysisWorker::deliver(const AnalysisJobQueue::Ticket &ticket, juce::int64 result,
+                                    bool success, juce::int64 sampleRate,
+                                    juce::int64 lengthInSamples, const juce::String &hash,
+                                    std::shared_ptr<const CutPointCurves> curves,
+                                    std::shared_ptr<const NoiseFloorHistogram> noiseFloor,
+                                    std::shared_ptr<const LevelStats> levelStats) {
+    const juce::String filePath = ticket.request.filePath;
+    const bool detectingIn = ticket.request.detectingIn;
     std::weak_ptr<bool> weakToken = lifeToken;
 
     juce::MessageManager::callAsync(
-        [this, weakToken, result, success, sampleRate, lengthInSamples, filePath]() {
+        [this, weakToken, ticket, result, success, sampleRate, lengthInSamples, filePath, hash,
+         curves, noiseFloor, levelStats, detectingIn]() {
             if (auto token = weakToken.lock()) {
+                const bool current = queue.isCurrent(ticket);
+                queue.finish(ticket);
+                if (!current)
+                    return; // superseded or cancelled while scanning
+
                 if (!success || lengthInSamples <= 0) {
                     if (lengthInSamples <= 0 && success)
                         client.logStatusMessage(Config::Labels::errorZeroLength, true);
@@ -79,13 +546,22 @@ void SilenceAnalysisWorker::run() {
                 } else {
                     client.logStatusMessage(Config::Labels::scanningCutPoints);
 
-                    const bool stillActive = detectingIn.load() ? client.isAutoCutInActive()
-                                                                : client.isAutoCutOutActive();
+                    const bool stillActive = detectingIn ? client.isAutoCutInActive()
+                                                         : client.isAutoCutOutActive();
 
                     FileMetadata metadata = sessionState.getMetadataForFile(filePath);
+                    metadata.hash = hash;
+                    if (curves != nullptr && curves->getLengthInSamples() == lengthInSamples)
+                        metadata.cutCurves = curves;
+                    if (noiseFloor != nullptr &&
+                        noiseFloor->getLengthInSamples() == lengthInSamples)
+                        metadata.noiseFloor = noiseFloor;
+                    if (levelStats != nullptr &&
+                        levelStats->getLengthInSamples() == lengthInSamples)
+                        metadata.levelStats = levelStats;
                     if (result != -1) {
                         const double resultSeconds = (double)result / (double)sampleRate;
-                        if (detectingIn.load()) {
+                        if (detectingIn) {
                             if (stillActive) {
                                 metadata.cutIn = resultSeconds;
                                 client.logStatusMessage(
@@ -96,7 +572,8 @@ void SilenceAnalysisWorker::run() {
                                     Config::Labels::closeBracket);
                             }
                         } else {
-                            const juce::int64 tailSamples = (juce::int64)(sampleRate * 0.05);
+                            const juce::int64 tailSamples =
+                                (juce::int64)(sampleRate * Config::Audio::autoCutOutTailSeconds);
                             const juce::int64 endPoint64 = result + tailSamples;
                             const juce::int64 finalEndPoint = std::min(endPoint64, lengthInSamples);
                             const double endSeconds = (double)finalEndPoint / (double)sampleRate;
@@ -118,10 +595,46 @@ void SilenceAnalysisWorker::run() {
                     if (stillActive) {
                         metadata.isAnalyzed = true;
                         sessionState.setMetadataForFile(filePath, metadata);
+                    } else {
+                        if (metadata.cutCurves != nullptr)
+                            sessionState.setCutCurvesForFile(filePath, metadata.cutCurves);
+                        if (metadata.noiseFloor != nullptr)
+                            sessionState.setNoiseFloorForFile(filePath, metadata.noiseFloor);
+                        if (metadata.levelStats != nullptr)
+                            sessionState.setLevelStatsForFile(filePath, metadata.levelStats);
                     }
+                    if (metadata.noiseFloor != nullptr)
+                        client.noiseFloorEstimated(filePath);
                 }
-
-                busy.store(false);
             }
         });
 }
+
+void SilenceAnalysisWorker::scheduleEnvelopeBuild(const juce::File &file,
+                                                  const juce::String &hash) {
+    if (!envelopeStore->tryBeginBuild(hash))
+        return;
+
+    scanPool->addJob(new FilePassJob(file, *readerPool, *envelopeStore, hash, std::nullopt,
+                                     {}, ioGovernor, progress,
+                                     makeEnvelopeCallback(file.getFullPathName())),
+                     true);
+}
+
+SilenceAnalysisWorker::EnvelopeCallback
+SilenceAnalysisWorker::makeEnvelopeCallback(const juce::String &filePath) {
+    std::weak_ptr<bool> weakToken = lifeToken;
+    return [this, weakToken, filePath](std::shared_ptr<const CutPointCurves> curves,
+                                       std::shared_ptr<const NoiseFloorHistogram> noiseFloor,
+                                       std::shared_ptr<const LevelStats> levelStats) {
+        juce::MessageManager::callAsync(
+            [this, weakToken, filePath, curves, noiseFloor, levelStats]() {
+                if (auto token = weakToken.lock()) {
+                    sessionState.setCutCurvesForFile(filePath, curves);
+                    sessionState.setNoiseFloorForFile(filePath, noiseFloor);
+                    sessionState.setLevelStatsForFile(filePath, levelStats);
+                    client.noiseFloorEstimated(filePath);
+                }
+            });
+    };
+}
@@ -9,94 +9,248 @@
 #include <JuceHeader.h>
 #endif
 
+#include "Workers/AnalysisJobQueue.h"
+#include "Workers/AnalysisProgress.h"
+#include "Workers/MipmapHandoff.h"
 #include "Workers/SilenceWorkerClient.h"
-#include <atomic>
+#include <functional>
 #include <memory>
+#include <vector>
 
+class CutPointCurves;
+class LevelStats;
+class NoiseFloorHistogram;
+class IoGovernor;
 class SessionState;
+class EnvelopeStore;
+class ReaderPool;
+class BoundaryHistory;
 
 /**
  * @file SilenceAnalysisWorker.h
  * @ingroup AudioEngine
- * @brief Thread-safe background worker for non-blocking audio silence detection.
+ * @brief Thread-safe background scheduler for non-blocking audio silence detection.
  * 
  * @details Architecturally, this class serves as a "Thread-Safe Background Worker" that 
  *          implements the "Air Gap" protocol. It offloads the computationally expensive 
- *          task of scanning entire audio files for silence regions to a dedicated 
- *          low-priority background thread. This ensures that the UI remains responsive 
- *          and the Audio Thread remains jitter-free during analysis.
+ *          task of scanning entire audio files for silence regions to a small pool of
+ *          low-priority background threads. This ensures that the UI remains responsive 
+ *          and the Audio Thread remains jitter-free during analysis. Scans run flat out
+ *          unless the AudioPlayer's IoGovernor reports playback at risk, in which case
+ *          they yield after every chunk.
  * 
- *          The worker operates by:
- *          1. Creating a private `juce::AudioFormatReader` for the target file, 
- *             ensuring no resource contention with the `AudioPlayer`.
+ *          Requests never get lost: they enter an AnalysisJobQueue, which de-duplicates
+ *          identical requests, supersedes stale ones for the same file and direction, and
+ *          bounds its size. Up to `Config::Audio::analysisWorkerThreads` runners drain the
+ *          queue in priority order, so enabling Auto-Cut In and Out together analyses
+ *          both sides concurrently.
+ * 
+ *          Each pass operates by:
+ *          1. Checking out a private `juce::AudioFormatReader` for the target file from
+ *             the worker's ReaderPool, ensuring no resource contention with the
+ *             `AudioPlayer`. Readers are returned to the pool after the pass, so a
+ *             burst of Threshold edits on one file opens it (and indexes an MP3) once.
  *          2. Iterating through the audio samples in blocks to identify amplitude 
- *             crossings relative to a user-defined decibel threshold.
+ *             crossings relative to a user-defined decibel threshold. Long PCM files
+ *             are split into segments and scanned by the runner together with the idle
+ *             threads of a private `juce::ThreadPool` (see ParallelSilenceScan), each
+ *             task with its own reader leased from the same ReaderPool. After the
+ *             first scan a PeakPyramid and CutPointCurves of the file are built in the
+ *             background and persisted, so later Threshold edits are answered by reading
+ *             a single 256-sample leaf, or by the curves alone, instead of rescanning.
+ *             The same pass counts a NoiseFloorHistogram, from which the Auto Threshold
+ *             is suggested without another read, and the LevelStats of the stats overlay.
+ *             Every whole-file pass is one AnalysisPipeline decode feeding all of these
+ *             builders, plus the SilenceGapMap when a gap scan is due.
+ *             When In and Out of one file are both pending, a single runner serves them
+ *             with one FusedSilenceScan over one reader.
+ *             Until the pyramid exists, a BoundaryHistory of recent Peak results narrows a
+ *             nudged Threshold's scan to the stretch between the boundaries found at the
+ *             neighbouring Thresholds, which is usually a few chunks around the old marker.
  *          3. Packaging the results into a `FileMetadata` object.
  *          4. Communicating results back to the Message Thread via 
  *             `juce::MessageManager::callAsync`, strictly adhering to the threading law.
+ *             Results of superseded requests are discarded there.
+ *
+ *          Every pass, gap scan and envelope build reports its chunks to the worker's
+ *          AnalysisProgress, which the UI samples for live progress and which keeps the
+ *          timing of recent jobs for the stats overlay.
  * 
+ * @see AnalysisJobQueue
+ * @see AnalysisPipeline
+ * @see AnalysisProgress
+ * @see ReaderPool
+ * @see BoundaryHistory
+ * @see IoGovernor
  * @see SilenceAnalysisAlgorithms
  * @see SilenceWorkerClient
  * @see SessionState
  * @see FileMetadata
  */
-class SilenceAnalysisWorker : public juce::Thread {
+class SilenceAnalysisWorker {
   public:
     /**
      * @brief Constructs the worker and initializes its dependencies.
      * @param client Reference to the client interface that will receive results.
      * @param sessionState Reference to the global state for boundary updates.
      * @param formatManager Reference to the format manager for file decoding.
+     * @param ioGovernor Paces every scan and envelope build against playback health.
      */
     explicit SilenceAnalysisWorker(SilenceWorkerClient &client, SessionState &sessionState,
-                                   juce::AudioFormatManager &formatManager);
+                                   juce::AudioFormatManager &formatManager,
+                                   IoGovernor &ioGovernor);
 
     /**
-     * @brief Ensures the thread is safely stopped before destruction.
+     * @brief Cancels all work and joins the pools before destruction.
      */
-    ~SilenceAnalysisWorker() override;
+    ~SilenceAnalysisWorker();
 
     /**
-     * @brief Triggers a new analysis pass for a specific file.
+     * @brief Schedules an analysis pass for a specific file.
      * @param threshold The dB threshold to use for silence detection.
      * @param detectingIn True if searching for the 'In' point, false for 'Out'.
      * @param filePath Absolute path to the file to analyze.
-     * @note If the worker is already busy, this request may be queued or ignored 
-     *       depending on the implementation of the specific algorithm.
+     * @param priority Scheduling rank; user-driven edits should be `Interactive`.
+     * @param mode The criterion that ends the silence (see MainDomain::DetectionMode).
+     * @param filter The band the scan listens to; filtered scans always stream.
+     * @note Identical pending requests are merged, and a request with a new Threshold,
+     *       mode or filter supersedes the pending or running one for the same file and
+     *       direction.
+     */
+    void startAnalysis(float threshold, bool detectingIn, const juce::String &filePath,
+                       AnalysisJobQueue::Priority priority = AnalysisJobQueue::Priority::Normal,
+                       MainDomain::DetectionMode mode = MainDomain::DetectionMode::Peak,
+                       MainDomain::FilterMode filter = MainDomain::FilterMode::Off);
+
+    /**
+     * @brief Withdraws the pending pass and stops the running ones for a file and direction.
+     * @details Running passes stop at their next chunk and their results are discarded.
+     * @param filePath Absolute path to the file.
+     * @param detectingIn True for the 'In' pass, false for 'Out'.
      */
-    void startAnalysis(float threshold, bool detectingIn, const juce::String &filePath);
+    void cancelAnalysis(const juce::String &filePath, bool detectingIn);
 
     /**
-     * @brief Checks if the worker thread is currently executing an analysis pass.
-     * @return True if the thread is active.
+     * @brief Checks if any analysis pass is pending or running.
+     * @return True while the queue holds work.
      */
     bool isBusy() const;
 
     /**
-     * @brief Queries the current direction of detection.
-     * @return True if searching for start-of-audio silence.
+     * @brief Checks for live work in one direction.
+     * @param detectingIn True for start-of-audio, false for end-of-audio passes.
+     * @return True if a current pass for that direction is pending or running.
+     */
+    bool isAnalyzing(bool detectingIn) const;
+
+    /**
+     * @brief Schedules a background scan for every internal silent gap of a file.
+     * @details The finished SilenceGapMap is attached to the file's metadata on the
+     *          Message Thread. A newer call cancels the previous scan, and its result is
+     *          dropped even if it was already posted. If the file's envelope is neither
+     *          cached nor being built, the same decode pass builds it too, and so does the
+     *          waveform when given a building Feed, so opening a file reads it once for all
+     *          of them. Call from the Message Thread.
+     * @param filePath Absolute path to the file to scan.
+     * @param threshold The linear amplitude threshold that separates silence from audio.
+     * @param waveform The waveform build claimed with WaveformManager::claimBuild(), if any.
      */
-    bool isDetectingIn() const {
-        return detectingIn.load();
+    void startGapScan(const juce::String &filePath, float threshold,
+                      MipmapHandoff::Feed waveform = {});
+
+    /** @brief Stops the latest gap scan and drops its result. Call from the Message Thread. */
+    void cancelGapScan();
+
+    /** @return Live progress and timing history of every pass, gap scan and envelope build. */
+    const AnalysisProgress &getProgress() const noexcept {
+        return progress;
     }
 
   private:
+    class Runner;
+
+    /** @brief Receives a file's finished envelope summaries, from any thread. */
+    using EnvelopeCallback = std::function<void(std::shared_ptr<const CutPointCurves>,
+                                                std::shared_ptr<const NoiseFloorHistogram>,
+                                                std::shared_ptr<const LevelStats>)>;
+
+    /**
+     * @brief Takes the next request for a runner, retiring the runner if none is left.
+     * @details The pending request for the other direction of the same file, if any, is
+     *          taken along so both are served by one fused pass.
+     * @return One or two tickets for the same file, or an empty list if the queue is empty.
+     */
+    std::vector<AnalysisJobQueue::Ticket> takeNextTickets();
+
+    /**
+     * @brief Performs one analysis pass on a runner thread.
+     * @details This method performs the actual file I/O and sample scanning. It checks
+     *          each ticket's cancel flag and the job's exit signal after every chunk to
+     *          allow for immediate cancellation.
+     * @param tickets The requests to serve; all target the same file.
+     * @param job The runner executing the pass.
+     */
+    void analyse(const std::vector<AnalysisJobQueue::Ticket> &tickets, juce::ThreadPoolJob &job);
+
+    /**
+     * @brief Posts one ticket's result to the Message Thread and applies it there if current.
+     * @param ticket The request that was served.
+     * @param result The boundary sample, or -1 if none was found.
+     * @param success False if the file could not be opened.
+     * @param sampleRate The file's sample rate.
+     * @param lengthInSamples The file's length.
+     * @param hash The file's FileIdentity hash.
+     * @param curves The file's cached CutPointCurves, if any.
+     * @param noiseFloor The file's cached NoiseFloorHistogram, if any.
+     * @param levelStats The file's cached LevelStats, if any.
+     */
+    void deliver(const AnalysisJobQueue::Ticket &ticket, juce::int64 result, bool success,
+                 juce::int64 sampleRate, juce::int64 lengthInSamples, const juce::String &hash,
+                 std::shared_ptr<const CutPointCurves> curves,
+                 std::shared_ptr<const NoiseFloorHistogram> noiseFloor,
+                 std::shared_ptr<const LevelStats> levelStats);
+
+    /**
+     * @brief Queues a background envelope build for a file unless one exists or is running.
+     * @details The finished CutPointCurves, NoiseFloorHistogram and LevelStats are
+     *          attached to the file's metadata on the Message Thread, and the client is told
+     *          that an Auto Threshold can now be suggested.
+     * @param file The file to summarize.
+     * @param hash The file's FileIdentity hash, used as the cache key.
+     */
+    void scheduleEnvelopeBuild(const juce::File &file, const juce::String &hash);
+
+    /**
+     * @brief Builds the callback that attaches a finished envelope to a file's metadata.
+     * @details The returned function may be called from any thread; it posts to the
+     *          Message Thread and tells the client that an Auto Threshold can be suggested.
+     * @param filePath Absolute path to the summarized file.
+     */
+    EnvelopeCallback makeEnvelopeCallback(const juce::String &filePath);
+
     /**
-     * @brief The main execution loop for the background thread.
-     * @details This method performs the actual file I/O and sample scanning. 
-     *          It periodically checks `threadShouldExit()` to allow for 
-     *          immediate cancellation.
+     * @brief Opens a private reader for a scan, preferring the zero-copy mapped path.
+     * @param file The file to read.
+     * @return A MappedPcmReader for plain PCM WAV/AIFF, the decoding reader for every
+     *         other format, or nullptr if the file cannot be opened.
      */
-    void run() override;
+    std::unique_ptr<juce::AudioFormatReader> createScanReader(const juce::File &file) const;
 
     SilenceWorkerClient &client;                      /**< Interface for pushing results back to the UI. */
     SessionState &sessionState;                        /**< The central state hub for metadata storage. */
-    juce::AudioFormatManager &formatManager;          /**< Used to instantiate the private file reader. */
-    std::atomic<float> threshold{0.0f};                /**< The dB level considered "silence" for this pass. */
-    std::atomic<bool> detectingIn{true};              /**< Directional flag for the analysis algorithm. */
-    std::atomic<bool> busy{false};                     /**< Atomic flag indicating background activity. */
-    juce::String assignedFilePath;                    /**< The path currently being analyzed. */
+    juce::AudioFormatManager &formatManager;          /**< Used to instantiate the private file readers. */
+    IoGovernor &ioGovernor;                           /**< Decides how long scans yield to playback. */
+    AnalysisJobQueue queue;                           /**< Pending and running analysis requests. */
+    AnalysisProgress progress;                        /**< Lock-free progress and per-job timings. */
+    juce::CriticalSection runnerLock;                 /**< Guards runner start and retirement. */
+    int activeRunners{0};                             /**< Runners currently draining the queue. */
+    std::unique_ptr<ReaderPool> readerPool;           /**< Idle private readers reused across passes. */
+    std::unique_ptr<BoundaryHistory> boundaryHistory; /**< Recent Peak boundaries that narrow re-scans. */
+    std::unique_ptr<EnvelopeStore> envelopeStore;     /**< Cached per-file envelopes for instant Threshold queries. */
+    std::unique_ptr<juce::ThreadPool> scanPool;       /**< Threads for segmented scans and pyramid builds. */
+    std::unique_ptr<juce::ThreadPool> analysisPool;   /**< Threads running the queue's analysis passes. */
 
+    std::shared_ptr<std::atomic<bool>> gapScanCancelled; /**< Cancel flag of the latest gap scan. */
     std::shared_ptr<bool> lifeToken;                  /**< Safety token for async callback validation. */
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SilenceAnalysisWorker)
@@ -1,27 +1,263 @@
 
 
 #include "Core/WaveformManager.h"
+#include "Utils/Config.h"
+#include "Utils/FileIdentity.h"
+#include "Workers/AnalysisPipeline.h"
+#include "Workers/IoGovernor.h"
+#include "Workers/ScanContext.h"
 
-WaveformManager::WaveformManager(juce::AudioFormatManager &formatManagerIn)
-    : formatManager(formatManagerIn) {
+namespace {
+/** @brief Pipeline stage that announces every decoded chunk to the waveform views. */
+struct ChangeNotifier {
+    juce::ChangeBroadcaster *broadcaster;
+
+    void addChunk(const juce::AudioBuffer<float> &, int) {
+        broadcaster->sendChangeMessage();
+    }
+};
+} // namespace
+
+/**
+ * @class WaveformManager::LookupJob
+ * @brief Loads one file's mipmap from the cache on the build thread, and tells a waiting
+ *        MipmapHandoff::Feed whether it is needed.
+ */
+class WaveformManager::LookupJob final : public juce::ThreadPoolJob {
+  public:
+    LookupJob(const juce::File &sourceFile, juce::uint32 loadGeneration,
+              WaveformManager &ownerManager)
+        : juce::ThreadPoolJob("WaveformLookup"), file(sourceFile), generation(loadGeneration),
+          owner(ownerManager) {
+    }
+
+    JobStatus runJob() override {
+        const juce::String hash = FileIdentity::computeHash(file);
+        if (hash.isNotEmpty() && owner.cache.load(hash, owner.mipmap)) {
+            owner.handoff.publishLookup(generation, true);
+            owner.changeBroadcaster.sendChangeMessage();
+            return jobHasFinished;
+        }
+
+        // Posted before the Feed is released, so it reaches the Message Thread first.
+        std::weak_ptr<bool> weakToken = owner.lifeToken;
+        auto *manager = &owner;
+        const juce::uint32 missed = generation;
+        juce::MessageManager::callAsync([manager, weakToken, missed, hash]() {
+            if (auto token = weakToken.lock())
+                manager->lookupMissed(missed, hash);
+        });
+        owner.handoff.publishLookup(generation, false);
+        return jobHasFinished;
+    }
+
+  private:
+    juce::File file;
+    juce::uint32 generation;
+    WaveformManager &owner;
+};
+
+/**
+ * @class WaveformManager::BuildJob
+ * @brief Decodes one file through a PeakMipmap::Builder on the build thread, when no
+ *        analysis pass took the build over.
+ */
+class WaveformManager::BuildJob final : public juce::ThreadPoolJob {
+  public:
+    BuildJob(std::unique_ptr<juce::AudioFormatReader> source, const juce::String &fileHash,
+             WaveformManager &ownerManager)
+        : juce::ThreadPoolJob("WaveformBuild"), reader(std::move(source)), hash(fileHash),
+          owner(ownerManager) {
+    }
+
+    JobStatus runJob() override {
+        ScanContext context;
+        context.job = this;
+        context.governor = &owner.governor;
+        AnalysisPipeline<PeakMipmap::Builder, ChangeNotifier> pipeline(
+            PeakMipmap::Builder(owner.mipmap), ChangeNotifier{&owner.changeBroadcaster});
+        if (!pipeline.run(*reader, context))
+            return jobHasFinished;
+
+        pipeline.get<PeakMipmap::Builder>().finish();
+        owner.changeBroadcaster.sendChangeMessage();
+        owner.saveMipmap(hash, *this);
+        return jobHasFinished;
+    }
+
+  private:
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::String hash;
+    WaveformManager &owner;
+};
+
+/**
+ * @class WaveformManager::SaveJob
+ * @brief Saves a mipmap an analysis pass finished building, on the build thread.
+ */
+class WaveformManager::SaveJob final : public juce::ThreadPoolJob {
+  public:
+    SaveJob(const juce::String &fileHash, WaveformManager &ownerManager)
+        : juce::ThreadPoolJob("WaveformSave"), hash(fileHash), owner(ownerManager) {
+    }
+
+    JobStatus runJob() override {
+        owner.saveMipmap(hash, *this);
+        return jobHasFinished;
+    }
+
+  private:
+    juce::String hash;
+    WaveformManager &owner;
+};
+
+/**
+ * @class WaveformManager::StoreJob
+ * @brief Writes one serialized mipmap to the cache and trims it, on the store thread.
+ */
+class WaveformManager::StoreJob final : public juce::ThreadPoolJob {
+  public:
+    StoreJob(const juce::String &fileHash, std::unique_ptr<juce::MemoryBlock> data,
+             WaveformCache &waveformCache)
+        : juce::ThreadPoolJob("WaveformStore"), hash(fileHash), serialized(std::move(data)),
+          cache(waveformCache) {
+    }
+
+    JobStatus runJob() override {
+        if (shouldExit() || !cache.store(hash, *serialized))
+            return jobHasFinished;
+        serialized.reset(); // the copy can be large; free it before scanning the folder
+        if (!shouldExit())
+            cache.evict();
+        return jobHasFinished;
+    }
+
+  private:
+    juce::String hash;
+    std::unique_ptr<juce::MemoryBlock> serialized;
+    WaveformCache &cache;
+};
+
+WaveformManager::WaveformManager(juce::AudioFormatManager &formatManagerIn,
+                                 IoGovernor &ioGovernor)
+    : formatManager(formatManagerIn), governor(ioGovernor),
+      cache(WaveformCache::getDefaultDirectory(), Config::Audio::waveformCacheMaxBytes),
+      lifeToken(std::make_shared<bool>(true)),
+      handoff(
+          mipmap, [this]() { changeBroadcaster.sendChangeMessage(); },
+          [this, weakToken = std::weak_ptr<bool>(lifeToken)](juce::uint32 ended, bool complete) {
+              juce::MessageManager::callAsync([this, weakToken, ended, complete]() {
+                  if (auto token = weakToken.lock())
+                      feedEnded(ended, complete);
+              });
+          }) {
+    buildPool = std::make_unique<juce::ThreadPool>(
+        juce::ThreadPoolOptions{}.withThreadName("WaveformBuild").withNumberOfThreads(1));
+    storePool = std::make_unique<juce::ThreadPool>(
+        juce::ThreadPoolOptions{}.withThreadName("WaveformStore").withNumberOfThreads(1));
+}
+
+WaveformManager::~WaveformManager() {
+    stopTimer();
+    buildPool.reset(); // the jobs write into mipmap and queue store jobs
+    storePool.reset();
 }
 
 void WaveformManager::loadFile(const juce::File &file) {
-    thumbnail.setSource(new juce::FileInputSource(file));
+    pendingFile = file;
+    pendingHash.clear();
+    generation = handoff.beginFile(); // a Feed of the previous file stops writing here
+    startPendingLoad();
+}
+
+MipmapHandoff::Feed WaveformManager::claimBuild(const juce::File &file) {
+    if (file != pendingFile)
+        return {};
+    return handoff.claimFeed();
+}
+
+void WaveformManager::timerCallback() {
+    startPendingLoad();
+}
+
+/**
+ * @details The mipmap is resized in place, so the previous build must have stopped writing.
+ *          A build stops within one chunk of being told to; the Message Thread waits for it
+ *          only briefly and otherwise retries from the timer, so it never stalls behind a
+ *          slow read. Only the cache lookup is queued here: a miss is decoded by the pass
+ *          that claimed the build, or else by lookupMissed().
+ */
+void WaveformManager::startPendingLoad() {
+    if (!buildPool->removeAllJobs(true, Config::Audio::waveformBuildStopWaitMs)) {
+        startTimer(Config::Audio::waveformBuildStopWaitMs);
+        return;
+    }
+    stopTimer();
+
+    const juce::File file = pendingFile;
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0) {
+        mipmap.reset(0, 0, 0.0);
+        handoff.publishLookup(generation, true); // nothing for a Feed to build
+        changeBroadcaster.sendChangeMessage();
+        return;
+    }
+
+    mipmap.reset(reader->lengthInSamples, (int)reader->numChannels, reader->sampleRate);
+    buildPool->addJob(new LookupJob(file, generation, *this), true);
+    changeBroadcaster.sendChangeMessage();
+}
+
+void WaveformManager::lookupMissed(juce::uint32 lookupGeneration, const juce::String &hash) {
+    if (!handoff.isCurrent(lookupGeneration))
+        return;
+    pendingHash = hash;
+    if (!handoff.claimDecode(lookupGeneration))
+        return; // an analysis pass is filling the mipmap
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(pendingFile));
+    if (reader != nullptr)
+        buildPool->addJob(new BuildJob(std::move(reader), hash, *this), true);
+}
+
+/**
+ * @details A Feed that gave up leaves a partly filled mipmap, so the file is loaded afresh,
+ *          which finds no pass to claim it this time and decodes it here.
+ */
+void WaveformManager::feedEnded(juce::uint32 feedGeneration, bool complete) {
+    if (!handoff.isCurrent(feedGeneration))
+        return;
+    if (!complete)
+        loadFile(pendingFile);
+    else if (pendingHash.isNotEmpty())
+        buildPool->addJob(new SaveJob(pendingHash, *this), true);
+}
+
+void WaveformManager::saveMipmap(const juce::String &hash, juce::ThreadPoolJob &job) {
+    if (hash.isEmpty() || job.shouldExit())
+        return;
+
+    auto serialized = std::make_unique<juce::MemoryBlock>();
+    {
+        juce::MemoryOutputStream output(*serialized, false);
+        if (!mipmap.writeTo(output))
+            return;
+    }
+    storePool->addJob(new StoreJob(hash, std::move(serialized), cache), true);
 }
 
-juce::AudioThumbnail &WaveformManager::getThumbnail() {
-    return thumbnail;
+PeakMipmap &WaveformManager::getThumbnail() {
+    return mipmap;
 }
 
-const juce::AudioThumbnail &WaveformManager::getThumbnail() const {
-    return thumbnail;
+const PeakMipmap &WaveformManager::getThumbnail() const {
+    return mipmap;
 }
 
 void WaveformManager::addChangeListener(juce::ChangeListener *listener) {
-    thumbnail.addChangeListener(listener);
+    changeBroadcaster.addChangeListener(listener);
 }
 
 void WaveformManager::removeChangeListener(juce::ChangeListener *listener) {
-    thumbnail.removeChangeListener(listener);
+    changeBroadcaster.removeChangeListener(listener);
 }
@@ -11,59 +11,93 @@
 #include <JuceHeader.h>
 #endif
 
+#include "Workers/MipmapHandoff.h"
+#include "Workers/PeakMipmap.h"
+#include "Workers/WaveformCache.h"
+#include <memory>
+
+class IoGovernor;
+
 /**
  * @file WaveformManager.h
  * @ingroup Logic
- * @brief Logic-tier manager for waveform visualization and thumbnail caching.
+ * @brief Logic-tier manager for waveform visualization data.
  * 
  * @details Architecturally, WaveformManager serves as a "Resource Manager" that 
  *          bridges the gap between raw audio files and the visual display layer. 
- *          It encapsulates JUCE's `juce::AudioThumbnail` and `juce::AudioThumbnailCache` 
- *          to provide efficient, multi-level waveform rendering.
+ *          It owns the PeakMipmap every waveform view draws from, and the background
+ *          thread that fills it.
  * 
  *          Key responsibilities:
- *          - **Asynchronous Analysis**: Automatically generates low-resolution 
- *            waveform data in the background upon file loading.
- *          - **Cache Management**: Maintains a pool of recently analyzed waveforms 
- *            to ensure instant navigation between previously opened assets.
+ *          - **Asynchronous Analysis**: Fills the mipmap of a newly loaded file from a
+ *            single decode. The mipmap is sized up front, so the length is known
+ *            immediately and the waveform fills in as the pass advances. The file-open
+ *            gap scan claims the build through claimBuild() and carries a
+ *            MipmapHandoff::Feed in its own AnalysisPipeline, so opening a file decodes
+ *            it once for the waveform, the gap map and the envelope. Only when no pass
+ *            claims it does the manager decode the file on its private thread; either
+ *            pass yields to playback through the AudioPlayer's IoGovernor.
+ *          - **Cache Management**: Maps the mipmap of a previously opened file from the
+ *            WaveformCache instead of decoding it, and saves every newly built one,
+ *            evicting the least recently used entries afterwards, on a second thread
+ *            that never holds up the next build.
  *          - **Change Broadcasting**: Notifies waveform views (via standard 
- *            `juce::ChangeListener`) when thumbnail data becomes available or 
- *            changes due to background analysis.
+ *            `juce::ChangeListener`) after every decoded chunk and when the pass ends.
  * 
  * @see AudioPlayer
  * @see WaveformView
- * @see AudioThumbnail
+ * @see PeakMipmap
+ * @see WaveformCache
  */
-class WaveformManager {
+class WaveformManager : private juce::Timer {
   public:
     /**
-     * @brief Constructs the manager and initializes the thumbnail engine.
+     * @brief Constructs the manager and its waveform build thread.
      * @param formatManagerIn Reference to the application-wide format decoder.
+     * @param ioGovernor The governor that paces the build against playback.
      */
-    explicit WaveformManager(juce::AudioFormatManager &formatManagerIn);
+    WaveformManager(juce::AudioFormatManager &formatManagerIn, IoGovernor &ioGovernor);
+
+    /** @brief Stops any running build before the mipmap goes away. */
+    ~WaveformManager();
 
     /**
      * @brief Initiates waveform analysis for a new file.
      * @param file The audio asset to analyze.
-     * @details This triggers a background process that updates the thumbnail cache. 
-     *          The view will be notified of progress via change listeners.
+     * @details Cancels the build of the previous file, resizes the mipmap and starts
+     *          filling it in the background, from the cache if possible. If the previous
+     *          build does not stop at once, the switch is retried from a timer rather than
+     *          waited for. The view will be notified of progress via change listeners. Must
+     *          be called on the Message Thread.
      */
     void loadFile(const juce::File &file);
 
     /**
-     * @brief Provides access to the primary thumbnail object.
-     * @return Reference to the internal AudioThumbnail.
+     * @brief Hands the mipmap build of the loaded file to an analysis pass that decodes it.
+     * @details The Feed waits for the cache lookup, then fills the mipmap as a stage of the
+     *          pass; a pass that fails or stops partway hands the build back. Must be called
+     *          on the Message Thread, right after loadFile(), before the manager decodes the
+     *          file itself.
+     * @param file The file the pass decodes.
+     * @return A Feed for the pass's pipeline; inert if `file` is not the loaded file or the
+     *         build is already taken or cached.
+     */
+    MipmapHandoff::Feed claimBuild(const juce::File &file);
+
+    /**
+     * @brief Provides access to the waveform data of the current file.
+     * @return Reference to the internal PeakMipmap.
      */
-    juce::AudioThumbnail &getThumbnail();
+    PeakMipmap &getThumbnail();
 
     /**
-     * @brief Provides read-only access to the primary thumbnail object.
-     * @return Const reference to the AudioThumbnail.
+     * @brief Provides read-only access to the waveform data of the current file.
+     * @return Const reference to the PeakMipmap.
      */
-    const juce::AudioThumbnail &getThumbnail() const;
+    const PeakMipmap &getThumbnail() const;
 
     /**
-     * @brief Registers a view or component to receive thumbnail update notifications.
+     * @brief Registers a view or component to receive waveform update notifications.
      * @param listener The observer implementing juce::ChangeListener.
      */
     void addChangeListener(juce::ChangeListener *listener);
@@ -75,9 +109,36 @@ class WaveformManager {
     void removeChangeListener(juce::ChangeListener *listener);
 
   private:
+    class LookupJob;
+    class BuildJob;
+    class SaveJob;
+    class StoreJob;
+
+    /** @brief Switches to pendingFile once the previous build has stopped. */
+    void startPendingLoad();
+    void timerCallback() override;
+
+    /** @brief Decodes the file itself after a cache miss, unless a pass claimed the build. */
+    void lookupMissed(juce::uint32 lookupGeneration, const juce::String &hash);
+
+    /** @brief Saves a mipmap a Feed completed, or decodes the file if the Feed gave up. */
+    void feedEnded(juce::uint32 feedGeneration, bool complete);
+
+    /** @brief Serializes the finished mipmap and queues a StoreJob; on the build thread. */
+    void saveMipmap(const juce::String &hash, juce::ThreadPoolJob &job);
+
     juce::AudioFormatManager &formatManager;          /**< Dependency for audio decoding. */
-    juce::AudioThumbnailCache thumbnailCache{5};      /**< Memory-backed cache for 5 concurrent thumbnails. */
-    juce::AudioThumbnail thumbnail{512, formatManager, thumbnailCache}; /**< The primary waveform data source. */
+    IoGovernor &governor;                             /**< Paces the build against playback. */
+    PeakMipmap mipmap;                                /**< The primary waveform data source. */
+    WaveformCache cache;                              /**< Mipmaps of earlier files on disk. */
+    juce::ChangeBroadcaster changeBroadcaster;        /**< Announces newly built blocks. */
+    juce::File pendingFile;                           /**< Last file passed to loadFile(). */
+    juce::uint32 generation = 0;                      /**< Handoff generation of pendingFile. */
+    juce::String pendingHash;                         /**< Cache key, once looked up and missed. */
+    std::shared_ptr<bool> lifeToken;                  /**< Guards callbacks posted by the jobs. */
+    MipmapHandoff handoff;                            /**< Lends the build to an analysis pass. */
+    std::unique_ptr<juce::ThreadPool> buildPool;      /**< Single thread for lookups and builds. */
+    std::unique_ptr<juce::ThreadPool> storePool;      /**< Single thread running StoreJobs. */
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformManager)
 };
@@ -4,6 +4,20 @@
 
 namespace MainDomain {
 
+/** @brief How the Auto-Cut scans decide that a stretch of audio is no longer silent. */
+enum class DetectionMode {
+    Peak,    /**< A single sample above the Threshold. */
+    Rms,     /**< A sliding window whose RMS exceeds the Threshold. */
+    PeakHold /**< Peaks above the Threshold, sustained for a minimum duration. */
+};
+
+/** @brief Which part of the spectrum the Auto-Cut scans listen to. */
+enum class FilterMode {
+    Off,      /**< The full band, as recorded. */
+    HighPass, /**< Rumble, hum and DC below the high-pass corner are ignored. */
+    BandLimit /**< As HighPass, and hiss above the low-pass corner is ignored too. */
+};
+
 struct CutPreferences {
     bool active{false};
     bool inLocked{false};
@@ -18,6 +32,11 @@ struct CutPreferences {
         bool outActive{false};
         float thresholdIn{0.0f};
         float thresholdOut{0.0f};
+        DetectionMode modeIn{DetectionMode::Peak};
+        DetectionMode modeOut{DetectionMode::Peak};
+        FilterMode filterIn{FilterMode::Off};
+        FilterMode filterOut{FilterMode::Off};
+        bool autoThreshold{false}; /**< Thresholds follow each file's suggested noise floor. */
     } autoCut;
 };
 
@@ -172,6 +172,9 @@ void ControlButtonsPresenter::initialiseMarkerButtons() {
         inStrip->getResetButton().onClick = [this] {
             owner.getPresenterCore().getCutResetPresenter().resetIn();
         };
+        inStrip->getFilterButton().onClick = [this] {
+            owner.getPresenterCore().getSilenceDetectionPresenter().cycleFilterMode(true);
+        };
         inStrip->getAutoCutButton().onClick = [this, inStrip, &sessionState] {
             sessionState.setAutoCutInActive(inStrip->getAutoCutButton().getToggleState());
         };
@@ -187,6 +190,9 @@ void ControlButtonsPresenter::initialiseMarkerButtons() {
         outStrip->getResetButton().onClick = [this] {
             owner.getPresenterCore().getCutResetPresenter().resetOut();
         };
+        outStrip->getFilterButton().onClick = [this] {
+            owner.getPresenterCore().getSilenceDetectionPresenter().cycleFilterMode(false);
+        };
         outStrip->getAutoCutButton().onClick = [this, outStrip, &sessionState] {
             sessionState.setAutoCutOutActive(outStrip->getAutoCutButton().getToggleState());
         };
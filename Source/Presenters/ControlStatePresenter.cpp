@@ -51,10 +51,14 @@ void ControlStatePresenter::updateUIFromState() {
         ts->updateCutModeState(prefs.active);
     }
 
-    if (owner.getInStrip() != nullptr)
+    if (owner.getInStrip() != nullptr) {
         owner.getInStrip()->updateAutoCutState(autoCut.inActive);
-    if (owner.getOutStrip() != nullptr)
+        owner.getInStrip()->updateFilterMode(autoCut.filterIn);
+    }
+    if (owner.getOutStrip() != nullptr) {
         owner.getOutStrip()->updateAutoCutState(autoCut.outActive);
+        owner.getOutStrip()->updateFilterMode(autoCut.filterOut);
+    }
 
     const int inPercent = static_cast<int>(autoCut.thresholdIn * 100.0f);
     const int outPercent = static_cast<int>(autoCut.thresholdOut * 100.0f);
@@ -78,10 +82,14 @@ void ControlStatePresenter::cutPreferenceChanged(const MainDomain::CutPreference
         ts->updateCutModeState(prefs.active);
     }
 
-    if (owner.getInStrip() != nullptr)
+    if (owner.getInStrip() != nullptr) {
         owner.getInStrip()->updateAutoCutState(prefs.autoCut.inActive);
-    if (owner.getOutStrip() != nullptr)
+        owner.getInStrip()->updateFilterMode(prefs.autoCut.filterIn);
+    }
+    if (owner.getOutStrip() != nullptr) {
         owner.getOutStrip()->updateAutoCutState(prefs.autoCut.outActive);
+        owner.getOutStrip()->updateFilterMode(prefs.autoCut.filterOut);
+    }
 
     refreshStates();
 }
@@ -194,6 +194,7 @@ void CutPresenter::pushStateToView() {
     state.audioLength = (float)audioLength;
     state.markersVisible = sessionState.getCutPrefs().active;
     state.channelMode = cutLayerView.getOwner().getChannelViewMode();
+    state.gapMap = sessionState.getCurrentMetadata().gapMap;
 
     updateAnimationState(state);
 }
@@ -4,10 +4,14 @@
 #include "Core/AudioPlayer.h"
 #include "Presenters/ControlStatePresenter.h"
 #include "Presenters/CutResetPresenter.h"
+#include "Presenters/SilenceDetectionPresenter.h"
 #include "Presenters/StatsPresenter.h"
 #include "UI/ControlPanel.h"
 #include "UI/Views/TopBarView.h"
 #include "Utils/Config.h"
+#include "Workers/SilenceGapMap.h"
+
+#include <cmath>
 
 KeybindPresenter::KeybindPresenter(ControlPanel &ownerPanel)
     : owner(ownerPanel) {
@@ -59,6 +63,15 @@ bool KeybindPresenter::handlePlaybackKeybinds(const juce::KeyPress &key) {
         audioPlayer.setPlayheadPosition(current + seekStepSeconds);
         return true;
     }
+    const auto keyChar = key.getTextCharacter();
+    if (keyChar == ']') {
+        jumpToGap(true);
+        return true;
+    }
+    if (keyChar == '[') {
+        jumpToGap(false);
+        return true;
+    }
     return false;
 }
 
@@ -118,5 +131,67 @@ bool KeybindPresenter::handleCutKeybinds(const juce::KeyPress &key) {
         owner.getPresenterCore().getCutResetPresenter().resetOut();
         return true;
     }
+    if (keyChar == 'k' || keyChar == 'K') {
+        cycleDetectionMode(true);
+        return true;
+    }
+    if (keyChar == 'l' || keyChar == 'L') {
+        cycleDetectionMode(false);
+        return true;
+    }
+    if (keyChar == 't' || keyChar == 'T') {
+        owner.getPresenterCore().getSilenceDetectionPresenter().handleAutoThresholdToggle(
+            !sessionState.getCutPrefs().autoCut.autoThreshold);
+        return true;
+    }
     return false;
 }
+
+void KeybindPresenter::cycleDetectionMode(bool detectingIn) {
+    using Mode = MainDomain::DetectionMode;
+    auto &sessionState = owner.getSessionState();
+    const auto autoCut = sessionState.getCutPrefs().autoCut;
+    const Mode current = detectingIn ? autoCut.modeIn : autoCut.modeOut;
+    const Mode next = current == Mode::Peak  ? Mode::Rms
+                      : current == Mode::Rms ? Mode::PeakHold
+                                             : Mode::Peak;
+
+    if (detectingIn)
+        sessionState.setDetectionModeIn(next);
+    else
+        sessionState.setDetectionModeOut(next);
+
+    const juce::String &prefix = detectingIn ? Config::Labels::detectionModeInPrefix
+                                             : Config::Labels::detectionModeOutPrefix;
+    const juce::String &name = next == Mode::Peak  ? Config::Labels::detectionModePeak
+                               : next == Mode::Rms ? Config::Labels::detectionModeRms
+                                                   : Config::Labels::detectionModePeakHold;
+    owner.getHintView().setHint(prefix + name);
+}
+
+void KeybindPresenter::jumpToGap(bool forward) {
+    const auto map = owner.getSessionState().getCurrentMetadata().gapMap;
+    auto &audioPlayer = owner.getAudioPlayer();
+    if (map == nullptr || map->getSampleRate() <= 0.0) {
+        owner.getHintView().setHint(Config::Labels::noSilenceGaps);
+        return;
+    }
+
+    // Gaps are entered at their end, where the next take starts. Going back skips the gap
+    // just landed on while playback has only moved a little past it.
+    const double rate = map->getSampleRate();
+    const auto current = (juce::int64)std::llround(audioPlayer.getCurrentPosition() * rate);
+    const auto backTolerance = (juce::int64)(rate * Config::Audio::gapMinSeconds * 0.5);
+    const auto &gaps = map->getGaps();
+    const size_t next = map->findFirstEndingAfter(current);
+    const size_t previous = map->findFirstEndingAfter(current - backTolerance - 1);
+    if ((forward && next >= gaps.size()) || (!forward && previous == 0)) {
+        owner.getHintView().setHint(Config::Labels::noSilenceGaps);
+        return;
+    }
+
+    const size_t index = forward ? next : previous - 1;
+    audioPlayer.setPlayheadPosition((double)gaps[index].end / rate);
+    owner.getHintView().setHint(Config::Labels::gapJumpPrefix + juce::String((int)index + 1) +
+                                Config::Labels::gapJumpOf + juce::String((int)gaps.size()));
+}
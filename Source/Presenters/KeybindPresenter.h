@@ -58,6 +58,12 @@ class KeybindPresenter final {
     /** @brief Handles shortcuts for manipulating cut boundaries. */
     bool handleCutKeybinds(const juce::KeyPress &key);
 
+    /** @brief Advances one direction's Auto-Cut DetectionMode and shows it as a hint. */
+    void cycleDetectionMode(bool detectingIn);
+
+    /** @brief Moves the playhead to the end of the next or previous silence gap, if any. */
+    void jumpToGap(bool forward);
+
     ControlPanel &owner;
 };
 
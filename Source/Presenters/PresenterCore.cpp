@@ -36,6 +36,7 @@ PresenterCore::PresenterCore(ControlPanel &cp) : owner(cp) {
     
     statsPresenter = std::make_unique<StatsPresenter>(owner);
     silenceDetectionPresenter = std::make_unique<SilenceDetectionPresenter>(owner, owner.getSessionState(), owner.getAudioPlayer());
+    statsPresenter->setAnalysisProgress(&silenceDetectionPresenter->getAnalysisProgress());
     
     playbackTextPresenter = std::make_unique<PlaybackTextPresenter>(owner);
     playbackTextPresenter->initialiseEditors();
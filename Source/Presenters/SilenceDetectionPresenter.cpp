@@ -7,12 +7,19 @@
 #include "Core/SilenceAnalysisWorker.h"
 #include "Presenters/StatsPresenter.h"
 #include "UI/ControlPanel.h"
+#include "Workers/CutPointCurves.h"
+#include "Workers/NoiseFloorHistogram.h"
+#include "Workers/SilenceGapMap.h"
+
+#include <algorithm>
+#include <cmath>
 
 SilenceDetectionPresenter::SilenceDetectionPresenter(ControlPanel &ownerPanel,
                                                      SessionState &sessionStateIn,
                                                      AudioPlayer &audioPlayerIn)
     : owner(ownerPanel), sessionState(sessionStateIn), audioPlayer(audioPlayerIn),
-      silenceWorker(*this, sessionStateIn, audioPlayerIn.getFormatManager()) {
+      silenceWorker(*this, sessionStateIn, audioPlayerIn.getFormatManager(),
+                    audioPlayerIn.getIoGovernor()) {
     sessionState.addListener(this);
     owner.getPlaybackTimerManager().addListener(this);
 
@@ -21,6 +28,10 @@ SilenceDetectionPresenter::SilenceDetectionPresenter(ControlPanel &ownerPanel,
     lastAutoCutThresholdOut = prefs.autoCut.thresholdOut;
     lastAutoCutInActive = prefs.autoCut.inActive;
     lastAutoCutOutActive = prefs.autoCut.outActive;
+    lastModeIn = prefs.autoCut.modeIn;
+    lastModeOut = prefs.autoCut.modeOut;
+    lastFilterIn = prefs.autoCut.filterIn;
+    lastFilterOut = prefs.autoCut.filterOut;
 }
 
 SilenceDetectionPresenter::~SilenceDetectionPresenter() {
@@ -29,15 +40,65 @@ SilenceDetectionPresenter::~SilenceDetectionPresenter() {
 }
 
 void SilenceDetectionPresenter::playbackTimerTick() {
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    const juce::String loadedPath = audioPlayer.getLoadedFile().getFullPathName();
+    auto takeDue = [now, &loadedPath](DeferredScan &scan) {
+        if (!scan.armed || now < scan.deadlineMs)
+            return false;
+        scan.armed = false;
+        return scan.filePath == loadedPath;
+    };
+
+    if (takeDue(deferredGapScan))
+        silenceWorker.startGapScan(deferredGapScan.filePath, deferredGapScan.threshold);
+    if (takeDue(deferredIn))
+        startSilenceAnalysis(deferredIn.threshold, true, AnalysisJobQueue::Priority::Interactive);
+    if (takeDue(deferredOut))
+        startSilenceAnalysis(deferredOut.threshold, false, AnalysisJobQueue::Priority::Interactive);
+
+    if (!isAnalyzing()) {
+        lastProgressText.clear();
+        return;
+    }
+    const juce::String progressText =
+        StatsPresenter::formatAnalysisProgress(silenceWorker.getProgress().getSnapshot());
+    if (progressText != lastProgressText) {
+        lastProgressText = progressText;
+        owner.getHintView().setHint(Config::Labels::statsAnalysisProgress + progressText);
+    }
+}
+
+void SilenceDetectionPresenter::defer(DeferredScan &scan, const juce::String &filePath,
+                                      float threshold) {
+    scan.armed = true;
+    scan.filePath = filePath;
+    scan.threshold = threshold;
+    scan.deadlineMs =
+        juce::Time::getMillisecondCounterHiRes() + Config::Audio::reanalysisDebounceMs;
 }
 
 void SilenceDetectionPresenter::fileChanged(const juce::String &filePath) {
+    // Applied before the scans below, which then run at the suggested Threshold directly.
+    if (filePath.isNotEmpty() && sessionState.getCutPrefs().autoCut.autoThreshold)
+        applyAutoThreshold(filePath);
+
+    // Edits made to the previous file no longer matter; the new file is scanned below.
+    deferredIn.armed = false;
+    deferredOut.armed = false;
+    deferredGapScan.armed = false;
+
     if (filePath.isEmpty())
         return;
 
     const FileMetadata activeMetadata = sessionState.getMetadataForFile(filePath);
+    auto prefs = sessionState.getCutPrefs();
+    if (activeMetadata.gapMap == nullptr ||
+        activeMetadata.gapMap->getThreshold() != prefs.autoCut.thresholdIn)
+        silenceWorker.startGapScan(
+            filePath, prefs.autoCut.thresholdIn,
+            audioPlayer.getWaveformManager().claimBuild(juce::File(filePath)));
+
     if (!activeMetadata.isAnalyzed) {
-        auto prefs = sessionState.getCutPrefs();
         if (prefs.autoCut.inActive)
             startSilenceAnalysis(prefs.autoCut.thresholdIn, true);
 
@@ -47,7 +108,8 @@ void SilenceDetectionPresenter::fileChanged(const juce::String &filePath) {
 }
 
 void SilenceDetectionPresenter::cutPreferenceChanged(const MainDomain::CutPreferences &prefs) {
-    const auto &autoCut = prefs.autoCut;
+    // Copied: applying a cut re-broadcasts the preferences this reference points into.
+    const auto autoCut = prefs.autoCut;
 
     // Check for significant change (> 0.01)
     const bool inThresholdChanged =
@@ -55,22 +117,106 @@ void SilenceDetectionPresenter::cutPreferenceChanged(const MainDomain::CutPrefer
     const bool outThresholdChanged =
         std::abs(autoCut.thresholdOut - lastAutoCutThresholdOut) > 0.01001f;
 
+    const bool inThresholdMoved = autoCut.thresholdIn != lastAutoCutThresholdIn;
+    const bool outThresholdMoved = autoCut.thresholdOut != lastAutoCutThresholdOut;
+
     const bool inActiveChanged = autoCut.inActive != lastAutoCutInActive;
     const bool outActiveChanged = autoCut.outActive != lastAutoCutOutActive;
 
-    const bool shouldAnalyzeIn = (inThresholdChanged || inActiveChanged) && autoCut.inActive;
-    const bool shouldAnalyzeOut = (outThresholdChanged || outActiveChanged) && autoCut.outActive;
-
-    if (shouldAnalyzeIn)
-        startSilenceAnalysis(autoCut.thresholdIn, true);
-
-    if (shouldAnalyzeOut)
-        startSilenceAnalysis(autoCut.thresholdOut, false);
+    // A new detection mode or pre-filter invalidates the previous cut just like
+    // re-enabling Auto-Cut.
+    const bool inModeChanged = autoCut.modeIn != lastModeIn || autoCut.filterIn != lastFilterIn;
+    const bool outModeChanged =
+        autoCut.modeOut != lastModeOut || autoCut.filterOut != lastFilterOut;
 
     lastAutoCutThresholdIn = autoCut.thresholdIn;
     lastAutoCutThresholdOut = autoCut.thresholdOut;
     lastAutoCutInActive = autoCut.inActive;
     lastAutoCutOutActive = autoCut.outActive;
+    lastModeIn = autoCut.modeIn;
+    lastModeOut = autoCut.modeOut;
+    lastFilterIn = autoCut.filterIn;
+    lastFilterOut = autoCut.filterOut;
+
+    // The gap map has no instant answer: stop the stale scan now, rescan once at rest.
+    const juce::String filePath = audioPlayer.getLoadedFile().getFullPathName();
+    if (filePath.isNotEmpty() &&
+        (inThresholdChanged || (inThresholdMoved && deferredGapScan.armed))) {
+        silenceWorker.cancelGapScan();
+        defer(deferredGapScan, filePath, autoCut.thresholdIn);
+    }
+
+    updateCutPoint(true, autoCut.thresholdIn, autoCut.inActive, inThresholdMoved,
+                   inThresholdChanged, inActiveChanged || inModeChanged);
+    updateCutPoint(false, autoCut.thresholdOut, autoCut.outActive, outThresholdMoved,
+                   outThresholdChanged, outActiveChanged || outModeChanged);
+}
+
+/**
+ * @details Any Threshold movement is resolved instantly when the curves can answer it,
+ *          and any scan still queued or running for that direction is cancelled so its
+ *          older result cannot replace the answer. Only otherwise does a significant change
+ *          fall back to a background scan. That scan is debounced: the running pass is
+ *          cancelled straight away (it stops at its next chunk), and every further
+ *          movement, however small, re-arms the deadline with the newest Threshold.
+ */
+void SilenceDetectionPresenter::updateCutPoint(bool detectingIn, float threshold, bool active,
+                                               bool moved, bool significant, bool rescan) {
+    auto &deferred = detectingIn ? deferredIn : deferredOut;
+    if (!active) {
+        deferred.armed = false;
+        return;
+    }
+    if (!moved && !rescan)
+        return;
+
+    const juce::String filePath = audioPlayer.getLoadedFile().getFullPathName();
+    if (applyCutFromCurves(threshold, detectingIn)) {
+        // A scan already started for an older Threshold would overwrite this answer.
+        silenceWorker.cancelAnalysis(filePath, detectingIn);
+        deferred.armed = false;
+    } else if (rescan) {
+        deferred.armed = false;
+        startSilenceAnalysis(threshold, detectingIn, AnalysisJobQueue::Priority::Interactive);
+    } else if ((significant || deferred.armed) && filePath.isNotEmpty()) {
+        silenceWorker.cancelAnalysis(filePath, detectingIn);
+        defer(deferred, filePath, threshold);
+    }
+}
+
+bool SilenceDetectionPresenter::applyCutFromCurves(float threshold, bool detectingIn) {
+    // The curves record unfiltered single-sample crossings, i.e. the plain Peak criterion.
+    const auto autoCut = sessionState.getCutPrefs().autoCut;
+    if ((detectingIn ? autoCut.modeIn : autoCut.modeOut) != MainDomain::DetectionMode::Peak ||
+        (detectingIn ? autoCut.filterIn : autoCut.filterOut) != MainDomain::FilterMode::Off)
+        return false;
+
+    const juce::String filePath = audioPlayer.getLoadedFile().getFullPathName();
+    FileMetadata metadata = sessionState.getMetadataForFile(filePath);
+    const auto curves = metadata.cutCurves;
+    if (curves == nullptr)
+        return false;
+
+    const auto hit = detectingIn ? curves->findIn(threshold) : curves->findOut(threshold);
+    if (!hit.has_value())
+        return false;
+
+    if (*hit < 0) {
+        logStatusMessage(Config::Labels::noSilenceBoundaries);
+        return true;
+    }
+
+    const double sampleRate = curves->getSampleRate();
+    if (detectingIn) {
+        metadata.cutIn = (double)*hit / sampleRate;
+    } else {
+        const auto tailSamples = (juce::int64)(sampleRate * Config::Audio::autoCutOutTailSeconds);
+        metadata.cutOut =
+            (double)std::min(*hit + tailSamples, curves->getLengthInSamples()) / sampleRate;
+    }
+    metadata.isAnalyzed = true;
+    sessionState.setMetadataForFile(filePath, metadata);
+    return true;
 }
 
 void SilenceDetectionPresenter::handleAutoCutInToggle(bool isActive) {
@@ -81,17 +227,71 @@ void SilenceDetectionPresenter::handleAutoCutOutToggle(bool isActive) {
     sessionState.setAutoCutOutActive(isActive);
 }
 
-void SilenceDetectionPresenter::startSilenceAnalysis(float threshold, bool detectingIn) {
-    if (silenceWorker.isBusy()) {
-        // If it's busy with the same thing, ignore.
-        if (silenceWorker.isDetectingIn() == detectingIn)
-            return;
-
-        // If it's busy with the OTHER thing, we might want to queue it or just wait.
-        // For now, let's at least log it.
+void SilenceDetectionPresenter::handleAutoThresholdToggle(bool isActive) {
+    sessionState.setAutoThresholdActive(isActive);
+    if (!isActive) {
+        owner.getHintView().setHint(Config::Labels::autoThresholdPrefix +
+                                    Config::Labels::autoThresholdOff);
         return;
     }
-    silenceWorker.startAnalysis(threshold, detectingIn, audioPlayer.getLoadedFile().getFullPathName());
+
+    const juce::String filePath = audioPlayer.getLoadedFile().getFullPathName();
+    if (filePath.isEmpty() || !applyAutoThreshold(filePath))
+        owner.getHintView().setHint(Config::Labels::autoThresholdPrefix +
+                                    Config::Labels::autoThresholdPending);
+}
+
+void SilenceDetectionPresenter::cycleFilterMode(bool detectingIn) {
+    using Filter = MainDomain::FilterMode;
+    const auto autoCut = sessionState.getCutPrefs().autoCut;
+    const Filter current = detectingIn ? autoCut.filterIn : autoCut.filterOut;
+    const Filter next = current == Filter::Off        ? Filter::HighPass
+                        : current == Filter::HighPass ? Filter::BandLimit
+                                                      : Filter::Off;
+
+    if (detectingIn)
+        sessionState.setFilterModeIn(next);
+    else
+        sessionState.setFilterModeOut(next);
+
+    const juce::String &prefix =
+        detectingIn ? Config::Labels::filterModeInPrefix : Config::Labels::filterModeOutPrefix;
+    const juce::String &name = next == Filter::HighPass    ? Config::Labels::filterModeHighPass
+                               : next == Filter::BandLimit ? Config::Labels::filterModeBandLimit
+                                                           : Config::Labels::filterModeOff;
+    owner.getHintView().setHint(prefix + name);
+}
+
+void SilenceDetectionPresenter::noiseFloorEstimated(const juce::String &filePath) {
+    if (sessionState.getCutPrefs().autoCut.autoThreshold &&
+        filePath == audioPlayer.getLoadedFile().getFullPathName())
+        applyAutoThreshold(filePath);
+}
+
+bool SilenceDetectionPresenter::applyAutoThreshold(const juce::String &filePath) {
+    const auto noiseFloor = sessionState.getMetadataForFile(filePath).noiseFloor;
+    if (noiseFloor == nullptr)
+        return false;
+    const auto suggested = noiseFloor->suggestThreshold();
+    if (!suggested.has_value())
+        return false;
+
+    const int percent = juce::jlimit(1, 99, (int)std::ceil(*suggested * 100.0f));
+    const float threshold = (float)percent / 100.0f;
+    sessionState.setThresholdIn(threshold);
+    sessionState.setThresholdOut(threshold);
+    owner.getHintView().setHint(Config::Labels::autoThresholdPrefix + juce::String(percent) +
+                                Config::Labels::autoThresholdPercent);
+    return true;
+}
+
+void SilenceDetectionPresenter::startSilenceAnalysis(float threshold, bool detectingIn,
+                                                     AnalysisJobQueue::Priority priority) {
+    const auto autoCut = sessionState.getCutPrefs().autoCut;
+    silenceWorker.startAnalysis(threshold, detectingIn,
+                                audioPlayer.getLoadedFile().getFullPathName(), priority,
+                                detectingIn ? autoCut.modeIn : autoCut.modeOut,
+                                detectingIn ? autoCut.filterIn : autoCut.filterOut);
 }
 
 void SilenceDetectionPresenter::logStatusMessage(const juce::String &message, bool isError) {
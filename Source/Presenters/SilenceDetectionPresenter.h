@@ -33,6 +33,10 @@ class ControlPanel;
  *            the UI's status bar.
  *          - **Change Monitoring**: Observes `SessionState` and `PlaybackTimerManager` 
  *            to ensure the analysis state remains synchronized with the active audio file.
+ *          - **Debouncing**: While a Threshold is being dragged, the in-flight scan for
+ *            that file and direction is cancelled at once, but its replacement is only
+ *            dispatched from the timer tick after `Config::Audio::reanalysisDebounceMs`
+ *            without further edits. Only the final Threshold costs a full scan.
  * 
  * @see SilenceAnalysisWorker
  * @see SilenceWorkerClient
@@ -60,18 +64,25 @@ class SilenceDetectionPresenter final : public SilenceWorkerClient,
 
     /** 
      * @brief Periodic callback from the playback timer.
-     * @details Used for high-frequency polling of worker status or UI animation updates.
+     * @details Dispatches the debounced scans whose quiet time has elapsed, provided
+     *          their file is still the loaded one, and shows the worker's live progress
+     *          in the hint line while a cut-point pass is running.
      */
     void playbackTimerTick() override;
 
     /** 
      * @brief Triggers automatic re-analysis when the active audio file path changes.
+     * @details The gap scan also claims the waveform build, so the new file is decoded once.
      * @param filePath Absolute path to the new asset.
      */
     void fileChanged(const juce::String &filePath) override;
 
     /** 
-     * @brief Reacts to threshold adjustments by triggering a background analysis pass.
+     * @brief Reacts to threshold adjustments by moving the cut points.
+     * @details When the file's CutPointCurves are available the new cut is resolved
+     *          synchronously, so markers follow the Threshold control live; otherwise the
+     *          running pass is cancelled and a background pass is scheduled for when the
+     *          control comes to rest. Toggle and mode changes are dispatched immediately.
      * @param prefs The updated user preferences from state.
      */
     void cutPreferenceChanged(const MainDomain::CutPreferences &prefs) override;
@@ -88,27 +99,52 @@ class SilenceDetectionPresenter final : public SilenceWorkerClient,
      */
     void handleAutoCutOutToggle(bool isActive);
 
+    /**
+     * @brief Switches the Auto Threshold on or off and reports the outcome in the hint line.
+     * @details Switching it on applies the loaded file's suggestion at once if its
+     *          NoiseFloorHistogram is known; otherwise the suggestion is applied when the
+     *          envelope pass delivers it.
+     * @param isActive True to let both Thresholds follow each file's noise floor.
+     */
+    void handleAutoThresholdToggle(bool isActive);
+
+    /**
+     * @brief Advances one direction's pre-filter (Off, HighPass, BandLimit) and names it in
+     *        the hint line.
+     * @details The preference change reaches cutPreferenceChanged(), which rescans that
+     *          direction with the new filter at once if its Auto-Cut is active.
+     * @param detectingIn True for the 'In' scan, false for 'Out'.
+     */
+    void cycleFilterMode(bool detectingIn);
+
     /** 
-     * @brief Dispatches a specific analysis pass to the background thread.
+     * @brief Queues a specific analysis pass for the background workers.
      * @param threshold The dB level to use for silence detection.
      * @param detectingIn True to search for start-of-audio, false for end-of-audio.
-     * @note This method handles the "Air Gap" by ensuring the worker is not already busy.
+     * @param priority Scheduling rank; direct user edits jump ahead of automatic passes.
+     * @note The pass uses the direction's current DetectionMode from the preferences.
+     * @note Requests are never dropped for being busy; the worker's queue merges
+     *       duplicates and supersedes stale passes for the same direction.
      */
-    void startSilenceAnalysis(float threshold, bool detectingIn);
+    void startSilenceAnalysis(float threshold, bool detectingIn,
+                              AnalysisJobQueue::Priority priority = AnalysisJobQueue::Priority::Normal);
 
     /** 
      * @brief Queries the activity state of the background worker.
-     * @return True if a scan is currently in progress.
+     * @return True if a scan is currently pending or in progress.
      */
     bool isAnalyzing() const {
         return silenceWorker.isBusy();
     }
 
     /** @brief Specific query for 'In' point analysis status. */
-    bool isAnalyzingIn() const { return silenceWorker.isBusy() && silenceWorker.isDetectingIn(); }
+    bool isAnalyzingIn() const { return silenceWorker.isAnalyzing(true); }
     
     /** @brief Specific query for 'Out' point analysis status. */
-    bool isAnalyzingOut() const { return silenceWorker.isBusy() && !silenceWorker.isDetectingIn(); }
+    bool isAnalyzingOut() const { return silenceWorker.isAnalyzing(false); }
+
+    /** @brief Live progress and recent job timings of the background worker. */
+    const AnalysisProgress &getAnalysisProgress() const { return silenceWorker.getProgress(); }
 
     /** 
      * @brief Safe entry point for background threads to push messages to the UI.
@@ -123,7 +159,56 @@ class SilenceDetectionPresenter final : public SilenceWorkerClient,
     /** @brief Queries SessionState for the current Auto-Cut-Out preference. */
     bool isAutoCutOutActive() const override;
 
+    /** @brief Applies the suggested Threshold if the Auto Threshold is on for the loaded file. */
+    void noiseFloorEstimated(const juce::String &filePath) override;
+
   private:
+    /** @brief A background pass waiting for the Threshold control to come to rest. */
+    struct DeferredScan {
+        bool armed = false;      /**< True while a pass is waiting. */
+        juce::String filePath;   /**< The file the pass targets. */
+        float threshold = 0.0f;  /**< The latest Threshold of the edit. */
+        double deadlineMs = 0.0; /**< Millisecond counter at which the pass is dispatched. */
+    };
+
+    /**
+     * @brief Arms or re-arms a deferred pass with a fresh deadline.
+     * @param scan The slot to arm.
+     * @param filePath Absolute path of the loaded file.
+     * @param threshold The linear amplitude threshold.
+     */
+    static void defer(DeferredScan &scan, const juce::String &filePath, float threshold);
+
+    /**
+     * @brief Reacts to one direction's Auto-Cut preferences after an edit.
+     * @param detectingIn True for the 'In' point, false for the 'Out' point.
+     * @param threshold The direction's new linear amplitude threshold.
+     * @param active True if Auto-Cut is enabled for the direction.
+     * @param moved True if the Threshold changed at all.
+     * @param significant True if the Threshold changed enough to warrant a rescan.
+     * @param rescan True if a toggle or DetectionMode change requires a rescan.
+     */
+    void updateCutPoint(bool detectingIn, float threshold, bool active, bool moved,
+                        bool significant, bool rescan);
+
+    /**
+     * @brief Resolves an Auto-Cut point from the loaded file's CutPointCurves.
+     * @param threshold The linear amplitude threshold.
+     * @param detectingIn True for the 'In' point, false for the 'Out' point.
+     * @return False if no curves exist, they cannot answer this Threshold, or the
+     *         direction uses a windowed DetectionMode the curves do not model.
+     */
+    bool applyCutFromCurves(float threshold, bool detectingIn);
+
+    /**
+     * @brief Sets both Thresholds to a file's suggested Auto Threshold.
+     * @details The suggestion is rounded up to the whole-percent steps of the Threshold
+     *          editors. Changing the Thresholds then moves the cuts like any other edit.
+     * @param filePath Absolute path of the loaded file.
+     * @return False if the file has no NoiseFloorHistogram yet.
+     */
+    bool applyAutoThreshold(const juce::String &filePath);
+
     ControlPanel &owner;                      /**< Reference to the host View. */
     SessionState &sessionState;                /**< The central Model. */
     AudioPlayer &audioPlayer;                 /**< The primary Audio Engine. */
@@ -133,6 +218,16 @@ class SilenceDetectionPresenter final : public SilenceWorkerClient,
     float lastAutoCutThresholdOut{-1.0f};     /**< Cache to detect meaningful threshold changes. */
     bool lastAutoCutInActive{false};         /**< Cache to detect toggle changes. */
     bool lastAutoCutOutActive{false};        /**< Cache to detect toggle changes. */
+    /** @brief Caches to detect detection-mode and pre-filter changes. */
+    MainDomain::DetectionMode lastModeIn{MainDomain::DetectionMode::Peak};
+    MainDomain::DetectionMode lastModeOut{MainDomain::DetectionMode::Peak};
+    MainDomain::FilterMode lastFilterIn{MainDomain::FilterMode::Off};
+    MainDomain::FilterMode lastFilterOut{MainDomain::FilterMode::Off};
+
+    DeferredScan deferredIn;                  /**< Debounced 'In' analysis pass. */
+    DeferredScan deferredOut;                 /**< Debounced 'Out' analysis pass. */
+    DeferredScan deferredGapScan;             /**< Debounced gap scan (follows the 'In' Threshold). */
+    juce::String lastProgressText;            /**< Avoids repainting an unchanged progress hint. */
 };
 
 #endif
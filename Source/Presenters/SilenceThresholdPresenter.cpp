@@ -10,15 +10,27 @@ SilenceThresholdPresenter::SilenceThresholdPresenter(ControlPanel &ownerPanel,
     const auto& autoCut = owner.getSessionState().getCutPrefs().autoCut;
     configureEditor(inThresholdEditor, autoCut.thresholdIn, "In Silence Threshold (%)");
     configureEditor(outThresholdEditor, autoCut.thresholdOut, "Out Silence Threshold (%)");
+    owner.getSessionState().addListener(this);
 }
 
 SilenceThresholdPresenter::~SilenceThresholdPresenter() {
+    owner.getSessionState().removeListener(this);
     inThresholdEditor.removeListener(this);
     outThresholdEditor.removeListener(this);
     inThresholdEditor.removeMouseListener(this);
     outThresholdEditor.removeMouseListener(this);
 }
 
+void SilenceThresholdPresenter::cutPreferenceChanged(const MainDomain::CutPreferences &prefs) {
+    for (auto *editor : {&inThresholdEditor, &outThresholdEditor}) {
+        const float threshold =
+            editor == &inThresholdEditor ? prefs.autoCut.thresholdIn : prefs.autoCut.thresholdOut;
+        const juce::String text(juce::roundToInt(threshold * 100.0f));
+        if (!editor->hasKeyboardFocus(true) && editor->getText() != text)
+            editor->setText(text, juce::dontSendNotification);
+    }
+}
+
 void SilenceThresholdPresenter::configureEditor(juce::TextEditor &editor, float initialValue,
                                                const juce::String &tooltip) {
     editor.setReadOnly(false);
@@ -41,6 +53,8 @@ void SilenceThresholdPresenter::textEditorTextChanged(juce::TextEditor &editor)
         if (auto* styledEditor = dynamic_cast<StyledTextEditor*>(&editor)) {
             editor.setColour(juce::TextEditor::textColourId, styledEditor->getCustomTextColor());
         }
+        // Applied live so the cut markers follow while typing; focus stays put.
+        setThreshold(editor, val);
     }
 }
 
@@ -67,14 +81,39 @@ void SilenceThresholdPresenter::mouseWheelMove(const juce::MouseEvent &event,
     }
 }
 
+void SilenceThresholdPresenter::mouseDown(const juce::MouseEvent &event) {
+    if (auto *editor = dynamic_cast<juce::TextEditor *>(event.eventComponent))
+        dragStartValue = editor->getText().getIntValue();
+}
+
+void SilenceThresholdPresenter::mouseDrag(const juce::MouseEvent &event) {
+    auto *editor = dynamic_cast<juce::TextEditor *>(event.eventComponent);
+    if (editor == nullptr || !isValidPercentage(dragStartValue))
+        return;
+
+    const int steps = juce::roundToInt((float)-event.getDistanceFromDragStartY() /
+                                       Config::UI::ThresholdDragPixelsPerStep);
+    const int newVal = juce::jlimit(1, 99, dragStartValue + steps);
+
+    if (newVal != editor->getText().getIntValue()) {
+        editor->setText(juce::String(newVal), juce::dontSendNotification);
+        setThreshold(*editor, newVal);
+    }
+}
+
+void SilenceThresholdPresenter::setThreshold(juce::TextEditor &editor, int percentage) {
+    const float threshold = static_cast<float>(percentage) / 100.0f;
+    owner.getSessionState().setAutoThresholdActive(false);
+    if (&editor == &inThresholdEditor)
+        owner.getSessionState().setThresholdIn(threshold);
+    else
+        owner.getSessionState().setThresholdOut(threshold);
+}
+
 void SilenceThresholdPresenter::applyThresholdFromEditor(juce::TextEditor &editor) {
     const int val = editor.getText().getIntValue();
     if (isValidPercentage(val)) {
-        const float threshold = static_cast<float>(val) / 100.0f;
-        if (&editor == &inThresholdEditor)
-            owner.getSessionState().setThresholdIn(threshold);
-        else
-            owner.getSessionState().setThresholdOut(threshold);
+        setThreshold(editor, val);
     } else {
         restoreEditorToCurrentValue(editor);
     }
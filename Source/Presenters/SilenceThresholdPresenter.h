@@ -7,6 +7,8 @@
 #include <JuceHeader.h>
 #endif
 
+#include "Core/SessionState.h"
+
 /**
  * @file SilenceThresholdPresenter.h
  * @ingroup Logic
@@ -23,14 +25,18 @@ class ControlPanel;
  *          serving as the "glue" between the text-based UI views (TextEditors) and the 
  *          underlying silence analysis parameters in the SessionState. It ensures that 
  *          threshold values remain within a valid percentage range (1-99%) and 
- *          synchronizes these values across the UI. By managing transient editing 
- *          states and focus transitions, it keeps the View components focused 
- *          purely on text rendering.
+ *          synchronizes these values across the UI. Valid values are pushed to state on
+ *          every keystroke and drag step, so the cut markers follow the Threshold live.
+ *          A manual edit switches the Auto Threshold off; Thresholds set by the Auto
+ *          Threshold are mirrored back into the editors that are not being typed in.
+ *          By managing transient editing states and focus transitions, it keeps the
+ *          View components focused purely on text rendering.
  * 
  * @see SessionState, SilenceAnalysisWorker, ControlPanel
  */
 class SilenceThresholdPresenter final : private juce::TextEditor::Listener,
-                                        public juce::MouseListener {
+                                        public juce::MouseListener,
+                                        public SessionState::Listener {
   public:
     /**
      * @brief Constructs a new SilenceThresholdPresenter.
@@ -43,6 +49,9 @@ class SilenceThresholdPresenter final : private juce::TextEditor::Listener,
     /** @brief Destructor. */
     ~SilenceThresholdPresenter() override;
 
+    /** @brief Shows Thresholds changed elsewhere, e.g. by the Auto Threshold. */
+    void cutPreferenceChanged(const MainDomain::CutPreferences &prefs) override;
+
   private:
     /** 
      * @brief Configures an editor with initial values and visual properties. 
@@ -68,6 +77,23 @@ class SilenceThresholdPresenter final : private juce::TextEditor::Listener,
     void mouseWheelMove(const juce::MouseEvent &event,
                         const juce::MouseWheelDetails &wheel) override;
 
+    /** @brief Remembers the editor value a vertical drag adjusts from. */
+    void mouseDown(const juce::MouseEvent &event) override;
+
+    /** 
+     * @brief Adjusts the threshold by vertical dragging, applying every step live.
+     * @details Upward movement raises the value by one percent per
+     *          `Config::UI::ThresholdDragPixelsPerStep` pixels.
+     */
+    void mouseDrag(const juce::MouseEvent &event) override;
+
+    /** 
+     * @brief Writes a validated percentage to the state without touching focus.
+     * @param editor The editor the value belongs to.
+     * @param percentage A value in the 1-99 range.
+     */
+    void setThreshold(juce::TextEditor &editor, int percentage);
+
     /** 
      * @brief Commits the threshold value from the editor to the state. 
      * @param editor The source TextEditor.
@@ -94,6 +120,7 @@ class SilenceThresholdPresenter final : private juce::TextEditor::Listener,
     ControlPanel &owner;
     juce::TextEditor &inThresholdEditor;
     juce::TextEditor &outThresholdEditor;
+    int dragStartValue{0}; /**< Editor value when the current drag began. */
 };
 
 #endif
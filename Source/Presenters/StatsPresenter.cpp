@@ -3,10 +3,27 @@
 #include "Presenters/StatsPresenter.h"
 
 #include "Core/AudioPlayer.h"
+#include "Core/SessionState.h"
 #include "UI/ControlPanel.h"
 #include "Utils/TimeUtils.h"
+#include "Workers/LevelStats.h"
 #include <cmath>
 
+namespace {
+const juce::String &getLevelName(IoGovernor::Level level) {
+    switch (level) {
+    case IoGovernor::Level::Light:
+        return Config::Labels::ioLevelLight;
+    case IoGovernor::Level::Moderate:
+        return Config::Labels::ioLevelModerate;
+    case IoGovernor::Level::Heavy:
+        return Config::Labels::ioLevelHeavy;
+    default:
+        return Config::Labels::ioLevelUnthrottled;
+    }
+}
+} // namespace
+
 StatsPresenter::StatsPresenter(ControlPanel &ownerIn) : owner(ownerIn) {
     owner.addAndMakeVisible(statsOverlay);
     auto &statsDisplay = statsOverlay.statsDisplay;
@@ -20,12 +37,45 @@ StatsPresenter::StatsPresenter(ControlPanel &ownerIn) : owner(ownerIn) {
 
     statsOverlay.onHeightChanged = [this](int newHeight) { currentHeight = newHeight; };
     owner.getSessionState().addListener(this);
+    owner.getPlaybackTimerManager().addListener(this);
+    lastIoSampleMs = juce::Time::getMillisecondCounterHiRes();
+    lastIoSamples = owner.getAudioPlayer().getIoGovernor().getSamplesProcessed();
 }
 
 StatsPresenter::~StatsPresenter() {
+    owner.getPlaybackTimerManager().removeListener(this);
     owner.getSessionState().removeListener(this);
 }
 
+void StatsPresenter::playbackTimerTick() {
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (nowMs < lastIoSampleMs + Config::Audio::ioStatsRefreshMs)
+        return;
+
+    const juce::int64 samples = owner.getAudioPlayer().getIoGovernor().getSamplesProcessed();
+    ioThroughput = (double)(samples - lastIoSamples) * 1000.0 / (nowMs - lastIoSampleMs);
+    lastIoSamples = samples;
+    lastIoSampleMs = nowMs;
+
+    if (showStats)
+        updateStats();
+}
+
+juce::String StatsPresenter::formatAnalysisProgress(const AnalysisProgress::Snapshot &snapshot) {
+    if (snapshot.activeJobs <= 0)
+        return Config::Labels::statsAnalysisIdle;
+
+    juce::String text;
+    text << juce::roundToInt(snapshot.getFraction() * 100.0)
+         << Config::Labels::analysisProgressPercent
+         << juce::String(snapshot.bytesPerSecond / 1.0e6, 1)
+         << Config::Labels::analysisProgressRate;
+    if (snapshot.etaSeconds >= 0.0)
+        text << Config::Labels::analysisProgressEta << juce::String(snapshot.etaSeconds, 1)
+             << Config::Labels::analysisProgressSeconds;
+    return text;
+}
+
 void StatsPresenter::fileChanged(const juce::String &filePath) {
     setDisplayEnabled(filePath.isNotEmpty());
     updateStats();
@@ -86,20 +136,66 @@ juce::String StatsPresenter::buildStatsString() const {
         stats << Config::Labels::statsChannels << thumbnail.getNumChannels() << "\n";
         stats << Config::Labels::statsLength << TimeUtils::formatTime(thumbnail.getTotalLength(), sampleRate) << "\n";
 
-        float minVal = 0.0f;
-        float maxVal = 0.0f;
-        thumbnail.getApproximateMinMax(0.0, thumbnail.getTotalLength(), 0, minVal, maxVal);
-        stats << Config::Labels::statsPeak0 << juce::jmax(std::abs(minVal), std::abs(maxVal)) << "\n";
-        stats << Config::Labels::statsMin << minVal << Config::Labels::statsMax << maxVal << "\n";
-
-        if (thumbnail.getNumChannels() > 1) {
-            thumbnail.getApproximateMinMax(0.0, thumbnail.getTotalLength(), 1, minVal, maxVal);
-            stats << Config::Labels::statsPeak1 << juce::jmax(std::abs(minVal), std::abs(maxVal))
+        const juce::String filePath = audioPlayer.getLoadedFile().getFullPathName();
+        const auto levelStats = owner.getSessionState().getMetadataForFile(filePath).levelStats;
+        if (levelStats != nullptr && levelStats->getLengthInSamples() == lengthInSamples) {
+            // Exact figures from the envelope pass replace the thumbnail's estimate.
+            for (int ch = 0; ch < levelStats->getNumChannels(); ++ch) {
+                const auto &channel = levelStats->getChannel(ch);
+                stats << Config::Labels::statsLevelPrefix << ch << Config::Labels::statsLevelSuffix
+                      << levelStats->getPeak(ch) << "\n";
+                stats << Config::Labels::statsMin << channel.minimum << Config::Labels::statsMax
+                      << channel.maximum << "\n";
+                stats << Config::Labels::statsRms << levelStats->getRms(ch)
+                      << Config::Labels::statsDcOffset << levelStats->getDcOffset(ch)
+                      << Config::Labels::statsClips << channel.clipCount << "\n";
+            }
+        } else {
+            float minVal = 0.0f;
+            float maxVal = 0.0f;
+            thumbnail.getApproximateMinMax(0.0, thumbnail.getTotalLength(), 0, minVal, maxVal);
+            stats << Config::Labels::statsPeak0 << juce::jmax(std::abs(minVal), std::abs(maxVal))
+                  << "\n";
+            stats << Config::Labels::statsMin << minVal << Config::Labels::statsMax << maxVal
                   << "\n";
-            stats << Config::Labels::statsMin << minVal << Config::Labels::statsMax << maxVal << "\n";
+
+            if (thumbnail.getNumChannels() > 1) {
+                thumbnail.getApproximateMinMax(0.0, thumbnail.getTotalLength(), 1, minVal,
+                                               maxVal);
+                stats << Config::Labels::statsPeak1
+                      << juce::jmax(std::abs(minVal), std::abs(maxVal)) << "\n";
+                stats << Config::Labels::statsMin << minVal << Config::Labels::statsMax << maxVal
+                      << "\n";
+            }
         }
     } else {
-        stats << Config::Labels::statsError;
+        stats << Config::Labels::statsError << "\n";
+    }
+
+    stats << Config::Labels::statsIoThrottle
+          << getLevelName(audioPlayer.getIoGovernor().getLevel()) << "\n";
+    stats << Config::Labels::statsIoThroughput << juce::String(ioThroughput / 1.0e6, 1)
+          << Config::Labels::statsIoThroughputUnit << "\n";
+
+    if (analysisProgress == nullptr)
+        return stats;
+
+    stats << Config::Labels::statsAnalysisProgress
+          << formatAnalysisProgress(analysisProgress->getSnapshot()) << "\n";
+
+    const auto history = analysisProgress->getHistory();
+    if (!history.empty())
+        stats << Config::Labels::statsAnalysisHistory << "\n";
+    for (const auto &record : history) {
+        stats << record.kind << " " << record.fileName << ": "
+              << juce::String((double)record.bytes / 1.0e6, 1)
+              << Config::Labels::analysisRecordMegabytes << juce::String(record.seconds, 2)
+              << Config::Labels::analysisRecordSeconds
+              << juce::String(record.getBytesPerSecond() / 1.0e6, 1)
+              << Config::Labels::analysisRecordRateUnit;
+        if (record.cancelled)
+            stats << Config::Labels::statsAnalysisCancelled;
+        stats << "\n";
     }
 
     return stats;
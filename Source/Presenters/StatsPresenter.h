@@ -9,6 +9,8 @@
 
 #include "Utils/Config.h"
 #include "Core/SessionState.h"
+#include "Presenters/PlaybackTimerManager.h"
+#include "Workers/AnalysisProgress.h"
 
 class ControlPanel;
 
@@ -112,13 +114,21 @@ class StatsOverlay : public juce::Component {
  *            automatically refresh the display when a new asset is loaded.
  *          - **Visibility Management**: Toggles the metadata tray in response 
  *            to user keybinds or menu actions.
+ *          - **Analysis I/O**: While visible, refreshes once per
+ *            `Config::Audio::ioStatsRefreshMs` with the IoGovernor's throttle level and
+ *            the analysis throughput achieved over that window.
+ *          - **Analysis Jobs**: The same refresh shows the live AnalysisProgress of the
+ *            silence worker and the timings of its most recent jobs, newest first.
  * 
  * @see StatsOverlay
  * @see AudioPlayer
  * @see SessionState
  * @see ControlPanel
+ * @see IoGovernor
+ * @see AnalysisProgress
  */
-class StatsPresenter final : public SessionState::Listener {
+class StatsPresenter final : public SessionState::Listener,
+                             public PlaybackTimerManager::Listener {
   public:
     /**
      * @brief Constructs the presenter and wires it to the parent view.
@@ -185,6 +195,26 @@ class StatsPresenter final : public SessionState::Listener {
      */
     void fileChanged(const juce::String &filePath) override;
 
+    /**
+     * @brief Samples the analysis throughput and refreshes the overlay once per window.
+     */
+    void playbackTimerTick() override;
+
+    /**
+     * @brief Connects the progress surface whose state the overlay reports.
+     * @param progress The silence worker's progress, or nullptr to hide the section.
+     */
+    void setAnalysisProgress(const AnalysisProgress *progress) noexcept {
+        analysisProgress = progress;
+    }
+
+    /**
+     * @brief Formats live analysis progress as one line.
+     * @param snapshot The progress to describe.
+     * @return E.g. "42% | 310.5 MB/s | ETA 3.1 s", or the idle label if nothing runs.
+     */
+    static juce::String formatAnalysisProgress(const AnalysisProgress::Snapshot &snapshot);
+
   private:
     /**
      * @brief Mathematical internal helper to construct the technical summary.
@@ -201,6 +231,10 @@ class StatsPresenter final : public SessionState::Listener {
     StatsOverlay statsOverlay;  /**< The passive view managed by this presenter. */
     bool showStats{false};      /**< Current visibility flag. */
     int currentHeight{Config::Layout::Stats::initialHeight}; /**< User-defined height for the tray. */
+    double lastIoSampleMs{0.0};        /**< Start of the current throughput window. */
+    juce::int64 lastIoSamples{0};      /**< Governor sample count at the window start. */
+    double ioThroughput{0.0};          /**< Samples per second over the last window. */
+    const AnalysisProgress *analysisProgress{nullptr}; /**< The silence worker's progress. */
 };
 
 #endif
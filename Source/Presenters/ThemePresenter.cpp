@@ -99,6 +99,8 @@ void ThemePresenter::applyTheme() {
         s->getMarkerButton().setColour(juce::TextButton::textColourOnId, Config::Colors::Button::textActive);
         s->getResetButton().setColour(juce::TextButton::textColourOffId, Config::Colors::Button::text);
         s->getResetButton().setColour(juce::TextButton::textColourOnId, Config::Colors::Button::textActive);
+        s->getFilterButton().setColour(juce::TextButton::textColourOffId, Config::Colors::Button::text);
+        s->getFilterButton().setColour(juce::TextButton::textColourOnId, Config::Colors::Button::textActive);
         s->getAutoCutButton().setColour(juce::TextButton::textColourOffId, Config::Colors::Button::text);
         s->getAutoCutButton().setColour(juce::TextButton::textColourOnId, Config::Colors::Button::textActive);
         s->getLockButton().setColour(juce::TextButton::textColourOffId, Config::Colors::Button::text);
@@ -33,6 +33,11 @@ void MarkerStrip::initialiseComponents() {
     thresholdEditor.applyStandardStyle();
     thresholdEditor.getProperties().set("GroupPosition", (int)AppEnums::GroupPosition::Middle);
 
+    // Pre-Filter Button (cycles through MainDomain::FilterMode)
+    addAndMakeVisible(filterButton);
+    filterButton.getProperties().set("GroupPosition", (int)AppEnums::GroupPosition::Middle);
+    updateFilterMode(MainDomain::FilterMode::Off);
+
     // AutoCut Button
     addAndMakeVisible(autoCutButton);
     autoCutButton.setButtonText(markerType == MarkerType::In ? Config::Labels::autoCutInButton
@@ -58,11 +63,12 @@ void MarkerStrip::resized() {
     const int timerWidth = (int)(Config::UI::TimerWidthUnits * unit);
     const int resetWidth = (int)(Config::UI::ResetButtonWidthUnits * unit);
     const int thresholdWidth = (int)(Config::UI::ThresholdWidthUnits * unit);
+    const int filterWidth = (int)(Config::UI::FilterButtonWidthUnits * unit);
     const int autoCutWidth = (int)(Config::UI::CutButtonWidthUnits * unit);
     const int lockWidth = (int)(Config::UI::ResetButtonWidthUnits * unit);
 
     if (markerType == MarkerType::In) {
-        // [In(L), Timer, Reset, Threshold, AutoCut, Lock(R)]
+        // [In(L), Timer, Reset, Threshold, Filter, AutoCut, Lock(R)]
         markerButton.setBounds(b.removeFromLeft(markerWidth));
         b.removeFromLeft(spacing);
         timerEditor.setBounds(b.removeFromLeft(timerWidth));
@@ -71,15 +77,19 @@ void MarkerStrip::resized() {
         b.removeFromLeft(spacing);
         thresholdEditor.setBounds(b.removeFromLeft(thresholdWidth));
         b.removeFromLeft(spacing);
+        filterButton.setBounds(b.removeFromLeft(filterWidth));
+        b.removeFromLeft(spacing);
         autoCutButton.setBounds(b.removeFromLeft(autoCutWidth));
         b.removeFromLeft(spacing);
         lockButton.setBounds(b.removeFromLeft(lockWidth));
     } else {
-        // [Lock(L), AutoCut, Threshold, Reset, Timer, Out(R)]
+        // [Lock(L), AutoCut, Filter, Threshold, Reset, Timer, Out(R)]
         lockButton.setBounds(b.removeFromLeft(lockWidth));
         b.removeFromLeft(spacing);
         autoCutButton.setBounds(b.removeFromLeft(autoCutWidth));
         b.removeFromLeft(spacing);
+        filterButton.setBounds(b.removeFromLeft(filterWidth));
+        b.removeFromLeft(spacing);
         thresholdEditor.setBounds(b.removeFromLeft(thresholdWidth));
         b.removeFromLeft(spacing);
         resetButton.setBounds(b.removeFromLeft(resetWidth));
@@ -99,6 +109,15 @@ void MarkerStrip::updateAutoCutState(bool isActive) {
     autoCutButton.setToggleState(isActive, juce::dontSendNotification);
 }
 
+void MarkerStrip::updateFilterMode(MainDomain::FilterMode mode) {
+    filterButton.setButtonText(mode == MainDomain::FilterMode::HighPass
+                                   ? Config::Labels::filterHighPassButton
+                               : mode == MainDomain::FilterMode::BandLimit
+                                   ? Config::Labels::filterBandLimitButton
+                                   : Config::Labels::filterOffButton);
+    filterButton.setToggleState(mode != MainDomain::FilterMode::Off, juce::dontSendNotification);
+}
+
 void MarkerStrip::updateMarkerButtonColor(juce::Colour color) {
     markerButton.setColour(juce::TextButton::buttonColourId, color);
 }
@@ -7,6 +7,7 @@
 #include <JuceHeader.h>
 #endif
 
+#include "MainDomain.h"
 #include "UI/Components/TransportButton.h"
 #include "UI/Components/StyledTextEditor.h"
 #include "Utils/Config.h"
@@ -34,8 +35,8 @@ class BoundaryLogicPresenter;
  *          remains purely presentation-focused.
  * 
  *          Follows the Symmetry Rule:
- *          - In Strip: [In(L), Timer, Reset, Threshold, AutoCut(R)]
- *          - Out Strip: [AutoCut(L), Threshold, Reset, Timer, Out(R)]
+ *          - In Strip: [In(L), Timer, Reset, Threshold, Filter, AutoCut, Lock(R)]
+ *          - Out Strip: [Lock(L), AutoCut, Filter, Threshold, Reset, Timer, Out(R)]
  * 
  * @see BoundaryLogicPresenter, ControlPanel, TransportButton, StyledTextEditor
  */
@@ -74,6 +75,12 @@ class MarkerStrip : public juce::Component {
      */
     void updateAutoCutState(bool isActive);
 
+    /**
+     * @brief Shows which pre-filter the strip's Auto-Cut scan listens through.
+     * @param mode The active pre-filter; any filter other than Off lights the button.
+     */
+    void updateFilterMode(MainDomain::FilterMode mode);
+
     /** 
      * @brief Changes the color of the primary marker button. 
      * @param color The new color to apply.
@@ -104,6 +111,10 @@ class MarkerStrip : public juce::Component {
     StyledTextEditor &getThresholdEditor() {
         return thresholdEditor;
     }
+    /** @return Reference to the pre-filter cycle button. */
+    TransportButton &getFilterButton() {
+        return filterButton;
+    }
     /** @return Reference to the auto-cut toggle button. */
     TransportButton &getAutoCutButton() {
         return autoCutButton;
@@ -121,6 +132,7 @@ class MarkerStrip : public juce::Component {
     StyledTextEditor timerEditor;
     TransportButton resetButton;
     StyledTextEditor thresholdEditor;
+    TransportButton filterButton;
     TransportButton autoCutButton;
     TransportButton lockButton;
 
@@ -57,7 +57,8 @@ void LayoutManager::layoutCutControls(juce::Rectangle<int> &bounds, int height)
     auto cutRow = bounds.removeFromTop(height);
 
     const int stripWidth = (int)((Config::UI::CutButtonWidthUnits * 2 + Config::UI::TimerWidthUnits + 
-                                  Config::UI::ResetButtonWidthUnits * 2 + Config::UI::ThresholdWidthUnits) * unit) + (spacing * 5);
+                                  Config::UI::ResetButtonWidthUnits * 2 + Config::UI::ThresholdWidthUnits +
+                                  Config::UI::FilterButtonWidthUnits) * unit) + (spacing * 6);
 
     if (controlPanel.inStrip != nullptr)
         controlPanel.inStrip->setBounds(cutRow.removeFromLeft(stripWidth));
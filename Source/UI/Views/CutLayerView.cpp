@@ -4,6 +4,7 @@
 #include "UI/ControlPanel.h"
 #include "UI/Handlers/MarkerMouseHandler.h"
 #include "Utils/CoordinateMapper.h"
+#include "Workers/SilenceGapMap.h"
 
 CutLayerView::CutLayerView(ControlPanel &ownerIn)
     : owner(ownerIn) {
@@ -19,7 +20,8 @@ void CutLayerView::updateState(const CutLayerState& newState) {
         state.audioLength != newState.audioLength ||
         state.channelMode != newState.channelMode ||
         state.inThresholdYTop != newState.inThresholdYTop ||
-        state.outThresholdYTop != newState.outThresholdYTop) {
+        state.outThresholdYTop != newState.outThresholdYTop ||
+        state.gapMap != newState.gapMap) {
         state = newState;
         repaint();
         return;
@@ -48,10 +50,12 @@ void CutLayerView::updateState(const CutLayerState& newState) {
 }
 
 void CutLayerView::paint(juce::Graphics &g) {
-    if (!state.markersVisible)
+    if (state.audioLength <= 0.0f)
         return;
 
-    if (state.audioLength <= 0.0f)
+    drawGaps(g);
+
+    if (!state.markersVisible)
         return;
 
     drawThresholds(g);
@@ -59,6 +63,30 @@ void CutLayerView::paint(juce::Graphics &g) {
     drawMarkersAndRegion(g);
 }
 
+void CutLayerView::drawGaps(juce::Graphics& g) {
+    const auto *map = state.gapMap.get();
+    if (map == nullptr || map->getGaps().empty() || map->getSampleRate() <= 0.0)
+        return;
+
+    const auto clip = g.getClipBounds().toFloat();
+    const float width = (float)getWidth();
+    const double rate = map->getSampleRate();
+    const auto clipStart = (juce::int64)(CoordinateMapper::pixelsToSeconds(clip.getX(), width, state.audioLength) * rate);
+    const float threshold = juce::jmax(map->getThreshold(), 1.0e-6f);
+    const auto &gaps = map->getGaps();
+
+    // Digital silence gets the full overlay colour; gaps that hover near the Threshold fade out.
+    for (size_t i = map->findFirstEndingAfter(clipStart); i < gaps.size(); ++i) {
+        const float startX = CoordinateMapper::secondsToPixels((double)gaps[i].start / rate, width, state.audioLength);
+        if (startX > clip.getRight())
+            break;
+        const float endX = CoordinateMapper::secondsToPixels((double)gaps[i].end / rate, width, state.audioLength);
+        const float shade = 1.0f - 0.75f * juce::jlimit(0.0f, 1.0f, gaps[i].depth / threshold);
+        g.setColour(Config::Colors::silenceGap.withMultipliedAlpha(shade));
+        g.fillRect(startX, clip.getY(), juce::jmax(1.0f, endX - startX), clip.getHeight());
+    }
+}
+
 void CutLayerView::drawThresholds(juce::Graphics& g) {
     const auto bounds = getLocalBounds();
     auto drawThresholdVisualisation = [&](float xPos, float topThresholdY, float bottomThresholdY, juce::Colour color) {
@@ -11,6 +11,8 @@
 #include "Utils/Config.h"
 #include "UI/Handlers/MarkerMouseHandler.h"
 
+#include <memory>
+
 /**
  * @file CutLayerView.h
  * @Source/Core/FileMetadata.h
@@ -19,6 +21,7 @@
  */
 
 class ControlPanel;
+class SilenceGapMap;
 
 /**
  * @struct CutLayerState
@@ -78,6 +81,9 @@ struct CutLayerState {
     float regionOutlineThickness{0.0f};
     /** @brief True if the entire region should currently be pulsing. */
     bool regionShouldPulse{false};
+
+    /** @brief Internal silent gaps of the loaded file, shaded by depth; null until scanned. */
+    std::shared_ptr<const SilenceGapMap> gapMap;
 };
 
 /**
@@ -120,6 +126,8 @@ class CutLayerView : public juce::Component {
     void paint(juce::Graphics &g) override;
 
   private:
+    /** @brief Shades the internal silence gaps that intersect the clip region. */
+    void drawGaps(juce::Graphics& g);
     /** @brief Renders the horizontal silence threshold lines. */
     void drawThresholds(juce::Graphics& g);
     /** @brief Renders the fade/cut regions (darkened areas). */
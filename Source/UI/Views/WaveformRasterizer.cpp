@@ -0,0 +1,64 @@
+#include "UI/Views/WaveformRasterizer.h"
+
+#include <cmath>
+#include <vector>
+
+void WaveformRasterizer::drawColumns(juce::Image &image, juce::Rectangle<int> area,
+                                     const float *minima, const float *maxima, int numColumns,
+                                     int columnWidth, const Palette &palette) {
+    area = area.getIntersection(image.getBounds());
+    if (area.isEmpty() || columnWidth <= 0)
+        return;
+    jassert(image.getFormat() == juce::Image::ARGB);
+
+    const int width = area.getWidth();
+    const int height = area.getHeight();
+    const float halfHeight = (float)height * 0.5f;
+
+    // One opaque colour per row, as the vertical gradient would paint it over the background.
+    std::vector<juce::PixelARGB> fill((size_t)height);
+    for (int y = 0; y < height; ++y) {
+        const float distance = std::abs(((float)y + 0.5f) / (float)height - 0.5f) * 2.0f;
+        const auto colour = palette.centre.interpolatedWith(palette.edge, distance);
+        fill[(size_t)y] = palette.background.overlaidWith(colour).getPixelARGB();
+    }
+    const juce::PixelARGB background = palette.background.getPixelARGB();
+
+    numColumns = juce::jmin(numColumns, (width + columnWidth - 1) / columnWidth);
+    std::vector<float> tops((size_t)juce::jmax(0, numColumns));
+    std::vector<float> bottoms(tops.size());
+    for (int column = 0; column < numColumns; ++column) {
+        const float top = halfHeight - maxima[column] * halfHeight;
+        const float bottom = halfHeight - minima[column] * halfHeight;
+        tops[(size_t)column] = top;
+        bottoms[(size_t)column] = juce::jmax(bottom, top + 1.0f);
+    }
+
+    juce::Image::BitmapData data(image, area.getX(), area.getY(), width, height,
+                                 juce::Image::BitmapData::writeOnly);
+    for (int y = 0; y < height; ++y) {
+        auto *pixel = data.getLinePointer(y);
+        const float rowTop = (float)y;
+        const float rowBottom = rowTop + 1.0f;
+        int x = 0;
+        for (int column = 0; column < numColumns; ++column) {
+            const float coverage = juce::jlimit(0.0f, 1.0f,
+                                                juce::jmin(bottoms[(size_t)column], rowBottom) -
+                                                    juce::jmax(tops[(size_t)column], rowTop));
+            juce::PixelARGB colour = background;
+            if (coverage >= 1.0f)
+                colour = fill[(size_t)y];
+            else if (coverage > 0.0f)
+                colour.blend(fill[(size_t)y], (juce::uint32)juce::roundToInt(coverage * 255.0f));
+
+            for (const int end = juce::jmin(width, x + columnWidth); x < end; ++x) {
+                *reinterpret_cast<juce::PixelARGB *>(pixel) = colour;
+                pixel += data.pixelStride;
+            }
+        }
+        for (; x < width; ++x) {
+            *reinterpret_cast<juce::PixelARGB *>(pixel) = background;
+            pixel += data.pixelStride;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef AUDIOFILER_WAVEFORMRASTERIZER_H
+#define AUDIOFILER_WAVEFORMRASTERIZER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_graphics/juce_graphics.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Utils/Config.h"
+
+/**
+ * @file WaveformRasterizer.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup UI
+ * @brief Writes rows of waveform columns straight into an image's pixels.
+ */
+
+/**
+ * @class WaveformRasterizer
+ * @brief Renders min/max column spans into a juce::Image without the Graphics path API.
+ *
+ * @details Drawing a waveform through juce::Graphics costs one fillRect, with its clip and
+ *          gradient set-up, per pixel column. The rasterizer instead precomputes one opaque
+ *          colour per row (the peak-core-peak gradient already blended over the background)
+ *          and fills the image row by row through juce::Image::BitmapData, covering the
+ *          background too. The top and bottom pixel of each column are blended by coverage,
+ *          matching the anti-aliased edges of the former fillRect path.
+ *
+ * @see WaveformView, ZoomView, PeakMipmap::getColumns
+ */
+class WaveformRasterizer {
+  public:
+    /** @brief The colours of a rendered waveform. */
+    struct Palette {
+        juce::Colour background{Config::Colors::solidBlack}; /**< Behind the columns. */
+        juce::Colour edge{Config::Colors::waveformPeak};     /**< At the top and bottom. */
+        juce::Colour centre{Config::Colors::waveformCore};   /**< At the zero line. */
+    };
+
+    /**
+     * @brief Fills an area of an ARGB image with waveform columns.
+     * @param image The image to write into.
+     * @param area The area to fill; the zero line runs through its centre.
+     * @param minima The minimum of each column, in [-1, 1].
+     * @param maxima The maximum of each column, in [-1, 1].
+     * @param numColumns The number of columns; pixels past the last one show background.
+     * @param columnWidth The width of each column in pixels.
+     * @param palette The colours to use.
+     */
+    static void drawColumns(juce::Image &image, juce::Rectangle<int> area, const float *minima,
+                            const float *maxima, int numColumns, int columnWidth,
+                            const Palette &palette = {});
+};
+
+#endif
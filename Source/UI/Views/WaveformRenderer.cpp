@@ -0,0 +1,96 @@
+#include "UI/Views/WaveformRenderer.h"
+
+/**
+ * @class WaveformRenderer::RenderJob
+ * @brief Drains the renderer's queued requests on the render thread.
+ */
+class WaveformRenderer::RenderJob final : public juce::ThreadPoolJob {
+  public:
+    explicit RenderJob(WaveformRenderer &ownerRenderer)
+        : juce::ThreadPoolJob("WaveformRender"), renderer(ownerRenderer) {
+    }
+
+    JobStatus runJob() override {
+        renderer.renderPending();
+        return jobHasFinished;
+    }
+
+  private:
+    WaveformRenderer &renderer;
+};
+
+WaveformRenderer::WaveformRenderer(juce::Component &ownerComponent) : owner(&ownerComponent) {
+    renderPool = std::make_unique<juce::ThreadPool>(
+        juce::ThreadPoolOptions{}.withThreadName("WaveformRender").withNumberOfThreads(1));
+}
+
+WaveformRenderer::~WaveformRenderer() {
+    {
+        const juce::ScopedLock lock(pendingLock);
+        pending = nullptr;
+    }
+    renderPool.reset(); // the job renders through this object
+}
+
+void WaveformRenderer::request(int width, int height, RenderFunction render) {
+    const juce::ScopedLock lock(pendingLock);
+    pending = std::move(render);
+    pendingWidth = juce::jmax(1, width);
+    pendingHeight = juce::jmax(1, height);
+    if (!isJobQueued) {
+        isJobQueued = true;
+        renderPool->addJob(new RenderJob(*this), true);
+    }
+}
+
+bool WaveformRenderer::drawFrame(juce::Graphics &g, juce::Rectangle<int> area) const {
+    const auto frame = std::atomic_load(&front);
+    if (frame == nullptr)
+        return false;
+    if (frame->image.getBounds() == area.withZeroOrigin())
+        g.drawImageAt(frame->image, area.getX(), area.getY());
+    else
+        g.drawImage(frame->image, area.toFloat());
+    return true;
+}
+
+/**
+ * @details A published frame is recycled as the next back frame only once the Message Thread
+ *          holds no copy of it; otherwise a fresh frame is allocated.
+ */
+void WaveformRenderer::renderPending() {
+    for (;;) {
+        RenderFunction render;
+        int width = 0, height = 0;
+        {
+            const juce::ScopedLock lock(pendingLock);
+            if (pending == nullptr) {
+                isJobQueued = false;
+                return;
+            }
+            render = std::move(pending);
+            pending = nullptr;
+            width = pendingWidth;
+            height = pendingHeight;
+        }
+
+        auto frame = spare != nullptr ? std::move(spare) : std::make_shared<Frame>();
+        if (frame->image.getWidth() != width || frame->image.getHeight() != height) {
+            frame->image = juce::Image(juce::Image::ARGB, width, height, false);
+            frame->layout = -1;
+            frame->progress = 0;
+        }
+        render(*frame);
+
+        auto previous = std::atomic_exchange(&front, std::move(frame));
+        if (previous != nullptr && previous.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            spare = std::move(previous);
+        }
+
+        juce::MessageManager::callAsync([view = owner] {
+            if (view != nullptr)
+                view->repaint();
+        });
+    }
+}
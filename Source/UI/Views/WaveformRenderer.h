@@ -0,0 +1,95 @@
+#ifndef AUDIOFILER_WAVEFORMRENDERER_H
+#define AUDIOFILER_WAVEFORMRENDERER_H
+
+#if defined(JUCE_HEADLESS)
+#include <juce_gui_basics/juce_gui_basics.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * @file WaveformRenderer.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup UI
+ * @brief Double-buffered rendering of a view's cached image on a background thread.
+ */
+
+/**
+ * @class WaveformRenderer
+ * @brief Renders images for a view on its own thread and hands them over without locking.
+ *
+ * @details Rebuilding a waveform image inside `paint()` stalls the Message Thread on every
+ *          resize, channel-mode toggle or theme change. A view instead queues a render
+ *          function with request(); a single render thread runs the newest one into a back
+ *          frame and publishes it with an atomic pointer swap, then asks the view to repaint.
+ *          The view's `paint()` only blits the newest published frame with drawFrame(),
+ *          stretched if its size is stale, and never waits for the render thread.
+ *
+ *          Requests coalesce: one queued while another renders replaces any older queued
+ *          request. Two frames take turns as the back buffer, and each keeps the `layout`
+ *          and `progress` its last render left behind, so a render function can update a
+ *          frame incrementally instead of redrawing it.
+ *
+ * @see WaveformView, ZoomView, WaveformRasterizer
+ */
+class WaveformRenderer final {
+  public:
+    /** @brief An image owned by the renderer, with what it was last rendered for. */
+    struct Frame {
+        juce::Image image;
+        juce::int64 layout{-1};  /**< Set by the render function; -1 for a new image. */
+        juce::int64 progress{0}; /**< How far an incremental render has got. */
+    };
+
+    /** @brief Renders into a frame of the requested size, on the render thread. */
+    using RenderFunction = std::function<void(Frame &)>;
+
+    /**
+     * @brief Constructs a renderer for a view.
+     * @param owner The view to repaint when a frame is published.
+     */
+    explicit WaveformRenderer(juce::Component &owner);
+
+    /** @brief Stops the render thread, waiting for the render in progress. */
+    ~WaveformRenderer();
+
+    /**
+     * @brief Queues a render, replacing any request that has not started yet.
+     * @param width The width of the frame to render.
+     * @param height The height of the frame to render.
+     * @param render Draws into the frame; must only touch data that is safe to read off the
+     *               Message Thread.
+     */
+    void request(int width, int height, RenderFunction render);
+
+    /**
+     * @brief Draws the newest published frame, stretched to fill an area.
+     * @return False if no frame has been published yet.
+     */
+    bool drawFrame(juce::Graphics &g, juce::Rectangle<int> area) const;
+
+  private:
+    class RenderJob;
+
+    /** @brief Runs queued requests until none is left; on the render thread. */
+    void renderPending();
+
+    juce::Component::SafePointer<juce::Component> owner;
+
+    juce::CriticalSection pendingLock;
+    RenderFunction pending;
+    int pendingWidth{0}, pendingHeight{0};
+    bool isJobQueued{false};
+
+    std::shared_ptr<Frame> front; /**< Accessed with std::atomic_load / std::atomic_exchange. */
+    std::shared_ptr<Frame> spare; /**< The back frame; render thread only. */
+    std::unique_ptr<juce::ThreadPool> renderPool;
+
+    JUCE_DECLARE_NON_COPYABLE(WaveformRenderer)
+};
+
+#endif
@@ -2,6 +2,8 @@
 #include "Utils/Config.h"
 #include "Utils/CoordinateMapper.h"
 
+#include <cmath>
+
 WaveformView::WaveformView() {
     setInterceptsMouseClicks(false, false);
     setOpaque(true);
@@ -10,82 +12,129 @@ WaveformView::WaveformView() {
 WaveformView::~WaveformView() = default;
 
 void WaveformView::updateState(const WaveformViewState& newState) {
-    // 1. Check if core parameters changed (requires immediate redraw)
+    // 1. Check if core parameters changed (requires a full redraw). A reset of the
+    //    mipmap means another file, even one of the same length.
+    const juce::uint32 resetCount =
+        newState.thumbnail != nullptr ? newState.thumbnail->getResetCount() : 0;
     bool majorChange = (state.thumbnail != newState.thumbnail ||
                         state.totalLength != newState.totalLength ||
-                        state.channelMode != newState.channelMode);
+                        state.channelMode != newState.channelMode ||
+                        lastResetCount != resetCount);
 
-    // 2. Check if the background thread is still building the waveform
-    bool isActivelyLoading = (newState.thumbnail != nullptr && !newState.thumbnail->isFullyLoaded());
+    state = newState;
+    lastResetCount = resetCount;
 
     if (majorChange) {
-        isCacheDirty = true;
-        loadingTickCounter = 0; 
-    } else if (isActivelyLoading) {
-        loadingTickCounter++;
-        // Throttle the heavy image cache rebuild to exactly 10 FPS (assuming 60Hz input)
-        if (loadingTickCounter % 6 == 0) {
-            isCacheDirty = true;
-        }
+        requestRender(true);
+        return;
     }
 
-    state = newState;
-    
-    // 3. ONLY trigger the massive UI redraw if the cache was actually dirtied!
-    // This ignores 60Hz ticks and mouse drags once the file is fully loaded!
-    if (isCacheDirty) {
-        repaint();
+    // 2. While the background thread builds the waveform, only the columns covering the
+    //    samples finished since the last render need drawing; mouse drags and 60Hz ticks
+    //    after loading leave the cache untouched.
+    if (state.thumbnail != nullptr) {
+        const juce::int64 finished = state.thumbnail->getNumSamplesFinished();
+        if (finished != requestedSamples)
+            requestRender(false);
     }
 }
 
 void WaveformView::clearCaches() {
-    isCacheDirty = true;
-    repaint();
+    requestRender(true);
+}
+
+void WaveformView::resized() {
+    requestRender(true);
 }
 
 void WaveformView::paint(juce::Graphics &g) {
-    if (isCacheDirty || cachedWaveform.getWidth() != getWidth() || cachedWaveform.getHeight() != getHeight()) {
-        cachedWaveform = juce::Image(juce::Image::ARGB, juce::jmax(1, getWidth()), juce::jmax(1, getHeight()), true);
-        juce::Graphics ig(cachedWaveform);
-
-        ig.fillAll(Config::Colors::solidBlack);
-        
-        if (state.thumbnail != nullptr && state.totalLength > 0.0) {
-            const auto bounds = getLocalBounds().toFloat();
-            juce::ColourGradient gradient(Config::Colors::waveformPeak, bounds.getX(), bounds.getY(),
-                                          Config::Colors::waveformPeak, bounds.getX(), bounds.getBottom(), false);
-            gradient.addColour(0.5, Config::Colors::waveformCore);
-            ig.setGradientFill(gradient);
-            drawWaveform(ig);
-        }
-        isCacheDirty = false;
-    }
-    g.drawImageAt(cachedWaveform, 0, 0);
+    if (!renderer.drawFrame(g, getLocalBounds()))
+        g.fillAll(Config::Colors::solidBlack);
+}
+
+void WaveformView::requestRender(bool fullRedraw) {
+    if (fullRedraw)
+        ++layoutGeneration;
+    requestedSamples = state.thumbnail != nullptr ? state.thumbnail->getNumSamplesFinished() : 0;
+    // Colours are captured here, as a theme change may rewrite them during a render.
+    renderer.request(getWidth(), getHeight(),
+                     [this, snapshot = state, layout = layoutGeneration,
+                      palette = WaveformRasterizer::Palette()](auto &frame) {
+                         renderFrame(frame, snapshot, palette, layout);
+                     });
 }
 
-void WaveformView::drawWaveform(juce::Graphics &g) {
-    if (state.thumbnail == nullptr) return;
+int WaveformView::getColumnWidth() {
+    return juce::jmax(1, Config::Layout::Waveform::pixelsPerSampleHigh);
+}
 
-    const auto totalLength = (float)state.totalLength;
-    const auto bounds = getLocalBounds().toFloat();
-    const auto width = bounds.getWidth();
-    const auto centerY = bounds.getCentreY();
-    const auto halfHeight = bounds.getHeight() * 0.5f;
-    
-    // Changed from Low (4) to High (1)
-    const float step = (float)Config::Layout::Waveform::pixelsPerSampleHigh; 
+int WaveformView::getNumColumns(int width) {
+    return (juce::jmax(1, width) + getColumnWidth() - 1) / getColumnWidth();
+}
 
-    // Draw the full width into the cache
-    for (float x = 0.0f; x < width; x += step) {
-        const double startTime = CoordinateMapper::pixelsToSeconds(x, width, totalLength);
-        const double endTime = CoordinateMapper::pixelsToSeconds(x + step, width, totalLength);
+double WaveformView::getSamplesPerColumn(const WaveformViewState &snapshot, int width) {
+    if (snapshot.thumbnail == nullptr || width <= 0)
+        return 0.0;
+    // The last column may reach past the right edge, exactly as the per-column loop did.
+    return CoordinateMapper::pixelsToSeconds((float)getColumnWidth(), (float)width,
+                                             snapshot.totalLength) *
+           snapshot.thumbnail->getSampleRate();
+}
 
-        float minVal = 0.0f, maxVal = 0.0f;
-        state.thumbnail->getApproximateMinMax(startTime, endTime, 0, minVal, maxVal);
+/**
+ * @details Column c covers samples [floor(c * n), ceil((c + 1) * n)), so the column before
+ *          the one holding `startSample` may also have reached into the range.
+ */
+juce::Range<int> WaveformView::getColumnsBetween(const WaveformViewState &snapshot, int width,
+                                                 juce::int64 startSample,
+                                                 juce::int64 endSample) {
+    const int numColumns = getNumColumns(width);
+    const double samplesPerColumn = getSamplesPerColumn(snapshot, width);
+    if (samplesPerColumn <= 0.0)
+        return {0, numColumns};
 
-        const float top = centerY - (maxVal * halfHeight);
-        const float bottom = centerY - (minVal * halfHeight);
+    const auto first = (juce::int64)std::floor((double)startSample / samplesPerColumn) - 1;
+    const auto last = (juce::int64)std::ceil((double)endSample / samplesPerColumn) + 1;
+    return {(int)juce::jlimit((juce::int64)0, (juce::int64)numColumns, first),
+            (int)juce::jlimit((juce::int64)0, (juce::int64)numColumns, last)};
+}
 
-        g.fillRect(x, top, step, juce::jmax(1.0f, bottom - top));
+void WaveformView::renderFrame(WaveformRenderer::Frame &frame, const WaveformViewState &snapshot,
+                               const WaveformRasterizer::Palette &palette, juce::int64 layout) {
+    auto &image = frame.image;
+    const auto bounds = image.getBounds();
+    if (snapshot.thumbnail == nullptr || snapshot.totalLength <= 0.0) {
+        image.clear(bounds, palette.background);
+        frame.layout = layout;
+        frame.progress = 0;
+        return;
     }
+
+    const juce::ScopedReadLock lock(snapshot.thumbnail->getResetLock());
+    // Read the loading front first: anything finished during the query is picked up again
+    // by the next render.
+    const juce::int64 finished = snapshot.thumbnail->getNumSamplesFinished();
+    const int width = bounds.getWidth();
+    const bool isIncremental = frame.layout == layout && finished >= frame.progress;
+    const auto columns = isIncremental
+                             ? getColumnsBetween(snapshot, width, frame.progress, finished)
+                             : juce::Range<int>(0, getNumColumns(width));
+
+    const int step = getColumnWidth();
+    const double samplesPerColumn = getSamplesPerColumn(snapshot, width);
+    const int numColumns = columns.getLength();
+    columnMinima.resize((size_t)juce::jmax(0, numColumns));
+    columnMaxima.resize(columnMinima.size());
+
+    float *minima[] = {columnMinima.data()};
+    float *maxima[] = {columnMaxima.data()};
+    snapshot.thumbnail->getColumns(columns.getStart() * samplesPerColumn,
+                                   columns.getEnd() * samplesPerColumn, numColumns, 0, 1, minima,
+                                   maxima);
+
+    const auto area = bounds.withX(columns.getStart() * step).withWidth(numColumns * step);
+    WaveformRasterizer::drawColumns(image, area, columnMinima.data(), columnMaxima.data(),
+                                    numColumns, step, palette);
+    frame.layout = layout;
+    frame.progress = finished;
 }
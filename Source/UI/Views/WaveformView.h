@@ -9,6 +9,11 @@
 
 #include "Core/AppEnums.h"
 #include "Utils/Config.h"
+#include "UI/Views/WaveformRasterizer.h"
+#include "UI/Views/WaveformRenderer.h"
+#include "Workers/PeakMipmap.h"
+
+#include <vector>
 
 /**
  * @file WaveformView.h
@@ -22,8 +27,8 @@
  * @brief Encapsulates the visual data required to render the base waveform.
  */
 struct WaveformViewState {
-    /** @brief Pointer to the audio thumbnail provider. */
-    juce::AudioThumbnail* thumbnail{nullptr};
+    /** @brief Pointer to the waveform data provider. */
+    const PeakMipmap* thumbnail{nullptr};
     /** @brief The total duration of the audio in seconds. */
     double totalLength{0.0};
     /** @brief The current channel view mode. */
@@ -38,8 +43,9 @@ struct WaveformViewState {
  *          within the Model-View-Presenter (MVP) law. It contains zero business 
  *          logic and exists purely to render the audio data provided by its 
  *          associated state struct. It employs an image-based caching strategy 
- *          for efficient repainting. It relies entirely on the CutPresenter 
- *          to push updates via updateState().
+ *          for efficient repainting: the image is rendered by a WaveformRenderer 
+ *          off the Message Thread, and paint() only blits the newest frame. It 
+ *          relies entirely on the CutPresenter to push updates via updateState().
  * 
  * @see CutPresenter, WaveformCanvasView, ControlPanel, WaveformViewState
  */
@@ -56,6 +62,9 @@ class WaveformView : public juce::Component {
     /** @brief Standard JUCE paint callback, utilizing the cached waveform image. */
     void paint(juce::Graphics &g) override;
 
+    /** @brief Re-renders the cached image at the new size; the old one is stretched meanwhile. */
+    void resized() override;
+
     /** 
      * @brief Updates the view's internal state and marks the cache as dirty. 
      * @param newState The new visual state to apply.
@@ -66,16 +75,45 @@ class WaveformView : public juce::Component {
     void clearCaches();
 
   private:
+    /**
+     * @brief Queues a render of the cached image for the current state and size.
+     * @param fullRedraw True if the existing image no longer matches the state; otherwise
+     *                   only the columns finished since its last render are drawn.
+     */
+    void requestRender(bool fullRedraw);
+
     /** 
-     * @brief Internal helper to draw the waveform data into the graphics context. 
-     * @param g The graphics context to draw into.
+     * @brief Internal helper to bring a frame up to date with a snapshot of the state. 
+     * @details Runs on the render thread. Queries the columns in one PeakMipmap::getColumns()
+     *          call and writes them with WaveformRasterizer.
      */
-    void drawWaveform(juce::Graphics &g);
+    void renderFrame(WaveformRenderer::Frame &frame, const WaveformViewState &snapshot,
+                     const WaveformRasterizer::Palette &palette, juce::int64 layout);
+
+    /** @return The width of one waveform column in pixels. */
+    static int getColumnWidth();
+
+    /** @return The number of columns spanning a width, the last one possibly clipped. */
+    static int getNumColumns(int width);
+
+    /** @return The number of samples one column covers at a width. */
+    static double getSamplesPerColumn(const WaveformViewState &snapshot, int width);
+
+    /** @return The columns whose spans overlap the given sample range. */
+    static juce::Range<int> getColumnsBetween(const WaveformViewState &snapshot, int width,
+                                              juce::int64 startSample, juce::int64 endSample);
 
     WaveformViewState state;
-    juce::Image cachedWaveform;
-    bool isCacheDirty{true};
-    int loadingTickCounter{0};
+    /** @brief Bumped whenever the cached image must be redrawn from scratch. */
+    juce::int64 layoutGeneration{0};
+    /** @brief The loading front of the last requested render. */
+    juce::int64 requestedSamples{0};
+    /** @brief The mipmap's reset count when the state was last pushed. */
+    juce::uint32 lastResetCount{0};
+    /** @brief Column scratch space; touched on the render thread only. */
+    std::vector<float> columnMinima, columnMaxima;
+    /** @brief Declared last so its thread stops before the members it renders from go. */
+    WaveformRenderer renderer{*this};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformView)
 };
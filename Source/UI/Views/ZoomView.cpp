@@ -3,6 +3,7 @@
 #include "UI/Views/ZoomView.h"
 #include "UI/ControlPanel.h"
 #include "UI/Views/PlaybackCursorGlow.h"
+#include "UI/Views/WaveformRasterizer.h"
 #include "Utils/Config.h"
 
 ZoomView::ZoomView(ControlPanel &ownerIn) : owner(ownerIn) {
@@ -65,42 +66,17 @@ void ZoomView::drawZoomPopup(juce::Graphics& g) {
     if (!state.isZooming || state.thumbnail == nullptr) return;
 
     const juce::Rectangle<int> popupBounds = state.popupBounds;
-    const double startTime = state.startTime;
-    const double endTime = state.endTime;
 
-    if (isCacheDirty || waveformCache.isNull() || 
-        waveformCache.getWidth() != popupBounds.getWidth() || 
-        waveformCache.getHeight() != popupBounds.getHeight()) 
-    {
-        waveformCache = juce::Image(juce::Image::ARGB, popupBounds.getWidth(), popupBounds.getHeight(), true);
-        juce::Graphics imgG(waveformCache);
-
-        imgG.setColour(Config::Colors::solidBlack);
-        imgG.fillAll();
-
-        juce::ColourGradient gradient(Config::Colors::waveformPeak, 0, 0,
-                                      Config::Colors::waveformPeak, 0, (float)popupBounds.getHeight(), false);
-        gradient.addColour(0.5, Config::Colors::waveformCore);
-        imgG.setGradientFill(gradient);
-
-        auto localBounds = waveformCache.getBounds();
-        if (state.channelMode == AppEnums::ChannelViewMode::Mono || state.numChannels == 1) {
-            state.thumbnail->drawChannel(imgG, localBounds, startTime, endTime, 0, 1.0f);
-            imgG.setColour(Config::Colors::zoomPopupZeroLine);
-            imgG.drawHorizontalLine(localBounds.getCentreY(), 0.0f, (float)localBounds.getWidth());
-        } else {
-            auto topBounds = localBounds.withHeight(localBounds.getHeight() / 2);
-            auto bottomBounds = localBounds.withTop(topBounds.getBottom()).withHeight(localBounds.getHeight() / 2);
-            state.thumbnail->drawChannel(imgG, topBounds, startTime, endTime, 0, 1.0f);
-            state.thumbnail->drawChannel(imgG, bottomBounds, startTime, endTime, 1, 1.0f);
-            imgG.setColour(Config::Colors::zoomPopupZeroLine);
-            imgG.drawHorizontalLine(topBounds.getCentreY(), 0.0f, (float)topBounds.getWidth());
-            imgG.drawHorizontalLine(bottomBounds.getCentreY(), 0.0f, (float)bottomBounds.getWidth());
-        }
+    // The popup waveform is rendered off the Message Thread; until a fresh frame arrives
+    // the previous one is shown, stretched to the new bounds.
+    if (isCacheDirty) {
+        requestPopupRender();
         isCacheDirty = false;
     }
-
-    g.drawImageAt(waveformCache, popupBounds.getX(), popupBounds.getY());
+    if (!renderer.drawFrame(g, popupBounds)) {
+        g.setColour(Config::Colors::solidBlack);
+        g.fillRect(popupBounds);
+    }
 
     auto drawShadow = [&](float x1, float x2, juce::Colour color) {
         if (x1 >= x2) return;
@@ -146,6 +122,58 @@ void ZoomView::drawZoomPopup(juce::Graphics& g) {
     g.drawRect(popupBounds.toFloat(), Config::Layout::Zoom::borderThickness);
 }
 
+void ZoomView::requestPopupRender() {
+    // Colours are captured here, as a theme change may rewrite them during a render.
+    renderer.request(state.popupBounds.getWidth(), state.popupBounds.getHeight(),
+                     [this, snapshot = state, palette = WaveformRasterizer::Palette(),
+                      zeroLine = Config::Colors::zoomPopupZeroLine](auto &frame) {
+                         renderPopup(frame, snapshot, palette, zeroLine);
+                     });
+}
+
+void ZoomView::renderPopup(WaveformRenderer::Frame &frame, const ZoomViewState &snapshot,
+                           const WaveformRasterizer::Palette &palette,
+                           juce::Colour zeroLineColour) {
+    auto &image = frame.image;
+    const auto bounds = image.getBounds();
+    const int width = bounds.getWidth();
+    const bool isMono = snapshot.channelMode == AppEnums::ChannelViewMode::Mono ||
+                        snapshot.numChannels == 1;
+    const int numChannelsToDraw = isMono ? 1 : 2;
+
+    columnMinima.resize((size_t)(width * numChannelsToDraw));
+    columnMaxima.resize(columnMinima.size());
+    std::vector<float *> minima, maxima;
+    for (int channel = 0; channel < numChannelsToDraw; ++channel) {
+        minima.push_back(columnMinima.data() + channel * width);
+        maxima.push_back(columnMaxima.data() + channel * width);
+    }
+
+    {
+        const juce::ScopedReadLock lock(snapshot.thumbnail->getResetLock());
+        const double sampleRate = snapshot.thumbnail->getSampleRate();
+        // The zoomed span may reach past either end of the file; those columns come back silent.
+        snapshot.thumbnail->getColumns(snapshot.startTime * sampleRate,
+                                       snapshot.endTime * sampleRate, width, 0,
+                                       numChannelsToDraw, minima.data(), maxima.data());
+    }
+
+    juce::Array<int> zeroLines;
+    for (int channel = 0; channel < numChannelsToDraw; ++channel) {
+        const int top = bounds.getHeight() * channel / numChannelsToDraw;
+        const int bottom = bounds.getHeight() * (channel + 1) / numChannelsToDraw;
+        const auto band = bounds.withTop(top).withBottom(bottom);
+        WaveformRasterizer::drawColumns(image, band, minima[(size_t)channel],
+                                        maxima[(size_t)channel], width, 1, palette);
+        zeroLines.add(band.getCentreY());
+    }
+
+    juce::Graphics imgG(image);
+    imgG.setColour(zeroLineColour);
+    for (const int y : zeroLines)
+        imgG.drawHorizontalLine(y, 0.0f, (float)width);
+}
+
 void ZoomView::drawHud(juce::Graphics& g) {
     if (state.hudLines.empty()) return;
 
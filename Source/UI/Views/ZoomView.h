@@ -9,6 +9,11 @@
 
 #include "Core/AppEnums.h"
 #include "Presenters/PlaybackTimerManager.h"
+#include "UI/Views/WaveformRasterizer.h"
+#include "UI/Views/WaveformRenderer.h"
+#include "Workers/PeakMipmap.h"
+
+#include <vector>
 
 /**
  * @file ZoomView.h
@@ -87,8 +92,8 @@ struct ZoomViewState {
     bool isDraggingCutOut{false};
     /** @brief The precise time in seconds under the mouse cursor. */
     double mouseTime{0.0};
-    /** @brief Pointer to the audio thumbnail used for high-detail rendering. */
-    juce::AudioThumbnail* thumbnail{nullptr};
+    /** @brief Pointer to the waveform data used for high-detail rendering. */
+    const PeakMipmap* thumbnail{nullptr};
     /** @brief The collection of lines to render in the status HUD. */
     std::vector<ZoomHudLine> hudLines;
 
@@ -193,13 +198,24 @@ class ZoomView : public juce::Component {
     void drawMouseCursor(juce::Graphics& g);
     /** @brief Renders the high-detail zoom preview window. */
     void drawZoomPopup(juce::Graphics& g);
+    /** @brief Queues a render of the popup waveform for the current state. */
+    void requestPopupRender();
+    /**
+     * @brief Renders the zoomed span of a state snapshot into a frame, one band per channel.
+     * @details Runs on the render thread.
+     */
+    void renderPopup(WaveformRenderer::Frame &frame, const ZoomViewState &snapshot,
+                     const WaveformRasterizer::Palette &palette, juce::Colour zeroLineColour);
     /** @brief Renders the status and metadata HUD overlay. */
     void drawHud(juce::Graphics& g);
 
     ControlPanel &owner;
     ZoomViewState state;
-    juce::Image waveformCache;
+    /** @brief Column scratch space; touched on the render thread only. */
+    std::vector<float> columnMinima, columnMaxima;
     bool isCacheDirty{true};
+    /** @brief Declared last so its thread stops before the members it renders from go. */
+    WaveformRenderer renderer{*this};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ZoomView)
 };
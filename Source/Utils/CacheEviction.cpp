@@ -0,0 +1,35 @@
+#include "Utils/CacheEviction.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+juce::int64 CacheEviction::trimToSize(const juce::File &directory,
+                                      std::initializer_list<const char *> extensions,
+                                      juce::int64 maxBytes) {
+    std::vector<std::pair<juce::int64, juce::File>> byAge;
+    juce::int64 total = 0;
+    for (const char *extension : extensions) {
+        const juce::String pattern = juce::String("*") + extension;
+        for (const auto &file : directory.findChildFiles(juce::File::findFiles, false, pattern)) {
+            byAge.emplace_back(file.getLastModificationTime().toMilliseconds(), file);
+            total += file.getSize();
+        }
+    }
+    std::sort(byAge.begin(), byAge.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    juce::int64 freed = 0;
+    for (const auto &entry : byAge) {
+        if (total - freed <= maxBytes)
+            break;
+        const juce::int64 size = entry.second.getSize();
+        if (entry.second.deleteFile())
+            freed += size;
+    }
+    return freed;
+}
+
+void CacheEviction::touch(const juce::File &file) {
+    file.setLastModificationTime(juce::Time::getCurrentTime());
+}
@@ -0,0 +1,47 @@
+#ifndef AUDIOFILER_CACHEEVICTION_H
+#define AUDIOFILER_CACHEEVICTION_H
+
+#include <juce_core/juce_core.h>
+
+#include <initializer_list>
+
+/**
+ * @file CacheEviction.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup Helpers
+ * @brief Least-recently-used trimming of an on-disk cache folder.
+ *
+ * @details Architecturally, CacheEviction is a "Functional Utility" shared by the persistent
+ *          caches (EnvelopeStore, WaveformCache). Each cache refreshes an entry's
+ *          modification time when it is used, which makes the time its recency, so the
+ *          least recently used order survives restarts without an index file.
+ *
+ *          All methods are stateless and safe to call from background workers.
+ *
+ * @see EnvelopeStore
+ * @see WaveformCache
+ */
+class CacheEviction {
+  public:
+    /**
+     * @brief Deletes the least recently used cache files until the folder fits a size cap.
+     * @details Files that cannot be deleted (a mapping still open on Windows) are skipped
+     *          and still counted, so the next trim tries them again.
+     * @param directory The cache folder.
+     * @param extensions The extensions of the cache files, e.g. ".peaks"; others are left
+     *                   alone and not counted.
+     * @param maxBytes The total size to trim the cache files to.
+     * @return The number of bytes freed.
+     */
+    static juce::int64 trimToSize(const juce::File &directory,
+                                  std::initializer_list<const char *> extensions,
+                                  juce::int64 maxBytes);
+
+    /**
+     * @brief Marks a cache file as just used.
+     * @param file The cache file.
+     */
+    static void touch(const juce::File &file);
+};
+
+#endif
@@ -50,6 +50,7 @@ juce::Colour mouseAmplitudeLine = juce::Colours::orange.brighter(0.5f);
 juce::Colour mousePlacementMode = juce::Colours::deeppink;
 juce::Colour thresholdLine = juce::Colour(0xffe600e6);
 juce::Colour thresholdRegion = juce::Colours::red;
+juce::Colour silenceGap = juce::Colours::deepskyblue.withAlpha(0.3f);
 juce::Colour statsBackground = juce::Colours::black;
 juce::Colour statsText = juce::Colour(0xFF34FA11);
 juce::Colour statsErrorText = juce::Colours::red;
@@ -109,6 +110,9 @@ juce::String clearButton = "X";
 juce::String autoplayButton = "[A]utoPlay";
 juce::String autoCutInButton = "[AC In]";
 juce::String autoCutOutButton = "[AC Out]";
+juce::String filterOffButton = "[Flat]";
+juce::String filterHighPassButton = "[HP]";
+juce::String filterBandLimitButton = "[Band]";
 juce::String cutButton = "[Cut]";
 juce::String themeUp = juce::CharPointer_UTF8("\xe2\x96\xb4");
 juce::String themeDown = juce::CharPointer_UTF8("\xe2\x96\xbe");
@@ -131,7 +135,52 @@ juce::String statsPeak0 = "Approx Peak (Ch 0): ";
 juce::String statsPeak1 = "Approx Peak (Ch 1): ";
 juce::String statsMin = "Min: ";
 juce::String statsMax = ", Max: ";
+juce::String statsLevelPrefix = "Peak (Ch ";
+juce::String statsLevelSuffix = "): ";
+juce::String statsRms = "RMS: ";
+juce::String statsDcOffset = ", DC: ";
+juce::String statsClips = ", Clipped: ";
 juce::String statsError = "No file loaded or error reading audio.";
+juce::String statsIoThrottle = "Analysis Throttle: ";
+juce::String statsIoThroughput = "Analysis Throughput: ";
+juce::String statsIoThroughputUnit = " Msamples/s";
+juce::String statsAnalysisProgress = "Analysis: ";
+juce::String statsAnalysisIdle = "Idle";
+juce::String statsAnalysisHistory = "Recent Analysis Jobs:";
+juce::String statsAnalysisCancelled = " (cancelled)";
+juce::String analysisProgressPercent = "% | ";
+juce::String analysisProgressRate = " MB/s";
+juce::String analysisProgressEta = " | ETA ";
+juce::String analysisProgressSeconds = " s";
+juce::String analysisRecordMegabytes = " MB in ";
+juce::String analysisRecordSeconds = " s, ";
+juce::String analysisRecordRateUnit = " MB/s";
+juce::String analysisKindIn = "In";
+juce::String analysisKindOut = "Out";
+juce::String analysisKindInOut = "In+Out";
+juce::String analysisKindGaps = "Gaps";
+juce::String analysisKindEnvelope = "Envelope";
+juce::String ioLevelUnthrottled = "Off";
+juce::String ioLevelLight = "Light";
+juce::String ioLevelModerate = "Moderate";
+juce::String ioLevelHeavy = "Heavy";
+juce::String detectionModeInPrefix = "Auto-Cut In detection: ";
+juce::String detectionModeOutPrefix = "Auto-Cut Out detection: ";
+juce::String detectionModePeak = "Peak";
+juce::String detectionModeRms = "RMS window";
+juce::String detectionModePeakHold = "Peak hold";
+juce::String filterModeInPrefix = "Auto-Cut In filter: ";
+juce::String filterModeOutPrefix = "Auto-Cut Out filter: ";
+juce::String filterModeOff = "Off (full band)";
+juce::String filterModeHighPass = "High-pass (ignores rumble and hum)";
+juce::String filterModeBandLimit = "Band limit (ignores rumble, hum and hiss)";
+juce::String gapJumpPrefix = "Gap ";
+juce::String gapJumpOf = " of ";
+juce::String noSilenceGaps = "No silence gaps in this direction";
+juce::String autoThresholdPrefix = "Auto Threshold: ";
+juce::String autoThresholdOff = "Off";
+juce::String autoThresholdPending = "On, after analysis";
+juce::String autoThresholdPercent = "%";
 juce::String logNoAudio = "No audio loaded to detect silence.";
 juce::String logScanning = "SilenceDetector: Scanning ";
 juce::String logSamplesFor = " samples for ";
@@ -145,6 +194,7 @@ juce::String errorZeroLength = "Error: Audio file has zero length.";
 juce::String errorNoAudio = "No audio loaded.";
 juce::String scanningCutPoints = "Scanning for Cut Points...";
 juce::String noSilenceBoundaries = "No Silence Boundaries detected.";
+juce::String analysisQueueFull = "Analysis queue is full; request skipped.";
 juce::String hintViewPrefix = "View: ";
 juce::String hintViewClassic = "Classic";
 juce::String hintViewOverlay = "Overlay";
@@ -377,6 +427,9 @@ void initializeConfigs() {
         setStr("labelAutoplayButton", Labels::autoplayButton);
         setStr("labelAutoCutInButton", Labels::autoCutInButton);
         setStr("labelAutoCutOutButton", Labels::autoCutOutButton);
+        setStr("labelFilterOffButton", Labels::filterOffButton);
+        setStr("labelFilterHighPassButton", Labels::filterHighPassButton);
+        setStr("labelFilterBandLimitButton", Labels::filterBandLimitButton);
         setStr("labelCutButton", Labels::cutButton);
 
         setBool("showFpsOverlay", Advanced::showFpsOverlay);
@@ -65,6 +65,10 @@ namespace UI {
     inline constexpr float ResetButtonWidthUnits = 1.5f;
     /** @brief Width for Threshold editors in units. */
     inline constexpr float ThresholdWidthUnits = 1.5f;
+    /** @brief Width for the Auto-Cut pre-filter buttons in units. */
+    inline constexpr float FilterButtonWidthUnits = 2.0f;
+    /** @brief Vertical drag distance in pixels per 1% Threshold step. */
+    inline constexpr float ThresholdDragPixelsPerStep = 4.0f;
     /** @brief The base unit for widgets (all dimensions are multiples of this). */
     inline constexpr float WidgetUnit = 32.0f;
     /** @brief The standard height for widgets. */
@@ -123,6 +127,7 @@ namespace Colors {
     extern juce::Colour mousePlacementMode;  /**< Visual cue for active placement state. */
     extern juce::Colour thresholdLine;       /**< Silence threshold indicator. */
     extern juce::Colour thresholdRegion;     /**< Shaded area for the silence zone. */
+    extern juce::Colour silenceGap;          /**< Shaded overlay for internal silent gaps. */
     extern juce::Colour statsBackground;     /**< Backdrop for the metadata panel. */
     extern juce::Colour statsText;           /**< Text in the metadata panel. */
     extern juce::Colour statsErrorText;      /**< Error text in the metadata panel. */
@@ -293,8 +298,6 @@ namespace Animation {
 
 /** @brief Default technical parameters for the audio engine. */
 namespace Audio {
-    constexpr int thumbnailCacheSize = 5;
-    constexpr int thumbnailSizePixels = 512;
     static constexpr double fallbackSampleRate = 44100.0;
     constexpr double keyboardSkipSeconds = 5.0;
     constexpr double cutStepHours = 3600.0;
@@ -306,6 +309,59 @@ namespace Audio {
     constexpr float silenceThresholdIn = 0.01f;
     constexpr float silenceThresholdOut = 0.01f;
     constexpr bool lockHandlesWhenAutoCutActive = false;
+    constexpr int parallelScanMaxThreads = 8;          /**< Upper bound for the segmented scan pool. */
+    constexpr int parallelScanSegmentsPerThread = 4;   /**< Over-decomposition for load balancing. */
+    constexpr juce::int64 parallelScanMinSamples = 1 << 20; /**< Shorter files scan sequentially. */
+    constexpr const char *peakCacheFolder = ".config/audiofiler/peaks"; /**< Relative to the home dir. */
+    constexpr const char *peakCacheExtension = ".peaks";
+    constexpr int peakCacheMemoryEntries = 8;          /**< Pyramids kept in RAM (LRU). */
+    constexpr int peakCacheIoBufferBytes = 1 << 16;
+    constexpr juce::int64 peakCacheMaxBytes = (juce::int64)256 << 20; /**< Disk cap of the envelope cache (LRU). */
+    constexpr const char *cutCurveCacheExtension = ".curves";
+    constexpr int cutCurveMaxBreakpoints = 1 << 16;    /**< Per direction; ~768 KB per file at most. */
+    constexpr const char *noiseFloorCacheExtension = ".noise";
+    constexpr double noiseFloorBlockSeconds = 0.01;    /**< Span of one block peak in the level histogram. */
+    constexpr float noiseFloorMinDb = -96.0f;          /**< Quieter block peaks share the lowest bin. */
+    constexpr float noiseFloorBinDb = 0.5f;            /**< Resolution of the level histogram. */
+    constexpr double noiseFloorPercentile = 0.1;       /**< Share of blocks taken to be noise. */
+    constexpr float noiseFloorMarginDb = 6.0f;         /**< Auto Threshold headroom over the noise floor. */
+    constexpr const char *levelStatsCacheExtension = ".levels";
+    constexpr float levelStatsClipLevel = 0.9999f;     /**< Sample magnitude counted as clipped (16-bit full scale). */
+    constexpr const char *waveformCacheFolder = ".config/audiofiler/waveforms"; /**< Relative to the home dir. */
+    constexpr const char *waveformCacheExtension = ".wave";
+    constexpr juce::int64 waveformCacheMaxBytes = (juce::int64)1 << 30; /**< ~70 channel-hours of waveform. */
+    constexpr int waveformBuildStopWaitMs = 10;        /**< Longest wait for a superseded build; then retried. */
+    constexpr double autoCutOutTailSeconds = 0.05;     /**< Release kept after the last loud sample. */
+    constexpr int analysisWorkerThreads = 2;           /**< Concurrent analysis passes (files/directions). */
+    constexpr int analysisQueueCapacity = 32;          /**< Pending analysis requests before eviction. */
+    constexpr float playbackLoadSmoothing = 0.1f;      /**< EMA weight of the newest callback load. */
+    constexpr float ioGovernorLightLoad = 0.5f;        /**< Callback load that starts light throttling. */
+    constexpr float ioGovernorModerateLoad = 0.7f;
+    constexpr float ioGovernorHeavyLoad = 0.85f;
+    constexpr float ioGovernorLightFill = 0.75f;       /**< Read-ahead fill below which analysis yields. */
+    constexpr float ioGovernorModerateFill = 0.5f;
+    constexpr float ioGovernorHeavyFill = 0.25f;
+    constexpr int ioGovernorLightYieldMs = 1;          /**< Per-chunk yield at each throttle level. */
+    constexpr int ioGovernorModerateYieldMs = 4;
+    constexpr int ioGovernorHeavyYieldMs = 16;
+    constexpr int ioStatsRefreshMs = 1000;             /**< Throughput window of the stats overlay. */
+    constexpr double reanalysisDebounceMs = 150.0;     /**< Quiet time after a Threshold edit before it is rescanned. */
+    constexpr int analysisTimingHistory = 16;          /**< Finished jobs listed in the stats overlay. */
+    constexpr int readerPoolMaxIdle = 8;               /**< Idle analysis readers kept for reuse. */
+    constexpr int readerPoolMaxOpen = 24;              /**< Readers the pool keeps open, leased or idle. */
+    constexpr int boundaryHistoryFiles = 32;           /**< Files whose recent Peak boundaries are remembered. */
+    constexpr int boundaryHistoryRecords = 8;          /**< Thresholds remembered per file and direction. */
+    constexpr double rmsWindowSeconds = 0.01;          /**< Sliding window of the Rms detection mode. */
+    constexpr double peakHoldSeconds = 0.02;           /**< Longest gap that keeps a PeakHold run alive. */
+    constexpr double peakHoldMinSeconds = 0.05;        /**< Run length PeakHold needs before it cuts. */
+    constexpr double preFilterHighPassHz = 100.0;      /**< Corner below which the scan pre-filter ignores rumble. */
+    constexpr double preFilterLowPassHz = 8000.0;      /**< Corner above which the band-limited pre-filter ignores hiss. */
+    constexpr double preFilterWarmupSeconds = 0.05;    /**< Pre-roll that settles the pre-filter at the file's edge. */
+    constexpr double gapMinSeconds = 0.5;              /**< Shortest internal silence listed as a gap. */
+    constexpr int gapMapMaxGaps = 1 << 17;             /**< Per file; 3 MB at most. */
+    constexpr juce::int64 compressedTailFirstSamples = 1 << 20; /**< First tail window of a compressed Out scan. */
+    constexpr juce::int64 mappedWindowBytes =
+        (juce::int64)1 << (sizeof(void *) >= 8 ? 30 : 26); /**< Address space per mapped-reader window. */
 } // namespace Audio
 
 /** @brief User preferences and experimental features. */
@@ -345,6 +401,9 @@ namespace Labels {
     extern juce::String autoplayButton;
     extern juce::String autoCutInButton;
     extern juce::String autoCutOutButton;
+    extern juce::String filterOffButton;
+    extern juce::String filterHighPassButton;
+    extern juce::String filterBandLimitButton;
     extern juce::String cutButton;
     extern juce::String themeUp;
     extern juce::String themeDown;
@@ -367,7 +426,52 @@ namespace Labels {
     extern juce::String statsPeak1;
     extern juce::String statsMin;
     extern juce::String statsMax;
+    extern juce::String statsLevelPrefix;
+    extern juce::String statsLevelSuffix;
+    extern juce::String statsRms;
+    extern juce::String statsDcOffset;
+    extern juce::String statsClips;
     extern juce::String statsError;
+    extern juce::String statsIoThrottle;
+    extern juce::String statsIoThroughput;
+    extern juce::String statsIoThroughputUnit;
+    extern juce::String statsAnalysisProgress;
+    extern juce::String statsAnalysisIdle;
+    extern juce::String statsAnalysisHistory;
+    extern juce::String statsAnalysisCancelled;
+    extern juce::String analysisProgressPercent;
+    extern juce::String analysisProgressRate;
+    extern juce::String analysisProgressEta;
+    extern juce::String analysisProgressSeconds;
+    extern juce::String analysisRecordMegabytes;
+    extern juce::String analysisRecordSeconds;
+    extern juce::String analysisRecordRateUnit;
+    extern juce::String analysisKindIn;
+    extern juce::String analysisKindOut;
+    extern juce::String analysisKindInOut;
+    extern juce::String analysisKindGaps;
+    extern juce::String analysisKindEnvelope;
+    extern juce::String ioLevelUnthrottled;
+    extern juce::String ioLevelLight;
+    extern juce::String ioLevelModerate;
+    extern juce::String ioLevelHeavy;
+    extern juce::String detectionModeInPrefix;
+    extern juce::String detectionModeOutPrefix;
+    extern juce::String detectionModePeak;
+    extern juce::String detectionModeRms;
+    extern juce::String detectionModePeakHold;
+    extern juce::String filterModeInPrefix;
+    extern juce::String filterModeOutPrefix;
+    extern juce::String filterModeOff;
+    extern juce::String filterModeHighPass;
+    extern juce::String filterModeBandLimit;
+    extern juce::String gapJumpPrefix;
+    extern juce::String gapJumpOf;
+    extern juce::String noSilenceGaps;
+    extern juce::String autoThresholdPrefix;
+    extern juce::String autoThresholdOff;
+    extern juce::String autoThresholdPending;
+    extern juce::String autoThresholdPercent;
     extern juce::String logNoAudio;
     extern juce::String logScanning;
     extern juce::String logSamplesFor;
@@ -381,6 +485,7 @@ namespace Labels {
     extern juce::String errorNoAudio;
     extern juce::String scanningCutPoints;
     extern juce::String noSilenceBoundaries;
+    extern juce::String analysisQueueFull;
     extern juce::String hintViewPrefix;
     extern juce::String hintViewClassic;
     extern juce::String hintViewOverlay;
@@ -0,0 +1,54 @@
+#include "Utils/FileIdentity.h"
+
+namespace {
+/** @brief Bytes sampled from each end of the file. */
+constexpr int kSampleBytes = 65536;
+
+/**
+ * @brief Two independent 64-bit FNV-1a lanes, giving a 128-bit fingerprint.
+ */
+struct Fnv128 {
+    juce::uint64 a = 0xcbf29ce484222325ull;
+    juce::uint64 b = 0x84222325cbf29ce4ull;
+
+    void add(const void *data, size_t numBytes) {
+        const auto *bytes = static_cast<const juce::uint8 *>(data);
+        for (size_t i = 0; i < numBytes; ++i) {
+            a = (a ^ bytes[i]) * 0x100000001b3ull;
+            b = (b ^ (juce::uint8)(bytes[i] + 0x5b)) * 0x100000001b3ull;
+        }
+    }
+
+    void add(juce::int64 value) {
+        add(&value, sizeof(value));
+    }
+
+    juce::String toString() const {
+        return juce::String::toHexString((juce::int64)a).paddedLeft('0', 16) +
+               juce::String::toHexString((juce::int64)b).paddedLeft('0', 16);
+    }
+};
+} // namespace
+
+juce::String FileIdentity::computeHash(const juce::File &file) {
+    juce::FileInputStream input(file);
+    if (!input.openedOk())
+        return {};
+
+    Fnv128 hash;
+    const juce::int64 size = input.getTotalLength();
+    hash.add(size);
+    hash.add(file.getLastModificationTime().toMilliseconds());
+
+    juce::HeapBlock<char> block((size_t)kSampleBytes);
+    const int headBytes = input.read(block.get(), kSampleBytes);
+    hash.add(block.get(), (size_t)juce::jmax(0, headBytes));
+
+    if (size > kSampleBytes && input.setPosition(juce::jmax((juce::int64)kSampleBytes,
+                                                            size - kSampleBytes))) {
+        const int tailBytes = input.read(block.get(), kSampleBytes);
+        hash.add(block.get(), (size_t)juce::jmax(0, tailBytes));
+    }
+
+    return hash.toString();
+}
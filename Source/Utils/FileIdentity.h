@@ -0,0 +1,35 @@
+#ifndef AUDIOFILER_FILEIDENTITY_H
+#define AUDIOFILER_FILEIDENTITY_H
+
+#include <juce_core/juce_core.h>
+
+/**
+ * @file FileIdentity.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup Helpers
+ * @brief Cheap, stable fingerprint of an audio file used as a cache key.
+ *
+ * @details Architecturally, FileIdentity is a "Functional Utility" that fills
+ *          `FileMetadata::hash`. Hashing a multi-gigabyte recording end to end would cost
+ *          as much as the analysis it is meant to cache, so the fingerprint covers the
+ *          file size, its modification time and the first and last 64 KB of content.
+ *          Header rewrites, truncation, appends and re-encodes all change at least one
+ *          of these, which is what the persistent analysis caches need to detect.
+ *
+ *          All methods are stateless and safe to call from background workers.
+ *
+ * @see FileMetadata
+ * @see EnvelopeStore
+ */
+class FileIdentity {
+  public:
+    /**
+     * @brief Computes the fingerprint of a file.
+     * @param file The file to fingerprint.
+     * @return A 32-character lowercase hex string, or an empty string if the file
+     *         cannot be opened.
+     */
+    static juce::String computeHash(const juce::File &file);
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include "Workers/AnalysisJobQueue.h"
+
+#include <algorithm>
+
+AnalysisJobQueue::AnalysisJobQueue(int maxPending) : capacity(std::max(1, maxPending)) {
+}
+
+juce::uint64 AnalysisJobQueue::assignGeneration(const Request &request) {
+    const auto generation = nextGeneration++;
+    latest[keyOf(request)] = generation;
+    return generation;
+}
+
+bool AnalysisJobQueue::hasPending(const Key &key) const {
+    return std::any_of(pending.begin(), pending.end(),
+                       [&key](const Pending &p) { return keyOf(p.request) == key; });
+}
+
+/**
+ * @details A key has at most one pending entry, so superseding rewrites that entry in
+ *          place (it keeps its queue position, but gains a new generation) rather than
+ *          appending a second one. Superseding a running ticket only raises its cancel
+ *          flag; the runner notices at its next chunk and isCurrent() discards whatever
+ *          it still delivers.
+ */
+AnalysisJobQueue::Admission AnalysisJobQueue::push(const Request &request) {
+    const juce::ScopedLock sl(lock);
+    const auto key = keyOf(request);
+
+    const auto queued = std::find_if(pending.begin(), pending.end(),
+                                     [&key](const Pending &p) { return keyOf(p.request) == key; });
+    if (queued != pending.end()) {
+        const auto priority = std::max(queued->request.priority, request.priority);
+        if (asksSame(queued->request, request)) {
+            queued->request.priority = priority;
+            return Admission::Duplicate;
+        }
+        queued->request = request;
+        queued->request.priority = priority;
+        queued->generation = assignGeneration(request);
+        return Admission::Superseded;
+    }
+
+    bool superseded = false;
+    for (auto &ticket : running) {
+        if (keyOf(ticket.request) != key || ticket.cancelled->load())
+            continue;
+        const auto current = latest.find(key);
+        if (asksSame(ticket.request, request) && current != latest.end() &&
+            current->second == ticket.generation)
+            return Admission::Duplicate;
+        ticket.cancelled->store(true);
+        superseded = true;
+    }
+
+    if ((int)pending.size() >= capacity) {
+        const auto victim = std::min_element(
+            pending.begin(), pending.end(), [](const Pending &a, const Pending &b) {
+                return a.request.priority != b.request.priority
+                           ? a.request.priority < b.request.priority
+                           : a.generation < b.generation;
+            });
+        if (victim->request.priority > request.priority)
+            return Admission::Rejected;
+        latest.erase(keyOf(victim->request));
+        pending.erase(victim);
+    }
+
+    pending.push_back({request, assignGeneration(request)});
+    return superseded ? Admission::Superseded : Admission::Queued;
+}
+
+std::optional<AnalysisJobQueue::Ticket> AnalysisJobQueue::pop() {
+    const juce::ScopedLock sl(lock);
+    if (pending.empty())
+        return std::nullopt;
+
+    const auto next = std::max_element(
+        pending.begin(), pending.end(), [](const Pending &a, const Pending &b) {
+            return a.request.priority != b.request.priority
+                       ? a.request.priority < b.request.priority
+                       : a.generation > b.generation;
+        });
+
+    Ticket ticket{next->request, next->generation, std::make_shared<std::atomic<bool>>(false)};
+    pending.erase(next);
+    running.push_back(ticket);
+    return ticket;
+}
+
+std::optional<AnalysisJobQueue::Ticket> AnalysisJobQueue::popCompanion(const Ticket &ticket) {
+    const juce::ScopedLock sl(lock);
+    const Key companion{ticket.request.filePath, !ticket.request.detectingIn};
+    const auto next = std::find_if(pending.begin(), pending.end(), [&companion](const Pending &p) {
+        return keyOf(p.request) == companion;
+    });
+    if (next == pending.end())
+        return std::nullopt;
+
+    Ticket result{next->request, next->generation, std::make_shared<std::atomic<bool>>(false)};
+    pending.erase(next);
+    running.push_back(result);
+    return result;
+}
+
+bool AnalysisJobQueue::isCurrent(const Ticket &ticket) const {
+    const juce::ScopedLock sl(lock);
+    if (ticket.cancelled == nullptr || ticket.cancelled->load())
+        return false;
+    const auto it = latest.find(keyOf(ticket.request));
+    return it != latest.end() && it->second == ticket.generation;
+}
+
+void AnalysisJobQueue::finish(const Ticket &ticket) {
+    const juce::ScopedLock sl(lock);
+    running.erase(std::remove_if(running.begin(), running.end(),
+                                 [&ticket](const Ticket &t) {
+                                     return t.generation == ticket.generation;
+                                 }),
+                  running.end());
+
+    const auto key = keyOf(ticket.request);
+    const auto it = latest.find(key);
+    if (it != latest.end() && it->second == ticket.generation && !hasPending(key))
+        latest.erase(it);
+}
+
+void AnalysisJobQueue::cancel(const juce::String &filePath, bool detectingIn) {
+    const juce::ScopedLock sl(lock);
+    const Key key{filePath, detectingIn};
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [&key](const Pending &p) { return keyOf(p.request) == key; }),
+                  pending.end());
+    latest.erase(key);
+    for (auto &ticket : running)
+        if (keyOf(ticket.request) == key)
+            ticket.cancelled->store(true);
+}
+
+void AnalysisJobQueue::cancelAll() {
+    const juce::ScopedLock sl(lock);
+    pending.clear();
+    latest.clear();
+    for (auto &ticket : running)
+        ticket.cancelled->store(true);
+}
+
+bool AnalysisJobQueue::isIdle() const {
+    const juce::ScopedLock sl(lock);
+    return pending.empty() && running.empty();
+}
+
+bool AnalysisJobQueue::isActive(bool detectingIn) const {
+    const juce::ScopedLock sl(lock);
+    const bool anyPending =
+        std::any_of(pending.begin(), pending.end(), [detectingIn](const Pending &p) {
+            return p.request.detectingIn == detectingIn;
+        });
+    return anyPending ||
+           std::any_of(running.begin(), running.end(), [detectingIn](const Ticket &t) {
+               return t.request.detectingIn == detectingIn && !t.cancelled->load();
+           });
+}
+
+int AnalysisJobQueue::getNumPending() const {
+    const juce::ScopedLock sl(lock);
+    return (int)pending.size();
+}
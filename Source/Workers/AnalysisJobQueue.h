@@ -0,0 +1,163 @@
+#ifndef AUDIOFILER_ANALYSISJOBQUEUE_H
+#define AUDIOFILER_ANALYSISJOBQUEUE_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "MainDomain.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @file AnalysisJobQueue.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Thread-safe, bounded priority queue of silence analysis requests.
+ *
+ * @details Architecturally, AnalysisJobQueue is the scheduling brick behind
+ *          SilenceAnalysisWorker. It holds no threads itself; the worker's pool runners
+ *          pop requests from it and report back when a result has been delivered.
+ *
+ *          Requests are keyed by file and direction. The queue enforces three rules:
+ *          - **De-duplication**: an identical request that is already pending or running
+ *            is dropped (a pending one inherits the higher priority).
+ *          - **Superseding**: a request with a new Threshold or DetectionMode replaces the pending one for
+ *            the same key and raises the cancel flag of a running one, whose result is
+ *            then reported as stale by isCurrent().
+ *          - **Bounding**: when `capacity` requests are pending, the oldest request of
+ *            the lowest priority is evicted, or the newcomer rejected if it ranks lower.
+ *
+ *          cancel() withdraws one file and direction outright; the presenter uses it the
+ *          moment a Threshold starts moving, before the debounced replacement is pushed.
+ *
+ * @see SilenceAnalysisWorker
+ * @see SilenceDetectionPresenter
+ */
+class AnalysisJobQueue final {
+  public:
+    /** @brief Scheduling rank; higher values are served first. */
+    enum class Priority { Normal, Interactive };
+
+    /** @brief One analysis pass to perform. */
+    struct Request {
+        juce::String filePath;         /**< Absolute path of the file to analyse. */
+        bool detectingIn = true;       /**< True for the 'In' point, false for 'Out'. */
+        float threshold = 0.0f;        /**< Linear amplitude threshold. */
+        Priority priority = Priority::Normal;
+        MainDomain::DetectionMode mode = MainDomain::DetectionMode::Peak;
+        MainDomain::FilterMode filter = MainDomain::FilterMode::Off;
+    };
+
+    /** @brief A request handed to a runner, with the state to cancel and validate it. */
+    struct Ticket {
+        Request request;
+        juce::uint64 generation = 0;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    /** @brief Outcome of push(). */
+    enum class Admission { Queued, Duplicate, Superseded, Rejected };
+
+    /**
+     * @brief Constructs an empty queue.
+     * @param capacity The maximum number of pending requests.
+     */
+    explicit AnalysisJobQueue(int capacity);
+
+    /**
+     * @brief Schedules a request, applying de-duplication, superseding and the bound.
+     * @param request The request to schedule.
+     * @return How the request was admitted.
+     */
+    Admission push(const Request &request);
+
+    /**
+     * @brief Takes the highest-priority, oldest pending request and marks it running.
+     * @return The ticket, or nullopt if nothing is pending.
+     */
+    std::optional<Ticket> pop();
+
+    /**
+     * @brief Takes the pending request for the other direction of a running ticket's file.
+     * @details Lets a runner serve In and Out of one file with a single fused read pass
+     *          instead of leaving the second request to another runner.
+     * @param ticket A ticket returned by pop().
+     * @return The companion ticket, now running, or nullopt if none is pending.
+     */
+    std::optional<Ticket> popCompanion(const Ticket &ticket);
+
+    /**
+     * @brief Checks whether a ticket's result should still be applied.
+     * @param ticket A ticket returned by pop().
+     * @return False if the ticket was cancelled or superseded by a newer request.
+     */
+    bool isCurrent(const Ticket &ticket) const;
+
+    /**
+     * @brief Marks a running ticket as completed.
+     * @param ticket A ticket returned by pop().
+     */
+    void finish(const Ticket &ticket);
+
+    /**
+     * @brief Drops the pending request and cancels the running ones for one file and direction.
+     * @details Running passes notice at their next chunk; isCurrent() rejects their results.
+     * @param filePath Absolute path of the file.
+     * @param detectingIn The direction to cancel.
+     */
+    void cancel(const juce::String &filePath, bool detectingIn);
+
+    /** @brief Drops all pending requests and cancels all running ones. */
+    void cancelAll();
+
+    /** @return True if nothing is pending or running. */
+    bool isIdle() const;
+
+    /**
+     * @brief Checks for live work in one direction.
+     * @param detectingIn The direction to check.
+     * @return True if a non-cancelled request for that direction is pending or running.
+     */
+    bool isActive(bool detectingIn) const;
+
+    /** @return The number of pending requests. */
+    int getNumPending() const;
+
+  private:
+    using Key = std::pair<juce::String, bool>;
+
+    struct Pending {
+        Request request;
+        juce::uint64 generation;
+    };
+
+    static Key keyOf(const Request &request) {
+        return {request.filePath, request.detectingIn};
+    }
+
+    /** @brief True if two requests for one key would produce the same answer. */
+    static bool asksSame(const Request &a, const Request &b) {
+        return a.threshold == b.threshold && a.mode == b.mode && a.filter == b.filter;
+    }
+
+    juce::uint64 assignGeneration(const Request &request);
+    bool hasPending(const Key &key) const;
+
+    const int capacity;
+    mutable juce::CriticalSection lock;
+    std::vector<Pending> pending;
+    std::vector<Ticket> running;
+    std::map<Key, juce::uint64> latest;
+    juce::uint64 nextGeneration = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisJobQueue)
+};
+
+#endif
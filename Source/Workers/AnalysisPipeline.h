@@ -0,0 +1,95 @@
+#ifndef AUDIOFILER_ANALYSISPIPELINE_H
+#define AUDIOFILER_ANALYSISPIPELINE_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Workers/ScanContext.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+/**
+ * @file AnalysisPipeline.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief One streaming decode of a file feeding a compile-time set of analyzers.
+ *
+ * @details Architecturally, AnalysisPipeline is the single read loop behind every
+ *          whole-file pass of SilenceAnalysisWorker. Each summary of a file (PeakPyramid,
+ *          CutPointCurves, NoiseFloorHistogram, LevelStats, SilenceGapMap) is produced by
+ *          a builder that consumes the file chunk by chunk, so any set of them can share one
+ *          decode instead of reading a compressed file once per summary.
+ *
+ *          An analyzer is any type with
+ *          `void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples)`, called
+ *          with consecutive chunks in file order. The set is a template parameter pack, so
+ *          the per-chunk dispatch is a fold expression over the tuple of analyzers: no
+ *          virtual calls, and every analyzer sees a chunk while it is still in cache. Each
+ *          analyzer keeps its own vectorized inner loop; statistics that share one loop
+ *          (see LevelStats) fuse it inside their builder.
+ *
+ * @see SilenceAnalysisWorker
+ * @see LevelStats
+ */
+template <typename... Analyzers> class AnalysisPipeline final {
+  public:
+    /**
+     * @brief Takes ownership of the analyzers.
+     * @param analyzers One freshly constructed builder per summary.
+     */
+    explicit AnalysisPipeline(Analyzers... analyzers) : stages(std::move(analyzers)...) {
+    }
+
+    /**
+     * @brief Streams the whole file through every analyzer, once.
+     * @param reader The reader to decode with.
+     * @param context Cancellation and pacing policy.
+     * @return True if every chunk was analysed; false if a read failed or the context
+     *         stopped the pass.
+     */
+    bool run(juce::AudioFormatReader &reader, const ScanContext &context) {
+        const juce::int64 length = reader.lengthInSamples;
+        juce::AudioBuffer<float> buffer((int)reader.numChannels,
+                                        SilenceAnalysisAlgorithms::chunkSize);
+        for (juce::int64 pos = 0; pos < length;) {
+            const int numThisTime =
+                (int)std::min((juce::int64)SilenceAnalysisAlgorithms::chunkSize, length - pos);
+            if (!reader.read(&buffer, 0, numThisTime, pos, true, true) || context.shouldStop())
+                return false;
+            context.pace(numThisTime);
+
+            addChunk(buffer, numThisTime);
+            pos += numThisTime;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Offers the next chunk of the file to every analyzer, in declaration order.
+     * @param buffer Decoded samples; only the first `numSamples` are used.
+     * @param numSamples The number of valid samples in the buffer.
+     */
+    void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+        std::apply([&](auto &...stage) { (stage.addChunk(buffer, numSamples), ...); }, stages);
+    }
+
+    /** @return The analyzer of the given type, to finish it once the pass is done. */
+    template <typename Analyzer> Analyzer &get() {
+        return std::get<Analyzer>(stages);
+    }
+
+    /** @brief The number of analyzers fed by each chunk. */
+    static constexpr size_t numAnalyzers = sizeof...(Analyzers);
+
+  private:
+    std::tuple<Analyzers...> stages;
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "Workers/AnalysisProgress.h"
+
+#include <algorithm>
+
+AnalysisProgress::Job::Job(AnalysisProgress &owner, const juce::File &file,
+                           const juce::String &jobKind, juce::int64 totalSamples,
+                           double storageBytesPerFrame)
+    : progress(owner), fileName(file.getFileName()), kind(jobKind),
+      total(std::max((juce::int64)0, totalSamples)), bytesPerFrame(storageBytesPerFrame),
+      startMs(juce::Time::getMillisecondCounterHiRes()) {
+    progress.begin(total);
+}
+
+AnalysisProgress::Job::~Job() {
+    Record record;
+    record.fileName = fileName;
+    record.kind = kind;
+    record.samples = samples.load();
+    record.bytes = bytes.load();
+    record.seconds = (juce::Time::getMillisecondCounterHiRes() - startMs) / 1000.0;
+    record.cancelled = cancelled.load();
+    progress.end(record, total);
+}
+
+/**
+ * @details Frames beyond the announced total (a range scan that re-reads a boundary
+ *          chunk) are still counted as bytes, but not as progress, so the fraction of the
+ *          running jobs can never pass 1.
+ */
+void AnalysisProgress::Job::advance(int numSamples) noexcept {
+    if (numSamples <= 0)
+        return;
+    const auto chunkBytes = (juce::int64)((double)numSamples * bytesPerFrame);
+    const auto before = samples.fetch_add(numSamples, std::memory_order_relaxed);
+    bytes.fetch_add(chunkBytes, std::memory_order_relaxed);
+
+    const auto counted =
+        std::max((juce::int64)0, std::min((juce::int64)numSamples, total - before));
+    progress.activeScanned.fetch_add(counted, std::memory_order_relaxed);
+    progress.samplesEver.fetch_add(numSamples, std::memory_order_relaxed);
+    progress.bytesEver.fetch_add(chunkBytes, std::memory_order_relaxed);
+}
+
+AnalysisProgress::AnalysisProgress(int historySize) : capacity(std::max(1, historySize)) {
+    history.reserve((size_t)capacity);
+}
+
+void AnalysisProgress::begin(juce::int64 totalSamples) noexcept {
+    if (activeJobs.fetch_add(1) == 0) {
+        busySamples.store(samplesEver.load());
+        busyBytes.store(bytesEver.load());
+        busySinceMs.store(juce::Time::getMillisecondCounterHiRes());
+    }
+    activeTotal.fetch_add(totalSamples);
+}
+
+void AnalysisProgress::end(const Record &record, juce::int64 totalSamples) {
+    activeTotal.fetch_sub(totalSamples);
+    activeScanned.fetch_sub(std::min(record.samples, totalSamples));
+    activeJobs.fetch_sub(1);
+
+    const juce::ScopedLock sl(historyLock);
+    if ((int)history.size() < capacity)
+        history.push_back(record);
+    else
+        history[(size_t)nextSlot] = record;
+    nextSlot = (nextSlot + 1) % capacity;
+}
+
+/**
+ * @details The counters are read one at a time, so a job starting or ending between two
+ *          loads can skew a single snapshot; the next vblank corrects it. The rates are
+ *          averaged over the whole busy period, which keeps the ETA from jittering with
+ *          every chunk.
+ */
+AnalysisProgress::Snapshot AnalysisProgress::getSnapshot() const noexcept {
+    Snapshot snapshot;
+    snapshot.activeJobs = activeJobs.load(std::memory_order_relaxed);
+    if (snapshot.activeJobs <= 0)
+        return snapshot;
+
+    snapshot.totalSamples = std::max((juce::int64)0, activeTotal.load(std::memory_order_relaxed));
+    snapshot.samplesScanned = juce::jlimit((juce::int64)0, snapshot.totalSamples,
+                                           activeScanned.load(std::memory_order_relaxed));
+    snapshot.bytesRead = std::max((juce::int64)0, bytesEver.load() - busyBytes.load());
+
+    const double seconds =
+        (juce::Time::getMillisecondCounterHiRes() - busySinceMs.load()) / 1000.0;
+    if (seconds <= 0.0)
+        return snapshot;
+
+    snapshot.bytesPerSecond = (double)snapshot.bytesRead / seconds;
+    const double samplesPerSecond = (double)(samplesEver.load() - busySamples.load()) / seconds;
+    if (samplesPerSecond > 0.0)
+        snapshot.etaSeconds =
+            (double)(snapshot.totalSamples - snapshot.samplesScanned) / samplesPerSecond;
+    return snapshot;
+}
+
+std::vector<AnalysisProgress::Record> AnalysisProgress::getHistory() const {
+    const juce::ScopedLock sl(historyLock);
+    std::vector<Record> newestFirst;
+    newestFirst.reserve(history.size());
+    const int size = (int)history.size();
+    for (int i = 1; i <= size; ++i)
+        newestFirst.push_back(history[(size_t)((nextSlot - i + size) % size)]);
+    return newestFirst;
+}
+
+double AnalysisProgress::storageBytesPerFrame(const juce::File &file,
+                                              const juce::AudioFormatReader &reader) {
+    if (reader.lengthInSamples <= 0)
+        return 0.0;
+    return (double)file.getSize() / (double)reader.lengthInSamples;
+}
@@ -0,0 +1,165 @@
+#ifndef AUDIOFILER_ANALYSISPROGRESS_H
+#define AUDIOFILER_ANALYSISPROGRESS_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+#include <vector>
+
+/**
+ * @file AnalysisProgress.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Live progress and per-job timing history of background analysis.
+ *
+ * @details Architecturally, AnalysisProgress is the reporting surface between the scan
+ *          threads and the UI. Every background job (cut-point pass, gap scan, envelope
+ *          build) opens a Job for its lifetime and hands it down through ScanContext, so
+ *          every chunk the scan loops already report to ScanContext::pace() is counted
+ *          here as well:
+ *
+ *          - **Live progress**: samples scanned against the total of all running jobs,
+ *            storage bytes read, throughput and an ETA. The counters are atomics; scan
+ *            threads only ever add to them, and the UI samples a Snapshot on every
+ *            vblank without taking a lock.
+ *          - **Timing history**: when a Job ends, one Record (file, kind, samples, bytes,
+ *            wall time, whether it was cancelled) is written to a ring of the last
+ *            `Config::Audio::analysisTimingHistory` jobs, which the stats overlay lists.
+ *            The ring is written once per job, so it is guarded by a plain lock.
+ *
+ *          Bytes are storage bytes: a job is given the file's size per sample frame, so
+ *          compressed and PCM files report what they actually cost the disk.
+ *
+ * @see ScanContext
+ * @see SilenceAnalysisWorker
+ * @see StatsPresenter
+ */
+class AnalysisProgress final {
+  public:
+    /** @brief The live state of all running jobs, sampled at one moment. */
+    struct Snapshot {
+        int activeJobs = 0;             /**< Jobs currently running. */
+        juce::int64 samplesScanned = 0; /**< Frames scanned by the running jobs. */
+        juce::int64 totalSamples = 0;   /**< Frames the running jobs scan at most. */
+        juce::int64 bytesRead = 0;      /**< Storage bytes read since the jobs became busy. */
+        double bytesPerSecond = 0.0;    /**< Mean throughput since the jobs became busy. */
+        double etaSeconds = -1.0;       /**< Upper bound of the time left; -1 if unknown. */
+
+        /** @return The scanned share of the running jobs' total in [0, 1]. */
+        double getFraction() const noexcept {
+            return totalSamples > 0 ? juce::jlimit(0.0, 1.0, (double)samplesScanned /
+                                                                 (double)totalSamples)
+                                    : 0.0;
+        }
+    };
+
+    /** @brief The final timing of one finished job. */
+    struct Record {
+        juce::String fileName;   /**< File name without its directory. */
+        juce::String kind;       /**< What the job computed, e.g. "In" or "Gaps". */
+        juce::int64 samples = 0; /**< Frames the job scanned. */
+        juce::int64 bytes = 0;   /**< Storage bytes the job read. */
+        double seconds = 0.0;    /**< Wall time from start to end. */
+        bool cancelled = false;  /**< True if the job was abandoned. */
+
+        /** @return The job's throughput in bytes per second. */
+        double getBytesPerSecond() const noexcept {
+            return seconds > 0.0 ? (double)bytes / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @class Job
+     * @brief Scoped registration of one running job; its Record is written on destruction.
+     * @details advance() may be called from any number of threads at once, e.g. by the
+     *          segment tasks of a ParallelSilenceScan sharing one ScanContext.
+     */
+    class Job final {
+      public:
+        /**
+         * @brief Registers a running job.
+         * @param owner The progress surface to report to.
+         * @param file The file being scanned.
+         * @param kind What the job computes, for the timing history.
+         * @param totalSamples The most frames the job will scan.
+         * @param bytesPerFrame Storage bytes per frame (see storageBytesPerFrame()).
+         */
+        Job(AnalysisProgress &owner, const juce::File &file, const juce::String &kind,
+            juce::int64 totalSamples, double bytesPerFrame);
+
+        /** @brief Unregisters the job and records its timing. */
+        ~Job();
+
+        /**
+         * @brief Counts a chunk the job has read.
+         * @param numSamples The number of frames just read.
+         */
+        void advance(int numSamples) noexcept;
+
+        /** @brief Marks the job as abandoned in its Record. */
+        void markCancelled() noexcept {
+            cancelled.store(true, std::memory_order_relaxed);
+        }
+
+      private:
+        AnalysisProgress &progress;
+        const juce::String fileName;
+        const juce::String kind;
+        const juce::int64 total;
+        const double bytesPerFrame;
+        const double startMs;
+        std::atomic<juce::int64> samples{0};
+        std::atomic<juce::int64> bytes{0};
+        std::atomic<bool> cancelled{false};
+
+        JUCE_DECLARE_NON_COPYABLE(Job)
+    };
+
+    /**
+     * @brief Constructs an idle surface.
+     * @param historySize The number of Records kept.
+     */
+    explicit AnalysisProgress(int historySize);
+
+    /** @return The live state of all running jobs. Lock-free; call from any thread. */
+    Snapshot getSnapshot() const noexcept;
+
+    /** @return The kept Records, newest first. */
+    std::vector<Record> getHistory() const;
+
+    /**
+     * @brief Estimates the storage cost of one sample frame of a file.
+     * @param file The file on disk.
+     * @param reader A reader of that file.
+     * @return The file size divided by its length in frames, or 0 if unknown.
+     */
+    static double storageBytesPerFrame(const juce::File &file,
+                                       const juce::AudioFormatReader &reader);
+
+  private:
+    void begin(juce::int64 totalSamples) noexcept;
+    void end(const Record &record, juce::int64 totalSamples);
+
+    std::atomic<int> activeJobs{0};
+    std::atomic<juce::int64> activeScanned{0};
+    std::atomic<juce::int64> activeTotal{0};
+    std::atomic<juce::int64> samplesEver{0}; /**< Monotonic; deltas give the scan rate. */
+    std::atomic<juce::int64> bytesEver{0};   /**< Monotonic; deltas give the byte rate. */
+    std::atomic<juce::int64> busySamples{0}; /**< samplesEver when the jobs became busy. */
+    std::atomic<juce::int64> busyBytes{0};   /**< bytesEver when the jobs became busy. */
+    std::atomic<double> busySinceMs{0.0};
+
+    const int capacity;
+    mutable juce::CriticalSection historyLock;
+    std::vector<Record> history;
+    int nextSlot = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisProgress)
+};
+
+#endif
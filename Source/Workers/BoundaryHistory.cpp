@@ -0,0 +1,91 @@
+#include "Workers/BoundaryHistory.h"
+
+#include <algorithm>
+
+BoundaryHistory::BoundaryHistory(int maxFilesIn, int maxRecordsIn)
+    : maxFiles(std::max(1, maxFilesIn)), maxRecords(std::max(1, maxRecordsIn)) {
+}
+
+void BoundaryHistory::record(const juce::String &fileKey, juce::int64 lengthInSamples,
+                             bool detectingIn, float threshold, juce::int64 boundary) {
+    if (fileKey.isEmpty() || lengthInSamples <= 0 || boundary < -1 || boundary >= lengthInSamples)
+        return;
+
+    const juce::ScopedLock sl(lock);
+    auto &entry = entries[fileKey];
+    if (entry.lengthInSamples != lengthInSamples) {
+        entry = Entry();
+        entry.lengthInSamples = lengthInSamples;
+    }
+    entry.lastUse = ++useCounter;
+
+    // Newest last; a repeated Threshold replaces its older record.
+    auto &records = detectingIn ? entry.in : entry.out;
+    records.erase(std::remove_if(records.begin(), records.end(),
+                                 [threshold](const Record &r) { return r.threshold == threshold; }),
+                  records.end());
+    records.push_back({threshold, boundary});
+    if ((int)records.size() > maxRecords)
+        records.erase(records.begin());
+
+    if ((int)entries.size() > maxFiles) {
+        const auto oldest = std::min_element(
+            entries.begin(), entries.end(),
+            [](const auto &a, const auto &b) { return a.second.lastUse < b.second.lastUse; });
+        entries.erase(oldest);
+    }
+}
+
+/**
+ * @details For Out points a record (T, B) with T <= T' caps the answer at B (everything
+ *          after B is at most T), and one with T >= T' floors it at B (sample B exceeds
+ *          T'). The window is what lies strictly between the floor and the cap. A record of
+ *          "no crossing" (-1) empties an In prefix up to the end, or an Out suffix down to
+ *          the start, and tells nothing when T >= T'.
+ *
+ *          Records contradicting each other (a file rewritten in place with the same hash
+ *          and length) yield an inverted window, which is declined.
+ */
+std::optional<BoundaryHistory::Window> BoundaryHistory::narrow(const juce::String &fileKey,
+                                                               juce::int64 lengthInSamples,
+                                                               bool detectingIn,
+                                                               float threshold) const {
+    const juce::ScopedLock sl(lock);
+    const auto found = entries.find(fileKey);
+    if (found == entries.end() || found->second.lengthInSamples != lengthInSamples)
+        return std::nullopt;
+    found->second.lastUse = ++useCounter;
+
+    Window window{0, lengthInSamples, -1};
+    if (detectingIn) {
+        for (const auto &r : found->second.in) {
+            if (r.threshold <= threshold)
+                window.start =
+                    std::max(window.start, r.boundary < 0 ? lengthInSamples : r.boundary);
+            if (r.threshold >= threshold && r.boundary >= 0 && r.boundary < window.end) {
+                window.end = r.boundary;
+                window.fallback = r.boundary;
+            }
+        }
+    } else {
+        for (const auto &r : found->second.out) {
+            if (r.threshold <= threshold)
+                window.end = std::min(window.end, r.boundary + 1);
+            if (r.threshold >= threshold && r.boundary > window.fallback) {
+                window.start = std::max(window.start, r.boundary + 1);
+                window.fallback = r.boundary;
+            }
+        }
+    }
+
+    if (window.start > window.end)
+        return std::nullopt;
+    if (window.start == 0 && window.end == lengthInSamples && window.fallback == -1)
+        return std::nullopt;
+    return window;
+}
+
+void BoundaryHistory::clear() {
+    const juce::ScopedLock sl(lock);
+    entries.clear();
+}
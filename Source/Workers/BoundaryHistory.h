@@ -0,0 +1,116 @@
+#ifndef AUDIOFILER_BOUNDARYHISTORY_H
+#define AUDIOFILER_BOUNDARYHISTORY_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <map>
+#include <optional>
+#include <vector>
+
+/**
+ * @file BoundaryHistory.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Remembers recent Peak boundaries per file so a re-analysis only reads near them.
+ *
+ * @details Architecturally, BoundaryHistory is a small thread-safe cache owned by
+ *          SilenceAnalysisWorker. Every exact Peak result is a fact about the file that
+ *          still holds at other Thresholds: an In point B found at Threshold T means no
+ *          sample before B exceeds T, and that sample B itself does. So for a new
+ *          Threshold T':
+ *
+ *          - every record with T <= T' moves the search start up to its B (the prefix is
+ *            quieter than T', so it cannot hold the answer);
+ *          - every record with T >= T' caps the search at its B (sample B exceeds T', so
+ *            the answer is B at the latest).
+ *
+ *          A nudge of the Threshold therefore reads only the stretch between the nearest
+ *          boundaries on either side, and an equal Threshold reads nothing. Raising it
+ *          searches outward from the old boundary and stops at the first crossing, usually
+ *          within a chunk or two. Lowering it has to prove the file's edge is quiet at the
+ *          new level too, which is cheap only once a lower Threshold is on record, as it is
+ *          after the first nudge back and forth. Out points are the mirror image. When no
+ *          record narrows the range, narrow() declines and the worker takes its full
+ *          strategy.
+ *
+ *          Records are keyed by the file's FileIdentity hash and length. Each direction
+ *          keeps the `maxRecords` most recent Thresholds; at most `maxFiles` files are
+ *          kept, least recently used first out. Only the plain (unfiltered) Peak criterion
+ *          has these properties, so windowed and filtered scans are never recorded.
+ *
+ * @see SilenceAnalysisWorker
+ * @see SilenceAnalysisAlgorithms
+ */
+class BoundaryHistory final {
+  public:
+    /** @brief The part of a file a re-analysis must still read. */
+    struct Window {
+        juce::int64 start = 0;     /**< First sample to examine. */
+        juce::int64 end = 0;       /**< One past the last sample to examine. */
+        juce::int64 fallback = -1; /**< The answer when [start, end) holds no crossing. */
+
+        /** @return True if the answer is known without reading anything. */
+        bool isEmpty() const {
+            return start >= end;
+        }
+    };
+
+    /**
+     * @brief Constructs an empty history.
+     * @param maxFiles The number of files remembered.
+     * @param maxRecords The number of Thresholds remembered per file and direction.
+     */
+    BoundaryHistory(int maxFiles, int maxRecords);
+
+    /**
+     * @brief Remembers an exact Peak result.
+     * @param fileKey The file's FileIdentity hash.
+     * @param lengthInSamples The file length; a different length discards older records.
+     * @param detectingIn True for an In point, false for an Out point.
+     * @param threshold The linear Threshold the result was found at.
+     * @param boundary The crossing, or -1 if no sample exceeds the Threshold.
+     */
+    void record(const juce::String &fileKey, juce::int64 lengthInSamples, bool detectingIn,
+                float threshold, juce::int64 boundary);
+
+    /**
+     * @brief Narrows the range a new Peak scan has to read.
+     * @details In windows are scanned forwards for the first crossing, Out windows
+     *          backwards for the last one; either way an empty result means `fallback`.
+     * @param fileKey The file's FileIdentity hash.
+     * @param lengthInSamples The file length.
+     * @param detectingIn True for an In point, false for an Out point.
+     * @param threshold The linear Threshold to scan at.
+     * @return The window, or nullopt if the records do not narrow the whole file.
+     */
+    std::optional<Window> narrow(const juce::String &fileKey, juce::int64 lengthInSamples,
+                                 bool detectingIn, float threshold) const;
+
+    /** @brief Forgets every file. */
+    void clear();
+
+  private:
+    struct Record {
+        float threshold;
+        juce::int64 boundary;
+    };
+
+    struct Entry {
+        juce::int64 lengthInSamples = 0;
+        std::vector<Record> in;
+        std::vector<Record> out;
+        juce::uint64 lastUse = 0;
+    };
+
+    const int maxFiles;
+    const int maxRecords;
+    mutable juce::CriticalSection lock;
+    mutable juce::uint64 useCounter = 0;
+    mutable std::map<juce::String, Entry> entries;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "Workers/ChunkScanner.h"
+#include "Workers/MappedPcmReader.h"
+#include "Workers/PcmScanKernels.h"
+#include "Workers/PeakScanKernels.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+ChunkScanner::ChunkScanner(juce::AudioFormatReader &readerToUse, float thresholdToUse)
+    : reader(readerToUse), threshold(thresholdToUse) {
+    if (auto *pcm = dynamic_cast<MappedPcmReader *>(&reader)) {
+        const auto encoding = pcm->getLayout().encoding;
+        if (encoding != MappedPcmReader::Encoding::Float32) {
+            mapped = pcm;
+            limit = PcmScanKernels::toIntegerLimit(threshold, encoding);
+            return;
+        }
+    }
+    buffer.setSize((int)reader.numChannels, SilenceAnalysisAlgorithms::chunkSize);
+}
+
+int ChunkScanner::findFirstAbove(juce::int64 startSample, int numSamples) {
+    return scan(startSample, numSamples, true);
+}
+
+int ChunkScanner::findLastAbove(juce::int64 startSample, int numSamples) {
+    return scan(startSample, numSamples, false);
+}
+
+int ChunkScanner::scan(juce::int64 startSample, int numSamples, bool first) {
+    if (mapped != nullptr) {
+        const char *frames = mapped->mapFrames(startSample, numSamples);
+        if (frames == nullptr)
+            return readFailed;
+        const auto &layout = mapped->getLayout();
+        return first ? PcmScanKernels::findFirstAbove(layout, frames, numSamples, limit)
+                     : PcmScanKernels::findLastAbove(layout, frames, numSamples, limit);
+    }
+
+    if (!reader.read(&buffer, 0, numSamples, startSample, true, true))
+        return readFailed;
+    const auto *const *channels = buffer.getArrayOfReadPointers();
+    return first ? PeakScanKernels::findFirstAbove(channels, buffer.getNumChannels(), numSamples,
+                                                   threshold)
+                 : PeakScanKernels::findLastAbove(channels, buffer.getNumChannels(), numSamples,
+                                                  threshold);
+}
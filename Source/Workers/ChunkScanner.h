@@ -0,0 +1,81 @@
+#ifndef AUDIOFILER_CHUNKSCANNER_H
+#define AUDIOFILER_CHUNKSCANNER_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+class MappedPcmReader;
+
+/**
+ * @file ChunkScanner.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Reads one chunk of a file and finds its first or last Threshold crossing.
+ *
+ * @details Architecturally, ChunkScanner is the read-and-test step shared by the range
+ *          scans and the fused scan. It picks the cheapest route once, when it is
+ *          constructed:
+ *
+ *          - **Raw integer PCM**: if the reader is a MappedPcmReader over 16, 24 or 32-bit
+ *            integer data, the Threshold is converted to an integer limit and each chunk
+ *            is tested in place by PcmScanKernels; no sample is ever converted to float.
+ *          - **Everything else**: the chunk is read into a float buffer and tested by
+ *            PeakScanKernels.
+ *
+ *          Both routes report the same crossing for the same Threshold. A scanner holds
+ *          its own buffer, so one instance serves one scan direction on one thread.
+ *
+ * @see PcmScanKernels
+ * @see SilenceAnalysisAlgorithms
+ * @see FusedSilenceScan
+ */
+class ChunkScanner final {
+  public:
+    /** @brief Returned by the find methods when the reader could not supply the chunk. */
+    static constexpr int readFailed = -2;
+
+    /**
+     * @brief Prepares a scanner for one reader and Threshold.
+     * @param reader The reader to scan; must outlive the scanner.
+     * @param threshold The linear amplitude threshold (a sample must be strictly greater).
+     */
+    ChunkScanner(juce::AudioFormatReader &reader, float threshold);
+
+    /**
+     * @brief Finds the first frame beyond the Threshold in one chunk.
+     * @param startSample The first frame of the chunk.
+     * @param numSamples The number of frames; must lie within the file.
+     * @return The offset of the crossing from `startSample`, -1 if none, or `readFailed`.
+     */
+    int findFirstAbove(juce::int64 startSample, int numSamples);
+
+    /**
+     * @brief Finds the last frame beyond the Threshold in one chunk.
+     * @param startSample The first frame of the chunk.
+     * @param numSamples The number of frames; must lie within the file.
+     * @return The offset of the crossing from `startSample`, -1 if none, or `readFailed`.
+     */
+    int findLastAbove(juce::int64 startSample, int numSamples);
+
+    /** @return True if chunks are tested as raw integers rather than converted to float. */
+    bool isIntegerDomain() const noexcept {
+        return mapped != nullptr;
+    }
+
+  private:
+    int scan(juce::int64 startSample, int numSamples, bool first);
+
+    juce::AudioFormatReader &reader;
+    const float threshold;
+    MappedPcmReader *mapped = nullptr; /**< Set only when the integer route applies. */
+    juce::int64 limit = 0;
+    juce::AudioBuffer<float> buffer;
+
+    JUCE_DECLARE_NON_COPYABLE(ChunkScanner)
+};
+
+#endif
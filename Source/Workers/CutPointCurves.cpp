@@ -0,0 +1,176 @@
+#include "Workers/CutPointCurves.h"
+#include "Utils/Config.h"
+#include "Workers/PeakScanKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+constexpr juce::int32 kMagic = 0x43434641; // "AFCC"
+constexpr juce::int32 kVersion = 1;
+constexpr int kMaxChannels = 128;
+constexpr juce::int64 kBytesPerBreakpoint = 12;
+
+float levelAt(const float *const *channels, int numChannels, int index) {
+    float level = 0.0f;
+    for (int ch = 0; ch < numChannels; ++ch)
+        level = std::max(level, std::abs(channels[ch][index]));
+    return level;
+}
+} // namespace
+
+CutPointCurves::Builder::Builder(juce::int64 length, double rate)
+    : curves(std::make_unique<CutPointCurves>()) {
+    curves->lengthInSamples = length;
+    curves->sampleRate = rate;
+}
+
+void CutPointCurves::Builder::addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+    const int numChannels = std::min(buffer.getNumChannels(), kMaxChannels);
+    if (curves == nullptr || numChannels <= 0 || numSamples <= 0)
+        return;
+
+    addPrefixRecords(buffer.getArrayOfReadPointers(), numChannels, numSamples);
+    addSuffixRecords(buffer.getArrayOfReadPointers(), numChannels, numSamples);
+    position += numSamples;
+}
+
+/**
+ * @details Each kernel call jumps straight to the next sample louder than the running
+ *          maximum, so the chunk is visited once in total no matter how many records it
+ *          contains. Once the breakpoint budget is spent, recording stops; the curve then
+ *          remains exact for every Threshold below the last recorded level.
+ */
+void CutPointCurves::Builder::addPrefixRecords(const float *const *channels, int numChannels,
+                                               int numSamples) {
+    auto &points = curves->inPoints;
+    std::array<const float *, kMaxChannels> offset{};
+
+    for (int pos = 0; curves->inComplete && pos < numSamples;) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            offset[(size_t)ch] = channels[ch] + pos;
+
+        const int hit = PeakScanKernels::findFirstAbove(offset.data(), numChannels,
+                                                        numSamples - pos, runningMax);
+        if (hit < 0)
+            break;
+
+        runningMax = levelAt(channels, numChannels, pos + hit);
+        if ((int)points.size() >= Config::Audio::cutCurveMaxBreakpoints) {
+            curves->inComplete = false;
+            break;
+        }
+        points.push_back({position + pos + hit, runningMax});
+        pos += hit + 1;
+    }
+}
+
+/**
+ * @details Suffix records are computed per chunk by scanning backwards with a rising
+ *          bar, which yields the chunk's own records from loudest-latest to
+ *          loudest-overall. Merging then follows the monotonic-stack rule: every global
+ *          record that is not louder than the chunk's peak is dominated by a later sample
+ *          and is popped before the chunk's records are appended. When the budget is
+ *          exceeded the quietest half is discarded and the floor raised, which keeps
+ *          every Threshold at or above the floor exact.
+ */
+void CutPointCurves::Builder::addSuffixRecords(const float *const *channels, int numChannels,
+                                               int numSamples) {
+    auto &points = curves->outPoints;
+    chunkRecords.clear();
+
+    float bar = curves->outFloor;
+    for (int end = numSamples; end > 0;) {
+        const int hit = PeakScanKernels::findLastAbove(channels, numChannels, end, bar);
+        if (hit < 0)
+            break;
+        bar = levelAt(channels, numChannels, hit);
+        chunkRecords.push_back({position + hit, bar});
+        end = hit;
+    }
+
+    if (chunkRecords.empty())
+        return;
+
+    const float chunkPeak = chunkRecords.back().level;
+    while (!points.empty() && points.back().level <= chunkPeak)
+        points.pop_back();
+    points.insert(points.end(), chunkRecords.rbegin(), chunkRecords.rend());
+
+    const auto budget = (size_t)Config::Audio::cutCurveMaxBreakpoints;
+    if (points.size() > budget) {
+        curves->outFloor = points[budget / 2].level;
+        points.resize(budget / 2);
+    }
+}
+
+std::unique_ptr<CutPointCurves> CutPointCurves::Builder::finish() {
+    return std::move(curves);
+}
+
+std::optional<juce::int64> CutPointCurves::findIn(float threshold) const {
+    if (threshold < 0.0f)
+        return std::nullopt;
+
+    const auto it = std::upper_bound(
+        inPoints.begin(), inPoints.end(), threshold,
+        [](float t, const Breakpoint &point) { return t < point.level; });
+    if (it != inPoints.end())
+        return it->sample;
+    return inComplete ? std::optional<juce::int64>(-1) : std::nullopt;
+}
+
+std::optional<juce::int64> CutPointCurves::findOut(float threshold) const {
+    if (threshold < outFloor)
+        return std::nullopt;
+
+    const auto it = std::partition_point(
+        outPoints.begin(), outPoints.end(),
+        [threshold](const Breakpoint &point) { return point.level > threshold; });
+    if (it == outPoints.begin())
+        return -1;
+    return std::prev(it)->sample;
+}
+
+bool CutPointCurves::writeTo(juce::OutputStream &output) const {
+    bool ok = output.writeInt(kMagic) && output.writeInt(kVersion) &&
+              output.writeInt64(lengthInSamples) && output.writeDouble(sampleRate) &&
+              output.writeBool(inComplete) && output.writeFloat(outFloor);
+
+    for (const auto *points : {&inPoints, &outPoints}) {
+        ok = ok && output.writeInt((int)points->size());
+        for (const auto &point : *points)
+            ok = ok && output.writeInt64(point.sample) && output.writeFloat(point.level);
+    }
+    return ok;
+}
+
+std::unique_ptr<CutPointCurves> CutPointCurves::readFrom(juce::InputStream &input) {
+    if (input.readInt() != kMagic || input.readInt() != kVersion)
+        return nullptr;
+
+    auto curves = std::make_unique<CutPointCurves>();
+    curves->lengthInSamples = input.readInt64();
+    curves->sampleRate = input.readDouble();
+    curves->inComplete = input.readBool();
+    curves->outFloor = input.readFloat();
+
+    if (curves->lengthInSamples <= 0 || curves->sampleRate <= 0.0)
+        return nullptr;
+
+    for (auto *points : {&curves->inPoints, &curves->outPoints}) {
+        const int count = input.readInt();
+        const auto remaining = input.getNumBytesRemaining();
+        if (count < 0 || count > Config::Audio::cutCurveMaxBreakpoints ||
+            (remaining >= 0 && remaining < (juce::int64)count * kBytesPerBreakpoint))
+            return nullptr;
+
+        points->resize((size_t)count);
+        for (auto &point : *points) {
+            point.sample = input.readInt64();
+            point.level = input.readFloat();
+        }
+    }
+    return curves;
+}
@@ -0,0 +1,135 @@
+#ifndef AUDIOFILER_CUTPOINTCURVES_H
+#define AUDIOFILER_CUTPOINTCURVES_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @file CutPointCurves.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Exact Threshold-to-cut-point mapping for both Autocut directions of one file.
+ *
+ * @details Architecturally, CutPointCurves is an immutable "Passive Data Model" produced
+ *          by one streaming pass over the file and consumed on the Message Thread.
+ *
+ *          The first sample above a Threshold `t` is a monotone step function of `t`:
+ *          it can only change at samples that exceed every earlier sample (prefix records
+ *          of the running max-abs). Symmetrically, the last sample above `t` can only be
+ *          a sample that exceeds every later one (suffix records). Storing those
+ *          breakpoints turns "where would the In/Out cut land for this Threshold?" into
+ *          a binary search, so the cut markers can follow the Threshold control at
+ *          frame rate with zero disk I/O.
+ *
+ *          Memory is bounded by `Config::Audio::cutCurveMaxBreakpoints` per direction.
+ *          Pathological material (e.g. a multi-minute linear fade) may exceed it; the
+ *          curve then only answers the Threshold range it still covers and reports the
+ *          rest as unknown, so callers fall back to a scan.
+ *
+ * @see SilenceDetectionPresenter
+ * @see SilenceAnalysisWorker
+ * @see EnvelopeStore
+ */
+class CutPointCurves final {
+  public:
+    /** @brief One record of the running max-abs. */
+    struct Breakpoint {
+        juce::int64 sample; /**< Absolute sample index. */
+        float level;        /**< Max-abs across channels at that sample. */
+    };
+
+    /**
+     * @class Builder
+     * @brief Accumulates breakpoints chunk by chunk during a forward streaming pass.
+     * @details Prefix records are found with repeated forward kernel scans; suffix
+     *          records are found per chunk with repeated backward scans and merged into
+     *          a monotonic stack, so each chunk costs O(n) vectorized comparisons.
+     */
+    class Builder {
+      public:
+        /**
+         * @brief Prepares a builder for one file.
+         * @param lengthInSamples The file length in samples.
+         * @param sampleRate The file sample rate.
+         */
+        Builder(juce::int64 lengthInSamples, double sampleRate);
+
+        /**
+         * @brief Consumes the next chunk of the file, in order.
+         * @param buffer Decoded samples; only the first `numSamples` are used.
+         * @param numSamples The number of valid samples in the buffer.
+         */
+        void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples);
+
+        /**
+         * @brief Finalizes the curves.
+         * @return The finished curves.
+         */
+        std::unique_ptr<CutPointCurves> finish();
+
+      private:
+        void addPrefixRecords(const float *const *channels, int numChannels, int numSamples);
+        void addSuffixRecords(const float *const *channels, int numChannels, int numSamples);
+
+        std::unique_ptr<CutPointCurves> curves;
+        juce::int64 position = 0;
+        float runningMax = 0.0f;
+        std::vector<Breakpoint> chunkRecords;
+    };
+
+    /**
+     * @brief The In cut for a Threshold.
+     * @param threshold The linear amplitude threshold.
+     * @return The first sample above it, -1 if none, or nullopt if the curve cannot tell.
+     */
+    std::optional<juce::int64> findIn(float threshold) const;
+
+    /**
+     * @brief The Out cut for a Threshold.
+     * @param threshold The linear amplitude threshold.
+     * @return The last sample above it, -1 if none, or nullopt if the curve cannot tell.
+     */
+    std::optional<juce::int64> findOut(float threshold) const;
+
+    /** @return The sample rate of the analysed file. */
+    double getSampleRate() const {
+        return sampleRate;
+    }
+
+    /** @return The length of the analysed file in samples. */
+    juce::int64 getLengthInSamples() const {
+        return lengthInSamples;
+    }
+
+    /**
+     * @brief Serializes the curves.
+     * @param output The stream to write to.
+     * @return True on success.
+     */
+    bool writeTo(juce::OutputStream &output) const;
+
+    /**
+     * @brief Deserializes curves written by writeTo().
+     * @param input The stream to read from.
+     * @return The curves, or null if the data is malformed or of another version.
+     */
+    static std::unique_ptr<CutPointCurves> readFrom(juce::InputStream &input);
+
+  private:
+    juce::int64 lengthInSamples = 0;
+    double sampleRate = 0.0;
+    std::vector<Breakpoint> inPoints;  /**< Ascending sample, strictly ascending level. */
+    std::vector<Breakpoint> outPoints; /**< Ascending sample, strictly descending level. */
+    bool inComplete = true;            /**< False once the In budget was exhausted. */
+    float outFloor = 0.0f;             /**< Out queries below this level are unknown. */
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "Workers/EnvelopeStore.h"
+#include "Utils/CacheEviction.h"
+#include "Utils/Config.h"
+#include "Workers/CutPointCurves.h"
+#include "Workers/LevelStats.h"
+#include "Workers/NoiseFloorHistogram.h"
+#include "Workers/PeakPyramid.h"
+
+#include <algorithm>
+
+namespace {
+template <typename Summary> std::unique_ptr<Summary> load(const juce::File &file) {
+    if (!file.existsAsFile())
+        return nullptr;
+
+    std::unique_ptr<juce::InputStream> raw(file.createInputStream());
+    if (raw == nullptr)
+        return nullptr;
+
+    juce::BufferedInputStream input(*raw, Config::Audio::peakCacheIoBufferBytes);
+    auto summary = Summary::readFrom(input);
+    if (summary == nullptr)
+        file.deleteFile(); // corrupt or from an incompatible version
+    else
+        CacheEviction::touch(file);
+    return summary;
+}
+
+// Write to a sibling temp file first so a crash never leaves a truncated cache entry.
+template <typename Summary> void save(const juce::File &file, const Summary &summary) {
+    juce::TemporaryFile temp(file);
+    {
+        juce::FileOutputStream output(temp.getFile());
+        if (!output.openedOk() || !summary.writeTo(output))
+            return;
+        output.flush();
+    }
+    temp.overwriteTargetFileWithTemporary();
+}
+} // namespace
+
+EnvelopeStore::EnvelopeStore(const juce::File &dir, juce::int64 maxBytesIn)
+    : directory(dir), maxBytes(maxBytesIn) {
+}
+
+EnvelopeStore::~EnvelopeStore() = default;
+
+juce::File EnvelopeStore::getDefaultDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+        .getChildFile(Config::Audio::peakCacheFolder);
+}
+
+juce::File EnvelopeStore::fileFor(const juce::String &hash, const char *extension) const {
+    return directory.getChildFile(hash + extension);
+}
+
+template <typename Summary>
+std::shared_ptr<const Summary> EnvelopeStore::find(const juce::String &hash,
+                                                   std::shared_ptr<const Summary> Entry::*member,
+                                                   const char *extension) {
+    if (hash.isEmpty())
+        return nullptr;
+
+    {
+        const juce::ScopedLock sl(lock);
+        const auto it = memory.find(hash);
+        if (it != memory.end() && it->second.*member != nullptr)
+            return remember(hash).*member;
+    }
+
+    // Disk reads happen outside the lock; a racing duplicate load is harmless.
+    std::shared_ptr<const Summary> summary = load<Summary>(fileFor(hash, extension));
+    if (summary == nullptr)
+        return nullptr;
+
+    const juce::ScopedLock sl(lock);
+    remember(hash).*member = summary;
+    return summary;
+}
+
+std::shared_ptr<const PeakPyramid> EnvelopeStore::findPyramid(const juce::String &hash) {
+    return find(hash, &Entry::pyramid, Config::Audio::peakCacheExtension);
+}
+
+std::shared_ptr<const CutPointCurves> EnvelopeStore::findCurves(const juce::String &hash) {
+    return find(hash, &Entry::curves, Config::Audio::cutCurveCacheExtension);
+}
+
+std::shared_ptr<const NoiseFloorHistogram>
+EnvelopeStore::findNoiseFloor(const juce::String &hash) {
+    return find(hash, &Entry::noiseFloor, Config::Audio::noiseFloorCacheExtension);
+}
+
+std::shared_ptr<const LevelStats> EnvelopeStore::findLevelStats(const juce::String &hash) {
+    return find(hash, &Entry::levelStats, Config::Audio::levelStatsCacheExtension);
+}
+
+void EnvelopeStore::store(const juce::String &hash, std::shared_ptr<const PeakPyramid> pyramid,
+                          std::shared_ptr<const CutPointCurves> curves,
+                          std::shared_ptr<const NoiseFloorHistogram> noiseFloor,
+                          std::shared_ptr<const LevelStats> levelStats) {
+    if (hash.isEmpty())
+        return;
+
+    {
+        const juce::ScopedLock sl(lock);
+        auto &entry = remember(hash);
+        if (pyramid != nullptr)
+            entry.pyramid = pyramid;
+        if (curves != nullptr)
+            entry.curves = curves;
+        if (noiseFloor != nullptr)
+            entry.noiseFloor = noiseFloor;
+        if (levelStats != nullptr)
+            entry.levelStats = levelStats;
+    }
+
+    if (!directory.createDirectory())
+        return;
+
+    if (pyramid != nullptr)
+        save(fileFor(hash, Config::Audio::peakCacheExtension), *pyramid);
+    if (curves != nullptr)
+        save(fileFor(hash, Config::Audio::cutCurveCacheExtension), *curves);
+    if (noiseFloor != nullptr)
+        save(fileFor(hash, Config::Audio::noiseFloorCacheExtension), *noiseFloor);
+    if (levelStats != nullptr)
+        save(fileFor(hash, Config::Audio::levelStatsCacheExtension), *levelStats);
+
+    CacheEviction::trimToSize(directory,
+                              {Config::Audio::peakCacheExtension,
+                               Config::Audio::cutCurveCacheExtension,
+                               Config::Audio::noiseFloorCacheExtension,
+                               Config::Audio::levelStatsCacheExtension},
+                              maxBytes);
+}
+
+EnvelopeStore::Entry &EnvelopeStore::remember(const juce::String &hash) {
+    recency.erase(std::remove(recency.begin(), recency.end(), hash), recency.end());
+    recency.push_back(hash);
+
+    while ((int)recency.size() > Config::Audio::peakCacheMemoryEntries) {
+        memory.erase(recency.front());
+        recency.pop_front();
+    }
+    return memory[hash];
+}
+
+bool EnvelopeStore::tryBeginBuild(const juce::String &hash) {
+    const juce::ScopedLock sl(lock);
+    return !hash.isEmpty() && building.insert(hash).second;
+}
+
+void EnvelopeStore::endBuild(const juce::String &hash) {
+    const juce::ScopedLock sl(lock);
+    building.erase(hash);
+}
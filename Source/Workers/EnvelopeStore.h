@@ -0,0 +1,146 @@
+#ifndef AUDIOFILER_ENVELOPESTORE_H
+#define AUDIOFILER_ENVELOPESTORE_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+
+class CutPointCurves;
+class LevelStats;
+class NoiseFloorHistogram;
+class PeakPyramid;
+
+/**
+ * @file EnvelopeStore.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Thread-safe memory and disk cache of per-file amplitude summaries keyed by file hash.
+ *
+ * @details Architecturally, EnvelopeStore is the persistence brick of the Threshold
+ *          query path. A file's envelope consists of its PeakPyramid, its CutPointCurves,
+ *          its NoiseFloorHistogram and its LevelStats, all produced by the same background
+ *          AnalysisPipeline pass. The store keeps the most recently used envelopes in
+ *          memory and mirrors each summary to `~/.config/audiofiler/peaks/<hash>.peaks`,
+ *          `<hash>.curves`, `<hash>.noise` and `<hash>.levels`, next to the rest of the
+ *          session data, so a file analysed in an earlier session answers Threshold edits
+ *          instantly. Keys are
+ *          `FileMetadata::hash` values produced by FileIdentity. The folder is kept under
+ *          `Config::Audio::peakCacheMaxBytes` by evicting the least recently used files
+ *          through CacheEviction; a disk hit refreshes the file's modification time.
+ *
+ *          It also tracks which hashes are currently being built so that repeated
+ *          analysis requests for the same file never schedule duplicate build passes.
+ *          All methods may be called concurrently from the worker and pool threads.
+ *
+ * @see PeakPyramid
+ * @see CutPointCurves
+ * @see NoiseFloorHistogram
+ * @see LevelStats
+ * @see FileIdentity
+ * @see CacheEviction
+ * @see SilenceAnalysisWorker
+ */
+class EnvelopeStore final {
+  public:
+    /**
+     * @brief Constructs a store rooted at a directory.
+     * @param directory Folder holding the cache files; created on first write.
+     * @param maxBytes The total size the cache files are trimmed to after each store().
+     */
+    EnvelopeStore(const juce::File &directory, juce::int64 maxBytes);
+
+    /** @brief Destructor. */
+    ~EnvelopeStore();
+
+    /** @return The default on-disk location under the user's config folder. */
+    static juce::File getDefaultDirectory();
+
+    /**
+     * @brief Looks a pyramid up in memory, then on disk.
+     * @param hash The file hash.
+     * @return The pyramid, or null if none is cached.
+     */
+    std::shared_ptr<const PeakPyramid> findPyramid(const juce::String &hash);
+
+    /**
+     * @brief Looks cut-point curves up in memory, then on disk.
+     * @param hash The file hash.
+     * @return The curves, or null if none are cached.
+     */
+    std::shared_ptr<const CutPointCurves> findCurves(const juce::String &hash);
+
+    /**
+     * @brief Looks a level histogram up in memory, then on disk.
+     * @param hash The file hash.
+     * @return The histogram, or null if none is cached.
+     */
+    std::shared_ptr<const NoiseFloorHistogram> findNoiseFloor(const juce::String &hash);
+
+    /**
+     * @brief Looks level statistics up in memory, then on disk.
+     * @param hash The file hash.
+     * @return The statistics, or null if none are cached.
+     */
+    std::shared_ptr<const LevelStats> findLevelStats(const juce::String &hash);
+
+    /**
+     * @brief Adds a freshly built envelope to the memory cache and writes it to disk.
+     * @details Trims the folder back to its size cap afterwards.
+     * @param hash The file hash.
+     * @param pyramid The pyramid to store.
+     * @param curves The cut-point curves to store.
+     * @param noiseFloor The level histogram to store, if one was built.
+     * @param levelStats The level statistics to store, if they were gathered.
+     */
+    void store(const juce::String &hash, std::shared_ptr<const PeakPyramid> pyramid,
+               std::shared_ptr<const CutPointCurves> curves,
+               std::shared_ptr<const NoiseFloorHistogram> noiseFloor = nullptr,
+               std::shared_ptr<const LevelStats> levelStats = nullptr);
+
+    /**
+     * @brief Marks a hash as being built.
+     * @param hash The file hash.
+     * @return False if a build for this hash is already in flight.
+     */
+    bool tryBeginBuild(const juce::String &hash);
+
+    /**
+     * @brief Clears the in-flight mark set by tryBeginBuild().
+     * @param hash The file hash.
+     */
+    void endBuild(const juce::String &hash);
+
+  private:
+    struct Entry {
+        std::shared_ptr<const PeakPyramid> pyramid;
+        std::shared_ptr<const CutPointCurves> curves;
+        std::shared_ptr<const NoiseFloorHistogram> noiseFloor;
+        std::shared_ptr<const LevelStats> levelStats;
+    };
+
+    template <typename Summary>
+    std::shared_ptr<const Summary> find(const juce::String &hash,
+                                        std::shared_ptr<const Summary> Entry::*member,
+                                        const char *extension);
+
+    juce::File fileFor(const juce::String &hash, const char *extension) const;
+    Entry &remember(const juce::String &hash);
+
+    const juce::File directory;
+    const juce::int64 maxBytes;
+    juce::CriticalSection lock;
+    std::map<juce::String, Entry> memory;
+    std::deque<juce::String> recency;
+    std::set<juce::String> building;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeStore)
+};
+
+#endif
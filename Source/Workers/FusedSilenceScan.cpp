@@ -0,0 +1,130 @@
+#include "Workers/FusedSilenceScan.h"
+#include "Workers/ChunkScanner.h"
+#include "Workers/ParallelSilenceScan.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+#include <algorithm>
+
+FusedSilenceScan::Boundaries
+FusedSilenceScan::findBoundaries(juce::AudioFormatReader &reader, float thresholdIn,
+                                 float thresholdOut, const ScanContext &inContext,
+                                 const ScanContext &outContext) {
+    if (!SilenceAnalysisAlgorithms::isScannable(reader) || reader.lengthInSamples <= 0)
+        return {};
+
+    return ParallelSilenceScan::supportsParallelSeeking(reader)
+               ? alternate(reader, thresholdIn, thresholdOut, inContext, outContext)
+               : headAndTail(reader, thresholdIn, thresholdOut, inContext, outContext);
+}
+
+/**
+ * @details `front` is the end of the prefix the forward side has proven silent and `back`
+ *          the start of the suffix the backward side has proven silent; both only move
+ *          after a successful read. With a shared Threshold the first crossing can never
+ *          lie in the cleared suffix, nor the last one in the cleared prefix, so each side
+ *          stops at the other's frontier (or at the other's hit) instead of at the file
+ *          edge. With different Thresholds the sides are independent and only share the
+ *          reader; each side tests its chunks through its own ChunkScanner.
+ */
+FusedSilenceScan::Boundaries
+FusedSilenceScan::alternate(juce::AudioFormatReader &reader, float thresholdIn,
+                            float thresholdOut, const ScanContext &inContext,
+                            const ScanContext &outContext) {
+    const juce::int64 length = reader.lengthInSamples;
+    const bool shared = thresholdIn == thresholdOut;
+    ChunkScanner inScanner(reader, thresholdIn);
+    ChunkScanner outScanner(reader, thresholdOut);
+
+    Boundaries result;
+    bool inDone = false;
+    bool outDone = false;
+    juce::int64 front = 0;
+    juce::int64 back = length;
+
+    while (!inDone || !outDone) {
+        if (!inDone) {
+            const juce::int64 inEnd =
+                !shared ? length : (outDone && result.out >= 0 ? result.out + 1 : back);
+            if (inContext.shouldStop()) {
+                result.in = SilenceAnalysisAlgorithms::aborted;
+                inDone = true;
+            } else if (front >= inEnd) {
+                inDone = true;
+            } else {
+                const int numThisTime = (int)std::min(
+                    (juce::int64)SilenceAnalysisAlgorithms::chunkSize, inEnd - front);
+                const int hit = inScanner.findFirstAbove(front, numThisTime);
+                if (hit == ChunkScanner::readFailed) {
+                    result.in = SilenceAnalysisAlgorithms::aborted;
+                    inDone = true;
+                } else {
+                    inContext.pace(numThisTime);
+                    if (hit >= 0) {
+                        result.in = front + hit;
+                        inDone = true;
+                    } else {
+                        front += numThisTime;
+                    }
+                }
+            }
+        }
+
+        if (!outDone) {
+            const juce::int64 outStart =
+                !shared ? 0 : (inDone && result.in >= 0 ? result.in : front);
+            if (outContext.shouldStop()) {
+                result.out = SilenceAnalysisAlgorithms::aborted;
+                outDone = true;
+            } else if (back <= outStart) {
+                outDone = true;
+            } else {
+                const int numThisTime = (int)std::min(
+                    (juce::int64)SilenceAnalysisAlgorithms::chunkSize, back - outStart);
+                const juce::int64 startSample = back - numThisTime;
+                const int hit = outScanner.findLastAbove(startSample, numThisTime);
+                if (hit == ChunkScanner::readFailed) {
+                    result.out = SilenceAnalysisAlgorithms::aborted;
+                    outDone = true;
+                } else {
+                    outContext.pace(numThisTime);
+                    if (hit >= 0) {
+                        result.out = startSample + hit;
+                        outDone = true;
+                    } else {
+                        back = startSample;
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @details Decoders of compressed formats only stream efficiently forwards, so neither
+ *          side ever reads backwards: In streams forwards from the start and stops at the
+ *          first crossing, then Out decodes tail windows forwards from the end
+ *          (SilenceAnalysisAlgorithms::findLastAbove()). With a shared Threshold Out never
+ *          looks before In, so the two sides together decode the file at most once.
+ */
+FusedSilenceScan::Boundaries
+FusedSilenceScan::headAndTail(juce::AudioFormatReader &reader, float thresholdIn,
+                              float thresholdOut, const ScanContext &inContext,
+                              const ScanContext &outContext) {
+    const juce::int64 length = reader.lengthInSamples;
+
+    Boundaries result;
+    result.in = SilenceAnalysisAlgorithms::findFirstAboveInRange(reader, 0, length, thresholdIn,
+                                                                 inContext);
+
+    const bool shared = thresholdIn == thresholdOut;
+    if (shared && result.in == -1) {
+        result.out = outContext.shouldStop() ? SilenceAnalysisAlgorithms::aborted : -1;
+        return result;
+    }
+
+    const juce::int64 outStart = shared && result.in >= 0 ? result.in : 0;
+    result.out = SilenceAnalysisAlgorithms::findLastAbove(reader, outStart, length, thresholdOut,
+                                                          outContext);
+    return result;
+}
@@ -0,0 +1,72 @@
+#ifndef AUDIOFILER_FUSEDSILENCESCAN_H
+#define AUDIOFILER_FUSEDSILENCESCAN_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Workers/ScanContext.h"
+
+/**
+ * @file FusedSilenceScan.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Single-reader pass that finds both Autocut boundaries of a file at once.
+ *
+ * @details Architecturally, FusedSilenceScan is a "Pure Logic Engine" used by the
+ *          SilenceAnalysisWorker when In and Out are requested for the same file. Running
+ *          the two directional scans separately opens and primes two decoders; this pass
+ *          opens one and shares it between both directions.
+ *
+ *          - **Seekable formats** (WAV/AIFF): chunks are read alternately from the front
+ *            and the back, each side stopping as soon as its boundary is found. For the
+ *            typical file with short leading and trailing silence both boundaries fall
+ *            out of the first one or two chunks of each end.
+ *          - **Compressed formats**: seeking backwards would re-decode from a sync point
+ *            for every chunk, so nothing is read backwards: In streams forwards from the
+ *            start, and Out decodes growing tail windows forwards from the end, one seek
+ *            per window.
+ *
+ *          When both Thresholds are equal the two sides also bound each other: the
+ *          forward side never needs to pass the region the backward side has cleared,
+ *          and vice versa, so a silent file is read exactly once.
+ *
+ * @see SilenceAnalysisAlgorithms
+ * @see ParallelSilenceScan
+ * @see SilenceAnalysisWorker
+ */
+class FusedSilenceScan final {
+  public:
+    /** @brief Result of a fused pass; each field follows SilenceAnalysisAlgorithms' range scans. */
+    struct Boundaries {
+        juce::int64 in = -1;  /**< First crossing, -1 if none, or `aborted`. */
+        juce::int64 out = -1; /**< Last crossing, -1 if none, or `aborted`. */
+    };
+
+    /**
+     * @brief Finds the first and last non-silent samples with one reader.
+     * @param reader A private reader for the file.
+     * @param thresholdIn The amplitude threshold for the In boundary.
+     * @param thresholdOut The amplitude threshold for the Out boundary.
+     * @param inContext Cancellation and pacing policy of the In request.
+     * @param outContext Cancellation and pacing policy of the Out request.
+     * @return Both boundaries; a cancelled side reports `aborted` without stopping the other.
+     */
+    static Boundaries findBoundaries(juce::AudioFormatReader &reader, float thresholdIn,
+                                     float thresholdOut, const ScanContext &inContext,
+                                     const ScanContext &outContext);
+
+  private:
+    static Boundaries alternate(juce::AudioFormatReader &reader, float thresholdIn,
+                                float thresholdOut, const ScanContext &inContext,
+                                const ScanContext &outContext);
+
+    static Boundaries headAndTail(juce::AudioFormatReader &reader, float thresholdIn,
+                                  float thresholdOut, const ScanContext &inContext,
+                                  const ScanContext &outContext);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "Workers/IoGovernor.h"
+#include "Core/PlaybackHealth.h"
+#include "Utils/Config.h"
+
+IoGovernor::IoGovernor(const PlaybackHealth *health) : playbackHealth(health) {
+}
+
+int IoGovernor::admit(int numSamples) noexcept {
+    samplesProcessed.fetch_add(numSamples, std::memory_order_relaxed);
+
+    const Level chosen =
+        playbackHealth == nullptr
+            ? Level::Unthrottled
+            : chooseLevel(playbackHealth->isPlaying(), playbackHealth->getCallbackLoad(),
+                          playbackHealth->getReadAheadFill());
+    level.store((int)chosen, std::memory_order_relaxed);
+    return getYieldMs(chosen);
+}
+
+/**
+ * @details Either gauge alone can raise the level; the worse of the two wins. The
+ *          buffer limits are lower bounds on the fill, the load limits upper bounds on
+ *          the callback budget.
+ */
+IoGovernor::Level IoGovernor::chooseLevel(bool playing, float callbackLoad,
+                                          float readAheadFill) noexcept {
+    if (!playing)
+        return Level::Unthrottled;
+
+    if (callbackLoad >= Config::Audio::ioGovernorHeavyLoad ||
+        readAheadFill < Config::Audio::ioGovernorHeavyFill)
+        return Level::Heavy;
+    if (callbackLoad >= Config::Audio::ioGovernorModerateLoad ||
+        readAheadFill < Config::Audio::ioGovernorModerateFill)
+        return Level::Moderate;
+    if (callbackLoad >= Config::Audio::ioGovernorLightLoad ||
+        readAheadFill < Config::Audio::ioGovernorLightFill)
+        return Level::Light;
+    return Level::Unthrottled;
+}
+
+int IoGovernor::getYieldMs(Level throttle) noexcept {
+    switch (throttle) {
+    case Level::Light:
+        return Config::Audio::ioGovernorLightYieldMs;
+    case Level::Moderate:
+        return Config::Audio::ioGovernorModerateYieldMs;
+    case Level::Heavy:
+        return Config::Audio::ioGovernorHeavyYieldMs;
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef AUDIOFILER_IOGOVERNOR_H
+#define AUDIOFILER_IOGOVERNOR_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+
+class PlaybackHealth;
+
+/**
+ * @file IoGovernor.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Adaptive pacing of background analysis I/O against playback health.
+ *
+ * @details Architecturally, IoGovernor is the single arbiter between foreground playback
+ *          and every background scan. Scan loops report each chunk they read through
+ *          ScanContext::pace(); the governor answers with how long the loop should yield,
+ *          derived from the AudioPlayer's PlaybackHealth at that moment:
+ *
+ *          - While nothing is playing, or playback has ample callback headroom and a full
+ *            read-ahead buffer, analysis runs flat out (`Level::Unthrottled`).
+ *          - As the callback load rises or the read-ahead buffer drains past the limits in
+ *            `Config::Audio`, the level steps up through `Light`, `Moderate` and `Heavy`,
+ *            each with a longer per-chunk yield.
+ *
+ *          The governor also counts every sample it admits, so the stats overlay can show
+ *          the throughput analysis actually achieves next to the level it is held at.
+ *          All members are atomics; any number of scan threads may call admit()
+ *          concurrently.
+ *
+ * @see PlaybackHealth
+ * @see ScanContext
+ * @see StatsPresenter
+ */
+class IoGovernor final {
+  public:
+    /** @brief Throttle levels, from running flat out to yielding the most. */
+    enum class Level { Unthrottled, Light, Moderate, Heavy };
+
+    /**
+     * @brief Constructs a governor.
+     * @param health The playback gauges to watch, or nullptr to never throttle.
+     */
+    explicit IoGovernor(const PlaybackHealth *health);
+
+    /**
+     * @brief Records a chunk read by a scan and decides how long the scan should yield.
+     * @param numSamples The number of sample frames just read.
+     * @return The yield in milliseconds; 0 means continue immediately.
+     */
+    int admit(int numSamples) noexcept;
+
+    /** @return The level chosen by the most recent admit(). */
+    Level getLevel() const noexcept {
+        return (Level)level.load(std::memory_order_relaxed);
+    }
+
+    /** @return Sample frames admitted since construction; deltas give throughput. */
+    juce::int64 getSamplesProcessed() const noexcept {
+        return samplesProcessed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Maps playback gauges to a throttle level.
+     * @param playing True if the transport is rolling.
+     * @param callbackLoad The smoothed audio callback load (1.0 = full budget).
+     * @param readAheadFill The read-ahead buffer fill in [0, 1].
+     * @return The level; always `Unthrottled` while stopped.
+     */
+    static Level chooseLevel(bool playing, float callbackLoad, float readAheadFill) noexcept;
+
+    /**
+     * @brief The per-chunk yield of a level.
+     * @param throttle The throttle level.
+     * @return The yield in milliseconds.
+     */
+    static int getYieldMs(Level throttle) noexcept;
+
+  private:
+    const PlaybackHealth *const playbackHealth;
+    std::atomic<int> level{(int)Level::Unthrottled};
+    std::atomic<juce::int64> samplesProcessed{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(IoGovernor)
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "Workers/LevelStats.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr juce::int32 kMagic = 0x534C4641; // "AFLS"
+constexpr juce::int32 kVersion = 1;
+} // namespace
+
+LevelStats::Builder::Builder(juce::int64 length, int numChannels)
+    : stats(std::make_unique<LevelStats>()) {
+    stats->lengthInSamples = length;
+    LevelStats::Channel empty;
+    empty.minimum = std::numeric_limits<float>::max();
+    empty.maximum = std::numeric_limits<float>::lowest();
+    stats->channels.assign((size_t)std::max(0, numChannels), empty);
+}
+
+/**
+ * @details One loop per channel updates all five statistics, so each sample is loaded
+ *          once. The sums of a chunk are kept in double precision; a float sum of 65536
+ *          squares would already lose the last bits of a quiet file's RMS.
+ */
+void LevelStats::Builder::addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+    if (stats == nullptr || numSamples <= 0)
+        return;
+
+    const int numChannels = std::min(buffer.getNumChannels(), stats->getNumChannels());
+    const float clipLevel = Config::Audio::levelStatsClipLevel;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const float *samples = buffer.getReadPointer(ch);
+        auto &channel = stats->channels[(size_t)ch];
+        float minimum = channel.minimum;
+        float maximum = channel.maximum;
+        double sum = 0.0;
+        double sumOfSquares = 0.0;
+        juce::int64 clips = 0;
+        for (int i = 0; i < numSamples; ++i) {
+            const float sample = samples[i];
+            minimum = std::min(minimum, sample);
+            maximum = std::max(maximum, sample);
+            sum += sample;
+            sumOfSquares += (double)sample * (double)sample;
+            clips += std::abs(sample) >= clipLevel ? 1 : 0;
+        }
+        channel.minimum = minimum;
+        channel.maximum = maximum;
+        channel.sum += sum;
+        channel.sumOfSquares += sumOfSquares;
+        channel.clipCount += clips;
+    }
+    stats->numFrames += numSamples;
+}
+
+std::unique_ptr<LevelStats> LevelStats::Builder::finish() {
+    if (stats != nullptr && stats->numFrames == 0)
+        for (auto &channel : stats->channels)
+            channel = LevelStats::Channel();
+    return std::move(stats);
+}
+
+float LevelStats::getPeak(int channel) const {
+    if (numFrames <= 0)
+        return 0.0f;
+    const auto &stats = getChannel(channel);
+    return std::max(std::abs(stats.minimum), std::abs(stats.maximum));
+}
+
+float LevelStats::getRms(int channel) const {
+    if (numFrames <= 0)
+        return 0.0f;
+    return (float)std::sqrt(getChannel(channel).sumOfSquares / (double)numFrames);
+}
+
+float LevelStats::getDcOffset(int channel) const {
+    if (numFrames <= 0)
+        return 0.0f;
+    return (float)(getChannel(channel).sum / (double)numFrames);
+}
+
+bool LevelStats::writeTo(juce::OutputStream &output) const {
+    bool ok = output.writeInt(kMagic) && output.writeInt(kVersion) &&
+              output.writeInt64(lengthInSamples) && output.writeInt64(numFrames) &&
+              output.writeInt(getNumChannels());
+    for (const auto &channel : channels)
+        ok = ok && output.writeFloat(channel.minimum) && output.writeFloat(channel.maximum) &&
+             output.writeDouble(channel.sum) && output.writeDouble(channel.sumOfSquares) &&
+             output.writeInt64(channel.clipCount);
+    return ok;
+}
+
+std::unique_ptr<LevelStats> LevelStats::readFrom(juce::InputStream &input) {
+    if (input.readInt() != kMagic || input.readInt() != kVersion)
+        return nullptr;
+
+    auto stats = std::make_unique<LevelStats>();
+    stats->lengthInSamples = input.readInt64();
+    stats->numFrames = input.readInt64();
+    const int numChannels = input.readInt();
+    if (stats->lengthInSamples <= 0 || stats->numFrames < 0 || numChannels <= 0 ||
+        numChannels > 128)
+        return nullptr;
+
+    stats->channels.resize((size_t)numChannels);
+    for (auto &channel : stats->channels) {
+        if (input.isExhausted())
+            return nullptr;
+        channel.minimum = input.readFloat();
+        channel.maximum = input.readFloat();
+        channel.sum = input.readDouble();
+        channel.sumOfSquares = input.readDouble();
+        channel.clipCount = input.readInt64();
+        if (channel.clipCount < 0 || channel.sumOfSquares < 0.0)
+            return nullptr;
+    }
+    return stats;
+}
@@ -0,0 +1,123 @@
+#ifndef AUDIOFILER_LEVELSTATS_H
+#define AUDIOFILER_LEVELSTATS_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file LevelStats.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Exact per-channel level statistics of one file: peak, RMS, DC offset and clips.
+ *
+ * @details Architecturally, LevelStats is an immutable "Passive Data Model" built by the
+ *          same AnalysisPipeline pass as the rest of a file's envelope, and shown by the
+ *          stats overlay in place of the thumbnail's approximate min/max.
+ *
+ *          Per channel it keeps the smallest and largest sample, the sum and the sum of
+ *          squares (in double precision, so hours of audio do not lose the DC offset), and
+ *          the number of samples at or beyond `Config::Audio::levelStatsClipLevel`. The
+ *          builder gathers all of them in one fused loop per channel and chunk.
+ *
+ * @see AnalysisPipeline
+ * @see EnvelopeStore
+ * @see StatsPresenter
+ */
+class LevelStats final {
+  public:
+    /**
+     * @class Builder
+     * @brief Accumulates the statistics chunk by chunk during a forward streaming pass.
+     */
+    class Builder {
+      public:
+        /**
+         * @brief Prepares a builder for one file.
+         * @param lengthInSamples The file length in samples.
+         * @param numChannels The number of channels the chunks carry.
+         */
+        Builder(juce::int64 lengthInSamples, int numChannels);
+
+        /**
+         * @brief Consumes the next chunk of the file, in order.
+         * @param buffer Decoded samples; only the first `numSamples` are used.
+         * @param numSamples The number of valid samples in the buffer.
+         */
+        void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples);
+
+        /**
+         * @brief Finalizes the statistics.
+         * @return The finished statistics.
+         */
+        std::unique_ptr<LevelStats> finish();
+
+      private:
+        std::unique_ptr<LevelStats> stats;
+    };
+
+    /** @brief Statistics of one channel. */
+    struct Channel {
+        float minimum = 0.0f;       /**< Most negative sample. */
+        float maximum = 0.0f;       /**< Most positive sample. */
+        double sum = 0.0;           /**< Sum of all samples. */
+        double sumOfSquares = 0.0;  /**< Sum of all squared samples. */
+        juce::int64 clipCount = 0;  /**< Samples at or beyond the clip level. */
+    };
+
+    /** @return The number of channels. */
+    int getNumChannels() const {
+        return (int)channels.size();
+    }
+
+    /** @return The length of the analysed file in samples. */
+    juce::int64 getLengthInSamples() const {
+        return lengthInSamples;
+    }
+
+    /** @return The number of samples per channel that were counted. */
+    juce::int64 getNumFrames() const {
+        return numFrames;
+    }
+
+    /** @return The raw statistics of one channel. */
+    const Channel &getChannel(int channel) const {
+        return channels[(size_t)channel];
+    }
+
+    /** @return The largest sample magnitude of a channel, or 0 if nothing was counted. */
+    float getPeak(int channel) const;
+
+    /** @return The root mean square level of a channel. */
+    float getRms(int channel) const;
+
+    /** @return The mean sample value (DC offset) of a channel. */
+    float getDcOffset(int channel) const;
+
+    /**
+     * @brief Serializes the statistics.
+     * @param output The stream to write to.
+     * @return True on success.
+     */
+    bool writeTo(juce::OutputStream &output) const;
+
+    /**
+     * @brief Deserializes statistics written by writeTo().
+     * @param input The stream to read from.
+     * @return The statistics, or null if the data is malformed or of another version.
+     */
+    static std::unique_ptr<LevelStats> readFrom(juce::InputStream &input);
+
+  private:
+    juce::int64 lengthInSamples = 0;
+    juce::int64 numFrames = 0;
+    std::vector<Channel> channels;
+};
+
+#endif
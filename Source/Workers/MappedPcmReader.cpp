@@ -0,0 +1,368 @@
+#include "Workers/MappedPcmReader.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD || JUCE_ANDROID
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/** Every chunk header before the sample data must lie within this much of the file start. */
+constexpr int kHeaderProbeBytes = 1 << 20;
+
+bool hasTag(const juce::uint8 *bytes, const char *tag) {
+    return std::memcmp(bytes, tag, 4) == 0;
+}
+
+std::optional<MappedPcmReader::Layout> makeLayout(bool isFloat, int bits, int channels,
+                                                  juce::int64 dataOffset, juce::int64 dataBytes,
+                                                  bool bigEndian) {
+    using Encoding = MappedPcmReader::Encoding;
+    if (channels <= 0 || dataOffset < 0 || dataBytes < 0)
+        return std::nullopt;
+
+    MappedPcmReader::Layout layout;
+    if (isFloat && bits == 32)
+        layout.encoding = Encoding::Float32;
+    else if (!isFloat && bits == 16)
+        layout.encoding = Encoding::Int16;
+    else if (!isFloat && bits == 24)
+        layout.encoding = Encoding::Int24;
+    else if (!isFloat && bits == 32)
+        layout.encoding = Encoding::Int32;
+    else
+        return std::nullopt;
+
+    layout.dataOffset = dataOffset;
+    layout.dataBytes = dataBytes;
+    layout.numChannels = channels;
+    layout.bigEndian = bigEndian;
+    return layout;
+}
+
+std::optional<MappedPcmReader::Layout> parseWave(const juce::uint8 *bytes, size_t numBytes,
+                                                 bool rf64) {
+    constexpr int formatPcm = 1, formatFloat = 3, formatExtensible = 0xfffe;
+    int formatTag = -1, channels = 0, blockAlign = 0, bits = 0;
+    juce::int64 ds64DataBytes = -1;
+
+    for (size_t pos = 12; pos + 8 <= numBytes;) {
+        const juce::uint8 *chunk = bytes + pos;
+        const juce::uint32 size = juce::ByteOrder::littleEndianInt(chunk + 4);
+        const size_t body = pos + 8;
+
+        if (hasTag(chunk, "ds64") && body + 16 <= numBytes) {
+            ds64DataBytes = (juce::int64)juce::ByteOrder::littleEndianInt64(bytes + body + 8);
+        } else if (hasTag(chunk, "fmt ") && size >= 16 && body + 16 <= numBytes) {
+            formatTag = juce::ByteOrder::littleEndianShort(bytes + body);
+            channels = juce::ByteOrder::littleEndianShort(bytes + body + 2);
+            blockAlign = juce::ByteOrder::littleEndianShort(bytes + body + 12);
+            bits = juce::ByteOrder::littleEndianShort(bytes + body + 14);
+            if (formatTag == formatExtensible && size >= 26 && body + 26 <= numBytes)
+                formatTag = juce::ByteOrder::littleEndianShort(bytes + body + 24);
+        } else if (hasTag(chunk, "data")) {
+            if ((formatTag != formatPcm && formatTag != formatFloat) ||
+                blockAlign != channels * (bits / 8))
+                return std::nullopt;
+            const juce::int64 dataBytes =
+                (rf64 && size == 0xffffffffu) ? ds64DataBytes : (juce::int64)size;
+            return makeLayout(formatTag == formatFloat, bits, channels, (juce::int64)body,
+                              dataBytes, false);
+        }
+        pos = body + size + (size & 1);
+    }
+    return std::nullopt;
+}
+
+std::optional<MappedPcmReader::Layout> parseAiff(const juce::uint8 *bytes, size_t numBytes,
+                                                 bool aifc) {
+    int channels = 0, bits = 0;
+    bool haveCommon = false, isFloat = false, bigEndian = true, supported = true;
+    juce::int64 dataOffset = -1, dataBytes = 0;
+
+    for (size_t pos = 12; pos + 8 <= numBytes && !(haveCommon && dataOffset >= 0);) {
+        const juce::uint8 *chunk = bytes + pos;
+        const juce::uint32 size = juce::ByteOrder::bigEndianInt(chunk + 4);
+        const size_t body = pos + 8;
+
+        if (hasTag(chunk, "COMM") && size >= 18 && body + 18 <= numBytes) {
+            haveCommon = true;
+            channels = juce::ByteOrder::bigEndianShort(bytes + body);
+            bits = juce::ByteOrder::bigEndianShort(bytes + body + 6);
+            if (aifc && size >= 22 && body + 22 <= numBytes) {
+                const juce::uint8 *compression = bytes + body + 18;
+                if (hasTag(compression, "sowt"))
+                    bigEndian = false;
+                else if (hasTag(compression, "fl32") || hasTag(compression, "FL32"))
+                    isFloat = true;
+                else if (!hasTag(compression, "NONE") && !hasTag(compression, "twos"))
+                    supported = false;
+            }
+        } else if (hasTag(chunk, "SSND") && size >= 8 && body + 8 <= numBytes) {
+            const juce::uint32 offset = juce::ByteOrder::bigEndianInt(bytes + body);
+            dataOffset = (juce::int64)body + 8 + offset;
+            dataBytes = (juce::int64)size - 8 - offset;
+        }
+        pos = body + size + (size & 1);
+    }
+
+    if (!haveCommon || dataOffset < 0 || !supported)
+        return std::nullopt;
+    return makeLayout(isFloat, bits, channels, dataOffset, dataBytes, bigEndian);
+}
+
+/** @brief De-interleaves one encoding; `decode` turns the bytes of one sample into a float. */
+template <typename Decode>
+void deinterleave(const MappedPcmReader::Layout &layout, const char *frames, int numFrames,
+                  float *const *dest, int numDestChannels, int destOffset, Decode decode) {
+    const int frameBytes = layout.getBytesPerFrame();
+    for (int ch = 0; ch < numDestChannels; ++ch) {
+        if (dest[ch] == nullptr)
+            continue;
+        float *out = dest[ch] + destOffset;
+        if (ch >= layout.numChannels) {
+            juce::FloatVectorOperations::clear(out, numFrames);
+            continue;
+        }
+        const char *in = frames + ch * layout.getBytesPerSample();
+        for (int i = 0; i < numFrames; ++i, in += frameBytes)
+            out[i] = decode(in);
+    }
+}
+
+float floatFromBits(juce::uint32 bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void adviseSequential(void *data, size_t numBytes) {
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD || JUCE_ANDROID
+    ::madvise(data, numBytes, MADV_SEQUENTIAL);
+#else
+    juce::ignoreUnused(data, numBytes);
+#endif
+}
+
+void adviseWillNeed(const char *data, size_t numBytes) {
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD || JUCE_ANDROID
+    const auto pageSize = (std::uintptr_t)::sysconf(_SC_PAGESIZE);
+    const auto first = (std::uintptr_t)data & ~(pageSize - 1);
+    ::madvise((void *)first, (size_t)((std::uintptr_t)data + numBytes - first), MADV_WILLNEED);
+#else
+    juce::ignoreUnused(data, numBytes);
+#endif
+}
+} // namespace
+
+int MappedPcmReader::Layout::getBytesPerSample() const noexcept {
+    switch (encoding) {
+    case Encoding::Int16:
+        return 2;
+    case Encoding::Int24:
+        return 3;
+    case Encoding::Int32:
+    case Encoding::Float32:
+        return 4;
+    }
+    return 4;
+}
+
+std::unique_ptr<MappedPcmReader> MappedPcmReader::createFor(
+    const juce::File &file, const juce::AudioFormatReader &decoded) {
+    juce::FileInputStream stream(file);
+    if (!stream.openedOk())
+        return nullptr;
+
+    juce::HeapBlock<char> header((size_t)kHeaderProbeBytes);
+    const int numRead = stream.read(header.get(), kHeaderProbeBytes);
+    if (numRead <= 0)
+        return nullptr;
+
+    const auto layout = parseLayout(header.get(), (size_t)numRead);
+    if (!layout.has_value())
+        return nullptr;
+
+    // Trust the mapping only where the decoder reads the file the same way.
+    const bool isFloat = layout->encoding == Encoding::Float32;
+    const juce::int64 frameBytes = layout->getBytesPerFrame();
+    if (layout->numChannels != (int)decoded.numChannels ||
+        layout->getBytesPerSample() * 8 != (int)decoded.bitsPerSample ||
+        decoded.usesFloatingPointData != isFloat || decoded.lengthInSamples <= 0 ||
+        decoded.lengthInSamples > layout->dataBytes / frameBytes ||
+        layout->dataOffset + decoded.lengthInSamples * frameBytes > file.getSize())
+        return nullptr;
+
+    return std::unique_ptr<MappedPcmReader>(new MappedPcmReader(file, *layout, decoded));
+}
+
+std::optional<MappedPcmReader::Layout> MappedPcmReader::parseLayout(const void *header,
+                                                                    size_t numBytes) {
+    const auto *bytes = static_cast<const juce::uint8 *>(header);
+    if (header == nullptr || numBytes < 12)
+        return std::nullopt;
+
+    if ((hasTag(bytes, "RIFF") || hasTag(bytes, "RF64")) && hasTag(bytes + 8, "WAVE"))
+        return parseWave(bytes, numBytes, hasTag(bytes, "RF64"));
+    if (hasTag(bytes, "FORM") && (hasTag(bytes + 8, "AIFF") || hasTag(bytes + 8, "AIFC")))
+        return parseAiff(bytes, numBytes, hasTag(bytes + 8, "AIFC"));
+    return std::nullopt;
+}
+
+/**
+ * @details The scale factors are powers of two, so every integer sample converts exactly
+ *          and matches the JUCE decoders' fixed-to-float conversion bit for bit.
+ */
+void MappedPcmReader::convertFrames(const Layout &layout, const char *frames, int numFrames,
+                                    float *const *dest, int numDestChannels, int destOffset) {
+    using juce::ByteOrder;
+    const bool big = layout.bigEndian;
+    switch (layout.encoding) {
+    case Encoding::Int16:
+        deinterleave(layout, frames, numFrames, dest, numDestChannels, destOffset,
+                     [big](const char *p) {
+                         const auto raw = big ? ByteOrder::bigEndianShort(p)
+                                              : ByteOrder::littleEndianShort(p);
+                         return (float)(juce::int16)raw * (1.0f / 32768.0f);
+                     });
+        break;
+    case Encoding::Int24:
+        deinterleave(layout, frames, numFrames, dest, numDestChannels, destOffset,
+                     [big](const char *p) {
+                         const int raw = big ? ByteOrder::bigEndian24Bit(p)
+                                             : ByteOrder::littleEndian24Bit(p);
+                         return (float)raw * (1.0f / 8388608.0f);
+                     });
+        break;
+    case Encoding::Int32:
+        deinterleave(layout, frames, numFrames, dest, numDestChannels, destOffset,
+                     [big](const char *p) {
+                         const auto raw =
+                             big ? ByteOrder::bigEndianInt(p) : ByteOrder::littleEndianInt(p);
+                         return (float)(juce::int32)raw * (1.0f / 2147483648.0f);
+                     });
+        break;
+    case Encoding::Float32:
+        deinterleave(layout, frames, numFrames, dest, numDestChannels, destOffset,
+                     [big](const char *p) {
+                         return floatFromBits(big ? ByteOrder::bigEndianInt(p)
+                                                  : ByteOrder::littleEndianInt(p));
+                     });
+        break;
+    }
+}
+
+MappedPcmReader::MappedPcmReader(const juce::File &fileToMap, const Layout &pcmLayout,
+                                 const juce::AudioFormatReader &decoded)
+    : juce::AudioFormatReader(nullptr, decoded.getFormatName()), file(fileToMap),
+      layout(pcmLayout) {
+    sampleRate = decoded.sampleRate;
+    bitsPerSample = decoded.bitsPerSample;
+    lengthInSamples = decoded.lengthInSamples;
+    numChannels = decoded.numChannels;
+    usesFloatingPointData = true; // readSamples() always delivers floats
+}
+
+bool MappedPcmReader::readSamples(int *const *destChannels, int numDestChannels,
+                                  int startOffsetInDestBuffer, juce::int64 startSampleInFile,
+                                  int numSamples) {
+    clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                      startSampleInFile, numSamples, lengthInSamples);
+    if (numSamples <= 0)
+        return true;
+
+    const char *frames = mapFrames(startSampleInFile, numSamples);
+    if (frames == nullptr)
+        return false;
+
+    convertFrames(layout, frames, numSamples, reinterpret_cast<float *const *>(destChannels),
+                  numDestChannels, startOffsetInDestBuffer);
+    return true;
+}
+
+const char *MappedPcmReader::mapFrames(juce::int64 startSample, int numSamples) {
+    const juce::int64 end = startSample + numSamples;
+    if (startSample < 0 || numSamples < 0 || end > lengthInSamples)
+        return nullptr;
+
+    auto *window = std::find_if(windows.begin(), windows.end(), [&](const Window &w) {
+        return w.map != nullptr && startSample >= w.start && end <= w.end;
+    });
+    if (window == windows.end()) {
+        window = &nearestWindow(startSample, end);
+        const bool backward = window->map != nullptr && startSample < window->start;
+        window->lastStart = -1;
+        if (!remap(*window, startSample, end, backward))
+            return nullptr;
+    }
+
+    const bool backward = window->lastStart >= 0 && startSample < window->lastStart;
+    window->lastStart = startSample;
+
+    const juce::int64 frameBytes = layout.getBytesPerFrame();
+    const juce::int64 fileOffset = layout.dataOffset + startSample * frameBytes;
+    const char *data = static_cast<const char *>(window->map->getData()) +
+                       (fileOffset - window->map->getRange().getStart());
+
+    // Readahead only follows forward faults; a reverse crawl asks for each chunk up front.
+    if (backward)
+        adviseWillNeed(data, (size_t)(numSamples * frameBytes));
+    return data;
+}
+
+/**
+ * @details An empty slot is used first. Otherwise the stream that ran off the edge of its
+ *          window is the one whose window lies closest to the request, so the fused scan's
+ *          forward and backward sides each keep their own window.
+ */
+MappedPcmReader::Window &MappedPcmReader::nearestWindow(juce::int64 start, juce::int64 end) {
+    const auto distance = [start, end](const Window &w) {
+        if (w.map == nullptr)
+            return (juce::int64)-1;
+        return start >= w.end ? start - w.end : w.start >= end ? w.start - end : (juce::int64)0;
+    };
+    return *std::min_element(windows.begin(), windows.end(),
+                             [&](const Window &a, const Window &b) {
+                                 return distance(a) < distance(b);
+                             });
+}
+
+/**
+ * @details The window always covers at least the request. It extends forwards from a
+ *          forward read and backwards from a backward one, so a scan in either direction
+ *          crosses each window boundary once. `juce::MemoryMappedFile` rounds the start
+ *          down to a page boundary; addresses are resolved against its actual range.
+ */
+bool MappedPcmReader::remap(Window &window, juce::int64 start, juce::int64 end, bool backward) {
+    window.map.reset(); // release the address space before claiming the next window
+
+    const juce::int64 frameBytes = layout.getBytesPerFrame();
+    const juce::int64 windowFrames =
+        std::max(end - start, Config::Audio::mappedWindowBytes / frameBytes);
+    juce::int64 first = 0;
+    juce::int64 last = lengthInSamples;
+    if (lengthInSamples > windowFrames) {
+        first = backward ? std::max((juce::int64)0, end - windowFrames) : start;
+        last = std::min(lengthInSamples, first + windowFrames);
+        first = std::max((juce::int64)0, last - windowFrames);
+    }
+
+    const juce::Range<juce::int64> bytes(layout.dataOffset + first * frameBytes,
+                                         layout.dataOffset + last * frameBytes);
+    auto mapped =
+        std::make_unique<juce::MemoryMappedFile>(file, bytes, juce::MemoryMappedFile::readOnly);
+    if (mapped->getData() == nullptr || mapped->getRange().getStart() > bytes.getStart() ||
+        mapped->getRange().getEnd() < bytes.getEnd())
+        return false;
+
+    if (!backward)
+        adviseSequential(mapped->getData(), mapped->getSize());
+    window.map = std::move(mapped);
+    window.start = first;
+    window.end = last;
+    return true;
+}
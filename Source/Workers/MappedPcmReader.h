@@ -0,0 +1,139 @@
+#ifndef AUDIOFILER_MAPPEDPCMREADER_H
+#define AUDIOFILER_MAPPEDPCMREADER_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <array>
+#include <memory>
+#include <optional>
+
+/**
+ * @file MappedPcmReader.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Zero-copy reader that serves uncompressed WAV/AIFF audio straight from a file mapping.
+ *
+ * @details Architecturally, MappedPcmReader is a drop-in `juce::AudioFormatReader` for the
+ *          analysis paths. A decoding reader pulls every chunk through `read()` system
+ *          calls into its own buffer before converting it; this reader maps the PCM data
+ *          into the address space instead and converts samples directly out of the page
+ *          cache, so the kernel streams pages at disk speed and no intermediate copy is
+ *          made. Scan loops, parallel segments, envelope builds and gap scans all use it
+ *          through the plain reader interface.
+ *
+ *          Files that fit `Config::Audio::mappedWindowBytes` are mapped whole. Longer
+ *          files are mapped one page-aligned window at a time; the window slides in the
+ *          direction the reads travel, so forward and backward scans both remap only once
+ *          per window. Two windows are kept, so the fused scan's In and Out sides do not
+ *          evict each other. Forward windows are advised as sequential; backward reads
+ *          prefetch exactly the chunk being read.
+ *
+ *          Only interleaved 16/24/32-bit integer and 32-bit float PCM is handled. Anything
+ *          else, or any header the probe cannot vouch for, makes createFor() return
+ *          nullptr and the caller keeps the decoding reader. Samples convert exactly as
+ *          the JUCE decoders convert them, so both readers yield identical cut points.
+ *
+ * @see SilenceAnalysisWorker
+ * @see SilenceAnalysisAlgorithms
+ */
+class MappedPcmReader final : public juce::AudioFormatReader {
+  public:
+    /** @brief Storage format of one sample in the file. */
+    enum class Encoding { Int16, Int24, Int32, Float32 };
+
+    /** @brief Where the interleaved PCM lives in the file and how it is stored. */
+    struct Layout {
+        juce::int64 dataOffset = 0; /**< Byte offset of the first frame. */
+        juce::int64 dataBytes = 0;  /**< Size of the sample data in bytes. */
+        int numChannels = 0;
+        Encoding encoding = Encoding::Int16;
+        bool bigEndian = false;
+
+        /** @return The size of one sample in bytes. */
+        int getBytesPerSample() const noexcept;
+
+        /** @return The size of one interleaved frame in bytes. */
+        int getBytesPerFrame() const noexcept {
+            return numChannels * getBytesPerSample();
+        }
+    };
+
+    /**
+     * @brief Opens a mapped reader for a file a decoding reader has already accepted.
+     * @param file The audio file.
+     * @param decoded The decoding reader for the same file; its properties are copied and
+     *                must agree with the header probe.
+     * @return The mapped reader, or nullptr if the file is not plain PCM WAV/AIFF.
+     */
+    static std::unique_ptr<MappedPcmReader> createFor(const juce::File &file,
+                                                      const juce::AudioFormatReader &decoded);
+
+    /**
+     * @brief Locates the sample data in a RIFF/RF64 WAVE or AIFF/AIFC header.
+     * @param header The first bytes of the file.
+     * @param numBytes How many bytes `header` holds; the data chunk header must lie within.
+     * @return The layout, or nothing if the file is not supported PCM.
+     */
+    static std::optional<Layout> parseLayout(const void *header, size_t numBytes);
+
+    /**
+     * @brief De-interleaves and converts frames to float.
+     * @param layout The storage format of `frames`.
+     * @param frames The first frame.
+     * @param numFrames The number of frames to convert.
+     * @param dest Per-channel destinations; null entries are skipped, channels the file
+     *             does not have are zeroed.
+     * @param numDestChannels The number of entries in `dest`.
+     * @param destOffset The first destination index to write.
+     */
+    static void convertFrames(const Layout &layout, const char *frames, int numFrames,
+                              float *const *dest, int numDestChannels, int destOffset);
+
+    /** @brief Serves samples from the mapping, remapping the window when needed. */
+    bool readSamples(int *const *destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override;
+
+    /**
+     * @brief Maps a run of frames and returns the raw interleaved data.
+     * @param startSample The first frame.
+     * @param numSamples The number of frames; must lie within the file.
+     * @return A pointer valid until the next call, or nullptr if the mapping failed.
+     */
+    const char *mapFrames(juce::int64 startSample, int numSamples);
+
+    /** @return The storage format of the mapped data. */
+    const Layout &getLayout() const noexcept {
+        return layout;
+    }
+
+  private:
+    MappedPcmReader(const juce::File &file, const Layout &layout,
+                    const juce::AudioFormatReader &decoded);
+
+    /** @brief One mapped run of frames and the stream reading through it. */
+    struct Window {
+        std::unique_ptr<juce::MemoryMappedFile> map;
+        juce::int64 start = 0;      /**< First frame covered. */
+        juce::int64 end = 0;        /**< One past the last frame covered. */
+        juce::int64 lastStart = -1; /**< Start of the previous request, for the direction. */
+    };
+
+    /** @brief Picks the window a request that none covers should replace. */
+    Window &nearestWindow(juce::int64 start, juce::int64 end);
+
+    /** @brief Replaces a window with one covering at least frames `[start, end)`. */
+    bool remap(Window &window, juce::int64 start, juce::int64 end, bool backward);
+
+    const juce::File file;
+    const Layout layout;
+    std::array<Window, 2> windows; /**< One per read stream; the fused scan runs two. */
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MappedPcmReader)
+};
+
+#endif
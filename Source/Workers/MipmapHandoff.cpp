@@ -0,0 +1,164 @@
+#include "Workers/MipmapHandoff.h"
+
+#include <utility>
+
+namespace {
+/** @brief How often a Feed waiting for its lookup checks whether its job should exit. */
+constexpr int kLookupPollMs = 20;
+} // namespace
+
+/** @brief Everything a Feed shares with the handoff, guarded by `lock`. */
+struct MipmapHandoff::State {
+    enum class Lookup { Pending, Hit, Missed };
+
+    State(PeakMipmap &target, ChunkCallback chunkCallback, EndCallback endCallback)
+        : mipmap(&target), onChunk(std::move(chunkCallback)), onEnd(std::move(endCallback)) {
+    }
+
+    /** @return True if `feedGeneration` is current and the handoff still exists. */
+    bool isCurrent(juce::uint32 feedGeneration) const {
+        return mipmap != nullptr && feedGeneration == generation;
+    }
+
+    juce::CriticalSection lock; /**< Held while a Feed writes into the mipmap. */
+    PeakMipmap *mipmap;         /**< Cleared when the handoff is destroyed. */
+    ChunkCallback onChunk;
+    EndCallback onEnd;
+    juce::uint32 generation = 0;
+    bool claimed = false; /**< The build of this generation is taken. */
+    Lookup lookup = Lookup::Pending;
+    std::shared_ptr<juce::WaitableEvent> lookupDone = std::make_shared<juce::WaitableEvent>(true);
+};
+
+MipmapHandoff::Feed::Feed(std::shared_ptr<State> sharedState, juce::uint32 feedGeneration,
+                          std::shared_ptr<juce::WaitableEvent> lookupEvent)
+    : state(std::move(sharedState)), generation(feedGeneration),
+      lookupDone(std::move(lookupEvent)) {
+}
+
+MipmapHandoff::Feed::Feed(Feed &&other) noexcept
+    : state(std::move(other.state)), generation(other.generation),
+      lookupDone(std::move(other.lookupDone)), builder(std::move(other.builder)),
+      building(std::exchange(other.building, false)) {
+}
+
+MipmapHandoff::Feed &MipmapHandoff::Feed::operator=(Feed &&other) noexcept {
+    if (this != &other) {
+        release();
+        state = std::move(other.state);
+        generation = other.generation;
+        lookupDone = std::move(other.lookupDone);
+        if (other.builder.has_value())
+            builder.emplace(std::move(*other.builder)); // holds a reference; not assignable
+        building = std::exchange(other.building, false);
+    }
+    return *this;
+}
+
+MipmapHandoff::Feed::~Feed() {
+    release();
+}
+
+// A Feed holds its claim until it finishes or learns the cache has the mipmap, so one that
+// never got to build, or stopped partway, must hand the build back to the owner.
+void MipmapHandoff::Feed::release() noexcept {
+    if (state != nullptr) {
+        const juce::ScopedLock sl(state->lock);
+        if (state->isCurrent(generation) && state->lookup != State::Lookup::Hit)
+            state->onEnd(generation, false);
+    }
+    building = false;
+    builder.reset();
+    state.reset();
+}
+
+bool MipmapHandoff::Feed::waitForLookup(juce::ThreadPoolJob &job) {
+    if (state == nullptr)
+        return false;
+    while (!lookupDone->wait(kLookupPollMs))
+        if (job.shouldExit())
+            return false;
+
+    const juce::ScopedLock sl(state->lock);
+    if (!state->isCurrent(generation) || state->lookup != State::Lookup::Missed) {
+        state.reset(); // nothing to build, and nothing to hand back
+        return false;
+    }
+    builder.emplace(*state->mipmap);
+    building = true;
+    return true;
+}
+
+void MipmapHandoff::Feed::addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+    if (!building)
+        return;
+    const juce::ScopedLock sl(state->lock);
+    if (!state->isCurrent(generation))
+        return;
+    builder->addChunk(buffer, numSamples);
+    state->onChunk();
+}
+
+void MipmapHandoff::Feed::finish() {
+    if (!building)
+        return;
+    {
+        const juce::ScopedLock sl(state->lock);
+        if (state->isCurrent(generation)) {
+            builder->finish();
+            state->onChunk();
+            state->onEnd(generation, true);
+        }
+    }
+    building = false;
+    builder.reset();
+    state.reset();
+}
+
+MipmapHandoff::MipmapHandoff(PeakMipmap &target, ChunkCallback onChunk, EndCallback onEnd)
+    : state(std::make_shared<State>(target, std::move(onChunk), std::move(onEnd))) {
+}
+
+MipmapHandoff::~MipmapHandoff() {
+    const juce::ScopedLock sl(state->lock);
+    state->mipmap = nullptr;
+    state->lookupDone->signal();
+}
+
+juce::uint32 MipmapHandoff::beginFile() {
+    const juce::ScopedLock sl(state->lock);
+    state->lookupDone->signal(); // wakes any Feed of the old generation, inert
+    state->lookupDone = std::make_shared<juce::WaitableEvent>(true);
+    state->claimed = false;
+    state->lookup = State::Lookup::Pending;
+    return ++state->generation;
+}
+
+void MipmapHandoff::publishLookup(juce::uint32 generation, bool hit) {
+    const juce::ScopedLock sl(state->lock);
+    if (!state->isCurrent(generation))
+        return;
+    state->lookup = hit ? State::Lookup::Hit : State::Lookup::Missed;
+    state->lookupDone->signal();
+}
+
+MipmapHandoff::Feed MipmapHandoff::claimFeed() {
+    const juce::ScopedLock sl(state->lock);
+    if (state->claimed || state->lookup == State::Lookup::Hit)
+        return {};
+    state->claimed = true;
+    return Feed(state, state->generation, state->lookupDone);
+}
+
+bool MipmapHandoff::claimDecode(juce::uint32 generation) {
+    const juce::ScopedLock sl(state->lock);
+    if (!state->isCurrent(generation) || state->claimed)
+        return false;
+    state->claimed = true;
+    return true;
+}
+
+bool MipmapHandoff::isCurrent(juce::uint32 generation) const {
+    const juce::ScopedLock sl(state->lock);
+    return state->isCurrent(generation);
+}
@@ -0,0 +1,155 @@
+#ifndef AUDIOFILER_MIPMAPHANDOFF_H
+#define AUDIOFILER_MIPMAPHANDOFF_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Workers/PeakMipmap.h"
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+/**
+ * @file MipmapHandoff.h
+ * @ingroup AudioEngine
+ * @brief Hands the decode of a file's PeakMipmap to an analysis pass that reads it anyway.
+ *
+ * @details Opening a file starts two whole-file reads: WaveformManager fills the mipmap and
+ *          SilenceAnalysisWorker runs the gap scan, which also builds the envelope. The
+ *          handoff lets the second pass carry the first, so the file is decoded once:
+ *
+ *          - **Generations**: every file the manager loads starts a generation with
+ *            beginFile(). Anything tied to an older one is inert from then on.
+ *          - **Cache first**: a Feed claimed for the file waits until the manager's cache
+ *            lookup is published. After a hit it stays inert; after a miss it fills the
+ *            mipmap from the pass it rides in, as one more AnalysisPipeline stage.
+ *          - **One decoder**: the build is claimed exactly once per generation, by a Feed
+ *            or by the manager's own decode, whichever asks first.
+ *          - **Safe switching**: a Feed writes under the handoff's lock and only for the
+ *            current generation, so once beginFile() returns the mipmap may be reset.
+ *
+ *          The owner learns about Feed progress through the two callbacks, which run on the
+ *          pass's thread under the lock and must not block. The Feed of a pass that fails,
+ *          is stopped partway or never starts reports itself abandoned, so the owner can
+ *          decode instead.
+ *
+ * @see WaveformManager
+ * @see SilenceAnalysisWorker
+ */
+class MipmapHandoff final {
+  private:
+    struct State;
+
+  public:
+    /** @brief Called after every chunk a Feed adds to the mipmap. */
+    using ChunkCallback = std::function<void()>;
+
+    /** @brief Called when a building Feed ends: complete, or abandoned partway. */
+    using EndCallback = std::function<void(juce::uint32 generation, bool complete)>;
+
+    /**
+     * @class Feed
+     * @brief Move-only pipeline stage that fills the mipmap if the pass was handed its build.
+     * @details A default-constructed Feed, or one whose generation has passed, is inert.
+     */
+    class Feed final {
+      public:
+        Feed() = default;
+        Feed(Feed &&other) noexcept;
+        Feed &operator=(Feed &&other) noexcept;
+
+        /** @brief Hands the build back, reporting it abandoned, if this Feed did not finish it. */
+        ~Feed();
+
+        /**
+         * @brief Waits until the owner has looked the file up in its cache.
+         * @details Call once, before the pass starts decoding.
+         * @param job The job running the pass; the wait ends early if it should exit.
+         * @return True if this Feed builds the mipmap.
+         */
+        bool waitForLookup(juce::ThreadPoolJob &job);
+
+        /** @return True if this Feed builds the mipmap. */
+        bool isBuilding() const noexcept {
+            return building;
+        }
+
+        /**
+         * @brief Adds the next chunk of the file to the mipmap.
+         * @param buffer Decoded samples; only the first `numSamples` are used.
+         * @param numSamples The number of valid samples in the buffer.
+         */
+        void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples);
+
+        /** @brief Completes the mipmap after the last chunk and reports the build complete. */
+        void finish();
+
+      private:
+        friend class MipmapHandoff;
+        Feed(std::shared_ptr<State> sharedState, juce::uint32 feedGeneration,
+             std::shared_ptr<juce::WaitableEvent> lookupEvent);
+
+        void release() noexcept;
+
+        std::shared_ptr<State> state;
+        juce::uint32 generation = 0;
+        std::shared_ptr<juce::WaitableEvent> lookupDone;
+        std::optional<PeakMipmap::Builder> builder;
+        bool building = false;
+    };
+
+    /**
+     * @param target The store the Feeds fill; the owner must reset() it between generations.
+     * @param onChunk Called after every chunk a Feed adds.
+     * @param onEnd Called when a building Feed ends.
+     */
+    MipmapHandoff(PeakMipmap &target, ChunkCallback onChunk, EndCallback onEnd);
+
+    /** @brief Detaches every Feed, which may outlive the handoff, from the mipmap. */
+    ~MipmapHandoff();
+
+    /**
+     * @brief Starts a new generation for the next file.
+     * @details Feeds of older generations stop writing before this returns, and any still
+     *          waiting for their lookup wake up inert.
+     * @return The new generation.
+     */
+    juce::uint32 beginFile();
+
+    /**
+     * @brief Publishes the cache lookup of a generation, releasing its waiting Feed.
+     * @details Call after the mipmap is reset for the file. Stale generations are ignored.
+     * @param generation The generation the lookup was made for.
+     * @param hit True if the cache filled the mipmap, or there is nothing to build.
+     */
+    void publishLookup(juce::uint32 generation, bool hit);
+
+    /**
+     * @brief Hands the build of the current generation to an analysis pass.
+     * @return A Feed for the pass, or an inert one if the build is already taken or the
+     *         cache has filled the mipmap.
+     */
+    Feed claimFeed();
+
+    /**
+     * @brief Claims the build of a generation for the owner's own decode.
+     * @param generation The generation to build.
+     * @return True if the generation is current and no Feed has claimed it.
+     */
+    bool claimDecode(juce::uint32 generation);
+
+    /** @return True if the generation is still the current one. */
+    bool isCurrent(juce::uint32 generation) const;
+
+  private:
+    std::shared_ptr<State> state;
+
+    JUCE_DECLARE_NON_COPYABLE(MipmapHandoff)
+};
+
+#endif
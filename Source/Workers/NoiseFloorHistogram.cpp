@@ -0,0 +1,134 @@
+#include "Workers/NoiseFloorHistogram.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr juce::int32 kMagic = 0x464E4641; // "AFNF"
+constexpr juce::int32 kVersion = 1;
+
+int getNumBins() {
+    return 2 + (int)std::ceil(-Config::Audio::noiseFloorMinDb / Config::Audio::noiseFloorBinDb);
+}
+
+int binFor(float peak, int numBins) {
+    const float db = juce::Decibels::gainToDecibels(peak, Config::Audio::noiseFloorMinDb - 1.0f);
+    if (db < Config::Audio::noiseFloorMinDb)
+        return 0;
+    if (db >= 0.0f)
+        return numBins - 1;
+    const int bin =
+        1 + (int)((db - Config::Audio::noiseFloorMinDb) / Config::Audio::noiseFloorBinDb);
+    return std::min(bin, numBins - 2);
+}
+
+float upperEdgeOf(int bin, int numBins) {
+    if (bin >= numBins - 1)
+        return 1.0f;
+    return juce::Decibels::decibelsToGain(Config::Audio::noiseFloorMinDb +
+                                          (float)bin * Config::Audio::noiseFloorBinDb);
+}
+} // namespace
+
+NoiseFloorHistogram::NoiseFloorHistogram() : counts((size_t)getNumBins(), 0) {
+}
+
+NoiseFloorHistogram::Builder::Builder(juce::int64 length, double sampleRate)
+    : histogram(std::make_unique<NoiseFloorHistogram>()),
+      blockSize(std::max(1, (int)(sampleRate * Config::Audio::noiseFloorBlockSeconds))) {
+    histogram->lengthInSamples = length;
+}
+
+/**
+ * @details Block peaks are taken with FloatVectorOperations::findMinAndMax, one channel
+ *          at a time, so a chunk costs one vectorized sweep per channel plus one counter
+ *          increment per block.
+ */
+void NoiseFloorHistogram::Builder::addChunk(const juce::AudioBuffer<float> &buffer,
+                                            int numSamples) {
+    const int numChannels = buffer.getNumChannels();
+    if (histogram == nullptr || numChannels <= 0 || numSamples <= 0)
+        return;
+
+    for (int pos = 0; pos < numSamples;) {
+        const int span = std::min(blockSize - blockFill, numSamples - pos);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto range =
+                juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(ch, pos), span);
+            blockPeak = std::max({blockPeak, -range.getStart(), range.getEnd()});
+        }
+
+        blockFill += span;
+        pos += span;
+        if (blockFill == blockSize) {
+            histogram->add(blockPeak);
+            blockFill = 0;
+            blockPeak = 0.0f;
+        }
+    }
+}
+
+std::unique_ptr<NoiseFloorHistogram> NoiseFloorHistogram::Builder::finish() {
+    if (histogram != nullptr && blockFill > 0)
+        histogram->add(blockPeak);
+    blockFill = 0;
+    blockPeak = 0.0f;
+    return std::move(histogram);
+}
+
+void NoiseFloorHistogram::add(float peak) {
+    ++counts[(size_t)binFor(peak, (int)counts.size())];
+    ++numBlocks;
+}
+
+std::optional<float> NoiseFloorHistogram::getPercentileLevel(double fraction) const {
+    if (numBlocks <= 0)
+        return std::nullopt;
+
+    const auto target = std::max(
+        (juce::int64)1, (juce::int64)std::ceil(juce::jlimit(0.0, 1.0, fraction) * numBlocks));
+    juce::int64 seen = 0;
+    for (size_t bin = 0; bin < counts.size(); ++bin) {
+        seen += counts[bin];
+        if (seen >= target)
+            return upperEdgeOf((int)bin, (int)counts.size());
+    }
+    return 1.0f;
+}
+
+std::optional<float> NoiseFloorHistogram::suggestThreshold() const {
+    const auto floor = getPercentileLevel(Config::Audio::noiseFloorPercentile);
+    if (!floor.has_value())
+        return std::nullopt;
+    return *floor * juce::Decibels::decibelsToGain(Config::Audio::noiseFloorMarginDb);
+}
+
+bool NoiseFloorHistogram::writeTo(juce::OutputStream &output) const {
+    bool ok = output.writeInt(kMagic) && output.writeInt(kVersion) &&
+              output.writeInt64(lengthInSamples) && output.writeInt((int)counts.size());
+    for (const auto count : counts)
+        ok = ok && output.writeInt64(count);
+    return ok;
+}
+
+std::unique_ptr<NoiseFloorHistogram> NoiseFloorHistogram::readFrom(juce::InputStream &input) {
+    if (input.readInt() != kMagic || input.readInt() != kVersion)
+        return nullptr;
+
+    auto histogram = std::make_unique<NoiseFloorHistogram>();
+    histogram->lengthInSamples = input.readInt64();
+    // A changed bin layout in Config makes older files unreadable rather than misread.
+    if (histogram->lengthInSamples <= 0 || input.readInt() != (int)histogram->counts.size())
+        return nullptr;
+
+    for (auto &count : histogram->counts) {
+        if (input.isExhausted())
+            return nullptr;
+        count = input.readInt64();
+        if (count < 0)
+            return nullptr;
+        histogram->numBlocks += count;
+    }
+    return histogram;
+}
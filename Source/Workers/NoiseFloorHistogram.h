@@ -0,0 +1,124 @@
+#ifndef AUDIOFILER_NOISEFLOORHISTOGRAM_H
+#define AUDIOFILER_NOISEFLOORHISTOGRAM_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @file NoiseFloorHistogram.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Level histogram of one file, from which an Auto Threshold is suggested.
+ *
+ * @details Architecturally, NoiseFloorHistogram is an immutable "Passive Data Model"
+ *          built in the same streaming pass as the PeakPyramid and CutPointCurves, so
+ *          suggesting a Threshold never costs another read of the file.
+ *
+ *          The file is cut into blocks of `Config::Audio::noiseFloorBlockSeconds`, and
+ *          each block's peak (max-abs across channels) is counted in a bin of
+ *          `Config::Audio::noiseFloorBinDb` decibels between
+ *          `Config::Audio::noiseFloorMinDb` and full scale. Memory is therefore a few
+ *          hundred counters no matter how long the file is.
+ *
+ *          The noise floor is the level below which `Config::Audio::noiseFloorPercentile`
+ *          of the blocks fall. The suggested Threshold sits `noiseFloorMarginDb` above it,
+ *          i.e. just over the hiss of the lead-in and the tail, but below the material.
+ *          Bin upper edges are reported, so the estimate never undercuts a counted peak.
+ *
+ * @see SilenceDetectionPresenter
+ * @see SilenceAnalysisWorker
+ * @see EnvelopeStore
+ */
+class NoiseFloorHistogram final {
+  public:
+    /**
+     * @class Builder
+     * @brief Accumulates block peaks chunk by chunk during a forward streaming pass.
+     * @details Blocks may straddle chunks; the running block peak is carried over.
+     */
+    class Builder {
+      public:
+        /**
+         * @brief Prepares a builder for one file.
+         * @param lengthInSamples The file length in samples.
+         * @param sampleRate The file sample rate.
+         */
+        Builder(juce::int64 lengthInSamples, double sampleRate);
+
+        /**
+         * @brief Consumes the next chunk of the file, in order.
+         * @param buffer Decoded samples; only the first `numSamples` are used.
+         * @param numSamples The number of valid samples in the buffer.
+         */
+        void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples);
+
+        /**
+         * @brief Counts the last, partial block and finalizes the histogram.
+         * @return The finished histogram.
+         */
+        std::unique_ptr<NoiseFloorHistogram> finish();
+
+      private:
+        std::unique_ptr<NoiseFloorHistogram> histogram;
+        int blockSize = 1;
+        int blockFill = 0;
+        float blockPeak = 0.0f;
+    };
+
+    /** @brief Constructs an empty histogram. */
+    NoiseFloorHistogram();
+
+    /**
+     * @brief The level below which a fraction of the blocks peak.
+     * @param fraction Between 0 and 1.
+     * @return The linear level, or nullopt if no block was counted.
+     */
+    std::optional<float> getPercentileLevel(double fraction) const;
+
+    /**
+     * @brief The Threshold suggested for both Auto-Cut directions.
+     * @return The linear Threshold, or nullopt if no block was counted.
+     */
+    std::optional<float> suggestThreshold() const;
+
+    /** @return The number of blocks counted. */
+    juce::int64 getNumBlocks() const {
+        return numBlocks;
+    }
+
+    /** @return The length of the analysed file in samples. */
+    juce::int64 getLengthInSamples() const {
+        return lengthInSamples;
+    }
+
+    /**
+     * @brief Serializes the histogram.
+     * @param output The stream to write to.
+     * @return True on success.
+     */
+    bool writeTo(juce::OutputStream &output) const;
+
+    /**
+     * @brief Deserializes a histogram written by writeTo().
+     * @param input The stream to read from.
+     * @return The histogram, or null if the data is malformed or of another version.
+     */
+    static std::unique_ptr<NoiseFloorHistogram> readFrom(juce::InputStream &input);
+
+  private:
+    void add(float peak);
+
+    juce::int64 lengthInSamples = 0;
+    juce::int64 numBlocks = 0;
+    std::vector<juce::int64> counts; /**< Below the range first, full scale and above last. */
+};
+
+#endif
@@ -0,0 +1,206 @@
+#include "Workers/ParallelSilenceScan.h"
+#include "Utils/Config.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+/** @brief Polling interval of the calling thread while it waits for its helpers. */
+constexpr int kJoinPollMs = 20;
+
+/**
+ * @brief State shared by all segment tasks of one parallel scan.
+ * @details `best` doubles as the frontier handed to the range scans, while
+ *          `failedFrontier` remembers the segment closest to the scan origin whose read
+ *          failed; a hit is only trustworthy if no failed segment could have hidden an
+ *          even better one.
+ */
+struct SharedScan {
+    SharedScan(bool isForward, int segments, juce::int64 segLength, juce::int64 totalLength,
+               float thresholdValue, const ScanContext &context)
+        : forward(isForward), numSegments(segments), segmentLength(segLength),
+          length(totalLength), threshold(thresholdValue),
+          best(isForward ? std::numeric_limits<juce::int64>::max() : -1),
+          failedFrontier(isForward ? std::numeric_limits<juce::int64>::max() : -1) {
+        taskContext.cancelled = &cancelled;
+        taskContext.governor = context.governor;
+        taskContext.progress = context.progress;
+    }
+
+    const bool forward;
+    const int numSegments;
+    const juce::int64 segmentLength;
+    const juce::int64 length;
+    const float threshold;
+
+    std::atomic<int> nextClaim{0};
+    std::atomic<juce::int64> best;
+    std::atomic<juce::int64> failedFrontier;
+    std::atomic<bool> cancelled{false};
+    ScanContext taskContext;
+};
+
+/** @brief Lock-free "keep the better value" update used for both frontiers. */
+void improve(std::atomic<juce::int64> &target, juce::int64 candidate, bool keepLower) {
+    auto current = target.load();
+    while ((keepLower ? candidate < current : candidate > current) &&
+           !target.compare_exchange_weak(current, candidate)) {
+    }
+}
+
+/**
+ * @brief Claims segments in origin order and scans each with one reader until none is left.
+ * @details Claims are handed out nearest-origin first. Because every later claim is
+ *          further from the origin, the first claim that can no longer beat the
+ *          frontier proves that all remaining claims cannot either, so the loop exits.
+ */
+void scanClaims(juce::AudioFormatReader &reader, SharedScan &scan, const ScanContext &context) {
+    for (;;) {
+        const int claim = scan.nextClaim.fetch_add(1);
+        if (claim >= scan.numSegments || scan.cancelled.load() || context.shouldStop())
+            break;
+
+        const int segment = scan.forward ? claim : scan.numSegments - 1 - claim;
+        const juce::int64 segStart = (juce::int64)segment * scan.segmentLength;
+        const juce::int64 segEnd = std::min(scan.length, segStart + scan.segmentLength);
+
+        if (scan.forward) {
+            if (segStart >= scan.best.load())
+                break;
+            const auto hit = SilenceAnalysisAlgorithms::findFirstAboveInRange(
+                reader, segStart, segEnd, scan.threshold, context, &scan.best);
+            if (hit == SilenceAnalysisAlgorithms::aborted)
+                improve(scan.failedFrontier, segStart, true);
+            else if (hit >= 0)
+                improve(scan.best, hit, true);
+        } else {
+            if (segEnd - 1 <= scan.best.load())
+                break;
+            const auto hit = SilenceAnalysisAlgorithms::findLastAboveInRange(
+                reader, segStart, segEnd, scan.threshold, context, &scan.best);
+            if (hit == SilenceAnalysisAlgorithms::aborted)
+                improve(scan.failedFrontier, segEnd - 1, false);
+            else if (hit >= 0)
+                improve(scan.best, hit, false);
+        }
+    }
+}
+
+/**
+ * @class SegmentJob
+ * @brief One helper task: runs scanClaims() on a pool thread with its own reader.
+ */
+class SegmentJob final : public juce::ThreadPoolJob {
+  public:
+    SegmentJob(juce::AudioFormatReader &taskReader, SharedScan &sharedScan)
+        : juce::ThreadPoolJob("SilenceSegment"), reader(taskReader), scan(sharedScan),
+          context(sharedScan.taskContext) {
+        context.job = this;
+    }
+
+    JobStatus runJob() override {
+        scanClaims(reader, scan, context);
+        return jobHasFinished;
+    }
+
+  private:
+    juce::AudioFormatReader &reader;
+    SharedScan &scan;
+    ScanContext context;
+};
+
+juce::int64 runSequential(juce::AudioFormatReader &reader, float threshold, bool forward,
+                          const ScanContext &context) {
+    const auto result =
+        forward ? SilenceAnalysisAlgorithms::findFirstAboveInRange(reader, 0, reader.lengthInSamples,
+                                                                   threshold, context)
+                : SilenceAnalysisAlgorithms::findLastAbove(reader, 0, reader.lengthInSamples,
+                                                           threshold, context);
+    return result == SilenceAnalysisAlgorithms::aborted ? -1 : result;
+}
+
+/**
+ * @details The calling thread always scans with the primary reader, so the scan makes
+ *          progress even when every pool thread is busy with other work (e.g. whole-file
+ *          envelope passes). Helpers are only handed to threads that are idle right now;
+ *          any helper still queued when the caller runs out of claims is removed unrun.
+ *
+ *          Segment sizing: the file is cut into roughly `tasks * segmentsPerThread`
+ *          chunk-aligned ranges. Over-decomposing keeps every task busy even when some
+ *          ranges are pruned early, while chunk alignment guarantees each task issues
+ *          exactly the same reads a sequential scan would.
+ */
+juce::int64 runParallel(juce::AudioFormatReader &primary,
+                        const ParallelSilenceScan::ReaderFactory &openReader,
+                        juce::ThreadPool &pool, float threshold, bool forward,
+                        const ScanContext &context) {
+    const juce::int64 length = primary.lengthInSamples;
+    const int idleThreads = std::max(0, pool.getNumThreads() - pool.getNumJobs());
+
+    if (!SilenceAnalysisAlgorithms::isScannable(primary) || idleThreads < 1 ||
+        openReader == nullptr || length < Config::Audio::parallelScanMinSamples ||
+        !ParallelSilenceScan::supportsParallelSeeking(primary))
+        return runSequential(primary, threshold, forward, context);
+
+    const juce::int64 chunk = SilenceAnalysisAlgorithms::chunkSize;
+    const juce::int64 target =
+        (juce::int64)(idleThreads + 1) * Config::Audio::parallelScanSegmentsPerThread;
+    const juce::int64 rawLength = (length + target - 1) / target;
+    const juce::int64 segLength = ((rawLength + chunk - 1) / chunk) * chunk;
+    const int numSegments = (int)((length + segLength - 1) / segLength);
+
+    std::vector<ReaderPool::Lease> extraReaders;
+    const int wantedHelpers = std::min(idleThreads, numSegments - 1);
+    for (int i = 0; i < wantedHelpers; ++i)
+        if (auto reader = openReader())
+            extraReaders.push_back(std::move(reader));
+
+    SharedScan scan(forward, numSegments, segLength, length, threshold, context);
+
+    std::vector<std::unique_ptr<SegmentJob>> helpers;
+    for (auto &reader : extraReaders) {
+        helpers.push_back(std::make_unique<SegmentJob>(*reader, scan));
+        pool.addJob(helpers.back().get(), false);
+    }
+
+    scanClaims(primary, scan, context);
+    if (context.shouldStop())
+        scan.cancelled.store(true);
+
+    for (auto &helper : helpers)
+        if (!pool.removeJob(helper.get(), false, 0))
+            while (!pool.waitForJobToFinish(helper.get(), kJoinPollMs))
+                if (context.shouldStop())
+                    scan.cancelled.store(true);
+
+    if (scan.cancelled.load() || context.shouldStop())
+        return -1;
+
+    const juce::int64 best = scan.best.load();
+    const juce::int64 failed = scan.failedFrontier.load();
+    if (forward)
+        return (best != std::numeric_limits<juce::int64>::max() && best < failed) ? best : -1;
+    return (best >= 0 && best > failed) ? best : -1;
+}
+} // namespace
+
+juce::int64 ParallelSilenceScan::findSilenceIn(juce::AudioFormatReader &primary,
+                                               const ReaderFactory &openReader,
+                                               juce::ThreadPool &pool, float threshold,
+                                               const ScanContext &context) {
+    return runParallel(primary, openReader, pool, threshold, true, context);
+}
+
+juce::int64 ParallelSilenceScan::findSilenceOut(juce::AudioFormatReader &primary,
+                                                const ReaderFactory &openReader,
+                                                juce::ThreadPool &pool, float threshold,
+                                                const ScanContext &context) {
+    return runParallel(primary, openReader, pool, threshold, false, context);
+}
+
+bool ParallelSilenceScan::supportsParallelSeeking(const juce::AudioFormatReader &reader) {
+    return SilenceAnalysisAlgorithms::seeksCheaply(reader);
+}
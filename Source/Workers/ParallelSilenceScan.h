@@ -0,0 +1,89 @@
+#ifndef AUDIOFILER_PARALLELSILENCESCAN_H
+#define AUDIOFILER_PARALLELSILENCESCAN_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Workers/ReaderPool.h"
+#include "Workers/ScanContext.h"
+#include <functional>
+
+/**
+ * @file ParallelSilenceScan.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Segmented multi-threaded variant of the Autocut In/Out scans.
+ *
+ * @details Architecturally, ParallelSilenceScan is a "Pure Logic Engine" that sits
+ *          between the SilenceAnalysisWorker and SilenceAnalysisAlgorithms. A sequential
+ *          In scan of a file whose audio starts late keeps one core busy for the whole
+ *          lead-in; this class splits the file into chunk-aligned segments and scans them on
+ *          the calling thread together with the idle threads of a `juce::ThreadPool`.
+ *
+ *          The coordination rules are:
+ *          - **Private Readers**: Every task has its own `juce::AudioFormatReader`,
+ *            leased up front on the calling thread, in keeping with the Threading Law.
+ *          - **Caller First**: The calling thread scans with the primary reader itself and
+ *            only fans out to pool threads that are idle when the scan starts, so a pool
+ *            busy with other jobs never leaves the caller waiting behind them.
+ *          - **Ordered Claims**: Tasks claim segments nearest the scan origin first
+ *            (ascending for In, descending for Out), so the first hit is usually found
+ *            by the earliest claims.
+ *          - **Shared Frontier**: The best hit so far is published through an atomic;
+ *            every task abandons any segment that can no longer beat it, which acts
+ *            as cooperative cancellation of all later (In) or earlier (Out) ranges.
+ *          - **Graceful Fallback**: Parallel seeking only pays off for PCM containers
+ *            (WAV/AIFF). For compressed formats, short files, or a pool without an
+ *            idle thread the call degrades to the ordinary sequential scan on the primary reader.
+ *
+ * @see SilenceAnalysisAlgorithms
+ * @see SilenceAnalysisWorker
+ * @see ScanContext
+ */
+class ParallelSilenceScan final {
+  public:
+    /**
+     * @brief Leases an additional private reader for the file being scanned (or an empty
+     *        lease). Each lease is released as soon as the scan returns.
+     */
+    using ReaderFactory = std::function<ReaderPool::Lease()>;
+
+    /**
+     * @brief Finds the first non-silent sample using the caller and the pool's idle threads.
+     * @param primary An already-opened private reader; scanned on the calling thread.
+     * @param openReader Factory for the readers of the remaining tasks.
+     * @param pool The pool whose idle threads help with the segment tasks.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param context Cancellation and pacing policy of the caller.
+     * @return The earliest crossing, or -1 if none was found or the scan was cancelled.
+     */
+    static juce::int64 findSilenceIn(juce::AudioFormatReader &primary,
+                                     const ReaderFactory &openReader, juce::ThreadPool &pool,
+                                     float threshold, const ScanContext &context);
+
+    /**
+     * @brief Finds the last non-silent sample using the caller and the pool's idle threads.
+     * @param primary An already-opened private reader; scanned on the calling thread.
+     * @param openReader Factory for the readers of the remaining tasks.
+     * @param pool The pool whose idle threads help with the segment tasks.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param context Cancellation and pacing policy of the caller.
+     * @return The latest crossing, or -1 if none was found or the scan was cancelled.
+     */
+    static juce::int64 findSilenceOut(juce::AudioFormatReader &primary,
+                                      const ReaderFactory &openReader, juce::ThreadPool &pool,
+                                      float threshold, const ScanContext &context);
+
+    /**
+     * @brief Reports whether a reader supports cheap random access from many readers.
+     * @param reader The reader to inspect.
+     * @return True for uncompressed WAV and AIFF readers.
+     */
+    static bool supportsParallelSeeking(const juce::AudioFormatReader &reader);
+};
+
+#endif
@@ -0,0 +1,364 @@
+#include "Workers/PcmScanKernels.h"
+#include <cmath>
+#include <cstdint>
+
+#if JUCE_INTEL && (JUCE_64BIT || defined(__SSE2__))
+#define AUDIOFILER_PCMSCAN_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIOFILER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AUDIOFILER_TARGET_AVX2
+#endif
+#else
+#define AUDIOFILER_PCMSCAN_X86 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+using Encoding = MappedPcmReader::Encoding;
+
+/** @brief Samples tested per vector step. */
+constexpr int kBlock = 16;
+
+inline int lowestSetBit(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline int highestSetBit(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (int)index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+constexpr int bitsOf(Encoding encoding) noexcept {
+    return encoding == Encoding::Int16 ? 16 : encoding == Encoding::Int24 ? 24 : 32;
+}
+
+template <Encoding E, bool BigEndian>
+inline juce::int32 sampleAt(const char *data, int index) noexcept {
+    const char *p = data + index * (bitsOf(E) / 8);
+    if constexpr (E == Encoding::Int16)
+        return (juce::int16)(BigEndian ? juce::ByteOrder::bigEndianShort(p)
+                                       : juce::ByteOrder::littleEndianShort(p));
+    else if constexpr (E == Encoding::Int24)
+        return BigEndian ? juce::ByteOrder::bigEndian24Bit(p)
+                         : juce::ByteOrder::littleEndian24Bit(p);
+    else
+        return (juce::int32)(BigEndian ? juce::ByteOrder::bigEndianInt(p)
+                                       : juce::ByteOrder::littleEndianInt(p));
+}
+
+template <Encoding E, bool BigEndian>
+int scalarFirst(const char *data, int begin, int end, juce::int32 limit) noexcept {
+    for (int i = begin; i < end; ++i) {
+        const juce::int32 v = sampleAt<E, BigEndian>(data, i);
+        if (v > limit || v < -limit)
+            return i;
+    }
+    return -1;
+}
+
+template <Encoding E, bool BigEndian>
+int scalarLast(const char *data, int begin, int end, juce::int32 limit) noexcept {
+    for (int i = end - 1; i >= begin; --i) {
+        const juce::int32 v = sampleAt<E, BigEndian>(data, i);
+        if (v > limit || v < -limit)
+            return i;
+    }
+    return -1;
+}
+
+template <Encoding E>
+int scalarScan(bool first, bool bigEndian, const char *data, int numSamples,
+               juce::int32 limit) noexcept {
+    if (bigEndian)
+        return first ? scalarFirst<E, true>(data, 0, numSamples, limit)
+                     : scalarLast<E, true>(data, 0, numSamples, limit);
+    return first ? scalarFirst<E, false>(data, 0, numSamples, limit)
+                 : scalarLast<E, false>(data, 0, numSamples, limit);
+}
+
+#if AUDIOFILER_PCMSCAN_X86
+/**
+ * @details Each masker turns 16 raw samples starting at index `i` into a 16-bit mask,
+ *          bit k set when sample i + k lies beyond the limit. `pad` is how many samples
+ *          past the block its loads may touch; the drivers keep those inside the data.
+ */
+struct Sse2Int16 {
+    static constexpr Encoding encoding = Encoding::Int16;
+    static constexpr int pad = 0;
+    __m128i hi, lo;
+
+    explicit Sse2Int16(juce::int32 limit) noexcept
+        : hi(_mm_set1_epi16((short)limit)), lo(_mm_set1_epi16((short)-limit)) {
+    }
+
+    std::uint32_t operator()(const char *data, int i) const noexcept {
+        const auto *p = reinterpret_cast<const __m128i *>(data + i * 2);
+        const __m128i a = _mm_loadu_si128(p);
+        const __m128i b = _mm_loadu_si128(p + 1);
+        const __m128i hitA = _mm_or_si128(_mm_cmpgt_epi16(a, hi), _mm_cmplt_epi16(a, lo));
+        const __m128i hitB = _mm_or_si128(_mm_cmpgt_epi16(b, hi), _mm_cmplt_epi16(b, lo));
+        return (std::uint32_t)_mm_movemask_epi8(_mm_packs_epi16(hitA, hitB));
+    }
+};
+
+struct Sse2Int32 {
+    static constexpr Encoding encoding = Encoding::Int32;
+    static constexpr int pad = 0;
+    __m128i hi, lo;
+
+    explicit Sse2Int32(juce::int32 limit) noexcept
+        : hi(_mm_set1_epi32(limit)), lo(_mm_set1_epi32(-limit)) {
+    }
+
+    std::uint32_t operator()(const char *data, int i) const noexcept {
+        const auto *p = reinterpret_cast<const __m128i *>(data + i * 4);
+        std::uint32_t mask = 0;
+        for (int k = 0; k < 4; ++k) {
+            const __m128i v = _mm_loadu_si128(p + k);
+            const __m128i hit = _mm_or_si128(_mm_cmpgt_epi32(v, hi), _mm_cmplt_epi32(v, lo));
+            mask |= (std::uint32_t)_mm_movemask_ps(_mm_castsi128_ps(hit)) << (4 * k);
+        }
+        return mask;
+    }
+};
+
+struct Avx2Int16 {
+    static constexpr Encoding encoding = Encoding::Int16;
+    static constexpr int pad = 0;
+    __m256i hi, lo;
+
+    AUDIOFILER_TARGET_AVX2 explicit Avx2Int16(juce::int32 limit) noexcept
+        : hi(_mm256_set1_epi16((short)limit)), lo(_mm256_set1_epi16((short)-limit)) {
+    }
+
+    /** @details Packing interleaves the 128-bit lanes; the permute restores sample order. */
+    AUDIOFILER_TARGET_AVX2 std::uint32_t operator()(const char *data, int i) const noexcept {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i * 2));
+        const __m256i hit = _mm256_or_si256(_mm256_cmpgt_epi16(v, hi), _mm256_cmpgt_epi16(lo, v));
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(hit, hit), 0x08);
+        return (std::uint32_t)_mm256_movemask_epi8(packed) & 0xffffu;
+    }
+};
+
+struct Avx2Int24 {
+    static constexpr Encoding encoding = Encoding::Int24;
+    static constexpr int pad = 2; // the last 12-byte group is loaded as 16 bytes
+    __m256i hi, lo, spread;
+
+    AUDIOFILER_TARGET_AVX2 explicit Avx2Int24(juce::int32 limit) noexcept
+        : hi(_mm256_set1_epi32(limit)), lo(_mm256_set1_epi32(-limit)),
+          spread(_mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1,
+                                  2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11)) {
+    }
+
+    /** @details Places each 3-byte sample in the top of a 32-bit lane and shifts it down
+     *           arithmetically, which sign-extends it. */
+    AUDIOFILER_TARGET_AVX2 std::uint32_t eight(const char *p) const noexcept {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 12));
+        const __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+        const __m256i v = _mm256_srai_epi32(_mm256_shuffle_epi8(bytes, spread), 8);
+        const __m256i hit = _mm256_or_si256(_mm256_cmpgt_epi32(v, hi), _mm256_cmpgt_epi32(lo, v));
+        return (std::uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(hit));
+    }
+
+    AUDIOFILER_TARGET_AVX2 std::uint32_t operator()(const char *data, int i) const noexcept {
+        const char *p = data + i * 3;
+        return eight(p) | (eight(p + 24) << 8);
+    }
+};
+
+struct Avx2Int32 {
+    static constexpr Encoding encoding = Encoding::Int32;
+    static constexpr int pad = 0;
+    __m256i hi, lo;
+
+    AUDIOFILER_TARGET_AVX2 explicit Avx2Int32(juce::int32 limit) noexcept
+        : hi(_mm256_set1_epi32(limit)), lo(_mm256_set1_epi32(-limit)) {
+    }
+
+    AUDIOFILER_TARGET_AVX2 std::uint32_t operator()(const char *data, int i) const noexcept {
+        const auto *p = reinterpret_cast<const __m256i *>(data + i * 4);
+        const __m256i a = _mm256_loadu_si256(p);
+        const __m256i b = _mm256_loadu_si256(p + 1);
+        const __m256i hitA = _mm256_or_si256(_mm256_cmpgt_epi32(a, hi), _mm256_cmpgt_epi32(lo, a));
+        const __m256i hitB = _mm256_or_si256(_mm256_cmpgt_epi32(b, hi), _mm256_cmpgt_epi32(lo, b));
+        return (std::uint32_t)(_mm256_movemask_ps(_mm256_castsi256_ps(hitA)) |
+                               (_mm256_movemask_ps(_mm256_castsi256_ps(hitB)) << 8));
+    }
+};
+
+template <typename Masker>
+int sse2Scan(bool first, const char *data, int numSamples, juce::int32 limit) noexcept {
+    const Masker masker(limit);
+    const int vectorEnd = numSamples - Masker::pad;
+    if (first) {
+        int i = 0;
+        for (; i + kBlock <= vectorEnd; i += kBlock)
+            if (const auto mask = masker(data, i))
+                return i + lowestSetBit(mask);
+        return scalarFirst<Masker::encoding, false>(data, i, numSamples, limit);
+    }
+
+    int i = vectorEnd > 0 ? vectorEnd / kBlock * kBlock : 0;
+    if (const int hit = scalarLast<Masker::encoding, false>(data, i, numSamples, limit); hit >= 0)
+        return hit;
+    while (i >= kBlock) {
+        i -= kBlock;
+        if (const auto mask = masker(data, i))
+            return i + highestSetBit(mask);
+    }
+    return -1;
+}
+
+/** @details AVX2 flavour of sse2Scan(), compiled for AVX2 so the maskers inline. */
+template <typename Masker>
+AUDIOFILER_TARGET_AVX2 int avx2Scan(bool first, const char *data, int numSamples,
+                                    juce::int32 limit) noexcept {
+    const Masker masker(limit);
+    const int vectorEnd = numSamples - Masker::pad;
+    if (first) {
+        int i = 0;
+        for (; i + kBlock <= vectorEnd; i += kBlock)
+            if (const auto mask = masker(data, i))
+                return i + lowestSetBit(mask);
+        return scalarFirst<Masker::encoding, false>(data, i, numSamples, limit);
+    }
+
+    int i = vectorEnd > 0 ? vectorEnd / kBlock * kBlock : 0;
+    if (const int hit = scalarLast<Masker::encoding, false>(data, i, numSamples, limit); hit >= 0)
+        return hit;
+    while (i >= kBlock) {
+        i -= kBlock;
+        if (const auto mask = masker(data, i))
+            return i + highestSetBit(mask);
+    }
+    return -1;
+}
+#endif
+
+int scanSamples(bool first, PcmScanKernels::Kernel kernel,
+                const MappedPcmReader::Layout &layout, const char *data, int numSamples,
+                juce::int32 limit) noexcept {
+    using Kernel = PcmScanKernels::Kernel;
+    if (!PeakScanKernels::isSupported(kernel))
+        kernel = Kernel::Scalar;
+
+#if AUDIOFILER_PCMSCAN_X86
+    if (!layout.bigEndian) {
+        switch (layout.encoding) {
+        case Encoding::Int16:
+            if (kernel == Kernel::Avx2)
+                return avx2Scan<Avx2Int16>(first, data, numSamples, limit);
+            if (kernel == Kernel::Sse2)
+                return sse2Scan<Sse2Int16>(first, data, numSamples, limit);
+            break;
+        case Encoding::Int24:
+            if (kernel == Kernel::Avx2)
+                return avx2Scan<Avx2Int24>(first, data, numSamples, limit);
+            break;
+        case Encoding::Int32:
+            if (kernel == Kernel::Avx2)
+                return avx2Scan<Avx2Int32>(first, data, numSamples, limit);
+            if (kernel == Kernel::Sse2)
+                return sse2Scan<Sse2Int32>(first, data, numSamples, limit);
+            break;
+        case Encoding::Float32:
+            break;
+        }
+    }
+#else
+    juce::ignoreUnused(kernel);
+#endif
+
+    switch (layout.encoding) {
+    case Encoding::Int16:
+        return scalarScan<Encoding::Int16>(first, layout.bigEndian, data, numSamples, limit);
+    case Encoding::Int24:
+        return scalarScan<Encoding::Int24>(first, layout.bigEndian, data, numSamples, limit);
+    case Encoding::Int32:
+        return scalarScan<Encoding::Int32>(first, layout.bigEndian, data, numSamples, limit);
+    case Encoding::Float32:
+        break;
+    }
+    jassertfalse; // float data is scanned by PeakScanKernels
+    return -1;
+}
+
+int scanFrames(bool first, PcmScanKernels::Kernel kernel, const MappedPcmReader::Layout &layout,
+               const char *frames, int numFrames, juce::int64 limit) noexcept {
+    if (frames == nullptr || numFrames <= 0 || layout.numChannels <= 0)
+        return -1;
+
+    // Beyond full scale nothing can cross; below zero everything does.
+    if (limit >= (juce::int64)1 << (bitsOf(layout.encoding) - 1))
+        return -1;
+    const auto clamped = (juce::int32)std::max(limit, (juce::int64)-1);
+
+    const int hit = scanSamples(first, kernel, layout, frames, numFrames * layout.numChannels,
+                                clamped);
+    return hit < 0 ? -1 : hit / layout.numChannels;
+}
+} // namespace
+
+/**
+ * @details Scaling by a power of two is exact, so the float Threshold maps to an exact
+ *          scaled value. 16 and 24-bit samples convert to float exactly and cross above
+ *          its floor. 32-bit samples round to 24 bits of precision on conversion, so the
+ *          limit is walked up to the last integer that still rounds to at most the
+ *          scaled value; rounding is monotonic, so every larger magnitude crosses.
+ */
+juce::int64 PcmScanKernels::toIntegerLimit(float threshold,
+                                           MappedPcmReader::Encoding encoding) noexcept {
+    const juce::int64 fullScale = (juce::int64)1 << (bitsOf(encoding) - 1);
+    if (std::isnan(threshold) || encoding == Encoding::Float32)
+        return fullScale;
+    if (threshold < 0.0f)
+        return -1;
+
+    const float scaled = threshold * (float)fullScale;
+    if (scaled >= (float)fullScale)
+        return fullScale;
+
+    auto limit = (juce::int64)scaled;
+    while ((float)(limit + 1) <= scaled)
+        ++limit;
+    return limit;
+}
+
+int PcmScanKernels::findFirstAbove(const MappedPcmReader::Layout &layout, const char *frames,
+                                   int numFrames, juce::int64 limit) noexcept {
+    return findFirstAbove(PeakScanKernels::getActiveKernel(), layout, frames, numFrames, limit);
+}
+
+int PcmScanKernels::findLastAbove(const MappedPcmReader::Layout &layout, const char *frames,
+                                  int numFrames, juce::int64 limit) noexcept {
+    return findLastAbove(PeakScanKernels::getActiveKernel(), layout, frames, numFrames, limit);
+}
+
+int PcmScanKernels::findFirstAbove(Kernel kernel, const MappedPcmReader::Layout &layout,
+                                   const char *frames, int numFrames,
+                                   juce::int64 limit) noexcept {
+    return scanFrames(true, kernel, layout, frames, numFrames, limit);
+}
+
+int PcmScanKernels::findLastAbove(Kernel kernel, const MappedPcmReader::Layout &layout,
+                                  const char *frames, int numFrames, juce::int64 limit) noexcept {
+    return scanFrames(false, kernel, layout, frames, numFrames, limit);
+}
@@ -0,0 +1,89 @@
+#ifndef AUDIOFILER_PCMSCANKERNELS_H
+#define AUDIOFILER_PCMSCANKERNELS_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Workers/MappedPcmReader.h"
+#include "Workers/PeakScanKernels.h"
+
+/**
+ * @file PcmScanKernels.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Threshold-crossing kernels that compare raw integer PCM without converting it.
+ *
+ * @details Architecturally, PcmScanKernels is the integer-domain sibling of
+ *          PeakScanKernels. When a scan reads through a MappedPcmReader the samples are
+ *          still in their stored 16, 24 or 32-bit form, so instead of converting every
+ *          sample to float the Threshold is converted once into an integer limit for the
+ *          file's bit depth (toIntegerLimit()) and the raw words are compared directly.
+ *          For 16-bit files that halves the bytes the scan has to touch.
+ *
+ *          The limit is chosen so that an integer sample crosses exactly when its float
+ *          conversion would cross the float Threshold, including the rounding of 32-bit
+ *          samples to float; both paths always agree on the cut point.
+ *
+ *          Interleaved frames are scanned as one flat run of samples: a crossing on any
+ *          channel is a crossing of its frame, so the channel count never enters the
+ *          inner loop. Little-endian 16 and 32-bit data use SSE2 or AVX2 compares and
+ *          24-bit data is unpacked with AVX2 byte shuffles; big-endian (AIFF) data and
+ *          24-bit data without AVX2 take the portable scalar loop.
+ *
+ *          All methods are stateless and thread-safe.
+ *
+ * @see PeakScanKernels
+ * @see MappedPcmReader
+ * @see ChunkScanner
+ */
+class PcmScanKernels final {
+  public:
+    using Kernel = PeakScanKernels::Kernel;
+
+    /**
+     * @brief Converts a float Threshold into the integer limit for one encoding.
+     * @param threshold The linear amplitude threshold (a sample must be strictly greater).
+     * @param encoding An integer encoding.
+     * @return The limit L: a raw sample v crosses when `v > L || v < -L`.
+     */
+    static juce::int64 toIntegerLimit(float threshold, MappedPcmReader::Encoding encoding) noexcept;
+
+    /**
+     * @brief Finds the first frame with a sample beyond the limit on any channel.
+     * @param layout The storage format; its encoding must be an integer one.
+     * @param frames The first interleaved frame.
+     * @param numFrames The number of frames.
+     * @param limit The limit from toIntegerLimit().
+     * @return The index of the first crossing frame, or -1 if none.
+     */
+    static int findFirstAbove(const MappedPcmReader::Layout &layout, const char *frames,
+                              int numFrames, juce::int64 limit) noexcept;
+
+    /**
+     * @brief Finds the last frame with a sample beyond the limit on any channel.
+     * @param layout The storage format; its encoding must be an integer one.
+     * @param frames The first interleaved frame.
+     * @param numFrames The number of frames.
+     * @param limit The limit from toIntegerLimit().
+     * @return The index of the last crossing frame, or -1 if none.
+     */
+    static int findLastAbove(const MappedPcmReader::Layout &layout, const char *frames,
+                             int numFrames, juce::int64 limit) noexcept;
+
+    /**
+     * @brief Variant of findFirstAbove() that forces a specific instruction set.
+     * @details Intended for tests and benchmarks; an unsupported kernel falls back to
+     *          Kernel::Scalar.
+     */
+    static int findFirstAbove(Kernel kernel, const MappedPcmReader::Layout &layout,
+                              const char *frames, int numFrames, juce::int64 limit) noexcept;
+
+    /** @brief Variant of findLastAbove() that forces a specific instruction set. */
+    static int findLastAbove(Kernel kernel, const MappedPcmReader::Layout &layout,
+                             const char *frames, int numFrames, juce::int64 limit) noexcept;
+};
+
+#endif
@@ -0,0 +1,346 @@
+#include "Workers/PeakMipmap.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if JUCE_INTEL && (JUCE_64BIT || defined(__SSE2__))
+#define AUDIOFILER_PEAKMIPMAP_SSE2 1
+#include <immintrin.h>
+#else
+#define AUDIOFILER_PEAKMIPMAP_SSE2 0
+#endif
+
+namespace {
+constexpr juce::int32 kMagic = 0x56574641; // "AFWV"
+constexpr juce::int32 kVersion = 1;
+constexpr int kHeaderBytes = 40;
+constexpr float kSampleScale = 32767.0f;
+constexpr float kRmsScale = 65535.0f;
+
+/** @brief Smallest sample, largest sample and sum of squares of one block of one channel. */
+struct BlockLevels {
+    float minimum;
+    float maximum;
+    float sumOfSquares;
+};
+
+/**
+ * @brief Reduces one block in a single pass.
+ * @details Eight samples per step in two SSE2 registers for each of minimum, maximum and
+ *          sum of squares, folded horizontally at the end; the tail is scalar.
+ */
+BlockLevels reduceBlock(const float *data, int numSamples) noexcept {
+    BlockLevels result{data[0], data[0], 0.0f};
+    int i = 0;
+#if AUDIOFILER_PEAKMIPMAP_SSE2
+    if (numSamples >= 8) {
+        __m128 lo0 = _mm_loadu_ps(data), lo1 = _mm_loadu_ps(data + 4);
+        __m128 hi0 = lo0, hi1 = lo1;
+        __m128 sq0 = _mm_mul_ps(lo0, lo0), sq1 = _mm_mul_ps(lo1, lo1);
+        for (i = 8; i + 8 <= numSamples; i += 8) {
+            const __m128 a = _mm_loadu_ps(data + i), b = _mm_loadu_ps(data + i + 4);
+            lo0 = _mm_min_ps(lo0, a);
+            lo1 = _mm_min_ps(lo1, b);
+            hi0 = _mm_max_ps(hi0, a);
+            hi1 = _mm_max_ps(hi1, b);
+            sq0 = _mm_add_ps(sq0, _mm_mul_ps(a, a));
+            sq1 = _mm_add_ps(sq1, _mm_mul_ps(b, b));
+        }
+        alignas(16) float lo[4], hi[4], sq[4];
+        _mm_store_ps(lo, _mm_min_ps(lo0, lo1));
+        _mm_store_ps(hi, _mm_max_ps(hi0, hi1));
+        _mm_store_ps(sq, _mm_add_ps(sq0, sq1));
+        result = {std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3])),
+                  std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3])),
+                  (sq[0] + sq[1]) + (sq[2] + sq[3])};
+    }
+#endif
+    for (; i < numSamples; ++i) {
+        result.minimum = std::min(result.minimum, data[i]);
+        result.maximum = std::max(result.maximum, data[i]);
+        result.sumOfSquares += data[i] * data[i];
+    }
+    return result;
+}
+
+// NaN samples draw as silence; converting NaN to an integer would be undefined.
+juce::int16 quantizeDown(float sample) noexcept {
+    if (std::isnan(sample))
+        return 0;
+    return (juce::int16)juce::jlimit(-kSampleScale, kSampleScale,
+                                     std::floor(sample * kSampleScale));
+}
+
+juce::int16 quantizeUp(float sample) noexcept {
+    if (std::isnan(sample))
+        return 0;
+    return (juce::int16)juce::jlimit(-kSampleScale, kSampleScale, std::ceil(sample * kSampleScale));
+}
+
+juce::uint16 quantizeRms(double rms) noexcept {
+    if (std::isnan(rms))
+        return 0;
+    return (juce::uint16)juce::jlimit(0.0, (double)kRmsScale, std::ceil(rms * kRmsScale));
+}
+} // namespace
+
+PeakMipmap::Builder::Builder(PeakMipmap &target) : mipmap(target) {
+    static_assert(SilenceAnalysisAlgorithms::chunkSize % baseBlockSize == 0,
+                  "Blocks must not straddle chunk boundaries");
+    mipmap.storage.assign(mipmap.getNumEntries(), Entry());
+    mipmap.entries = mipmap.storage.data();
+}
+
+/**
+ * @details A parent block is merged as soon as its second child is written, so every
+ *          block that ends at or before the published sample count is final. Blocks on
+ *          the right edge of each level may have a single or partial child; finish()
+ *          writes them once the whole file has been seen.
+ */
+void PeakMipmap::Builder::addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+    jassert(buffer.getNumChannels() >= mipmap.numChannels);
+    std::vector<const float *> channelData((size_t)mipmap.numChannels);
+    for (int offset = 0; offset < numSamples; offset += baseBlockSize) {
+        for (int ch = 0; ch < mipmap.numChannels; ++ch)
+            channelData[(size_t)ch] = buffer.getReadPointer(ch, offset);
+        mipmap.writeBlock(nextBlock, channelData.data(),
+                          std::min(baseBlockSize, numSamples - offset));
+
+        juce::int64 index = nextBlock++;
+        for (int level = 1; level < mipmap.numLevels && (index & 1) == 1; ++level) {
+            index >>= 1;
+            mipmap.mergeBlock(level, index);
+        }
+    }
+
+    const juce::int64 done = nextBlock << baseBlockShift;
+    if (done < mipmap.lengthInSamples)
+        mipmap.finished.store(done, std::memory_order_release);
+}
+
+void PeakMipmap::Builder::finish() {
+    for (int level = 1; level < mipmap.numLevels; ++level)
+        mipmap.mergeBlock(level, mipmap.counts[(size_t)level] - 1);
+    mipmap.finished.store(mipmap.lengthInSamples, std::memory_order_release);
+}
+
+void PeakMipmap::reset(juce::int64 length, int channels, double rate) {
+    const juce::ScopedWriteLock lock(resetLock);
+    resetCount.fetch_add(1, std::memory_order_acq_rel);
+    finished.store(0, std::memory_order_release);
+    lengthInSamples = std::max((juce::int64)0, length);
+    numChannels = lengthInSamples > 0 ? std::max(0, channels) : 0;
+    sampleRate = rate;
+    entries = nullptr;
+    storage = std::vector<Entry>();
+    mapped.reset();
+
+    counts.clear();
+    offsets.clear();
+    if (numChannels > 0) {
+        counts.push_back((lengthInSamples + baseBlockSize - 1) / baseBlockSize);
+        while (counts.back() > 1)
+            counts.push_back((counts.back() + 1) / 2);
+    }
+    numLevels = (int)counts.size();
+    size_t offset = 0;
+    for (int level = 0; level < numLevels; ++level) {
+        for (int ch = 0; ch < numChannels; ++ch) {
+            offsets.push_back(offset);
+            offset += (size_t)counts[(size_t)level];
+        }
+    }
+}
+
+size_t PeakMipmap::getMemoryUsage() const {
+    return getNumEntries() * sizeof(Entry);
+}
+
+bool PeakMipmap::writeTo(juce::OutputStream &output) const {
+    static_assert(sizeof(Entry) == 6, "Entries are stored unpadded");
+    if (!isFullyLoaded() || entries == nullptr)
+        return false;
+    return output.writeInt(kMagic) && output.writeInt(kVersion) &&
+           output.writeInt64(lengthInSamples) && output.writeInt(numChannels) &&
+           output.writeDouble(sampleRate) && output.writeInt(baseBlockShift) &&
+           output.writeInt64((juce::int64)getNumEntries()) &&
+           output.write(entries, getNumEntries() * sizeof(Entry));
+}
+
+/**
+ * @details The header is parsed like any stream; the blocks are used where they lie in the
+ *          mapping, 40 bytes in and so suitably aligned. Publishing the full length with
+ *          release semantics makes the pointer visible before any query can use it.
+ */
+bool PeakMipmap::loadMapped(std::unique_ptr<juce::MemoryMappedFile> file) {
+    if (file == nullptr || file->getData() == nullptr || file->getSize() < (size_t)kHeaderBytes ||
+        numChannels == 0 || getNumSamplesFinished() != 0)
+        return false;
+
+    juce::MemoryInputStream header(file->getData(), (size_t)kHeaderBytes, false);
+    if (header.readInt() != kMagic || header.readInt() != kVersion ||
+        header.readInt64() != lengthInSamples || header.readInt() != numChannels ||
+        header.readDouble() != sampleRate || header.readInt() != baseBlockShift ||
+        header.readInt64() != (juce::int64)getNumEntries() ||
+        file->getSize() < (size_t)kHeaderBytes + getNumEntries() * sizeof(Entry))
+        return false;
+
+    mapped = std::move(file);
+    entries = reinterpret_cast<const Entry *>(static_cast<const char *>(mapped->getData()) +
+                                              kHeaderBytes);
+    finished.store(lengthInSamples, std::memory_order_release);
+    return true;
+}
+
+juce::int64 PeakMipmap::blockLength(int level, juce::int64 index) const {
+    const int shift = baseBlockShift + level;
+    return std::min(lengthInSamples, (index + 1) << shift) - (index << shift);
+}
+
+void PeakMipmap::writeBlock(juce::int64 index, const float *const *channelData, int numSamples) {
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const auto reduced = reduceBlock(channelData[ch], numSamples);
+        auto &entry = writableBlocks(0, ch)[index];
+        entry.minimum = quantizeDown(reduced.minimum);
+        entry.maximum = quantizeUp(reduced.maximum);
+        entry.rms = quantizeRms(std::sqrt((double)reduced.sumOfSquares / numSamples));
+    }
+}
+
+void PeakMipmap::mergeBlock(int level, juce::int64 index) {
+    const juce::int64 first = index * 2;
+    const juce::int64 numChildren = std::min((juce::int64)2, counts[(size_t)level - 1] - first);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const Entry *children = blocks(level - 1, ch);
+        Entry merged = children[first];
+        double sumOfSquares = 0.0;
+        for (juce::int64 child = first; child < first + numChildren; ++child) {
+            const auto &entry = children[child];
+            merged.minimum = std::min(merged.minimum, entry.minimum);
+            merged.maximum = std::max(merged.maximum, entry.maximum);
+            const double rms = entry.rms / (double)kRmsScale;
+            sumOfSquares += rms * rms * (double)blockLength(level - 1, child);
+        }
+        merged.rms = quantizeRms(std::sqrt(sumOfSquares / (double)blockLength(level, index)));
+        writableBlocks(level, ch)[index] = merged;
+    }
+}
+
+/**
+ * @details Blocks the builder has not reached yet are replaced by their finished children,
+ *          so only the column at the loading front ever descends below the chosen level.
+ */
+void PeakMipmap::accumulate(Accumulator &total, int channel, juce::int64 start,
+                            juce::int64 end, int level, juce::int64 done) const {
+    const int shift = baseBlockShift + level;
+    const Entry *levelBlocks = blocks(level, channel);
+    for (juce::int64 index = start >> shift; (index << shift) < end; ++index) {
+        if (std::min(lengthInSamples, (index + 1) << shift) > done) {
+            if (level > 0)
+                accumulate(total, channel, std::max(start, index << shift), end, level - 1, done);
+            return;
+        }
+        const auto &entry = levelBlocks[index];
+        const auto length = blockLength(level, index);
+        const double rms = entry.rms / (double)kRmsScale;
+        total.minimum = std::min(total.minimum, entry.minimum / kSampleScale);
+        total.maximum = std::max(total.maximum, entry.maximum / kSampleScale);
+        total.sumOfSquares += rms * rms * (double)length;
+        total.numSamples += length;
+    }
+}
+
+PeakMipmap::Column PeakMipmap::getColumn(int channel, juce::int64 startSample,
+                                         juce::int64 endSample) const {
+    if (channel < 0 || channel >= numChannels)
+        return {};
+
+    const juce::int64 done = getNumSamplesFinished();
+    const juce::int64 start = juce::jlimit((juce::int64)0, lengthInSamples, startSample);
+    const juce::int64 end = std::min(done, std::max(endSample, start + 1));
+    if (start >= end)
+        return {};
+
+    int level = 0;
+    while (level + 1 < numLevels && ((juce::int64)baseBlockSize << (level + 3)) <= end - start)
+        ++level;
+
+    Accumulator total;
+    accumulate(total, channel, start, end, level, done);
+    if (total.numSamples == 0)
+        return {};
+    return {total.minimum, total.maximum,
+            (float)std::sqrt(total.sumOfSquares / (double)total.numSamples)};
+}
+
+/**
+ * @details Each column covers [floor(a), ceil(b)) of its fractional bounds, so neighbouring
+ *          columns may share a sample but never leave one out.
+ */
+void PeakMipmap::getColumns(double startSample, double endSample, int numColumns,
+                            int firstChannel, int numChannelsToFill, float *const *minima,
+                            float *const *maxima) const {
+    if (numColumns <= 0)
+        return;
+
+    const juce::int64 done = getNumSamplesFinished();
+    const double columnSamples = (endSample - startSample) / numColumns;
+    int level = 0;
+    while (level + 1 < numLevels &&
+           (double)((juce::int64)baseBlockSize << (level + 3)) <= columnSamples)
+        ++level;
+    const int shift = baseBlockShift + level;
+
+    for (int c = 0; c < numChannelsToFill; ++c) {
+        const int channel = firstChannel + c;
+        float *minimum = minima[c];
+        float *maximum = maxima[c];
+        if (channel < 0 || channel >= numChannels || done == 0) {
+            std::fill(minimum, minimum + numColumns, 0.0f);
+            std::fill(maximum, maximum + numColumns, 0.0f);
+            continue;
+        }
+
+        const Entry *levelBlocks = blocks(level, channel);
+        for (int column = 0; column < numColumns; ++column) {
+            const auto start = std::max(
+                (juce::int64)0, (juce::int64)std::floor(startSample + column * columnSamples));
+            auto end = (juce::int64)std::ceil(startSample + (column + 1) * columnSamples);
+            end = std::min(done, std::max(end, start + 1));
+            minimum[column] = maximum[column] = 0.0f;
+            if (start >= end)
+                continue;
+
+            const juce::int64 last = (end - 1) >> shift;
+            if (std::min(lengthInSamples, (last + 1) << shift) > done) {
+                // The loading front: let the general path descend to finished blocks.
+                const auto front = getColumn(channel, start, end);
+                minimum[column] = front.minimum;
+                maximum[column] = front.maximum;
+                continue;
+            }
+
+            juce::int16 low = levelBlocks[start >> shift].minimum;
+            juce::int16 high = levelBlocks[start >> shift].maximum;
+            for (juce::int64 index = (start >> shift) + 1; index <= last; ++index) {
+                low = std::min(low, levelBlocks[index].minimum);
+                high = std::max(high, levelBlocks[index].maximum);
+            }
+            minimum[column] = low / kSampleScale;
+            maximum[column] = high / kSampleScale;
+        }
+    }
+}
+
+void PeakMipmap::getApproximateMinMax(double startTime, double endTime, int channel,
+                                      float &minValue, float &maxValue) const {
+    minValue = maxValue = 0.0f;
+    if (sampleRate <= 0.0)
+        return;
+
+    const auto column = getColumn(channel, (juce::int64)std::floor(startTime * sampleRate),
+                                  (juce::int64)std::ceil(endTime * sampleRate));
+    minValue = column.minimum;
+    maxValue = column.maximum;
+}
@@ -0,0 +1,258 @@
+#ifndef AUDIOFILER_PEAKMIPMAP_H
+#define AUDIOFILER_PEAKMIPMAP_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @file PeakMipmap.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Multi-level min/max/RMS store of a file that backs every waveform display.
+ *
+ * @details Architecturally, PeakMipmap is the "Model" drawn by WaveformView and ZoomView
+ *          in place of `juce::AudioThumbnail`. Level 0 holds, per channel and per block of
+ *          128 samples, the smallest and largest sample and the RMS level, quantized to 16
+ *          bits (minimum rounded down, maximum rounded up, so a block never looks quieter
+ *          than it is). Every further level halves the resolution by merging pairs of
+ *          blocks, until one block covers the whole file.
+ *
+ *          A column query picks the coarsest level whose blocks are at most a quarter of
+ *          the column, so any span from one block to the whole file is answered from at
+ *          most nine blocks, reaching past the span by less than half its length. Spans
+ *          shorter than a block report the enclosing block.
+ *
+ *          Memory cost is 6 bytes per 128 samples per channel, doubled by the coarser
+ *          levels: about 15 MB per channel-hour of 44.1 kHz audio.
+ *
+ *          The store is sized up front by reset() and then either filled front to back by a
+ *          single Builder on a background thread, or pointed at a memory-mapped copy written
+ *          by writeTo() in an earlier session (see WaveformCache). Readers on other threads
+ *          only ever see blocks below getNumSamplesFinished(), which is published after the
+ *          blocks are in place, so the waveform can be drawn while the file is still loading.
+ *
+ * @see WaveformManager
+ * @see WaveformCache
+ * @see AnalysisPipeline
+ * @see PeakPyramid
+ */
+class PeakMipmap final {
+  public:
+    static constexpr int baseBlockShift = 7;                  /**< log2 of baseBlockSize. */
+    static constexpr int baseBlockSize = 1 << baseBlockShift; /**< Samples per level-0 block. */
+
+    /** @brief The level range of a span of one channel. */
+    struct Column {
+        float minimum = 0.0f; /**< Most negative sample. */
+        float maximum = 0.0f; /**< Most positive sample. */
+        float rms = 0.0f;     /**< Root mean square level. */
+    };
+
+    /**
+     * @class Builder
+     * @brief Fills a PeakMipmap chunk by chunk so it can share a pass of AnalysisPipeline.
+     * @details Every chunk except the last must be a whole number of base blocks long.
+     */
+    class Builder {
+      public:
+        /**
+         * @brief Allocates the blocks of a store already sized by PeakMipmap::reset().
+         * @param target The store to fill; must outlive the builder.
+         */
+        explicit Builder(PeakMipmap &target);
+
+        /**
+         * @brief Consumes the next chunk of the file, in order, and publishes its blocks.
+         * @param buffer Decoded samples; only the first `numSamples` are used.
+         * @param numSamples The number of valid samples in the buffer.
+         */
+        void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples);
+
+        /** @brief Completes the partial blocks at the end of every level and publishes them. */
+        void finish();
+
+      private:
+        PeakMipmap &mipmap;
+        juce::int64 nextBlock = 0;
+    };
+
+    PeakMipmap() = default;
+
+    /**
+     * @brief Empties the store and sizes it for a new file, without allocating blocks.
+     * @details Must not run concurrently with a Builder. Waits for queries made under
+     *          getResetLock() to finish.
+     * @param lengthInSamples The file length in samples.
+     * @param numChannels The file channel count.
+     * @param sampleRate The file sample rate.
+     */
+    void reset(juce::int64 lengthInSamples, int numChannels, double sampleRate);
+
+    /** @return The number of samples per channel the store describes. */
+    juce::int64 getLengthInSamples() const {
+        return lengthInSamples;
+    }
+
+    /** @return The number of channels. */
+    int getNumChannels() const {
+        return numChannels;
+    }
+
+    /** @return The sample rate the store was sized for. */
+    double getSampleRate() const {
+        return sampleRate;
+    }
+
+    /** @return The file duration in seconds, known as soon as the store is sized. */
+    double getTotalLength() const {
+        return sampleRate > 0.0 ? (double)lengthInSamples / sampleRate : 0.0;
+    }
+
+    /** @return The number of leading samples whose blocks can be queried. */
+    juce::int64 getNumSamplesFinished() const {
+        return finished.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief The lock that keeps reset() from reshaping the store under a query.
+     * @details Threads other than the Message Thread hold a read lock on it across their
+     *          queries; reset() takes the write lock.
+     */
+    juce::ReadWriteLock &getResetLock() const {
+        return resetLock;
+    }
+
+    /**
+     * @return The number of reset() calls so far. A change tells a view that the store now
+     *         holds another file, even one of the same length whose blocks arrive at once
+     *         from the cache.
+     */
+    juce::uint32 getResetCount() const {
+        return resetCount.load(std::memory_order_acquire);
+    }
+
+    /** @return True once every block of every level has been built. */
+    bool isFullyLoaded() const {
+        return getNumSamplesFinished() >= lengthInSamples;
+    }
+
+    /** @return The number of levels, the last of which is a single block. */
+    int getNumLevels() const {
+        return numLevels;
+    }
+
+    /** @return The bytes the block arrays of the current shape occupy, in memory or mapped. */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Serializes a fully loaded store in the layout loadMapped() expects.
+     * @details The blocks are written in native byte order; the files are a local cache.
+     * @param output The stream to write to.
+     * @return True on success; false if the store is still building.
+     */
+    bool writeTo(juce::OutputStream &output) const;
+
+    /**
+     * @brief Uses the blocks of a mapped file written by writeTo() instead of building them.
+     * @details The file must describe the shape given to the last reset(). Like a Builder,
+     *          this may run on a background thread while other threads query the store,
+     *          since nothing is visible to them until the whole store is published.
+     * @param file The mapped file; kept open for as long as the store uses it.
+     * @return True if the file matched and the store is now fully loaded.
+     */
+    bool loadMapped(std::unique_ptr<juce::MemoryMappedFile> file);
+
+    /**
+     * @brief Summarizes a span of one channel.
+     * @param channel The channel index.
+     * @param startSample The first sample of the span.
+     * @param endSample One past the last sample; spans under one sample are widened to one.
+     * @return The level range, or silence for a channel or span without finished blocks.
+     */
+    Column getColumn(int channel, juce::int64 startSample, juce::int64 endSample) const;
+
+    /**
+     * @brief Fills the minimum and maximum of equal-width columns across a span, for a
+     *        range of channels, in one call.
+     * @details The level is chosen once for the whole row of columns and each column reads
+     *          its blocks directly, without the RMS bookkeeping of getColumn(). Columns that
+     *          lie outside the file or beyond the finished blocks are reported as silence.
+     * @param startSample The first sample of the span (fractional at deep zoom).
+     * @param endSample The end of the span; the span is divided into `numColumns` columns.
+     * @param numColumns The number of columns to fill.
+     * @param firstChannel The first channel to fill.
+     * @param numChannelsToFill The number of consecutive channels to fill.
+     * @param minima One array of `numColumns` floats per channel filled.
+     * @param maxima One array of `numColumns` floats per channel filled.
+     */
+    void getColumns(double startSample, double endSample, int numColumns, int firstChannel,
+                    int numChannelsToFill, float *const *minima, float *const *maxima) const;
+
+    /**
+     * @brief Drop-in equivalent of `juce::AudioThumbnail::getApproximateMinMax()`.
+     * @param startTime The start of the span in seconds.
+     * @param endTime The end of the span in seconds.
+     * @param channel The channel index.
+     * @param minValue Receives the most negative sample.
+     * @param maxValue Receives the most positive sample.
+     */
+    void getApproximateMinMax(double startTime, double endTime, int channel, float &minValue,
+                              float &maxValue) const;
+
+  private:
+    /** @brief One block of one channel. */
+    struct Entry {
+        juce::int16 minimum = 0;
+        juce::int16 maximum = 0;
+        juce::uint16 rms = 0;
+    };
+
+    /** @brief Running totals of a span while a query merges blocks. */
+    struct Accumulator {
+        float minimum = 1.0f;
+        float maximum = -1.0f;
+        double sumOfSquares = 0.0;
+        juce::int64 numSamples = 0;
+    };
+
+    const Entry *blocks(int level, int channel) const {
+        return entries + offsets[(size_t)(level * numChannels + channel)];
+    }
+
+    Entry *writableBlocks(int level, int channel) {
+        return storage.data() + offsets[(size_t)(level * numChannels + channel)];
+    }
+
+    size_t getNumEntries() const {
+        return offsets.empty() ? 0 : offsets.back() + (size_t)counts.back();
+    }
+
+    juce::int64 blockLength(int level, juce::int64 index) const;
+    void writeBlock(juce::int64 index, const float *const *channelData, int numSamples);
+    void mergeBlock(int level, juce::int64 index);
+    void accumulate(Accumulator &total, int channel, juce::int64 start, juce::int64 end,
+                    int level, juce::int64 done) const;
+
+    juce::int64 lengthInSamples = 0;
+    int numChannels = 0;
+    double sampleRate = 0.0;
+    int numLevels = 0;
+    std::vector<juce::int64> counts; /**< Blocks per channel, by level. */
+    std::vector<size_t> offsets;     /**< First entry, by level * numChannels + channel. */
+    std::vector<Entry> storage;      /**< Blocks written by a Builder. */
+    std::unique_ptr<juce::MemoryMappedFile> mapped; /**< Blocks loaded by loadMapped(). */
+    const Entry *entries = nullptr;  /**< Whichever of the two is in use. */
+    std::atomic<juce::int64> finished{0};
+    mutable juce::ReadWriteLock resetLock;
+    std::atomic<juce::uint32> resetCount{0};
+};
+
+#endif
@@ -0,0 +1,208 @@
+#include "Workers/PeakPyramid.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr juce::int32 kMagic = 0x4b504641; // "AFPK"
+constexpr juce::int32 kVersion = 1;
+constexpr float kScale = 65535.0f;
+} // namespace
+
+// A NaN peak saturates, so the leaf stays a candidate and the confirming read decides;
+// converting NaN to an integer would be undefined.
+juce::uint16 PeakPyramid::quantizeUp(float peak) noexcept {
+    if (std::isnan(peak))
+        return (juce::uint16)kScale;
+    return (juce::uint16)juce::jlimit(0.0f, kScale, std::ceil(peak * kScale));
+}
+
+// Capped one step below saturation: a saturated leaf may hold float samples beyond
+// full scale, so it must remain a candidate for every threshold. A NaN threshold makes
+// every non-silent leaf a candidate for the same reason.
+juce::uint16 PeakPyramid::quantizeThreshold(float threshold) noexcept {
+    if (std::isnan(threshold))
+        return 0;
+    return (juce::uint16)juce::jlimit(0.0f, kScale - 1.0f, std::floor(threshold * kScale));
+}
+
+PeakPyramid::Builder::Builder(juce::int64 length, int channels)
+    : pyramid(std::make_unique<PeakPyramid>()) {
+    pyramid->lengthInSamples = length;
+    pyramid->numChannels = channels;
+    pyramid->levels[0].reserve((size_t)((length + leafSize - 1) / leafSize));
+}
+
+/**
+ * @details For each 256-sample leaf and channel, `FloatVectorOperations::findMinAndMax`
+ *          yields the signed range, whose larger magnitude is the leaf's peak.
+ */
+void PeakPyramid::Builder::addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+    jassert(pyramid != nullptr);
+    auto &leaves = pyramid->levels[0];
+    for (int leafStart = 0; leafStart < numSamples; leafStart += leafSize) {
+        const int leafLength = std::min(leafSize, numSamples - leafStart);
+        float peak = 0.0f;
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(
+                buffer.getReadPointer(ch, leafStart), leafLength);
+            peak = std::max(peak, std::max(-range.getStart(), range.getEnd()));
+        }
+        leaves.push_back(quantizeUp(peak));
+    }
+}
+
+std::unique_ptr<PeakPyramid> PeakPyramid::Builder::finish() {
+    pyramid->buildUpperLevels();
+    return std::move(pyramid);
+}
+
+/**
+ * @details Level 0 is filled straight from the decoded chunks. Since the read chunk is a
+ *          multiple of the leaf size, leaves never straddle two reads. The coarser levels
+ *          are derived afterwards by taking the maximum over each group of 16 children.
+ */
+std::unique_ptr<PeakPyramid> PeakPyramid::build(juce::AudioFormatReader &reader,
+                                                const ScanContext &context) {
+    if (!SilenceAnalysisAlgorithms::isScannable(reader) || reader.lengthInSamples <= 0)
+        return nullptr;
+
+    static_assert(SilenceAnalysisAlgorithms::chunkSize % leafSize == 0,
+                  "Leaves must not straddle chunk boundaries");
+
+    Builder builder(reader.lengthInSamples, (int)reader.numChannels);
+    juce::AudioBuffer<float> buffer((int)reader.numChannels, SilenceAnalysisAlgorithms::chunkSize);
+    for (juce::int64 pos = 0; pos < reader.lengthInSamples;) {
+        const int numThisTime = (int)std::min((juce::int64)SilenceAnalysisAlgorithms::chunkSize,
+                                              reader.lengthInSamples - pos);
+        if (!reader.read(&buffer, 0, numThisTime, pos, true, true) || context.shouldStop())
+            return nullptr;
+        context.pace(numThisTime);
+
+        builder.addChunk(buffer, numThisTime);
+        pos += numThisTime;
+    }
+
+    return builder.finish();
+}
+
+void PeakPyramid::buildUpperLevels() {
+    for (int level = 1; level < numLevels; ++level) {
+        const auto &children = levels[(size_t)level - 1];
+        auto &parents = levels[(size_t)level];
+        parents.assign((children.size() + fanout - 1) / fanout, 0);
+        for (size_t i = 0; i < children.size(); ++i)
+            parents[i / fanout] = std::max(parents[i / fanout], children[i]);
+    }
+}
+
+bool PeakPyramid::matches(const juce::AudioFormatReader &reader) const {
+    return reader.lengthInSamples == lengthInSamples && (int)reader.numChannels == numChannels;
+}
+
+/**
+ * @details Search strategy: scan the remainder of the current group at this level; if
+ *          nothing qualifies, continue with the *next* parent one level up. When a
+ *          qualifying block is found at any level, descend() walks down to its first
+ *          qualifying leaf. The top level is scanned linearly; it is only ~1/65536 of
+ *          the file length, so even a ten-hour file costs a few microseconds.
+ */
+juce::int64 PeakPyramid::findFirst(int level, juce::int64 from, juce::uint16 limit) const {
+    const auto &values = levels[(size_t)level];
+    const auto size = (juce::int64)values.size();
+    const bool isTop = level == numLevels - 1;
+    const juce::int64 groupEnd = isTop ? size : std::min(size, (from / fanout + 1) * fanout);
+
+    for (juce::int64 i = from; i < groupEnd; ++i)
+        if (values[(size_t)i] > limit)
+            return descend(level, i, limit, true);
+
+    return isTop ? -1 : findFirst(level + 1, from / fanout + 1, limit);
+}
+
+juce::int64 PeakPyramid::findLast(int level, juce::int64 before, juce::uint16 limit) const {
+    const auto &values = levels[(size_t)level];
+    before = std::min(before, (juce::int64)values.size());
+    if (before <= 0)
+        return -1;
+
+    const bool isTop = level == numLevels - 1;
+    const juce::int64 groupStart = isTop ? 0 : ((before - 1) / fanout) * fanout;
+
+    for (juce::int64 i = before - 1; i >= groupStart; --i)
+        if (values[(size_t)i] > limit)
+            return descend(level, i, limit, false);
+
+    return isTop ? -1 : findLast(level + 1, (before - 1) / fanout, limit);
+}
+
+juce::int64 PeakPyramid::descend(int level, juce::int64 index, juce::uint16 limit,
+                                 bool first) const {
+    while (level > 0) {
+        const auto &children = levels[(size_t)level - 1];
+        const juce::int64 begin = index * fanout;
+        const juce::int64 end = std::min((juce::int64)children.size(), begin + fanout);
+        juce::int64 found = -1;
+        if (first) {
+            for (juce::int64 i = begin; i < end && found < 0; ++i)
+                if (children[(size_t)i] > limit)
+                    found = i;
+        } else {
+            for (juce::int64 i = end - 1; i >= begin && found < 0; --i)
+                if (children[(size_t)i] > limit)
+                    found = i;
+        }
+        jassert(found >= 0); // a parent's peak is the max of its children
+        if (found < 0)
+            return -1;
+        index = found;
+        --level;
+    }
+    return index;
+}
+
+juce::int64 PeakPyramid::findFirstLeafAbove(float threshold, juce::int64 fromLeaf) const {
+    if (fromLeaf >= getNumLeaves())
+        return -1;
+    return findFirst(0, std::max((juce::int64)0, fromLeaf), quantizeThreshold(threshold));
+}
+
+juce::int64 PeakPyramid::findLastLeafAbove(float threshold, juce::int64 beforeLeaf) const {
+    return findLast(0, beforeLeaf, quantizeThreshold(threshold));
+}
+
+bool PeakPyramid::writeTo(juce::OutputStream &output) const {
+    bool ok = output.writeInt(kMagic) && output.writeInt(kVersion) &&
+              output.writeInt64(lengthInSamples) && output.writeInt(numChannels) &&
+              output.writeInt64((juce::int64)levels[0].size());
+    for (const auto value : levels[0])
+        ok = ok && output.writeShort((short)value);
+    return ok;
+}
+
+std::unique_ptr<PeakPyramid> PeakPyramid::readFrom(juce::InputStream &input) {
+    if (input.readInt() != kMagic || input.readInt() != kVersion)
+        return nullptr;
+
+    auto pyramid = std::make_unique<PeakPyramid>();
+    pyramid->lengthInSamples = input.readInt64();
+    pyramid->numChannels = input.readInt();
+    const juce::int64 numLeaves = input.readInt64();
+
+    if (pyramid->lengthInSamples <= 0 ||
+        numLeaves != (pyramid->lengthInSamples + leafSize - 1) / leafSize)
+        return nullptr;
+
+    const auto remaining = input.getNumBytesRemaining();
+    if (remaining >= 0 && remaining < numLeaves * (juce::int64)sizeof(juce::uint16))
+        return nullptr;
+
+    auto &leaves = pyramid->levels[0];
+    leaves.resize((size_t)numLeaves);
+    for (auto &value : leaves)
+        value = (juce::uint16)input.readShort();
+
+    pyramid->buildUpperLevels();
+    return pyramid;
+}
@@ -0,0 +1,285 @@
+#include "Workers/PeakScanKernels.h"
+#include <cmath>
+#include <cstdint>
+
+#if JUCE_INTEL && (JUCE_64BIT || defined(__SSE2__))
+#define AUDIOFILER_PEAKSCAN_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIOFILER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AUDIOFILER_TARGET_AVX2
+#endif
+#else
+#define AUDIOFILER_PEAKSCAN_X86 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+/** @brief Samples tested per vector step (4 x SSE2 or 2 x AVX2 registers per channel). */
+constexpr int kBlock = 16;
+
+/**
+ * @brief Compile-time channel layout used to specialize the kernels.
+ * @details `NumChannels == 0` is the generic N-channel layout whose count is only known
+ *          at runtime; 1 and 2 let the compiler fully unroll the channel loop.
+ */
+template <int NumChannels> struct Layout {
+    static constexpr int count(int) noexcept { return NumChannels; }
+};
+
+template <> struct Layout<0> {
+    static int count(int numChannels) noexcept { return numChannels; }
+};
+
+inline int lowestSetBit(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline int highestSetBit(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (int)index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+template <int N>
+inline bool anyAbove(const float *const *ch, int numChannels, int i, float threshold) noexcept {
+    const int n = Layout<N>::count(numChannels);
+    for (int c = 0; c < n; ++c)
+        if (std::abs(ch[c][i]) > threshold)
+            return true;
+    return false;
+}
+
+template <int N>
+int scalarFirst(const float *const *ch, int numChannels, int begin, int end,
+                float threshold) noexcept {
+    for (int i = begin; i < end; ++i)
+        if (anyAbove<N>(ch, numChannels, i, threshold))
+            return i;
+    return -1;
+}
+
+template <int N>
+int scalarLast(const float *const *ch, int numChannels, int begin, int end,
+               float threshold) noexcept {
+    for (int i = end - 1; i >= begin; --i)
+        if (anyAbove<N>(ch, numChannels, i, threshold))
+            return i;
+    return -1;
+}
+
+#if AUDIOFILER_PEAKSCAN_X86
+/**
+ * @details Builds a 16-bit mask for samples [i, i + 16): bit k is set when sample
+ *          i + k exceeds the threshold on at least one channel. The absolute value is
+ *          taken by clearing the IEEE sign bit, and the per-channel compare results are
+ *          ORed so the channel count never multiplies the number of mask extractions.
+ *          NaN compares false, matching `std::abs(x) > threshold` in the scalar path.
+ */
+template <int N>
+inline std::uint32_t sse2Mask(const float *const *ch, int numChannels, int i,
+                              __m128 threshold) noexcept {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 hit0 = _mm_setzero_ps(), hit1 = _mm_setzero_ps();
+    __m128 hit2 = _mm_setzero_ps(), hit3 = _mm_setzero_ps();
+    const int n = Layout<N>::count(numChannels);
+    for (int c = 0; c < n; ++c) {
+        const float *p = ch[c] + i;
+        hit0 = _mm_or_ps(hit0, _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p), absMask), threshold));
+        hit1 = _mm_or_ps(hit1, _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p + 4), absMask), threshold));
+        hit2 = _mm_or_ps(hit2, _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p + 8), absMask), threshold));
+        hit3 =
+            _mm_or_ps(hit3, _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p + 12), absMask), threshold));
+    }
+    return (std::uint32_t)(_mm_movemask_ps(hit0) | (_mm_movemask_ps(hit1) << 4) |
+                           (_mm_movemask_ps(hit2) << 8) | (_mm_movemask_ps(hit3) << 12));
+}
+
+template <int N>
+int sse2First(const float *const *ch, int numChannels, int numSamples, float threshold) noexcept {
+    const __m128 t = _mm_set1_ps(threshold);
+    int i = 0;
+    for (; i + kBlock <= numSamples; i += kBlock)
+        if (const auto mask = sse2Mask<N>(ch, numChannels, i, t))
+            return i + lowestSetBit(mask);
+    return scalarFirst<N>(ch, numChannels, i, numSamples, threshold);
+}
+
+template <int N>
+int sse2Last(const float *const *ch, int numChannels, int numSamples, float threshold) noexcept {
+    const __m128 t = _mm_set1_ps(threshold);
+    int i = numSamples;
+    while (i - kBlock >= 0) {
+        i -= kBlock;
+        if (const auto mask = sse2Mask<N>(ch, numChannels, i, t))
+            return i + highestSetBit(mask);
+    }
+    return scalarLast<N>(ch, numChannels, 0, i, threshold);
+}
+
+/** @details AVX2 flavour of sse2Mask(): two 8-lane registers cover the same 16 samples. */
+template <int N>
+AUDIOFILER_TARGET_AVX2 inline std::uint32_t avx2Mask(const float *const *ch, int numChannels,
+                                                     int i, __m256 threshold) noexcept {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 hit0 = _mm256_setzero_ps(), hit1 = _mm256_setzero_ps();
+    const int n = Layout<N>::count(numChannels);
+    for (int c = 0; c < n; ++c) {
+        const float *p = ch[c] + i;
+        hit0 = _mm256_or_ps(hit0, _mm256_cmp_ps(_mm256_and_ps(_mm256_loadu_ps(p), absMask),
+                                                threshold, _CMP_GT_OQ));
+        hit1 = _mm256_or_ps(hit1, _mm256_cmp_ps(_mm256_and_ps(_mm256_loadu_ps(p + 8), absMask),
+                                                threshold, _CMP_GT_OQ));
+    }
+    return (std::uint32_t)(_mm256_movemask_ps(hit0) | (_mm256_movemask_ps(hit1) << 8));
+}
+
+template <int N>
+AUDIOFILER_TARGET_AVX2 int avx2First(const float *const *ch, int numChannels, int numSamples,
+                                     float threshold) noexcept {
+    const __m256 t = _mm256_set1_ps(threshold);
+    int i = 0;
+    for (; i + kBlock <= numSamples; i += kBlock)
+        if (const auto mask = avx2Mask<N>(ch, numChannels, i, t))
+            return i + lowestSetBit(mask);
+    return scalarFirst<N>(ch, numChannels, i, numSamples, threshold);
+}
+
+template <int N>
+AUDIOFILER_TARGET_AVX2 int avx2Last(const float *const *ch, int numChannels, int numSamples,
+                                    float threshold) noexcept {
+    const __m256 t = _mm256_set1_ps(threshold);
+    int i = numSamples;
+    while (i - kBlock >= 0) {
+        i -= kBlock;
+        if (const auto mask = avx2Mask<N>(ch, numChannels, i, t))
+            return i + highestSetBit(mask);
+    }
+    return scalarLast<N>(ch, numChannels, 0, i, threshold);
+}
+#endif
+
+template <int N>
+int dispatchFirst(PeakScanKernels::Kernel kernel, const float *const *ch, int numChannels,
+                  int numSamples, float threshold) noexcept {
+#if AUDIOFILER_PEAKSCAN_X86
+    if (kernel == PeakScanKernels::Kernel::Avx2)
+        return avx2First<N>(ch, numChannels, numSamples, threshold);
+    if (kernel == PeakScanKernels::Kernel::Sse2)
+        return sse2First<N>(ch, numChannels, numSamples, threshold);
+#else
+    juce::ignoreUnused(kernel);
+#endif
+    return scalarFirst<N>(ch, numChannels, 0, numSamples, threshold);
+}
+
+template <int N>
+int dispatchLast(PeakScanKernels::Kernel kernel, const float *const *ch, int numChannels,
+                 int numSamples, float threshold) noexcept {
+#if AUDIOFILER_PEAKSCAN_X86
+    if (kernel == PeakScanKernels::Kernel::Avx2)
+        return avx2Last<N>(ch, numChannels, numSamples, threshold);
+    if (kernel == PeakScanKernels::Kernel::Sse2)
+        return sse2Last<N>(ch, numChannels, numSamples, threshold);
+#else
+    juce::ignoreUnused(kernel);
+#endif
+    return scalarLast<N>(ch, numChannels, 0, numSamples, threshold);
+}
+
+PeakScanKernels::Kernel resolve(PeakScanKernels::Kernel kernel) noexcept {
+    return PeakScanKernels::isSupported(kernel) ? kernel : PeakScanKernels::Kernel::Scalar;
+}
+} // namespace
+
+int PeakScanKernels::findFirstAbove(const float *const *channels, int numChannels,
+                                    int numSamples, float threshold) noexcept {
+    return findFirstAbove(getActiveKernel(), channels, numChannels, numSamples, threshold);
+}
+
+int PeakScanKernels::findLastAbove(const float *const *channels, int numChannels, int numSamples,
+                                   float threshold) noexcept {
+    return findLastAbove(getActiveKernel(), channels, numChannels, numSamples, threshold);
+}
+
+int PeakScanKernels::findFirstAbove(Kernel kernel, const float *const *channels, int numChannels,
+                                    int numSamples, float threshold) noexcept {
+    if (channels == nullptr || numChannels <= 0 || numSamples <= 0)
+        return -1;
+
+    kernel = resolve(kernel);
+    switch (numChannels) {
+    case 1:
+        return dispatchFirst<1>(kernel, channels, numChannels, numSamples, threshold);
+    case 2:
+        return dispatchFirst<2>(kernel, channels, numChannels, numSamples, threshold);
+    default:
+        return dispatchFirst<0>(kernel, channels, numChannels, numSamples, threshold);
+    }
+}
+
+int PeakScanKernels::findLastAbove(Kernel kernel, const float *const *channels, int numChannels,
+                                   int numSamples, float threshold) noexcept {
+    if (channels == nullptr || numChannels <= 0 || numSamples <= 0)
+        return -1;
+
+    kernel = resolve(kernel);
+    switch (numChannels) {
+    case 1:
+        return dispatchLast<1>(kernel, channels, numChannels, numSamples, threshold);
+    case 2:
+        return dispatchLast<2>(kernel, channels, numChannels, numSamples, threshold);
+    default:
+        return dispatchLast<0>(kernel, channels, numChannels, numSamples, threshold);
+    }
+}
+
+bool PeakScanKernels::isSupported(Kernel kernel) noexcept {
+    switch (kernel) {
+    case Kernel::Scalar:
+        return true;
+#if AUDIOFILER_PEAKSCAN_X86
+    case Kernel::Sse2:
+        return true;
+    case Kernel::Avx2: {
+        static const bool hasAvx2 = juce::SystemStats::hasAVX2();
+        return hasAvx2;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+PeakScanKernels::Kernel PeakScanKernels::getActiveKernel() noexcept {
+    if (isSupported(Kernel::Avx2))
+        return Kernel::Avx2;
+    if (isSupported(Kernel::Sse2))
+        return Kernel::Sse2;
+    return Kernel::Scalar;
+}
+
+const char *PeakScanKernels::getKernelName(Kernel kernel) noexcept {
+    switch (kernel) {
+    case Kernel::Avx2:
+        return "AVX2";
+    case Kernel::Sse2:
+        return "SSE2";
+    default:
+        return "Scalar";
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef AUDIOFILER_PEAKSCANKERNELS_H
+#define AUDIOFILER_PEAKSCANKERNELS_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+/**
+ * @file PeakScanKernels.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Vectorized threshold-crossing kernels used by the silence scans.
+ *
+ * @details Architecturally, PeakScanKernels is the innermost "Pure Logic Engine" of
+ *          the Autocut feature. SilenceAnalysisAlgorithms streams a file in chunks and
+ *          hands every chunk to these kernels, which answer a single question: at which
+ *          index does the first (or last) sample whose absolute value exceeds the
+ *          Threshold occur on ANY channel?
+ *
+ *          The kernels test 16 samples per step across all channels (four SSE2 or two
+ *          AVX2 registers per channel, ORed together into one bit mask) and only touch
+ *          individual samples through a bit scan of that mask to pinpoint the exact
+ *          index. The instruction set is chosen once at runtime via
+ *          `juce::SystemStats`, with a portable scalar fallback for non-x86 targets.
+ *          Mono and stereo layouts are template specializations with the channel loop
+ *          unrolled at compile time; any other channel count uses the generic N-channel
+ *          instantiation.
+ *
+ *          All methods are stateless and thread-safe.
+ *
+ * @see SilenceAnalysisAlgorithms
+ * @see SilenceAnalysisWorker
+ */
+class PeakScanKernels final {
+  public:
+    /** @brief The instruction sets a kernel can be executed with. */
+    enum class Kernel {
+        Scalar, /**< Portable per-sample loop; always available. */
+        Sse2,   /**< 128-bit x86 vectors; baseline on every x86-64 CPU. */
+        Avx2    /**< 256-bit x86 vectors; selected when the CPU reports AVX2. */
+    };
+
+    /**
+     * @brief Finds the first sample whose magnitude exceeds the threshold on any channel.
+     * @param channels Array of `numChannels` pointers to non-interleaved sample data.
+     * @param numChannels The number of channels (must be at least 1).
+     * @param numSamples The number of samples available in every channel.
+     * @param threshold The linear amplitude threshold (a sample must be strictly greater).
+     * @return The index of the first crossing, or -1 if every sample is at or below it.
+     */
+    static int findFirstAbove(const float *const *channels, int numChannels, int numSamples,
+                              float threshold) noexcept;
+
+    /**
+     * @brief Finds the last sample whose magnitude exceeds the threshold on any channel.
+     * @param channels Array of `numChannels` pointers to non-interleaved sample data.
+     * @param numChannels The number of channels (must be at least 1).
+     * @param numSamples The number of samples available in every channel.
+     * @param threshold The linear amplitude threshold (a sample must be strictly greater).
+     * @return The index of the last crossing, or -1 if every sample is at or below it.
+     */
+    static int findLastAbove(const float *const *channels, int numChannels, int numSamples,
+                             float threshold) noexcept;
+
+    /**
+     * @brief Variant of findFirstAbove() that forces a specific instruction set.
+     * @details Intended for tests and benchmarks. Requesting an unsupported kernel
+     *          silently falls back to Kernel::Scalar.
+     * @param kernel The instruction set to execute with.
+     * @param channels Array of `numChannels` pointers to non-interleaved sample data.
+     * @param numChannels The number of channels (must be at least 1).
+     * @param numSamples The number of samples available in every channel.
+     * @param threshold The linear amplitude threshold.
+     * @return The index of the first crossing, or -1 if none.
+     */
+    static int findFirstAbove(Kernel kernel, const float *const *channels, int numChannels,
+                              int numSamples, float threshold) noexcept;
+
+    /**
+     * @brief Variant of findLastAbove() that forces a specific instruction set.
+     * @param kernel The instruction set to execute with.
+     * @param channels Array of `numChannels` pointers to non-interleaved sample data.
+     * @param numChannels The number of channels (must be at least 1).
+     * @param numSamples The number of samples available in every channel.
+     * @param threshold The linear amplitude threshold.
+     * @return The index of the last crossing, or -1 if none.
+     */
+    static int findLastAbove(Kernel kernel, const float *const *channels, int numChannels,
+                             int numSamples, float threshold) noexcept;
+
+    /**
+     * @brief Reports whether the running CPU and build can execute a kernel.
+     * @param kernel The instruction set to query.
+     * @return True if the kernel is compiled in and supported by the CPU.
+     */
+    static bool isSupported(Kernel kernel) noexcept;
+
+    /**
+     * @brief The kernel selected by runtime dispatch for the default entry points.
+     * @return The widest supported instruction set.
+     */
+    static Kernel getActiveKernel() noexcept;
+
+    /**
+     * @brief Human-readable name of a kernel, used in benchmark logs.
+     * @param kernel The instruction set to name.
+     * @return A static string such as "AVX2".
+     */
+    static const char *getKernelName(Kernel kernel) noexcept;
+};
+
+#endif
@@ -0,0 +1,286 @@
+#include "Workers/PreFilter.h"
+#include "Utils/Config.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if JUCE_INTEL && (JUCE_64BIT || defined(__SSE2__))
+#define AUDIOFILER_PREFILTER_X86 1
+#include <immintrin.h>
+#else
+#define AUDIOFILER_PREFILTER_X86 0
+#endif
+
+namespace {
+/** @brief Channels packed into one SSE2 register. */
+constexpr int kLanes = 4;
+
+/** @brief Carried values per stage and lane: x1, x2, y1, y2. */
+constexpr int kStateVars = 4;
+
+/** @brief Pole Qs of the two order-2 stages of a 4th-order Butterworth filter. */
+constexpr double kButterworthQ[] = {0.54119610014619701, 1.3065629648763764};
+
+enum class Shape { HighPass, LowPass };
+
+/** @details Bilinear-transform biquad after the RBJ Audio EQ Cookbook, in double. */
+PreFilter::Section design(Shape shape, double sampleRate, double frequency, double q) {
+    const double w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+    const double b0 = shape == Shape::HighPass ? (1.0 + cosW0) * 0.5 : (1.0 - cosW0) * 0.5;
+    const double b1 = shape == Shape::HighPass ? -2.0 * b0 : 2.0 * b0;
+
+    return {(float)(b0 / a0), (float)(b1 / a0), (float)(b0 / a0), (float)(-2.0 * cosW0 / a0),
+            (float)((1.0 - alpha) / a0)};
+}
+
+/**
+ * @details The feedback term is added last, so the only operation between one output
+ *          and the next is a single multiply-add; the feed-forward sum of the next sample
+ *          can be computed while the previous one is still in flight.
+ */
+template <int Lanes, int NumSections>
+void scalarGroup(float *const *ch, int numSamples, bool forward,
+                 const PreFilter::Section *sections, float *state) noexcept {
+    float x1[NumSections][Lanes], x2[NumSections][Lanes];
+    float y1[NumSections][Lanes], y2[NumSections][Lanes];
+    for (int s = 0; s < NumSections; ++s)
+        for (int l = 0; l < Lanes; ++l) {
+            const float *v = state + s * kStateVars * kLanes + l;
+            x1[s][l] = v[0];
+            x2[s][l] = v[kLanes];
+            y1[s][l] = v[2 * kLanes];
+            y2[s][l] = v[3 * kLanes];
+        }
+
+    const int step = forward ? 1 : -1;
+    for (int n = 0, i = forward ? 0 : numSamples - 1; n < numSamples; ++n, i += step) {
+        for (int l = 0; l < Lanes; ++l) {
+            float x = ch[l][i];
+            for (int s = 0; s < NumSections; ++s) {
+                const auto &c = sections[s];
+                const float y = (c.b0 * x + c.b1 * x1[s][l] + c.b2 * x2[s][l] -
+                                 c.a2 * y2[s][l]) -
+                                c.a1 * y1[s][l];
+                x2[s][l] = x1[s][l];
+                x1[s][l] = x;
+                y2[s][l] = y1[s][l];
+                y1[s][l] = y;
+                x = y;
+            }
+            ch[l][i] = x;
+        }
+    }
+
+    for (int s = 0; s < NumSections; ++s)
+        for (int l = 0; l < Lanes; ++l) {
+            float *v = state + s * kStateVars * kLanes + l;
+            v[0] = x1[s][l];
+            v[kLanes] = x2[s][l];
+            v[2 * kLanes] = y1[s][l];
+            v[3 * kLanes] = y2[s][l];
+        }
+}
+
+#if AUDIOFILER_PREFILTER_X86
+template <int Lanes> inline __m128 gather(float *const *ch, int i) noexcept {
+    if constexpr (Lanes == 1)
+        return _mm_set_ss(ch[0][i]);
+    else if constexpr (Lanes == 2)
+        return _mm_setr_ps(ch[0][i], ch[1][i], 0.0f, 0.0f);
+    else if constexpr (Lanes == 3)
+        return _mm_setr_ps(ch[0][i], ch[1][i], ch[2][i], 0.0f);
+    else
+        return _mm_setr_ps(ch[0][i], ch[1][i], ch[2][i], ch[3][i]);
+}
+
+template <int Lanes> inline void scatter(float *const *ch, int i, __m128 v) noexcept {
+    alignas(16) float lanes[kLanes];
+    _mm_store_ps(lanes, v);
+    for (int l = 0; l < Lanes; ++l)
+        ch[l][i] = lanes[l];
+}
+
+/** @details Lane-parallel twin of scalarGroup(); unused lanes filter zeros. */
+template <int Lanes, int NumSections>
+void sse2Group(float *const *ch, int numSamples, bool forward,
+               const PreFilter::Section *sections, float *state) noexcept {
+    __m128 b0[NumSections], b1[NumSections], b2[NumSections], a1[NumSections], a2[NumSections];
+    __m128 x1[NumSections], x2[NumSections], y1[NumSections], y2[NumSections];
+    for (int s = 0; s < NumSections; ++s) {
+        b0[s] = _mm_set1_ps(sections[s].b0);
+        b1[s] = _mm_set1_ps(sections[s].b1);
+        b2[s] = _mm_set1_ps(sections[s].b2);
+        a1[s] = _mm_set1_ps(sections[s].a1);
+        a2[s] = _mm_set1_ps(sections[s].a2);
+        const float *v = state + s * kStateVars * kLanes;
+        x1[s] = _mm_loadu_ps(v);
+        x2[s] = _mm_loadu_ps(v + kLanes);
+        y1[s] = _mm_loadu_ps(v + 2 * kLanes);
+        y2[s] = _mm_loadu_ps(v + 3 * kLanes);
+    }
+
+    const int step = forward ? 1 : -1;
+    for (int n = 0, i = forward ? 0 : numSamples - 1; n < numSamples; ++n, i += step) {
+        __m128 x = gather<Lanes>(ch, i);
+        for (int s = 0; s < NumSections; ++s) {
+            __m128 acc = _mm_mul_ps(b0[s], x);
+            acc = _mm_add_ps(acc, _mm_mul_ps(b1[s], x1[s]));
+            acc = _mm_add_ps(acc, _mm_mul_ps(b2[s], x2[s]));
+            acc = _mm_sub_ps(acc, _mm_mul_ps(a2[s], y2[s]));
+            const __m128 y = _mm_sub_ps(acc, _mm_mul_ps(a1[s], y1[s]));
+            x2[s] = x1[s];
+            x1[s] = x;
+            y2[s] = y1[s];
+            y1[s] = y;
+            x = y;
+        }
+        scatter<Lanes>(ch, i, x);
+    }
+
+    for (int s = 0; s < NumSections; ++s) {
+        float *v = state + s * kStateVars * kLanes;
+        _mm_storeu_ps(v, x1[s]);
+        _mm_storeu_ps(v + kLanes, x2[s]);
+        _mm_storeu_ps(v + 2 * kLanes, y1[s]);
+        _mm_storeu_ps(v + 3 * kLanes, y2[s]);
+    }
+}
+#endif
+
+template <int NumSections>
+void processGroup(bool vectorized, int lanes, float *const *ch, int numSamples, bool forward,
+                  const PreFilter::Section *sections, float *state) noexcept {
+#if AUDIOFILER_PREFILTER_X86
+    if (vectorized) {
+        switch (lanes) {
+        case 1:
+            return sse2Group<1, NumSections>(ch, numSamples, forward, sections, state);
+        case 2:
+            return sse2Group<2, NumSections>(ch, numSamples, forward, sections, state);
+        case 3:
+            return sse2Group<3, NumSections>(ch, numSamples, forward, sections, state);
+        default:
+            return sse2Group<4, NumSections>(ch, numSamples, forward, sections, state);
+        }
+    }
+#else
+    juce::ignoreUnused(vectorized);
+#endif
+    switch (lanes) {
+    case 1:
+        return scalarGroup<1, NumSections>(ch, numSamples, forward, sections, state);
+    case 2:
+        return scalarGroup<2, NumSections>(ch, numSamples, forward, sections, state);
+    case 3:
+        return scalarGroup<3, NumSections>(ch, numSamples, forward, sections, state);
+    default:
+        return scalarGroup<4, NumSections>(ch, numSamples, forward, sections, state);
+    }
+}
+} // namespace
+
+PreFilter::PreFilter(MainDomain::FilterMode mode, double sampleRate, int channels)
+    : numChannels(std::max(0, channels)) {
+    if (mode == MainDomain::FilterMode::Off || sampleRate <= 0.0 || numChannels == 0)
+        return;
+
+    const double nyquistLimit = sampleRate * 0.45;
+    for (const double q : kButterworthQ)
+        sections.push_back(design(Shape::HighPass, sampleRate,
+                                  std::min(Config::Audio::preFilterHighPassHz, nyquistLimit), q));
+
+    // A low-pass corner at or above Nyquist would keep everything anyway.
+    const bool lowPass = mode == MainDomain::FilterMode::BandLimit &&
+                         Config::Audio::preFilterLowPassHz < nyquistLimit;
+    if (lowPass)
+        for (const double q : kButterworthQ)
+            sections.push_back(
+                design(Shape::LowPass, sampleRate, Config::Audio::preFilterLowPassHz, q));
+
+    const int numGroups = (numChannels + kLanes - 1) / kLanes;
+    state.assign((size_t)(numGroups * (int)sections.size() * kStateVars * kLanes), 0.0f);
+    preRoll.setSize(numChannels,
+                    std::max(1, (int)(sampleRate * Config::Audio::preFilterWarmupSeconds)));
+}
+
+void PreFilter::process(juce::AudioBuffer<float> &buffer, int numSamples, bool forward) noexcept {
+    process(PeakScanKernels::getActiveKernel(), buffer, numSamples, forward);
+}
+
+/**
+ * @details Denormals are flushed for the duration of the call: the feedback path decays
+ *          into them on every stretch of digital silence, and they would otherwise cost
+ *          more than the filter itself.
+ */
+void PreFilter::process(PeakScanKernels::Kernel kernel, juce::AudioBuffer<float> &buffer,
+                        int numSamples, bool forward) noexcept {
+    numSamples = std::min(numSamples, buffer.getNumSamples());
+    if (isBypassed() || numSamples <= 0)
+        return;
+
+    const juce::ScopedNoDenormals noDenormals;
+    const bool vectorized = kernel != PeakScanKernels::Kernel::Scalar &&
+                            PeakScanKernels::isSupported(PeakScanKernels::Kernel::Sse2);
+    const int channels = std::min(numChannels, buffer.getNumChannels());
+    if (!primed)
+        prime(vectorized, buffer.getArrayOfReadPointers(), channels, numSamples, forward);
+    run(vectorized, buffer.getArrayOfWritePointers(), channels, numSamples, forward);
+}
+
+void PreFilter::reset() noexcept {
+    std::fill(state.begin(), state.end(), 0.0f);
+    primed = false;
+}
+
+/**
+ * @details A scan rarely starts at rest: the file's edge may sit on a DC offset or in the
+ *          middle of a low hum, and a filter starting from zero would ring on that step and
+ *          report it as audio. The state is therefore settled first, as if the signal had
+ *          been playing before the edge: the first stage is loaded with the DC level of the
+ *          first sample, then fed the head of the chunk point-reflected about that sample,
+ *          which continues both its level and its slope across the edge.
+ */
+void PreFilter::prime(bool vectorized, const float *const *data, int channels, int numSamples,
+                      bool forward) noexcept {
+    primed = true;
+    const int length = std::min(preRoll.getNumSamples(), numSamples - 1);
+    const int edge = forward ? 0 : numSamples - 1;
+    const int step = forward ? 1 : -1;
+    const int groupStride = (int)sections.size() * kStateVars * kLanes;
+
+    std::fill(state.begin(), state.end(), 0.0f);
+    for (int ch = 0; ch < channels; ++ch) {
+        const float x0 = data[ch][edge];
+        float *out = preRoll.getWritePointer(ch);
+        // preRoll is in processing order: it runs towards the edge and stops just before it.
+        for (int k = 0; k < length; ++k)
+            out[k] = 2.0f * x0 - data[ch][edge + step * (length - k)];
+
+        const float level = length > 0 ? out[0] : x0;
+        float *first = state.data() + (ch / kLanes) * groupStride + ch % kLanes;
+        first[0] = level;      // x1
+        first[kLanes] = level; // x2
+    }
+
+    if (length > 0)
+        run(vectorized, preRoll.getArrayOfWritePointers(), channels, length, true);
+}
+
+/** @details Channels are taken in groups of four, one group per register. */
+void PreFilter::run(bool vectorized, float *const *data, int channels, int numSamples,
+                    bool forward) noexcept {
+    const int groupStride = (int)sections.size() * kStateVars * kLanes;
+    for (int first = 0; first < channels; first += kLanes) {
+        const int lanes = std::min(kLanes, channels - first);
+        float *groupState = state.data() + (first / kLanes) * groupStride;
+        if (sections.size() == 2)
+            processGroup<2>(vectorized, lanes, data + first, numSamples, forward,
+                            sections.data(), groupState);
+        else
+            processGroup<4>(vectorized, lanes, data + first, numSamples, forward,
+                            sections.data(), groupState);
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef AUDIOFILER_PREFILTER_H
+#define AUDIOFILER_PREFILTER_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "MainDomain.h"
+#include "Workers/PeakScanKernels.h"
+#include <vector>
+
+/**
+ * @file PreFilter.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Streaming biquad cascade that band-limits audio before the silence scans.
+ *
+ * @details Architecturally, PreFilter is a stateful "Pure Logic Engine" owned by one
+ *          scan. SilenceAnalysisAlgorithms runs every chunk through it, in place, before
+ *          the chunk reaches the WindowedDetector, so rumble, hum or hiss in a lead-in no
+ *          longer counts as audio.
+ *
+ *          FilterMode::HighPass is a 4th-order Butterworth high-pass at
+ *          `Config::Audio::preFilterHighPassHz`; FilterMode::BandLimit adds a 4th-order
+ *          Butterworth low-pass at `Config::Audio::preFilterLowPassHz`. Each order-2 stage
+ *          is a direct form I biquad, whose feedback path is a single multiply-add and
+ *          therefore the shortest dependency chain from one sample to the next.
+ *
+ *          The filter state of every channel is carried across chunks, so chunk boundaries
+ *          are inaudible to the detector. Chunks are consumed in scan order: a backward
+ *          scan feeds the file time-reversed, which has the same magnitude response. The
+ *          first chunk settles the state on a short pre-roll before it is filtered, so the
+ *          edge of the file does not ring.
+ *
+ *          The SSE2 kernel packs up to four channels into the lanes of one register and
+ *          runs all stages per frame, so a stereo file costs one pass instead of two. The
+ *          scalar kernel is the portable fallback.
+ *
+ * @see SilenceAnalysisAlgorithms
+ * @see WindowedDetector
+ */
+class PreFilter final {
+  public:
+    /** @brief Normalized biquad coefficients (a0 == 1). */
+    struct Section {
+        float b0, b1, b2, a1, a2;
+    };
+
+    /**
+     * @brief Designs the cascade for one file.
+     * @param mode The band to keep; FilterMode::Off makes the filter a no-op.
+     * @param sampleRate The file sample rate.
+     * @param numChannels The number of channels that will be processed.
+     */
+    PreFilter(MainDomain::FilterMode mode, double sampleRate, int numChannels);
+
+    /**
+     * @brief Filters the next chunk in place, in scan order.
+     * @param buffer Decoded samples; only the first `numSamples` are touched.
+     * @param numSamples The number of valid samples in the buffer.
+     * @param forward True if the chunk follows the previous one in file order, false if
+     *        it precedes it (backward scan); the chunk is then processed from its end.
+     */
+    void process(juce::AudioBuffer<float> &buffer, int numSamples, bool forward) noexcept;
+
+    /**
+     * @brief Variant of process() that forces a specific instruction set.
+     * @details Intended for tests and benchmarks. Kernel::Avx2 runs the SSE2 kernel, since
+     *          the lanes hold channels; unsupported kernels fall back to Kernel::Scalar.
+     * @param kernel The instruction set to execute with.
+     * @param buffer Decoded samples; only the first `numSamples` are touched.
+     * @param numSamples The number of valid samples in the buffer.
+     * @param forward True for file order, false for a backward scan.
+     */
+    void process(PeakScanKernels::Kernel kernel, juce::AudioBuffer<float> &buffer,
+                 int numSamples, bool forward) noexcept;
+
+    /** @brief Forgets the carried state; the next chunk is treated as the file's edge. */
+    void reset() noexcept;
+
+    /** @return True if the filter leaves the audio untouched. */
+    bool isBypassed() const noexcept {
+        return sections.empty();
+    }
+
+    /** @return The number of order-2 stages in the cascade. */
+    int getNumSections() const noexcept {
+        return (int)sections.size();
+    }
+
+  private:
+    void prime(bool vectorized, const float *const *data, int channels, int numSamples,
+               bool forward) noexcept;
+    void run(bool vectorized, float *const *data, int channels, int numSamples,
+             bool forward) noexcept;
+
+    std::vector<Section> sections;
+    int numChannels = 0;
+    std::vector<float> state; /**< Per group of 4 channels and stage: x1, x2, y1, y2 x 4 lanes. */
+    juce::AudioBuffer<float> preRoll;
+    bool primed = false;
+};
+
+#endif
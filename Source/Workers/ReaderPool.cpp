@@ -0,0 +1,141 @@
+#include "Workers/ReaderPool.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+ReaderPool::Lease::Lease(Lease &&other) noexcept
+    : pool(std::exchange(other.pool, nullptr)), path(std::move(other.path)),
+      modified(other.modified), size(other.size), reader(std::move(other.reader)) {
+}
+
+ReaderPool::Lease &ReaderPool::Lease::operator=(Lease &&other) noexcept {
+    if (this != &other) {
+        giveBack();
+        pool = std::exchange(other.pool, nullptr);
+        path = std::move(other.path);
+        modified = other.modified;
+        size = other.size;
+        reader = std::move(other.reader);
+    }
+    return *this;
+}
+
+ReaderPool::Lease::~Lease() {
+    giveBack();
+}
+
+void ReaderPool::Lease::discard() noexcept {
+    auto *owner = std::exchange(pool, nullptr);
+    reader.reset();
+    if (owner != nullptr) {
+        const juce::ScopedLock sl(owner->lock);
+        --owner->leased;
+    }
+}
+
+void ReaderPool::Lease::giveBack() noexcept {
+    if (pool != nullptr)
+        pool->release(*this);
+    pool = nullptr;
+    reader.reset();
+}
+
+ReaderPool::ReaderPool(Opener opener, int idleLimit, int openLimit)
+    : open(std::move(opener)), maxIdle(std::max(0, idleLimit)),
+      maxOpen(std::max(1, openLimit)) {
+}
+
+ReaderPool::~ReaderPool() {
+    jassert(leased == 0);
+    clear();
+}
+
+/**
+ * @details Idle readers of the same path but a different modification time or size are
+ *          closed on the way, since the file they describe no longer exists. A miss opens
+ *          the reader after the lock is dropped, so a slow open (an MP3 frame index) never
+ *          blocks other jobs returning or checking out readers.
+ */
+ReaderPool::Lease ReaderPool::acquire(const juce::File &file) {
+    Lease lease;
+    lease.path = file.getFullPathName();
+    lease.modified = file.getLastModificationTime().toMilliseconds();
+    lease.size = file.getSize();
+
+    std::vector<std::unique_ptr<juce::AudioFormatReader>> stale;
+    {
+        const juce::ScopedLock sl(lock);
+        for (auto it = idle.begin(); it != idle.end();) {
+            if (it->path != lease.path) {
+                ++it;
+            } else if (lease.reader == nullptr && it->modified == lease.modified &&
+                       it->size == lease.size) {
+                lease.reader = std::move(it->reader);
+                it = idle.erase(it);
+            } else if (it->modified != lease.modified || it->size != lease.size) {
+                stale.push_back(std::move(it->reader));
+                it = idle.erase(it);
+                ++stats.evictions;
+            } else {
+                ++it;
+            }
+        }
+
+        if (lease.reader != nullptr) {
+            ++stats.hits;
+            ++leased;
+            lease.pool = this;
+            return lease;
+        }
+        ++stats.misses;
+    }
+    stale.clear();
+
+    lease.reader = open(file);
+    if (lease.reader == nullptr)
+        return lease;
+
+    const juce::ScopedLock sl(lock);
+    ++leased;
+    lease.pool = this;
+    return lease;
+}
+
+void ReaderPool::release(Lease &lease) noexcept {
+    std::unique_ptr<juce::AudioFormatReader> closing;
+    {
+        const juce::ScopedLock sl(lock);
+        --leased;
+        if (lease.reader == nullptr)
+            return;
+
+        idle.push_front({lease.path, lease.modified, lease.size, std::move(lease.reader)});
+        if ((int)idle.size() > maxIdle || (int)idle.size() + leased > maxOpen) {
+            closing = std::move(idle.back().reader);
+            idle.pop_back();
+            ++stats.evictions;
+        }
+    }
+}
+
+void ReaderPool::clear() {
+    std::list<Idle> closing;
+    const juce::ScopedLock sl(lock);
+    closing.swap(idle);
+}
+
+int ReaderPool::getNumIdle() const {
+    const juce::ScopedLock sl(lock);
+    return (int)idle.size();
+}
+
+int ReaderPool::getNumLeased() const {
+    const juce::ScopedLock sl(lock);
+    return leased;
+}
+
+ReaderPool::Stats ReaderPool::getStats() const {
+    const juce::ScopedLock sl(lock);
+    return stats;
+}
@@ -0,0 +1,150 @@
+#ifndef AUDIOFILER_READERPOOL_H
+#define AUDIOFILER_READERPOOL_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <functional>
+#include <list>
+#include <memory>
+
+/**
+ * @file ReaderPool.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Bounded pool of idle private readers shared by the analysis jobs.
+ *
+ * @details Architecturally, ReaderPool sits between SilenceAnalysisWorker and the format
+ *          manager. Opening a reader re-parses the file's header, and for MP3 also
+ *          rebuilds its frame index, so a burst of Threshold edits on one file used to pay
+ *          that cost for every pass. Jobs now check a reader out with acquire() and the
+ *          returned Lease hands it back when the job is done:
+ *
+ *          - **Keying**: idle readers are keyed by path, modification time and size, so a
+ *            file rewritten on disk is never served from a stale reader; such readers are
+ *            closed as soon as the mismatch is seen.
+ *          - **Exclusive use**: a reader is leased to one job at a time and is never the
+ *            AudioPlayer's reader, keeping the "private reader" rule of the Threading Law.
+ *          - **Bounds**: at most `maxIdle` readers are kept, least recently returned first
+ *            out. Returns that would keep more than `maxOpen` readers open (leased plus
+ *            idle) close the reader instead, which caps the file descriptors the pool holds.
+ *            A lease is never refused, so jobs cannot deadlock waiting for each other.
+ *
+ *          Readers are opened outside the lock; all members may be called from any thread.
+ *
+ * @see SilenceAnalysisWorker
+ */
+class ReaderPool final {
+  public:
+    /** @brief Opens a new private reader for a file, or returns nullptr. */
+    using Opener = std::function<std::unique_ptr<juce::AudioFormatReader>(const juce::File &)>;
+
+    /** @brief Cache counters since construction. */
+    struct Stats {
+        juce::int64 hits = 0;      /**< Leases served by an idle reader. */
+        juce::int64 misses = 0;    /**< Leases that had to open a reader. */
+        juce::int64 evictions = 0; /**< Idle readers closed by a bound or a stale key. */
+    };
+
+    /**
+     * @class Lease
+     * @brief Exclusive, move-only use of one reader; returns it to the pool on destruction.
+     */
+    class Lease final {
+      public:
+        Lease() = default;
+
+        /** @brief Wraps a reader that does not belong to any pool; it is closed on release. */
+        Lease(std::unique_ptr<juce::AudioFormatReader> unpooled) noexcept
+            : reader(std::move(unpooled)) {
+        }
+
+        Lease(Lease &&other) noexcept;
+        Lease &operator=(Lease &&other) noexcept;
+        ~Lease();
+
+        juce::AudioFormatReader *get() const noexcept {
+            return reader.get();
+        }
+        juce::AudioFormatReader &operator*() const noexcept {
+            return *reader;
+        }
+        juce::AudioFormatReader *operator->() const noexcept {
+            return reader.get();
+        }
+        explicit operator bool() const noexcept {
+            return reader != nullptr;
+        }
+
+        /** @brief Closes the reader instead of returning it, e.g. after a failed read. */
+        void discard() noexcept;
+
+      private:
+        friend class ReaderPool;
+        void giveBack() noexcept;
+
+        ReaderPool *pool = nullptr;
+        juce::String path;
+        juce::int64 modified = 0;
+        juce::int64 size = 0;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+
+        JUCE_DECLARE_NON_COPYABLE(Lease)
+    };
+
+    /**
+     * @brief Constructs an empty pool.
+     * @param opener Opens a reader on a miss.
+     * @param maxIdle The most idle readers kept.
+     * @param maxOpen The most readers, leased plus idle, the pool keeps open.
+     */
+    ReaderPool(Opener opener, int maxIdle, int maxOpen);
+
+    /** @brief Closes all idle readers. Every Lease must have been released. */
+    ~ReaderPool();
+
+    /**
+     * @brief Checks out a reader for a file, reusing an idle one when the file is unchanged.
+     * @param file The file to read.
+     * @return The lease; empty if the file cannot be opened.
+     */
+    Lease acquire(const juce::File &file);
+
+    /** @brief Closes every idle reader. */
+    void clear();
+
+    /** @return The number of idle readers. */
+    int getNumIdle() const;
+
+    /** @return The number of readers currently leased. */
+    int getNumLeased() const;
+
+    /** @return Hit, miss and eviction counts. */
+    Stats getStats() const;
+
+  private:
+    struct Idle {
+        juce::String path;
+        juce::int64 modified;
+        juce::int64 size;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+    };
+
+    void release(Lease &lease) noexcept;
+
+    const Opener open;
+    const int maxIdle;
+    const int maxOpen;
+    mutable juce::CriticalSection lock;
+    std::list<Idle> idle; /**< Most recently returned at the front. */
+    int leased = 0;
+    Stats stats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReaderPool)
+};
+
+#endif
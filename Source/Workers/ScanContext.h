@@ -0,0 +1,78 @@
+#ifndef AUDIOFILER_SCANCONTEXT_H
+#define AUDIOFILER_SCANCONTEXT_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "Workers/AnalysisProgress.h"
+#include "Workers/IoGovernor.h"
+
+#include <atomic>
+
+/**
+ * @file ScanContext.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Per-scan cancellation and pacing policy shared by every analysis loop.
+ *
+ * @details Architecturally, ScanContext is a small value object passed down from the
+ *          SilenceAnalysisWorker into the stateless scan routines. It bundles the two
+ *          questions every chunk loop has to ask, "should I stop?" and "should I yield?",
+ *          so that sequential scans, parallel segment tasks and future job types all
+ *          honour cancellation and background pacing identically without each algorithm
+ *          knowing who owns the thread it runs on. The same per-chunk report also feeds
+ *          the job's AnalysisProgress, when one is attached.
+ *
+ * @see SilenceAnalysisAlgorithms
+ * @see ParallelSilenceScan
+ * @see IoGovernor
+ */
+struct ScanContext {
+    /** @brief The owning thread; its exit signal cancels the scan. May be null. */
+    juce::Thread *thread = nullptr;
+
+    /** @brief Optional external cancel flag, e.g. shared by all tasks of one scan. */
+    const std::atomic<bool> *cancelled = nullptr;
+
+    /** @brief Decides after every chunk whether the scan must yield to playback. May be null. */
+    IoGovernor *governor = nullptr;
+
+    /** @brief The owning pool job, when the scan runs on a `juce::ThreadPool`. May be null. */
+    juce::ThreadPoolJob *job = nullptr;
+
+    /** @brief Counts every chunk for the progress display and timing history. May be null. */
+    AnalysisProgress::Job *progress = nullptr;
+
+    /**
+     * @brief Checks whether the scan must be abandoned.
+     * @return True if the owning thread or job is exiting or the cancel flag is raised.
+     */
+    bool shouldStop() const noexcept {
+        return (thread != nullptr && thread->threadShouldExit()) ||
+               (job != nullptr && job->shouldExit()) ||
+               (cancelled != nullptr && cancelled->load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Reports a chunk to the progress and the governor, and yields as long as asked.
+     * @param numSamples The number of sample frames just read.
+     */
+    void pace(int numSamples) const {
+        if (progress != nullptr)
+            progress->advance(numSamples);
+        if (governor == nullptr)
+            return;
+        const int yieldMs = governor->admit(numSamples);
+        if (yieldMs <= 0)
+            return;
+        if (thread != nullptr)
+            thread->wait(yieldMs);
+        else
+            juce::Thread::sleep(yieldMs);
+    }
+};
+
+#endif
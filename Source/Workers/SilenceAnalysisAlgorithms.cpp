@@ -1,68 +1,192 @@
 #include "Workers/SilenceAnalysisAlgorithms.h"
+#include "Utils/Config.h"
+#include "Workers/ChunkScanner.h"
+#include "Workers/PeakPyramid.h"
+#include "Workers/PreFilter.h"
+#include "Workers/WindowedDetector.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
 
 namespace {
-/** @brief The optimal buffer size for sequential disk access and cache locality. 
- *  @details We use a fixed 64k chunk size to ensure that even multi-gigabyte files 
- *           can be scanned without ballooning RAM usage or risking integer overflows 
- *           during large-scale buffer allocations.
+constexpr int kMaxChannels = 128;
+
+/**
+ * @brief Streams the whole file through a PreFilter and a WindowedDetector in scan order.
+ * @details Unlike the range scans the filter and the detector carry state across chunks,
+ *          so the chunks are always contiguous and start at the scan's own edge of the file.
  */
-constexpr int kChunkSize = 65536;
+juce::int64 scanWindowed(juce::AudioFormatReader &reader, float threshold,
+                         MainDomain::DetectionMode mode, MainDomain::FilterMode filterMode,
+                         bool forward, const ScanContext &context) {
+    const juce::int64 length = reader.lengthInSamples;
+    PreFilter filter(filterMode, reader.sampleRate, (int)reader.numChannels);
+    WindowedDetector detector(mode, reader.sampleRate, (int)reader.numChannels, threshold,
+                              forward, length);
+    juce::AudioBuffer<float> buffer((int)reader.numChannels,
+                                    SilenceAnalysisAlgorithms::chunkSize);
 
-constexpr int kMaxChannels = 128;
+    for (juce::int64 done = 0; done < length;) {
+        const int numThisTime =
+            (int)std::min((juce::int64)SilenceAnalysisAlgorithms::chunkSize, length - done);
+        const juce::int64 startSample = forward ? done : length - done - numThisTime;
+
+        if (!reader.read(&buffer, 0, numThisTime, startSample, true, true))
+            return SilenceAnalysisAlgorithms::aborted;
+
+        if (context.shouldStop())
+            return SilenceAnalysisAlgorithms::aborted;
+        context.pace(numThisTime);
+
+        filter.process(buffer, numThisTime, forward);
+        const juce::int64 hit = detector.addChunk(buffer, numThisTime);
+        if (hit >= 0)
+            return hit;
+        done += numThisTime;
+    }
+    return -1;
+}
 } // namespace
 
+bool SilenceAnalysisAlgorithms::isScannable(const juce::AudioFormatReader &reader) {
+    return reader.numChannels > 0 && reader.numChannels <= kMaxChannels;
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceIn(juce::AudioFormatReader &reader,
+                                                     float threshold, juce::Thread *thread) {
+    const ScanContext context{thread};
+    const auto result =
+        findFirstAboveInRange(reader, 0, reader.lengthInSamples, threshold, context);
+    return result == aborted ? -1 : result;
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceOut(juce::AudioFormatReader &reader,
+                                                      float threshold, juce::Thread *thread) {
+    const ScanContext context{thread};
+    const auto result = findLastAbove(reader, 0, reader.lengthInSamples, threshold, context);
+    return result == aborted ? -1 : result;
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceIn(juce::AudioFormatReader &reader,
+                                                     float threshold,
+                                                     MainDomain::DetectionMode mode,
+                                                     const ScanContext &context,
+                                                     MainDomain::FilterMode filter) {
+    if (mode == MainDomain::DetectionMode::Peak && filter == MainDomain::FilterMode::Off)
+        return findFirstAboveInRange(reader, 0, reader.lengthInSamples, threshold, context);
+    if (!isScannable(reader))
+        return -1;
+    return scanWindowed(reader, threshold, mode, filter, true, context);
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceOut(juce::AudioFormatReader &reader,
+                                                      float threshold,
+                                                      MainDomain::DetectionMode mode,
+                                                      const ScanContext &context,
+                                                      MainDomain::FilterMode filter) {
+    if (mode == MainDomain::DetectionMode::Peak && filter == MainDomain::FilterMode::Off)
+        return findLastAbove(reader, 0, reader.lengthInSamples, threshold, context);
+    if (!isScannable(reader))
+        return -1;
+    return scanWindowed(reader, threshold, mode, filter, false, context);
+}
+
+/**
+ * @details Candidate leaves come from the pyramid in scan order; each is confirmed by
+ *          reading exactly one leaf of samples. Because peaks are quantized upward the
+ *          pyramid never skips a real crossing, it can only over-report, in which case
+ *          the loop simply moves on to the next candidate.
+ */
+juce::int64 SilenceAnalysisAlgorithms::findSilenceIn(const PeakPyramid &pyramid,
+                                                     juce::AudioFormatReader &reader,
+                                                     float threshold) {
+    if (!isScannable(reader) || !pyramid.matches(reader))
+        return -1;
+
+    ChunkScanner scanner(reader, threshold);
+    for (juce::int64 leaf = pyramid.findFirstLeafAbove(threshold, 0); leaf >= 0;
+         leaf = pyramid.findFirstLeafAbove(threshold, leaf + 1)) {
+        const juce::int64 start = leaf * PeakPyramid::leafSize;
+        const int numSamples =
+            (int)std::min((juce::int64)PeakPyramid::leafSize, reader.lengthInSamples - start);
+        const int hit = scanner.findFirstAbove(start, numSamples);
+        if (hit == ChunkScanner::readFailed)
+            return -1;
+        if (hit >= 0)
+            return start + hit;
+    }
+    return -1;
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findSilenceOut(const PeakPyramid &pyramid,
+                                                      juce::AudioFormatReader &reader,
+                                                      float threshold) {
+    if (!isScannable(reader) || !pyramid.matches(reader))
+        return -1;
+
+    ChunkScanner scanner(reader, threshold);
+    for (juce::int64 leaf = pyramid.findLastLeafAbove(threshold, pyramid.getNumLeaves());
+         leaf >= 0; leaf = pyramid.findLastLeafAbove(threshold, leaf)) {
+        const juce::int64 start = leaf * PeakPyramid::leafSize;
+        const int numSamples =
+            (int)std::min((juce::int64)PeakPyramid::leafSize, reader.lengthInSamples - start);
+        const int hit = scanner.findLastAbove(start, numSamples);
+        if (hit == ChunkScanner::readFailed)
+            return -1;
+        if (hit >= 0)
+            return start + hit;
+    }
+    return -1;
+}
+
 /**
  * @details This method implements a forward-scanning linear search to identify the 
  *          first sample that exceeds the user-defined amplitude threshold. 
  *          
  *          Architecturally, it employs a "Windowed Streaming" approach:
  *          1. **Chunk-Based Processing**: Instead of loading the entire file, we 
- *             stream it in fixed 64k segments (kChunkSize). This prevents 
+ *             stream it in fixed 64k segments (chunkSize). This prevents 
  *             out-of-memory crashes on extremely long audio recordings.
- *          2. **Interleaved Channel Scanning**: To ensure accuracy, we check every 
- *             channel (Mono, Stereo, or Multi-channel) at each sample index. If 
- *             ANY channel exceeds the threshold, that sample is marked as the 'In' point.
- *          3. **Thread Safety**: We periodically poll for `threadShouldExit` to 
- *             ensure that long-running analysis passes can be safely cancelled by 
- *             the user without hanging the application.
+ *          2. **Vectorized Channel Scanning**: Each chunk is handed to a ChunkScanner,
+ *             which tests 16 samples per step across every channel (Mono, Stereo, or
+ *             Multi-channel) - as raw integers for mapped PCM, as floats otherwise. If
+ *             ANY channel exceeds the threshold, the first such sample is marked as the
+ *             'In' point.
+ *          3. **Thread Safety**: We poll the ScanContext after every chunk so that
+ *             long-running analysis passes can be safely cancelled by the user
+ *             without hanging the application.
+ *          4. **Frontier Pruning**: In parallel mode a sibling task may already hold
+ *             an earlier hit; once our next chunk starts past it we stop reading.
  */
-juce::int64 SilenceAnalysisAlgorithms::findSilenceIn(juce::AudioFormatReader &reader,
-                                                     float threshold, juce::Thread *thread) {
-    const juce::int64 lengthInSamples = reader.lengthInSamples;
-
-    if (reader.numChannels <= 0 || reader.numChannels > kMaxChannels)
+juce::int64 SilenceAnalysisAlgorithms::findFirstAboveInRange(
+    juce::AudioFormatReader &reader, juce::int64 start, juce::int64 end, float threshold,
+    const ScanContext &context, const std::atomic<juce::int64> *frontier) {
+    if (!isScannable(reader))
         return -1;
 
-    juce::AudioBuffer<float> buffer(reader.numChannels, kChunkSize);
+    end = std::min(end, reader.lengthInSamples);
+    ChunkScanner scanner(reader, threshold);
 
-    juce::int64 currentPos = 0;
-    while (currentPos < lengthInSamples) {
-        // Calculate the exact number of samples to read, accounting for the file's end
-        const int numThisTime =
-            (int)std::min((juce::int64)kChunkSize, lengthInSamples - currentPos);
-        
-        buffer.clear();
-        if (!reader.read(&buffer, 0, numThisTime, currentPos, true, true))
+    juce::int64 currentPos = std::max((juce::int64)0, start);
+    while (currentPos < end) {
+        if (frontier != nullptr && currentPos >= frontier->load(std::memory_order_relaxed))
             return -1;
 
-        if (thread != nullptr) {
-            if (thread->threadShouldExit())
-                return -1;
-            thread->wait(1);
-        }
-
-        // Perform the peak-detection pass on the current chunk
-        for (int sample = 0; sample < numThisTime; ++sample) {
-            for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-                // Use absolute value to catch both positive and negative peak excursions
-                if (std::abs(buffer.getSample(channel, sample)) > threshold) {
-                    return currentPos + sample;
-                }
-            }
-        }
+        // Calculate the exact number of samples to read, accounting for the range end
+        const int numThisTime = (int)std::min((juce::int64)chunkSize, end - currentPos);
+
+        // Read the chunk and run the vectorized peak-detection pass over it
+        const int hit = scanner.findFirstAbove(currentPos, numThisTime);
+        if (hit == ChunkScanner::readFailed)
+            return aborted;
+
+        if (context.shouldStop())
+            return aborted;
+        context.pace(numThisTime);
+
+        if (hit >= 0)
+            return currentPos + hit;
+
         // Advance the read pointer to the start of the next 64k window
         currentPos += numThisTime;
     }
@@ -71,54 +195,117 @@ juce::int64 SilenceAnalysisAlgorithms::findSilenceIn(juce::AudioFormatReader &re
 
 /**
  * @details This method implements a "Reverse Crawl" algorithm to find the last 
- *          audible sample in the file (the 'Out' point).
+ *          audible sample in the range (the 'Out' point).
  *          
  *          Key Algorithmic Decisions:
- *          1. **Reverse Chunking**: We start from the end of the file (`lengthInSamples`) 
- *             and work backwards in 64k chunks. This is mathematically more efficient 
+ *          1. **Reverse Chunking**: We start from the end of the range and work
+ *             backwards in 64k chunks. This is mathematically more efficient 
  *             than forward-scanning the entire file only to find the end point.
  *          2. **Window Start Calculation**: Because we are scanning backwards, we 
  *             calculate the `startSample` by subtracting the chunk size from the 
- *             current position, ensuring we never read before index 0.
- *          3. **Internal Reverse Loop**: Inside each chunk, we iterate from 
- *             `numThisTime - 1` down to 0. The first sample that trips the threshold 
- *             is guaranteed to be the *absolute last* non-silent sample in the file.
+ *             current position, ensuring we never read before the range start.
+ *          3. **Internal Reverse Scan**: Inside each chunk, the ChunkScanner walks the
+ *             vector blocks from `numThisTime - 1` down to 0. The first sample that
+ *             trips the threshold is guaranteed to be the *absolute last* non-silent
+ *             sample in the range.
+ *          4. **Frontier Pruning**: Mirrors the forward scan; once our next chunk ends
+ *             at or before a sibling task's hit, nothing here can be later.
  */
-juce::int64 SilenceAnalysisAlgorithms::findSilenceOut(juce::AudioFormatReader &reader,
-                                                      float threshold, juce::Thread *thread) {
-    const juce::int64 lengthInSamples = reader.lengthInSamples;
-
-    if (reader.numChannels <= 0 || reader.numChannels > kMaxChannels)
+juce::int64 SilenceAnalysisAlgorithms::findLastAboveInRange(
+    juce::AudioFormatReader &reader, juce::int64 start, juce::int64 end, float threshold,
+    const ScanContext &context, const std::atomic<juce::int64> *frontier) {
+    if (!isScannable(reader))
         return -1;
 
-    juce::AudioBuffer<float> buffer(reader.numChannels, kChunkSize);
+    start = std::max((juce::int64)0, start);
+    ChunkScanner scanner(reader, threshold);
+
+    juce::int64 currentPos = std::min(end, reader.lengthInSamples);
+    while (currentPos > start) {
+        if (frontier != nullptr && currentPos <= frontier->load(std::memory_order_relaxed) + 1)
+            return -1;
 
-    juce::int64 currentPos = lengthInSamples;
-    while (currentPos > 0) {
-        // Determine the chunk size, ensuring we don't go past the start of the file
-        const int numThisTime = (int)std::min((juce::int64)kChunkSize, currentPos);
+        // Determine the chunk size, ensuring we don't go past the start of the range
+        const int numThisTime = (int)std::min((juce::int64)chunkSize, currentPos - start);
         const juce::int64 startSample = currentPos - numThisTime;
 
-        buffer.clear();
-        if (!reader.read(&buffer, 0, numThisTime, startSample, true, true))
-            return -1;
+        // Scan backwards through the chunk to find the tail-end of the audio signal
+        const int hit = scanner.findLastAbove(startSample, numThisTime);
+        if (hit == ChunkScanner::readFailed)
+            return aborted;
+
+        if (context.shouldStop())
+            return aborted;
+        context.pace(numThisTime);
+
+        if (hit >= 0)
+            return startSample + hit;
 
-        if (thread != nullptr) {
-            if (thread->threadShouldExit())
-                return -1;
-            thread->wait(1);
-        }
-
-        // Scan backwards through the buffer to find the tail-end of the audio signal
-        for (int sample = numThisTime - 1; sample >= 0; --sample) {
-            for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-                if (std::abs(buffer.getSample(channel, sample)) > threshold) {
-                    return startSample + sample;
-                }
-            }
-        }
         // Move the reverse-scanning cursor back by one full chunk
         currentPos -= numThisTime;
     }
     return -1;
 }
+
+/**
+ * @details Tail windows are disjoint and each is decoded once, so the total work never
+ *          exceeds one forward pass over the range, while the typical file with a few
+ *          seconds of trailing silence is answered from the first window. Doubling keeps
+ *          the number of seeks logarithmic in the length of the trailing silence.
+ */
+juce::int64 SilenceAnalysisAlgorithms::findLastAbove(juce::AudioFormatReader &reader,
+                                                     juce::int64 start, juce::int64 end,
+                                                     float threshold,
+                                                     const ScanContext &context) {
+    if (seeksCheaply(reader))
+        return findLastAboveInRange(reader, start, end, threshold, context);
+
+    start = std::max((juce::int64)0, start);
+    juce::int64 windowEnd = std::min(end, reader.lengthInSamples);
+    juce::int64 windowLength = Config::Audio::compressedTailFirstSamples;
+    while (windowEnd > start) {
+        const juce::int64 windowStart = std::max(start, windowEnd - windowLength);
+        const auto hit = findLastAboveForwards(reader, windowStart, windowEnd, threshold, context);
+        if (hit != -1)
+            return hit;
+        windowEnd = windowStart;
+        windowLength *= 2;
+    }
+    return -1;
+}
+
+juce::int64 SilenceAnalysisAlgorithms::findLastAboveForwards(juce::AudioFormatReader &reader,
+                                                             juce::int64 start, juce::int64 end,
+                                                             float threshold,
+                                                             const ScanContext &context) {
+    if (!isScannable(reader))
+        return -1;
+
+    end = std::min(end, reader.lengthInSamples);
+    ChunkScanner scanner(reader, threshold);
+
+    juce::int64 last = -1;
+    for (juce::int64 currentPos = std::max((juce::int64)0, start); currentPos < end;) {
+        const int numThisTime = (int)std::min((juce::int64)chunkSize, end - currentPos);
+        const int hit = scanner.findLastAbove(currentPos, numThisTime);
+        if (hit == ChunkScanner::readFailed)
+            return aborted;
+
+        if (context.shouldStop())
+            return aborted;
+        context.pace(numThisTime);
+
+        // Every later crossing supersedes this one, so only the latest is kept
+        if (hit >= 0)
+            last = currentPos + hit;
+        currentPos += numThisTime;
+    }
+    return last;
+}
+
+bool SilenceAnalysisAlgorithms::seeksCheaply(const juce::AudioFormatReader &reader) {
+    static const juce::String wavName = juce::WavAudioFormat().getFormatName();
+    static const juce::String aiffName = juce::AiffAudioFormat().getFormatName();
+    const auto &name = reader.getFormatName();
+    return name == wavName || name == aiffName;
+}
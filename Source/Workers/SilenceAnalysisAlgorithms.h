@@ -9,6 +9,12 @@
 #include <JuceHeader.h>
 #endif
 
+#include "MainDomain.h"
+#include "Workers/ScanContext.h"
+#include <atomic>
+
+class PeakPyramid;
+
 /**
  * @file SilenceAnalysisAlgorithms.h
  * @ingroup AudioEngine
@@ -35,6 +41,12 @@
  */
 class SilenceAnalysisAlgorithms {
   public:
+    /** @brief Samples read per chunk; ranges handed to parallel tasks are aligned to it. */
+    static constexpr int chunkSize = 65536;
+
+    /** @brief Range-scan result when the scan was cancelled or a read failed. */
+    static constexpr juce::int64 aborted = -2;
+
     /**
      * @brief Identifies the first non-silent sample from the start of an audio stream.
      * @details This function performs a forward linear scan. It calculates the absolute 
@@ -66,6 +78,9 @@ class SilenceAnalysisAlgorithms {
      *          3. Scan the block *backwards*: if abs(s) > threshold, return current_sample_index.
      *          4. Move the cursor back by N samples and repeat until start-of-file.
      *
+     *          Compressed formats are decoded forwards in tail windows instead; see
+     *          findLastAbove().
+     *
      * @param reader The audio reader providing the sample stream.
      * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
      * @param thread Optional pointer to the calling thread for exit signal polling.
@@ -74,6 +89,156 @@ class SilenceAnalysisAlgorithms {
      */
     static juce::int64 findSilenceOut(juce::AudioFormatReader &reader, float threshold,
                                       juce::Thread *thread = nullptr);
+
+    /**
+     * @brief Identifies the start of the audio under a selectable detection criterion.
+     * @details DetectionMode::Peak is the plain forward scan. The Rms and PeakHold modes
+     *          stream the file forwards through a WindowedDetector, which ignores isolated
+     *          clicks and reports the start of the first sustained stretch instead.
+     *          Any `filter` other than FilterMode::Off takes the streaming path in every
+     *          mode, with each chunk run through a PreFilter before it is judged.
+     *
+     * @param reader The audio reader providing the sample stream.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param mode The detection criterion.
+     * @param context Cancellation and pacing policy.
+     * @param filter The band the scan listens to.
+     * @return The In point, -1 if the criterion never holds, or `aborted`.
+     */
+    static juce::int64 findSilenceIn(juce::AudioFormatReader &reader, float threshold,
+                                     MainDomain::DetectionMode mode, const ScanContext &context,
+                                     MainDomain::FilterMode filter = MainDomain::FilterMode::Off);
+
+    /**
+     * @brief Identifies the end of the audio under a selectable detection criterion.
+     * @details Mirror of the mode-aware findSilenceIn(), streaming backwards from the end.
+     *          DetectionMode::Peak picks its strategy by format through findLastAbove(),
+     *          unless a `filter` is set; the filter then sees the file time-reversed.
+     *
+     * @param reader The audio reader providing the sample stream.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param mode The detection criterion.
+     * @param context Cancellation and pacing policy.
+     * @param filter The band the scan listens to.
+     * @return The Out point, -1 if the criterion never holds, or `aborted`.
+     */
+    static juce::int64 findSilenceOut(juce::AudioFormatReader &reader, float threshold,
+                                      MainDomain::DetectionMode mode, const ScanContext &context,
+                                      MainDomain::FilterMode filter = MainDomain::FilterMode::Off);
+
+    /**
+     * @brief Answers an In query from a file's PeakPyramid instead of a full scan.
+     * @details The pyramid yields the first leaf whose (upward-quantized) peak may
+     *          exceed the threshold; only that leaf's 256 samples are read from disk to
+     *          pinpoint the exact index. If quantization made the leaf a false candidate
+     *          the search resumes at the next leaf, so the answer always equals
+     *          findSilenceIn().
+     *
+     * @param pyramid The pyramid built for the file behind `reader`.
+     * @param reader A private reader for the same file.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @return The first non-silent sample, or -1 if none (or a read failed).
+     */
+    static juce::int64 findSilenceIn(const PeakPyramid &pyramid, juce::AudioFormatReader &reader,
+                                     float threshold);
+
+    /**
+     * @brief Answers an Out query from a file's PeakPyramid instead of a full scan.
+     * @param pyramid The pyramid built for the file behind `reader`.
+     * @param reader A private reader for the same file.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @return The last non-silent sample, or -1 if none (or a read failed).
+     */
+    static juce::int64 findSilenceOut(const PeakPyramid &pyramid,
+                                      juce::AudioFormatReader &reader, float threshold);
+
+    /**
+     * @brief Forward scan of the sample range [start, end) for the first crossing.
+     * @details This is the building block shared by the sequential scan and by every
+     *          task of a ParallelSilenceScan. When `frontier` is supplied, it holds the
+     *          earliest crossing already found by a sibling task; the scan gives up as
+     *          soon as the next chunk starts at or after it, since it can no longer win.
+     *
+     * @param reader The audio reader providing the sample stream.
+     * @param start The first sample to examine.
+     * @param end One past the last sample to examine.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param context Cancellation and pacing policy.
+     * @param frontier Optional shared earliest-hit index (INT64_MAX when none yet).
+     * @return The first crossing in the range, -1 if none (or beaten by the frontier),
+     *         or `aborted` if the scan was cancelled or a read failed.
+     */
+    static juce::int64 findFirstAboveInRange(juce::AudioFormatReader &reader, juce::int64 start,
+                                             juce::int64 end, float threshold,
+                                             const ScanContext &context,
+                                             const std::atomic<juce::int64> *frontier = nullptr);
+
+    /**
+     * @brief Backward scan of the sample range [start, end) for the last crossing.
+     * @details Mirror of findFirstAboveInRange(). `frontier` holds the latest crossing
+     *          already found by a sibling task (-1 when none yet); the scan gives up once
+     *          the next chunk ends at or before it.
+     *
+     * @param reader The audio reader providing the sample stream.
+     * @param start The first sample to examine.
+     * @param end One past the last sample to examine.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param context Cancellation and pacing policy.
+     * @param frontier Optional shared latest-hit index (-1 when none yet).
+     * @return The last crossing in the range, -1 if none (or beaten by the frontier),
+     *         or `aborted` if the scan was cancelled or a read failed.
+     */
+    static juce::int64 findLastAboveInRange(juce::AudioFormatReader &reader, juce::int64 start,
+                                            juce::int64 end, float threshold,
+                                            const ScanContext &context,
+                                            const std::atomic<juce::int64> *frontier = nullptr);
+
+    /**
+     * @brief Finds the last crossing in [start, end) with the strategy suited to the format.
+     * @details Readers that seek cheaply (WAV/AIFF) take the backward crawl of
+     *          findLastAboveInRange(). Compressed decoders re-sync on every backward seek,
+     *          so for them the range is covered from the end in tail windows that start at
+     *          `Config::Audio::compressedTailFirstSamples` and double in size; each window
+     *          is decoded forwards exactly once by findLastAboveForwards(), and the first
+     *          window that holds a crossing holds the last one. Only one seek is made per
+     *          window instead of one per chunk.
+     *
+     * @param reader The audio reader providing the sample stream.
+     * @param start The first sample to examine.
+     * @param end One past the last sample to examine.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param context Cancellation and pacing policy.
+     * @return The last crossing in the range, -1 if none, or `aborted`.
+     */
+    static juce::int64 findLastAbove(juce::AudioFormatReader &reader, juce::int64 start,
+                                     juce::int64 end, float threshold, const ScanContext &context);
+
+    /**
+     * @brief Decodes [start, end) forwards once, keeping a rolling record of the last crossing.
+     * @param reader The audio reader providing the sample stream.
+     * @param start The first sample to examine.
+     * @param end One past the last sample to examine.
+     * @param threshold The amplitude threshold (linear range 0.0 to 1.0).
+     * @param context Cancellation and pacing policy.
+     * @return The last crossing in the range, -1 if none, or `aborted`.
+     */
+    static juce::int64 findLastAboveForwards(juce::AudioFormatReader &reader, juce::int64 start,
+                                             juce::int64 end, float threshold,
+                                             const ScanContext &context);
+
+    /**
+     * @brief Reports whether a reader serves random and backward reads cheaply.
+     * @param reader The reader to inspect.
+     * @return True for uncompressed WAV and AIFF readers.
+     */
+    static bool seeksCheaply(const juce::AudioFormatReader &reader);
+
+    /**
+     * @brief Reports whether a reader's channel layout can be scanned at all.
+     * @param reader The reader to validate.
+     * @return True for 1 to 128 channels.
+     */
+    static bool isScannable(const juce::AudioFormatReader &reader);
 };
 
 #endif
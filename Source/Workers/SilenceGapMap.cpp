@@ -0,0 +1,101 @@
+#include "Workers/SilenceGapMap.h"
+#include "Utils/Config.h"
+#include "Workers/PeakScanKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr int kMaxChannels = 128;
+} // namespace
+
+SilenceGapMap::Builder::Builder(float threshold, juce::int64 length, double rate)
+    : map(std::make_unique<SilenceGapMap>()) {
+    map->threshold = threshold;
+    map->sampleRate = rate;
+    map->lengthInSamples = length;
+    minGap = std::max((juce::int64)2,
+                      (juce::int64)std::llround(rate * Config::Audio::gapMinSeconds));
+    blockSize = (int)std::min(minGap / 2, (juce::int64)std::numeric_limits<int>::max());
+}
+
+/**
+ * @details A block with no loud sample only extends the current quiet stretch. Otherwise
+ *          its first loud sample ends the stretch (which becomes a gap if it is long
+ *          enough) and its last loud sample starts the next one, so loud samples in
+ *          between never need to be visited individually.
+ */
+void SilenceGapMap::Builder::addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+    numChannels = std::min(buffer.getNumChannels(), kMaxChannels);
+    if (map == nullptr || numChannels <= 0 || numSamples <= 0)
+        return;
+
+    channels = buffer.getArrayOfReadPointers();
+    std::array<const float *, kMaxChannels> block{};
+    const float threshold = map->threshold;
+
+    for (int pos = 0; pos < numSamples;) {
+        const int blockEnd = std::min(numSamples, pos + blockSize);
+        for (int ch = 0; ch < numChannels; ++ch)
+            block[(size_t)ch] = channels[ch] + pos;
+
+        const int last =
+            PeakScanKernels::findLastAbove(block.data(), numChannels, blockEnd - pos, threshold);
+        if (last < 0) {
+            if (lastLoud >= 0)
+                stretchPeak = std::max(stretchPeak, peakOf(pos, blockEnd));
+            pos = blockEnd;
+            continue;
+        }
+
+        const juce::int64 stretchStart = lastLoud + 1;
+        if (lastLoud >= 0 && position + pos + last - stretchStart >= minGap) {
+            const int first = PeakScanKernels::findFirstAbove(block.data(), numChannels,
+                                                              last + 1, threshold);
+            const juce::int64 stretchEnd = position + pos + first;
+            if (stretchEnd - stretchStart >= minGap)
+                addGap(stretchStart, stretchEnd, std::max(stretchPeak, peakOf(pos, pos + first)));
+        }
+
+        lastLoud = position + pos + last;
+        stretchPeak = peakOf(pos + last + 1, blockEnd);
+        pos = blockEnd;
+    }
+    position += numSamples;
+}
+
+std::unique_ptr<SilenceGapMap> SilenceGapMap::Builder::finish() {
+    return std::move(map);
+}
+
+float SilenceGapMap::Builder::peakOf(int from, int to) const noexcept {
+    float peak = 0.0f;
+    if (from >= to)
+        return peak;
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const auto range =
+            juce::FloatVectorOperations::findMinAndMax(channels[ch] + from, to - from);
+        peak = std::max(peak, std::max(-range.getStart(), range.getEnd()));
+    }
+    return peak;
+}
+
+void SilenceGapMap::Builder::addGap(juce::int64 start, juce::int64 end, float depth) {
+    if (map->truncated)
+        return;
+    if ((int)map->gaps.size() >= Config::Audio::gapMapMaxGaps) {
+        map->truncated = true;
+        return;
+    }
+    map->gaps.push_back({start, end, depth});
+}
+
+size_t SilenceGapMap::findFirstEndingAfter(juce::int64 sample) const {
+    const auto it = std::upper_bound(
+        gaps.begin(), gaps.end(), sample,
+        [](juce::int64 value, const Gap &gap) { return value < gap.end; });
+    return (size_t)(it - gaps.begin());
+}
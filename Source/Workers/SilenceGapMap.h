@@ -0,0 +1,135 @@
+#ifndef AUDIOFILER_SILENCEGAPMAP_H
+#define AUDIOFILER_SILENCEGAPMAP_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file SilenceGapMap.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Sorted list of every internal silent gap of one file at one Threshold.
+ *
+ * @details Architecturally, SilenceGapMap is an immutable "Passive Data Model" produced
+ *          by one forward streaming pass and consumed on the Message Thread, like
+ *          CutPointCurves. Where the Auto-Cut scans only locate the first and last loud
+ *          samples, the gap map records every stretch between two loud samples that is
+ *          at least `Config::Audio::gapMinSeconds` long, so long field recordings can be
+ *          split into takes: the waveform shades the gaps and the keyboard jumps from
+ *          gap to gap.
+ *
+ *          Leading and trailing silence are not gaps; they are what the Auto-Cut points
+ *          already trim. Memory is one 24-byte record per gap, bounded by
+ *          `Config::Audio::gapMapMaxGaps`; a map that hit the bound reports isTruncated()
+ *          and covers the file only up to its last gap.
+ *
+ * @see SilenceAnalysisWorker
+ * @see CutLayerView
+ */
+class SilenceGapMap final {
+  public:
+    /** @brief One silent stretch between two loud samples. */
+    struct Gap {
+        juce::int64 start; /**< First silent sample. */
+        juce::int64 end;   /**< The loud sample that ends the gap (exclusive). */
+        float depth;       /**< Largest magnitude inside the gap; 0 is digital silence. */
+    };
+
+    /**
+     * @class Builder
+     * @brief Accumulates gaps chunk by chunk during a forward streaming pass.
+     * @details The stream is walked in blocks of half the minimum gap length: any gap
+     *          contains at least one whole quiet block. A backward kernel scan finds each
+     *          block's last loud sample (in dense audio, within the first vector step);
+     *          only when the quiet stretch since the previous loud sample could already
+     *          be a gap is the block's first loud sample located as well. The depth is
+     *          accumulated with vectorized min/max over the quiet samples only.
+     */
+    class Builder {
+      public:
+        /**
+         * @brief Prepares a builder for one file.
+         * @param threshold The linear amplitude threshold; samples at or below it are silent.
+         * @param lengthInSamples The file length in samples.
+         * @param sampleRate The file sample rate.
+         */
+        Builder(float threshold, juce::int64 lengthInSamples, double sampleRate);
+
+        /**
+         * @brief Consumes the next chunk of the file, in order.
+         * @param buffer Decoded samples; only the first `numSamples` are used.
+         * @param numSamples The number of valid samples in the buffer.
+         */
+        void addChunk(const juce::AudioBuffer<float> &buffer, int numSamples);
+
+        /**
+         * @brief Finalizes the map.
+         * @return The finished map.
+         */
+        std::unique_ptr<SilenceGapMap> finish();
+
+      private:
+        /** @brief Largest magnitude across channels of samples `[from, to)` of the chunk. */
+        float peakOf(int from, int to) const noexcept;
+
+        /** @brief Appends a gap, or marks the map truncated once the budget is spent. */
+        void addGap(juce::int64 start, juce::int64 end, float depth);
+
+        std::unique_ptr<SilenceGapMap> map;
+        const float *const *channels = nullptr; /**< Read pointers of the current chunk. */
+        int numChannels = 0;
+        juce::int64 position = 0;
+        juce::int64 minGap = 1;
+        int blockSize = 1;
+        juce::int64 lastLoud = -1; /**< -1 until the first loud sample. */
+        float stretchPeak = 0.0f;  /**< Depth of the quiet stretch after `lastLoud`. */
+    };
+
+    /**
+     * @brief Finds the first gap ending after a sample.
+     * @param sample An absolute sample index.
+     * @return Index into getGaps(), or getGaps().size() if none.
+     */
+    size_t findFirstEndingAfter(juce::int64 sample) const;
+
+    /** @return The gaps, sorted and non-overlapping. */
+    const std::vector<Gap> &getGaps() const {
+        return gaps;
+    }
+
+    /** @return The Threshold the map was built for. */
+    float getThreshold() const {
+        return threshold;
+    }
+
+    /** @return The sample rate of the analysed file. */
+    double getSampleRate() const {
+        return sampleRate;
+    }
+
+    /** @return The length of the analysed file in samples. */
+    juce::int64 getLengthInSamples() const {
+        return lengthInSamples;
+    }
+
+    /** @return True if gaps beyond `Config::Audio::gapMapMaxGaps` were dropped. */
+    bool isTruncated() const {
+        return truncated;
+    }
+
+  private:
+    std::vector<Gap> gaps;
+    float threshold = 0.0f;
+    double sampleRate = 0.0;
+    juce::int64 lengthInSamples = 0;
+    bool truncated = false;
+};
+
+#endif
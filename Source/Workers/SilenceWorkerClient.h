@@ -48,6 +48,13 @@ class SilenceWorkerClient {
      * @return True if the worker should automatically update the 'Out' marker.
      */
     virtual bool isAutoCutOutActive() const = 0;
+
+    /**
+     * @brief Reports that a file's NoiseFloorHistogram is attached to its metadata.
+     * @param filePath Absolute path to the analysed file.
+     * @note Called on the Message Thread.
+     */
+    virtual void noiseFloorEstimated(const juce::String &filePath) = 0;
 };
 
 #endif
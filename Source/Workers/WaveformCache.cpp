@@ -0,0 +1,67 @@
+#include "Workers/WaveformCache.h"
+#include "Utils/CacheEviction.h"
+#include "Utils/Config.h"
+#include "Workers/PeakMipmap.h"
+
+#include <utility>
+
+WaveformCache::WaveformCache(const juce::File &dir, juce::int64 maxBytesIn)
+    : directory(dir), maxBytes(maxBytesIn) {
+}
+
+juce::File WaveformCache::getDefaultDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+        .getChildFile(Config::Audio::waveformCacheFolder);
+}
+
+juce::File WaveformCache::fileFor(const juce::String &hash) const {
+    return directory.getChildFile(hash + Config::Audio::waveformCacheExtension);
+}
+
+bool WaveformCache::load(const juce::String &hash, PeakMipmap &mipmap) {
+    const auto file = fileFor(hash);
+    if (!file.existsAsFile())
+        return false;
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (mapped->getData() == nullptr)
+        return false;
+    if (!mipmap.loadMapped(std::move(mapped))) {
+        file.deleteFile(); // corrupt, or from an incompatible version
+        return false;
+    }
+
+    CacheEviction::touch(file);
+    return true;
+}
+
+bool WaveformCache::store(const juce::String &hash, const PeakMipmap &mipmap) {
+    return write(hash, [&mipmap](juce::OutputStream &output) { return mipmap.writeTo(output); });
+}
+
+bool WaveformCache::store(const juce::String &hash, const juce::MemoryBlock &serialized) {
+    return write(hash, [&serialized](juce::OutputStream &output) {
+        return output.write(serialized.getData(), serialized.getSize());
+    });
+}
+
+// Write to a sibling temp file first so a crash never leaves a truncated cache entry.
+bool WaveformCache::write(const juce::String &hash,
+                          const std::function<bool(juce::OutputStream &)> &body) {
+    if (!directory.createDirectory())
+        return false;
+
+    juce::TemporaryFile temp(fileFor(hash));
+    {
+        juce::FileOutputStream output(temp.getFile());
+        if (!output.openedOk() || !body(output))
+            return false;
+        output.flush();
+    }
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+juce::int64 WaveformCache::evict() {
+    return CacheEviction::trimToSize(directory, {Config::Audio::waveformCacheExtension},
+                                     maxBytes);
+}
@@ -0,0 +1,94 @@
+#ifndef AUDIOFILER_WAVEFORMCACHE_H
+#define AUDIOFILER_WAVEFORMCACHE_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include <functional>
+
+class PeakMipmap;
+
+/**
+ * @file WaveformCache.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Size-capped disk cache of waveform mipmaps keyed by file hash.
+ *
+ * @details Architecturally, WaveformCache is the persistence brick of the waveform
+ *          display, as EnvelopeStore is for the Threshold queries. Every PeakMipmap built
+ *          by WaveformManager is written to `~/.config/audiofiler/waveforms/<hash>.wave`;
+ *          when the file is opened again its mipmap is memory-mapped straight back in, so
+ *          the full waveform appears without decoding the file. Keys are FileIdentity
+ *          hashes, which cover the file size, its modification time and both ends of its
+ *          content, so an edited file never picks up a stale waveform.
+ *
+ *          The folder is kept under `Config::Audio::waveformCacheMaxBytes` by evicting the
+ *          least recently used entries through CacheEviction. A hit refreshes the entry's
+ *          modification time, which serves as its recency.
+ *
+ *          The cache holds no state besides its folder. Loads run on the waveform build
+ *          thread and stores on the store thread; entries are replaced by renaming, so a
+ *          load never sees a half-written one.
+ *
+ * @see PeakMipmap
+ * @see WaveformManager
+ * @see FileIdentity
+ */
+class WaveformCache final {
+  public:
+    /**
+     * @brief Constructs a cache rooted at a directory.
+     * @param directory Folder holding the cache files; created on first write.
+     * @param maxBytes The total size eviction trims the folder to.
+     */
+    WaveformCache(const juce::File &directory, juce::int64 maxBytes);
+
+    /** @return The default on-disk location under the user's config folder. */
+    static juce::File getDefaultDirectory();
+
+    /**
+     * @brief Maps a cached mipmap into a store sized by PeakMipmap::reset().
+     * @details Entries that do not match the store's shape are stale or corrupt and are
+     *          deleted.
+     * @param hash The file hash.
+     * @param mipmap The store to load into.
+     * @return True if the store is now fully loaded from the cache.
+     */
+    bool load(const juce::String &hash, PeakMipmap &mipmap);
+
+    /**
+     * @brief Writes a fully built mipmap, replacing any older entry atomically.
+     * @param hash The file hash.
+     * @param mipmap The store to save.
+     * @return True on success.
+     */
+    bool store(const juce::String &hash, const PeakMipmap &mipmap);
+
+    /**
+     * @brief Writes a mipmap already serialized by PeakMipmap::writeTo(), replacing any
+     *        older entry atomically.
+     * @param hash The file hash.
+     * @param serialized The serialized mipmap.
+     * @return True on success.
+     */
+    bool store(const juce::String &hash, const juce::MemoryBlock &serialized);
+
+    /**
+     * @brief Deletes the least recently used entries until the folder fits the size cap.
+     * @see CacheEviction::trimToSize()
+     * @return The number of bytes freed.
+     */
+    juce::int64 evict();
+
+  private:
+    juce::File fileFor(const juce::String &hash) const;
+    bool write(const juce::String &hash, const std::function<bool(juce::OutputStream &)> &body);
+
+    juce::File directory;
+    juce::int64 maxBytes;
+};
+
+#endif
@@ -0,0 +1,190 @@
+#include "Workers/WindowedDetector.h"
+#include "Utils/Config.h"
+#include "Workers/PeakScanKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+WindowedDetector::WindowedDetector(MainDomain::DetectionMode modeIn, double sampleRate,
+                                   int numChannelsIn, float thresholdIn, bool forwardIn,
+                                   juce::int64 lengthInSamples)
+    : mode(modeIn), numChannels(numChannelsIn), threshold(thresholdIn), forward(forwardIn),
+      length(lengthInSamples), channels((size_t)numChannelsIn, nullptr),
+      offsetChannels((size_t)numChannelsIn, nullptr) {
+    if (mode == MainDomain::DetectionMode::Rms) {
+        window = std::max(1, juce::roundToInt(sampleRate * Config::Audio::rmsWindowSeconds));
+        // Squared in float like the samples themselves, so a window of samples at or below
+        // the Threshold can never sum above it.
+        windowEnergy = (double)window * (double)(threshold * threshold);
+        ring.assign((size_t)window * (size_t)numChannels, 0.0f);
+        sums.assign((size_t)numChannels, 0.0);
+    } else if (mode == MainDomain::DetectionMode::PeakHold) {
+        hold = (juce::int64)std::llround(sampleRate * Config::Audio::peakHoldSeconds);
+        minDuration = (juce::int64)std::llround(sampleRate * Config::Audio::peakHoldMinSeconds);
+    }
+}
+
+juce::int64 WindowedDetector::addChunk(const juce::AudioBuffer<float> &buffer, int numSamples) {
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[(size_t)ch] = buffer.getReadPointer(ch);
+
+    const auto result = mode == MainDomain::DetectionMode::Rms ? addChunkRms(numSamples)
+                                                               : addChunkHold(numSamples);
+    streamStart += numSamples;
+    return result;
+}
+
+/**
+ * @details While the window ending at the current position holds no sample above the
+ *          Threshold its RMS cannot exceed it either, so the loop jumps with the vector
+ *          kernel to the next loud sample and only pushes the window's worth of samples
+ *          before it into the ring. From there it advances sample by sample, keeping
+ *          one running sum per channel, until a window triggers or the last loud sample
+ *          has slid out of the window again.
+ */
+juce::int64 WindowedDetector::addChunkRms(int numSamples) {
+    int i = 0;
+    while (i < numSamples) {
+        if (lastLoudPosition < streamStart + i - window + 1) {
+            const int next = firstLoud(i, numSamples, numSamples);
+            pushSilently(std::max(i, next - window), next, numSamples);
+            if (next >= numSamples)
+                return -1;
+            i = next;
+        }
+
+        const int index = forward ? i : numSamples - 1 - i;
+        bool loud = false;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const float sample = channels[(size_t)ch][index];
+            const float squared = sample * sample;
+            float &slot = ring[(size_t)ch * (size_t)window + (size_t)ringPos];
+            sums[(size_t)ch] += (double)squared - (double)slot;
+            slot = squared;
+            loud = loud || std::abs(sample) > threshold;
+        }
+        ringPos = ringPos + 1 == window ? 0 : ringPos + 1;
+
+        const juce::int64 position = streamStart + i;
+        if (loud)
+            lastLoudPosition = position;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            if (sums[(size_t)ch] > windowEnergy)
+                return toFileIndex(std::max((juce::int64)0, position - window + 1));
+        ++i;
+    }
+    return -1;
+}
+
+/**
+ * @details Each step jumps straight to the furthest loud sample still within the hold of
+ *          the current run (extending it as far as possible in one kernel call) or, once
+ *          the hold has expired, to the next loud sample, which opens a new run. A run
+ *          that reaches the chunk's end unbroken carries over to the next chunk.
+ */
+juce::int64 WindowedDetector::addChunkHold(int numSamples) {
+    int i = 0;
+    while (i < numSamples) {
+        if (runLast >= 0) {
+            const juce::int64 reach = runLast + hold - streamStart;
+            if (reach >= i) {
+                const int to = (int)std::min(reach + 1, (juce::int64)numSamples);
+                const int hit = lastLoud(i, to, numSamples);
+                if (hit >= 0) {
+                    runLast = streamStart + hit;
+                    if (runLast - runStart >= minDuration)
+                        return toFileIndex(runStart);
+                    i = hit + 1;
+                    continue;
+                }
+                if (to == numSamples)
+                    return -1;
+                i = to;
+            }
+            runStart = runLast = -1;
+        }
+
+        const int next = firstLoud(i, numSamples, numSamples);
+        if (next >= numSamples)
+            return -1;
+        runStart = runLast = streamStart + next;
+        if (minDuration <= 0)
+            return toFileIndex(runStart);
+        i = next + 1;
+    }
+    return -1;
+}
+
+int WindowedDetector::firstLoud(int from, int to, int numSamples) noexcept {
+    if (from >= to)
+        return to;
+
+    if (forward) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            offsetChannels[(size_t)ch] = channels[(size_t)ch] + from;
+        const int hit =
+            PeakScanKernels::findFirstAbove(offsetChannels.data(), numChannels, to - from, threshold);
+        return hit >= 0 ? from + hit : to;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        offsetChannels[(size_t)ch] = channels[(size_t)ch] + (numSamples - to);
+    const int hit =
+        PeakScanKernels::findLastAbove(offsetChannels.data(), numChannels, to - from, threshold);
+    return hit >= 0 ? to - 1 - hit : to;
+}
+
+int WindowedDetector::lastLoud(int from, int to, int numSamples) noexcept {
+    if (from >= to)
+        return -1;
+
+    if (forward) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            offsetChannels[(size_t)ch] = channels[(size_t)ch] + from;
+        const int hit =
+            PeakScanKernels::findLastAbove(offsetChannels.data(), numChannels, to - from, threshold);
+        return hit >= 0 ? from + hit : -1;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        offsetChannels[(size_t)ch] = channels[(size_t)ch] + (numSamples - to);
+    const int hit =
+        PeakScanKernels::findFirstAbove(offsetChannels.data(), numChannels, to - from, threshold);
+    return hit >= 0 ? to - 1 - hit : -1;
+}
+
+/**
+ * @details Callers only skip samples when at least a full window follows, in which case
+ *          the ring is rebuilt from scratch and the sums recomputed exactly; this also
+ *          discards any rounding the incremental updates have accumulated.
+ */
+void WindowedDetector::pushSilently(int from, int to, int numSamples) noexcept {
+    if (to - from >= window) {
+        from = to - window;
+        ringPos = 0;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            float *slots = ring.data() + (size_t)ch * (size_t)window;
+            double sum = 0.0;
+            for (int k = 0; k < window; ++k) {
+                const int i = from + k;
+                const float sample = channels[(size_t)ch][forward ? i : numSamples - 1 - i];
+                slots[k] = sample * sample;
+                sum += (double)slots[k];
+            }
+            sums[(size_t)ch] = sum;
+        }
+        return;
+    }
+
+    for (int i = from; i < to; ++i) {
+        const int index = forward ? i : numSamples - 1 - i;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const float sample = channels[(size_t)ch][index];
+            float &slot = ring[(size_t)ch * (size_t)window + (size_t)ringPos];
+            sums[(size_t)ch] += (double)(sample * sample) - (double)slot;
+            slot = sample * sample;
+        }
+        ringPos = ringPos + 1 == window ? 0 : ringPos + 1;
+    }
+}
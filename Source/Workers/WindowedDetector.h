@@ -0,0 +1,109 @@
+#ifndef AUDIOFILER_WINDOWEDDETECTOR_H
+#define AUDIOFILER_WINDOWEDDETECTOR_H
+
+#ifdef JUCE_HEADLESS
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#else
+#include <JuceHeader.h>
+#endif
+
+#include "MainDomain.h"
+#include <vector>
+
+/**
+ * @file WindowedDetector.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup AudioEngine
+ * @brief Streaming click-tolerant onset detector for the Auto-Cut scans.
+ *
+ * @details Architecturally, WindowedDetector is the stateful counterpart of
+ *          PeakScanKernels. The plain Peak mode triggers on a single sample above the
+ *          Threshold, so one click or DC spike in a lead-in produces a wrong cut. The
+ *          detector is fed a file's chunks in scan order (ascending for In, descending
+ *          for Out) and reports the boundary once one of the alternative criteria holds:
+ *
+ *          - **Rms**: the RMS of a sliding `Config::Audio::rmsWindowSeconds` window on
+ *            any channel exceeds the Threshold. In is the first sample of the first such
+ *            window, Out the last sample of the last one, so a cut never clips an attack.
+ *          - **PeakHold**: peaks above the Threshold, with gaps no longer than
+ *            `Config::Audio::peakHoldSeconds`, span at least
+ *            `Config::Audio::peakHoldMinSeconds`. In is the run's first peak, Out its last.
+ *          - **Peak**: the degenerate PeakHold with no hold and no minimum duration.
+ *
+ *          Both criteria are gated by the vectorized PeakScanKernels: a window's RMS can
+ *          never exceed its largest sample, so stretches with no sample above the
+ *          Threshold are skipped at kernel speed and the scalar running sum only runs
+ *          within one window of a loud sample. State is a ring of one window of squared
+ *          samples per channel, independent of the file length.
+ *
+ * @see SilenceAnalysisAlgorithms
+ * @see PeakScanKernels
+ */
+class WindowedDetector final {
+  public:
+    /**
+     * @brief Constructs a detector for one scan.
+     * @param mode The detection criterion.
+     * @param sampleRate The file's sample rate, used to convert the Config durations.
+     * @param numChannels The file's channel count.
+     * @param threshold The linear amplitude threshold.
+     * @param forward True for an In scan (ascending), false for an Out scan (descending).
+     * @param lengthInSamples The file length; chunks must cover it contiguously from the
+     *        scan's starting edge.
+     */
+    WindowedDetector(MainDomain::DetectionMode mode, double sampleRate, int numChannels,
+                     float threshold, bool forward, juce::int64 lengthInSamples);
+
+    /**
+     * @brief Feeds the next chunk in scan order.
+     * @param buffer The chunk's samples in file order.
+     * @param numSamples The number of valid samples in the buffer.
+     * @return The boundary's absolute sample index, or -1 if not found yet.
+     */
+    juce::int64 addChunk(const juce::AudioBuffer<float> &buffer, int numSamples);
+
+  private:
+    juce::int64 addChunkRms(int numSamples);
+    juce::int64 addChunkHold(int numSamples);
+
+    /** @brief Scan-order index of the first loud sample in `[from, to)`, or `to`. */
+    int firstLoud(int from, int to, int numSamples) noexcept;
+
+    /** @brief Scan-order index of the last loud sample in `[from, to)`, or -1. */
+    int lastLoud(int from, int to, int numSamples) noexcept;
+
+    /** @brief Pushes scan-order samples `[from, to)` into the RMS ring without testing them. */
+    void pushSilently(int from, int to, int numSamples) noexcept;
+
+    /** @brief Maps a scan-order stream position to an absolute file index. */
+    juce::int64 toFileIndex(juce::int64 streamPosition) const noexcept {
+        return forward ? streamPosition : length - 1 - streamPosition;
+    }
+
+    const MainDomain::DetectionMode mode;
+    const int numChannels;
+    const float threshold;
+    const bool forward;
+    const juce::int64 length;
+
+    std::vector<const float *> channels; /**< Read pointers of the current chunk. */
+    std::vector<const float *> offsetChannels; /**< Scratch pointers for kernel subranges. */
+    juce::int64 streamStart{0};          /**< Scan-order position of the current chunk. */
+
+    // Rms state
+    int window{1};
+    double windowEnergy{0.0};            /**< `window * threshold^2`; sums above it trigger. */
+    std::vector<float> ring;             /**< `window` squared samples per channel. */
+    std::vector<double> sums;            /**< Running sum of each channel's ring. */
+    int ringPos{0};
+    juce::int64 lastLoudPosition{-1};
+
+    // PeakHold state
+    juce::int64 hold{0};
+    juce::int64 minDuration{0};
+    juce::int64 runStart{-1};
+    juce::int64 runLast{-1};
+};
+
+#endif
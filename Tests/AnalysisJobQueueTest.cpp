@@ -0,0 +1,164 @@
+/**
+ * @file AnalysisJobQueueTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies ordering, de-duplication, superseding and bounding of analysis requests.
+ */
+
+#include "Workers/AnalysisJobQueue.h"
+#include <juce_core/juce_core.h>
+
+/**
+ * @class AnalysisJobQueueTest
+ * @brief Exercises AnalysisJobQueue without any threads, one scheduling rule at a time.
+ */
+class AnalysisJobQueueTest : public juce::UnitTest {
+  public:
+    AnalysisJobQueueTest() : juce::UnitTest("Analysis Job Queue Test") {
+    }
+
+    void runTest() override {
+        using Admission = AnalysisJobQueue::Admission;
+        using Priority = AnalysisJobQueue::Priority;
+
+        beginTest("Both directions of one file are queued");
+        {
+            AnalysisJobQueue queue(8);
+            expect(queue.push({"a.wav", true, 0.1f}) == Admission::Queued);
+            expect(queue.push({"a.wav", false, 0.1f}) == Admission::Queued);
+            expect(queue.isActive(true) && queue.isActive(false));
+            expectEquals(queue.getNumPending(), 2);
+        }
+
+        beginTest("Interactive requests are served first, then oldest first");
+        {
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            queue.push({"b.wav", true, 0.1f});
+            queue.push({"c.wav", true, 0.1f, Priority::Interactive});
+            expectEquals(queue.pop()->request.filePath, juce::String("c.wav"));
+            expectEquals(queue.pop()->request.filePath, juce::String("a.wav"));
+            expectEquals(queue.pop()->request.filePath, juce::String("b.wav"));
+            expect(!queue.pop().has_value());
+        }
+
+        beginTest("Identical requests are merged");
+        {
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            queue.push({"b.wav", true, 0.1f});
+            expect(queue.push({"b.wav", true, 0.1f, Priority::Interactive}) == Admission::Duplicate);
+            expectEquals(queue.getNumPending(), 2);
+            expectEquals(queue.pop()->request.filePath, juce::String("b.wav"),
+                         "A merged duplicate keeps the higher priority");
+
+            const auto running = queue.pop();
+            expect(queue.push({"a.wav", true, 0.1f}) == Admission::Duplicate);
+            expect(queue.isCurrent(*running));
+        }
+
+        beginTest("A new Threshold supersedes pending and running requests");
+        {
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            expect(queue.push({"a.wav", true, 0.2f}) == Admission::Superseded);
+            expectEquals(queue.getNumPending(), 1);
+
+            const auto first = queue.pop();
+            expectEquals(first->request.threshold, 0.2f);
+            expect(queue.isCurrent(*first));
+
+            expect(queue.push({"a.wav", true, 0.3f}) == Admission::Superseded);
+            expect(first->cancelled->load(), "The running pass is told to stop");
+            expect(!queue.isCurrent(*first));
+            queue.finish(*first);
+
+            const auto second = queue.pop();
+            expectEquals(second->request.threshold, 0.3f);
+            expect(queue.isCurrent(*second));
+            queue.finish(*second);
+            expect(queue.isIdle());
+        }
+
+        beginTest("A new detection mode supersedes like a new Threshold");
+        {
+            using Mode = MainDomain::DetectionMode;
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            const auto running = queue.pop();
+            expect(queue.push({"a.wav", true, 0.1f, Priority::Normal, Mode::Rms}) ==
+                   Admission::Superseded);
+            expect(!queue.isCurrent(*running));
+            expect(queue.push({"a.wav", true, 0.1f, Priority::Normal, Mode::Rms}) ==
+                   Admission::Duplicate);
+            expect(queue.pop()->request.mode == Mode::Rms);
+        }
+
+        beginTest("A new pre-filter supersedes like a new detection mode");
+        {
+            using Mode = MainDomain::DetectionMode;
+            using Filter = MainDomain::FilterMode;
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            expect(queue.push({"a.wav", true, 0.1f, Priority::Normal, Mode::Peak,
+                               Filter::HighPass}) == Admission::Superseded);
+            expect(queue.push({"a.wav", true, 0.1f, Priority::Normal, Mode::Peak,
+                               Filter::HighPass}) == Admission::Duplicate);
+            expect(queue.pop()->request.filter == Filter::HighPass);
+        }
+
+        beginTest("The bound evicts the oldest lowest-priority request");
+        {
+            AnalysisJobQueue queue(2);
+            queue.push({"a.wav", true, 0.1f});
+            queue.push({"b.wav", true, 0.1f});
+            expect(queue.push({"c.wav", true, 0.1f, Priority::Interactive}) == Admission::Queued);
+            expectEquals(queue.getNumPending(), 2);
+            expectEquals(queue.pop()->request.filePath, juce::String("c.wav"));
+            expectEquals(queue.pop()->request.filePath, juce::String("b.wav"));
+
+            AnalysisJobQueue full(1);
+            full.push({"a.wav", true, 0.1f, Priority::Interactive});
+            expect(full.push({"b.wav", true, 0.1f}) == Admission::Rejected);
+        }
+
+        beginTest("Cancelling drops pending and invalidates running requests");
+        {
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            queue.push({"a.wav", false, 0.1f});
+            const auto running = queue.pop();
+            queue.cancelAll();
+            expectEquals(queue.getNumPending(), 0);
+            expect(!queue.isCurrent(*running));
+            expect(!queue.isActive(true) && !queue.isActive(false));
+            expect(!queue.isIdle(), "The running pass stays tracked until it finishes");
+            queue.finish(*running);
+            expect(queue.isIdle());
+        }
+
+        beginTest("Cancelling one file and direction leaves the others alone");
+        {
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            const auto running = queue.pop();
+            queue.push({"a.wav", true, 0.2f});
+            queue.push({"a.wav", false, 0.1f});
+            queue.push({"b.wav", true, 0.1f});
+
+            queue.cancel("a.wav", true);
+            expect(!queue.isCurrent(*running));
+            expectEquals(queue.getNumPending(), 2);
+            expect(queue.isActive(true), "b.wav In is still pending");
+            queue.finish(*running);
+
+            expect(queue.push({"a.wav", true, 0.2f}) == Admission::Queued,
+                   "A request after the cancel is scheduled afresh");
+            const auto next = queue.pop();
+            expect(next.has_value() && next->request.filePath == "a.wav");
+            expect(queue.isCurrent(*next));
+        }
+    }
+};
+
+static AnalysisJobQueueTest analysisJobQueueTest;
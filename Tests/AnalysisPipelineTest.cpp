@@ -0,0 +1,159 @@
+/**
+ * @file AnalysisPipelineTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the single-decode analyzer pipeline and the LevelStats it gathers.
+ */
+
+#include "BufferMockReader.h"
+#include "Utils/Config.h"
+#include "Workers/AnalysisPipeline.h"
+#include "Workers/CutPointCurves.h"
+#include "Workers/LevelStats.h"
+#include "Workers/NoiseFloorHistogram.h"
+#include "Workers/PeakPyramid.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @class AnalysisPipelineTest
+ * @brief Runs the envelope builders through one pipeline and compares them with builders
+ *        fed one at a time, then checks LevelStats against figures known in closed form.
+ */
+class AnalysisPipelineTest : public juce::UnitTest {
+  public:
+    AnalysisPipelineTest() : juce::UnitTest("Analysis Pipeline Test") {
+    }
+
+    void runTest() override {
+        constexpr int length = 300000;
+        constexpr double sampleRate = 44100.0;
+        juce::AudioBuffer<float> samples(2, length);
+        auto random = getRandom();
+        for (int i = 0; i < length; ++i) {
+            const float envelope = i < length / 4 ? 0.001f : 0.5f;
+            for (int ch = 0; ch < 2; ++ch)
+                samples.setSample(ch, i, envelope * (random.nextFloat() * 2.0f - 1.0f));
+        }
+
+        beginTest("One decode feeds every analyzer");
+        {
+            CountingReader reader(samples);
+            AnalysisPipeline<PeakPyramid::Builder, CutPointCurves::Builder,
+                             NoiseFloorHistogram::Builder, LevelStats::Builder>
+                pipeline(PeakPyramid::Builder(length, 2),
+                         CutPointCurves::Builder(length, sampleRate),
+                         NoiseFloorHistogram::Builder(length, sampleRate),
+                         LevelStats::Builder(length, 2));
+            expectEquals((int)decltype(pipeline)::numAnalyzers, 4);
+            expect(pipeline.run(reader, ScanContext()));
+            expectEquals(reader.samplesRead, (juce::int64)length);
+
+            // The same builders fed one after another must produce the same summaries.
+            PeakPyramid::Builder pyramid(length, 2);
+            NoiseFloorHistogram::Builder noiseFloor(length, sampleRate);
+            LevelStats::Builder levels(length, 2);
+            for (int pos = 0; pos < length; pos += SilenceAnalysisAlgorithms::chunkSize) {
+                const int n = std::min(SilenceAnalysisAlgorithms::chunkSize, length - pos);
+                juce::AudioBuffer<float> chunk(2, n);
+                for (int ch = 0; ch < 2; ++ch)
+                    chunk.copyFrom(ch, 0, samples, ch, pos, n);
+                pyramid.addChunk(chunk, n);
+                noiseFloor.addChunk(chunk, n);
+                levels.addChunk(chunk, n);
+            }
+            expect(sameBytes(*pipeline.get<PeakPyramid::Builder>().finish(), *pyramid.finish()));
+            expect(sameBytes(*pipeline.get<NoiseFloorHistogram::Builder>().finish(),
+                             *noiseFloor.finish()));
+            expect(sameBytes(*pipeline.get<LevelStats::Builder>().finish(), *levels.finish()));
+            expect(pipeline.get<CutPointCurves::Builder>().finish() != nullptr);
+        }
+
+        beginTest("A stopped pass reports that it is incomplete");
+        {
+            BufferMockReader reader(samples);
+            std::atomic<bool> cancelled{true};
+            ScanContext context;
+            context.cancelled = &cancelled;
+            AnalysisPipeline<LevelStats::Builder> pipeline(LevelStats::Builder(length, 2));
+            expect(!pipeline.run(reader, context));
+        }
+
+        beginTest("Level statistics are exact");
+        {
+            // A 0.25 DC offset under a full-cycle sine of amplitude 0.5, plus three clips.
+            constexpr int n = 44100;
+            juce::AudioBuffer<float> tone(1, n);
+            for (int i = 0; i < n; ++i)
+                tone.setSample(0, i,
+                               0.25f + 0.5f * (float)std::sin(juce::MathConstants<double>::twoPi *
+                                                              10.0 * i / n));
+            tone.setSample(0, 100, 1.0f);
+            tone.setSample(0, 200, -1.0f);
+            tone.setSample(0, 300, 1.0f);
+
+            LevelStats::Builder builder(n, 1);
+            builder.addChunk(tone, 1000);
+            juce::AudioBuffer<float> rest(1, n - 1000);
+            rest.copyFrom(0, 0, tone, 0, 1000, n - 1000);
+            builder.addChunk(rest, n - 1000);
+            const auto stats = builder.finish();
+
+            expectEquals(stats->getNumFrames(), (juce::int64)n);
+            expectEquals(stats->getChannel(0).clipCount, (juce::int64)3);
+            expectEquals(stats->getPeak(0), 1.0f);
+            expectEquals(stats->getChannel(0).minimum, -1.0f);
+            expectWithinAbsoluteError(stats->getDcOffset(0), 0.25f, 1.0e-3f);
+            expectWithinAbsoluteError(stats->getRms(0), std::sqrt(0.0625f + 0.125f), 1.0e-3f);
+
+            juce::MemoryOutputStream output;
+            expect(stats->writeTo(output));
+            juce::MemoryInputStream input(output.getData(), output.getDataSize(), false);
+            const auto restored = LevelStats::readFrom(input);
+            expect(restored != nullptr);
+            if (restored != nullptr)
+                expect(sameBytes(*restored, *stats));
+
+            juce::MemoryInputStream garbage("not a level file", 16, false);
+            expect(LevelStats::readFrom(garbage) == nullptr);
+        }
+
+        beginTest("An empty file reports silence");
+        {
+            const auto stats = LevelStats::Builder(1, 2).finish();
+            expectEquals(stats->getPeak(1), 0.0f);
+            expectEquals(stats->getRms(1), 0.0f);
+            expectEquals(stats->getChannel(1).maximum, 0.0f);
+        }
+    }
+
+  private:
+    /** @brief Reader that counts the samples it serves. */
+    class CountingReader : public BufferMockReader {
+      public:
+        using BufferMockReader::BufferMockReader;
+
+        bool readSamples(int *const *destSamples, int numDestChannels,
+                         int startOffsetInDestBuffer, juce::int64 startSampleInFile,
+                         int numSamples) override {
+            samplesRead += numSamples;
+            return BufferMockReader::readSamples(destSamples, numDestChannels,
+                                                 startOffsetInDestBuffer, startSampleInFile,
+                                                 numSamples);
+        }
+
+        juce::int64 samplesRead = 0;
+    };
+
+    template <typename Summary> static bool sameBytes(const Summary &a, const Summary &b) {
+        juce::MemoryOutputStream first, second;
+        return a.writeTo(first) && b.writeTo(second) &&
+               first.getDataSize() == second.getDataSize() &&
+               std::memcmp(first.getData(), second.getData(), first.getDataSize()) == 0;
+    }
+};
+
+static AnalysisPipelineTest analysisPipelineTest;
@@ -0,0 +1,133 @@
+/**
+ * @file AnalysisProgressTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the live progress counters and the timing history of background jobs.
+ */
+
+#include "Workers/AnalysisProgress.h"
+#include "Workers/ScanContext.h"
+#include <juce_core/juce_core.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @class AnalysisProgressTest
+ * @brief Drives jobs by hand, from one and from many threads, and checks what the UI sees.
+ */
+class AnalysisProgressTest : public juce::UnitTest {
+  public:
+    AnalysisProgressTest() : juce::UnitTest("Analysis Progress Test") {
+    }
+
+    void runTest() override {
+        const juce::File file("/tmp/fixture.wav");
+
+        beginTest("An idle surface reports nothing");
+        {
+            AnalysisProgress progress(4);
+            const auto snapshot = progress.getSnapshot();
+            expectEquals(snapshot.activeJobs, 0);
+            expectEquals(snapshot.getFraction(), 0.0);
+            expect(progress.getHistory().empty());
+        }
+
+        beginTest("Chunks reported through ScanContext advance the running job");
+        {
+            AnalysisProgress progress(4);
+            {
+                AnalysisProgress::Job job(progress, file, "In", 1000, 4.0);
+                ScanContext context;
+                context.progress = &job;
+                context.pace(250);
+                context.pace(250);
+
+                const auto snapshot = progress.getSnapshot();
+                expectEquals(snapshot.activeJobs, 1);
+                expectEquals(snapshot.samplesScanned, (juce::int64)500);
+                expectEquals(snapshot.totalSamples, (juce::int64)1000);
+                expectEquals(snapshot.bytesRead, (juce::int64)2000);
+                expectWithinAbsoluteError(snapshot.getFraction(), 0.5, 1.0e-9);
+            }
+            expectEquals(progress.getSnapshot().activeJobs, 0);
+
+            const auto history = progress.getHistory();
+            expectEquals((int)history.size(), 1);
+            expectEquals(history.front().fileName, juce::String("fixture.wav"));
+            expectEquals(history.front().kind, juce::String("In"));
+            expectEquals(history.front().samples, (juce::int64)500);
+            expectEquals(history.front().bytes, (juce::int64)2000);
+            expect(!history.front().cancelled);
+        }
+
+        beginTest("Re-read chunks never push the fraction past one");
+        {
+            AnalysisProgress progress(4);
+            AnalysisProgress::Job job(progress, file, "Out", 100, 1.0);
+            job.advance(80);
+            job.advance(80);
+            const auto snapshot = progress.getSnapshot();
+            expectEquals(snapshot.samplesScanned, (juce::int64)100);
+            expectEquals(snapshot.bytesRead, (juce::int64)160);
+            expectEquals(snapshot.getFraction(), 1.0);
+        }
+
+        beginTest("Concurrent segment tasks are all counted");
+        {
+            AnalysisProgress progress(4);
+            constexpr int numThreads = 8;
+            constexpr int chunksPerThread = 5000;
+            {
+                AnalysisProgress::Job job(progress, file, "In", (juce::int64)1 << 40, 2.0);
+                std::vector<std::thread> threads;
+                for (int t = 0; t < numThreads; ++t)
+                    threads.emplace_back([&job] {
+                        for (int i = 0; i < chunksPerThread; ++i)
+                            job.advance(64);
+                    });
+                for (auto &thread : threads)
+                    thread.join();
+
+                expectEquals(progress.getSnapshot().samplesScanned,
+                             (juce::int64)numThreads * chunksPerThread * 64);
+            }
+            expectEquals(progress.getHistory().front().bytes,
+                         (juce::int64)numThreads * chunksPerThread * 128);
+        }
+
+        beginTest("Finished jobs leave the live totals");
+        {
+            AnalysisProgress progress(4);
+            AnalysisProgress::Job running(progress, file, "Gaps", 400, 1.0);
+            running.advance(100);
+            {
+                AnalysisProgress::Job finished(progress, file, "In", 600, 1.0);
+                finished.advance(300);
+                expectEquals(progress.getSnapshot().totalSamples, (juce::int64)1000);
+            }
+            const auto snapshot = progress.getSnapshot();
+            expectEquals(snapshot.activeJobs, 1);
+            expectEquals(snapshot.samplesScanned, (juce::int64)100);
+            expectEquals(snapshot.totalSamples, (juce::int64)400);
+        }
+
+        beginTest("The history keeps the newest records, newest first");
+        {
+            AnalysisProgress progress(3);
+            for (int i = 0; i < 5; ++i) {
+                AnalysisProgress::Job job(progress, file, juce::String(i), 10, 1.0);
+                if (i == 4)
+                    job.markCancelled();
+            }
+            const auto history = progress.getHistory();
+            expectEquals((int)history.size(), 3);
+            expectEquals(history[0].kind, juce::String("4"));
+            expectEquals(history[1].kind, juce::String("3"));
+            expectEquals(history[2].kind, juce::String("2"));
+            expect(history[0].cancelled);
+            expect(!history[1].cancelled);
+        }
+    }
+};
+
+static AnalysisProgressTest analysisProgressTest;
@@ -0,0 +1,172 @@
+/**
+ * @file BoundaryHistoryTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that boundary-narrowed re-scans agree with full scans and read less.
+ */
+
+#include "BufferMockReader.h"
+#include "Workers/BoundaryHistory.h"
+#include "Workers/ScanContext.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * @class BoundaryHistoryTest
+ * @brief Replays Threshold sequences through a BoundaryHistory the way the worker does.
+ *
+ * @details The signal swells in from silence and fades out again, so every Threshold has a
+ *          distinct In and Out point. Each answer of the narrowed scan is compared with a
+ *          full scan of the file at the same Threshold.
+ */
+class BoundaryHistoryTest : public juce::UnitTest {
+  public:
+    BoundaryHistoryTest() : juce::UnitTest("Boundary History Test") {
+    }
+
+    void runTest() override {
+        constexpr int length = 2000000;
+        juce::AudioBuffer<float> samples(2, length);
+        juce::Random random(7);
+        for (int i = 0; i < length; ++i) {
+            // Triangle envelope peaking mid-file, with noise so crossings are not monotonic.
+            const float envelope = 1.0f - std::abs((float)i / (float)length * 2.0f - 1.0f);
+            for (int ch = 0; ch < 2; ++ch)
+                samples.setSample(ch, i, envelope * (random.nextFloat() * 2.0f - 1.0f));
+        }
+        CountingReader reader(samples);
+        const ScanContext context;
+        const juce::String key = "0123456789abcdef0123456789abcdef";
+
+        beginTest("Narrowed scans match full scans over random Threshold sequences");
+        {
+            BoundaryHistory history(4, 8);
+            float threshold = 0.3f;
+            for (int step = 0; step < 100; ++step) {
+                // Mostly small nudges either way, with an occasional jump.
+                threshold += step % 17 == 0 ? random.nextFloat() - 0.5f
+                                            : (random.nextFloat() - 0.5f) * 0.02f;
+                threshold = juce::jlimit(0.0f, 1.1f, threshold);
+                for (const bool detectingIn : {true, false}) {
+                    const auto narrowed =
+                        scan(history, reader, key, detectingIn, threshold, context);
+                    const auto full =
+                        detectingIn ? SilenceAnalysisAlgorithms::findFirstAboveInRange(
+                                          reader, 0, length, threshold, context)
+                                    : SilenceAnalysisAlgorithms::findLastAboveInRange(
+                                          reader, 0, length, threshold, context);
+                    expectEquals(narrowed, full,
+                                 (detectingIn ? "In at " : "Out at ") + juce::String(threshold));
+                }
+            }
+        }
+
+        beginTest("A nudged Threshold reads a few chunks around the old boundary");
+        {
+            BoundaryHistory history(4, 8);
+            for (const float known : {0.4f, 0.5f})
+                for (const bool detectingIn : {true, false})
+                    scan(history, reader, key, detectingIn, known, context);
+
+            // Raised past every record, or lowered between two: either way the search
+            // starts at a known boundary and stops at the first crossing it meets.
+            for (const float nudged : {0.52f, 0.48f}) {
+                for (const bool detectingIn : {true, false}) {
+                    reader.samplesRead = 0;
+                    scan(history, reader, key, detectingIn, nudged, context);
+                    expectLessThan(reader.samplesRead,
+                                   (juce::int64)SilenceAnalysisAlgorithms::chunkSize * 3 + 1);
+                }
+            }
+
+            reader.samplesRead = 0;
+            scan(history, reader, key, true, 0.5f, context);
+            scan(history, reader, key, false, 0.5f, context);
+            expectEquals(reader.samplesRead, (juce::int64)0,
+                         "A Threshold between known neighbours is answered without reading");
+        }
+
+        beginTest("Thresholds above every sample are remembered as such");
+        {
+            BoundaryHistory history(4, 8);
+            expectEquals(scan(history, reader, key, true, 1.5f, context), (juce::int64)-1);
+            expectEquals(scan(history, reader, key, false, 1.5f, context), (juce::int64)-1);
+            reader.samplesRead = 0;
+            expectEquals(scan(history, reader, key, true, 2.0f, context), (juce::int64)-1);
+            expectEquals(scan(history, reader, key, false, 2.0f, context), (juce::int64)-1);
+            expectEquals(reader.samplesRead, (juce::int64)0);
+        }
+
+        beginTest("Unknown files, other lengths and evicted files are not narrowed");
+        {
+            BoundaryHistory history(2, 8);
+            expect(!history.narrow(key, length, true, 0.5f).has_value());
+            history.record(key, length, true, 0.5f, 1000);
+            expect(history.narrow(key, length, true, 0.5f).has_value());
+            expect(!history.narrow(key, length + 1, true, 0.5f).has_value());
+            expect(!history.narrow(key, length, false, 0.5f).has_value());
+
+            history.record("second", length, true, 0.5f, 1000);
+            history.record("third", length, true, 0.5f, 1000);
+            expect(!history.narrow(key, length, true, 0.5f).has_value(),
+                   "The least recently used file must be evicted");
+            expect(history.narrow("third", length, true, 0.5f).has_value());
+
+            history.clear();
+            expect(!history.narrow("third", length, true, 0.5f).has_value());
+        }
+
+        beginTest("Contradicting records are declined");
+        {
+            BoundaryHistory history(2, 8);
+            history.record(key, length, true, 0.4f, 5000);
+            history.record(key, length, true, 0.6f, 1000);
+            expect(!history.narrow(key, length, true, 0.5f).has_value());
+        }
+    }
+
+  private:
+    /** @brief Reader that counts the samples it serves. */
+    class CountingReader : public BufferMockReader {
+      public:
+        using BufferMockReader::BufferMockReader;
+
+        bool readSamples(int *const *destSamples, int numDestChannels,
+                         int startOffsetInDestBuffer, juce::int64 startSampleInFile,
+                         int numSamples) override {
+            samplesRead += numSamples;
+            return BufferMockReader::readSamples(destSamples, numDestChannels,
+                                                 startOffsetInDestBuffer, startSampleInFile,
+                                                 numSamples);
+        }
+
+        juce::int64 samplesRead = 0;
+    };
+
+    /**
+     * @brief Mirrors the worker's narrowed Peak path, falling back to a full scan.
+     * @details Out windows are crawled backwards, as the worker does for WAV and AIFF.
+     */
+    static juce::int64 scan(BoundaryHistory &history, juce::AudioFormatReader &reader,
+                            const juce::String &key, bool detectingIn, float threshold,
+                            const ScanContext &context) {
+        const auto length = reader.lengthInSamples;
+        const auto window = history.narrow(key, length, detectingIn, threshold);
+        const juce::int64 start = window ? window->start : 0;
+        const juce::int64 end = window ? window->end : length;
+        juce::int64 found = -1;
+        if (start < end)
+            found = detectingIn ? SilenceAnalysisAlgorithms::findFirstAboveInRange(
+                                      reader, start, end, threshold, context)
+                                : SilenceAnalysisAlgorithms::findLastAboveInRange(
+                                      reader, start, end, threshold, context);
+        if (found == -1 && window)
+            found = window->fallback;
+        history.record(key, length, detectingIn, threshold, found);
+        return found;
+    }
+};
+
+static BoundaryHistoryTest boundaryHistoryTest;
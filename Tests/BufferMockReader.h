@@ -0,0 +1,43 @@
+#ifndef AUDIOFILER_BUFFERMOCKREADER_H
+#define AUDIOFILER_BUFFERMOCKREADER_H
+
+/**
+ * @file BufferMockReader.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Reader over an in-memory buffer for tests that need exact, arbitrary content.
+ */
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+/**
+ * @class BufferMockReader
+ * @brief In-memory reader over a float buffer, used to compare envelope and scan answers.
+ */
+class BufferMockReader : public juce::AudioFormatReader {
+  public:
+    explicit BufferMockReader(const juce::AudioBuffer<float> &source)
+        : juce::AudioFormatReader(nullptr, "BufferMock"), data(source) {
+        lengthInSamples = data.getNumSamples();
+        numChannels = (unsigned int)data.getNumChannels();
+        sampleRate = 44100.0;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        for (int ch = 0; ch < numDestChannels; ++ch)
+            if (destSamples[ch] != nullptr)
+                juce::FloatVectorOperations::copy(
+                    (float *)destSamples[ch] + startOffsetInDestBuffer,
+                    data.getReadPointer(ch, (int)startSampleInFile), numSamples);
+        return true;
+    }
+
+  private:
+    const juce::AudioBuffer<float> &data;
+};
+
+#endif
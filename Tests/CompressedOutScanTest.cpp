@@ -0,0 +1,187 @@
+/**
+ * @file CompressedOutScanTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the forward tail-window Out scan for compressed formats.
+ */
+
+#include "BufferMockReader.h"
+#include "Utils/Config.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * @class CompressedOutScanTest
+ * @brief Cross-checks findLastAbove() against the backward crawl and counts its seeks.
+ *
+ * @details A counting mock stands in for a compressed decoder: its format name is not
+ *          WAV/AIFF, and every read that does not continue where the previous one ended
+ *          counts as a seek (a decoder re-sync). Short FLAC and Ogg Vorbis fixtures
+ *          encoded with the JUCE writers check the same agreement through real decoders.
+ *          The timing of both Out scans lives in the `compressed` suite of `analysis_bench`.
+ */
+class CompressedOutScanTest : public juce::UnitTest {
+  public:
+    CompressedOutScanTest() : juce::UnitTest("Compressed Out Scan Test") {
+    }
+
+    void runTest() override {
+        const ScanContext context;
+        constexpr int length = 6 << 20;
+        juce::AudioBuffer<float> samples(1, length);
+
+        beginTest("Tail windows match the backward crawl");
+        {
+            CountingReader reader(samples);
+            auto random = getRandom();
+            for (int iteration = 0; iteration < 40; ++iteration) {
+                samples.clear();
+                const int numImpulses = random.nextInt(4);
+                for (int i = 0; i < numImpulses; ++i)
+                    samples.setSample(0, random.nextInt(length), random.nextBool() ? 0.5f : 0.2f);
+
+                const float threshold = random.nextBool() ? 0.1f : 0.3f;
+                const juce::int64 start = random.nextBool() ? 0 : random.nextInt(length / 2);
+                const juce::int64 end =
+                    random.nextBool() ? length : start + random.nextInt(length / 2);
+                expectEquals(SilenceAnalysisAlgorithms::findLastAbove(reader, start, end,
+                                                                      threshold, context),
+                             SilenceAnalysisAlgorithms::findLastAboveInRange(reader, start, end,
+                                                                             threshold, context));
+            }
+        }
+
+        beginTest("A short trailing silence is decoded once with one seek");
+        {
+            samples.clear();
+            samples.setSample(0, length - 1000, 0.5f);
+            CountingReader reader(samples);
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(reader, 0.1f),
+                         (juce::int64)length - 1000);
+            expectEquals(reader.seeks, 1);
+            expect(reader.samplesRead <= Config::Audio::compressedTailFirstSamples);
+
+            CountingReader backward(samples);
+            SilenceAnalysisAlgorithms::findLastAboveInRange(backward, 0, length, 0.1f, context);
+            expectEquals(backward.seeks, 1);
+        }
+
+        beginTest("A long trailing silence needs a logarithmic number of seeks");
+        {
+            samples.clear();
+            samples.setSample(0, 10, 0.5f);
+            CountingReader reader(samples);
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(reader, 0.1f), (juce::int64)10);
+            expect(reader.seeks <= 4, "Seeks: " + juce::String(reader.seeks));
+            expectEquals(reader.samplesRead, (juce::int64)length, "Every sample is decoded once");
+
+            CountingReader backward(samples);
+            SilenceAnalysisAlgorithms::findLastAboveInRange(backward, 0, length, 0.1f, context);
+            expectEquals(backward.seeks, length / SilenceAnalysisAlgorithms::chunkSize);
+        }
+
+        beginTest("Cancellation reports aborted");
+        {
+            std::atomic<bool> cancelled{true};
+            ScanContext cancelledContext;
+            cancelledContext.cancelled = &cancelled;
+            CountingReader reader(samples);
+            expectEquals(
+                SilenceAnalysisAlgorithms::findLastAbove(reader, 0, length, 0.1f, cancelledContext),
+                SilenceAnalysisAlgorithms::aborted);
+        }
+
+        beginTest("Tail windows match the backward crawl on real decoders");
+        {
+            juce::AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+            juce::FlacAudioFormat flac;
+            juce::OggVorbisAudioFormat ogg;
+            juce::AudioFormat *const formats[] = {&flac, &ogg};
+            for (auto *format : formats) {
+                juce::TemporaryFile file(format->getFileExtensions()[0]);
+                expect(writeFixture(*format, file.getFile()), format->getFormatName());
+                std::unique_ptr<juce::AudioFormatReader> reader(
+                    formatManager.createReaderFor(file.getFile()));
+                expect(reader != nullptr, format->getFormatName());
+                if (reader == nullptr)
+                    continue;
+                expect(!SilenceAnalysisAlgorithms::seeksCheaply(*reader));
+
+                const auto tail = SilenceAnalysisAlgorithms::findLastAbove(
+                    *reader, 0, reader->lengthInSamples, 0.01f, context);
+                expectEquals(tail, SilenceAnalysisAlgorithms::findLastAboveInRange(
+                                       *reader, 0, reader->lengthInSamples, 0.01f, context),
+                             format->getFormatName());
+                expect(tail > reader->lengthInSamples - 2 * (juce::int64)kFixtureRate &&
+                           tail < reader->lengthInSamples - (juce::int64)kFixtureRate / 2,
+                       "Out lands where the trailing second of silence begins");
+            }
+        }
+    }
+
+  private:
+    /** @brief Mock "compressed" reader that counts non-contiguous reads and decoded samples. */
+    class CountingReader final : public BufferMockReader {
+      public:
+        explicit CountingReader(const juce::AudioBuffer<float> &source)
+            : BufferMockReader(source) {
+        }
+
+        bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                         juce::int64 startSampleInFile, int numSamples) override {
+            if (startSampleInFile != position)
+                ++seeks;
+            position = startSampleInFile + numSamples;
+            samplesRead += numSamples;
+            return BufferMockReader::readSamples(destSamples, numDestChannels,
+                                                 startOffsetInDestBuffer, startSampleInFile,
+                                                 numSamples);
+        }
+
+        int seeks = 0;
+        juce::int64 samplesRead = 0;
+
+      private:
+        juce::int64 position = 0;
+    };
+
+    static constexpr double kFixtureRate = 44100.0;
+
+    /** @brief Three seconds of stereo: one second of lead-in, tone, one of trailing silence. */
+    static bool writeFixture(juce::AudioFormat &format, const juce::File &file) {
+        constexpr double sampleRate = kFixtureRate;
+        constexpr int numFrames = (int)(3 * sampleRate);
+        constexpr int blockSize = 8192;
+
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            format.createWriterFor(stream.get(), sampleRate, 2, 16, {}, 0));
+        if (writer == nullptr)
+            return false;
+        stream.release(); // now owned by the writer
+
+        juce::AudioBuffer<float> block(2, blockSize);
+        for (int pos = 0; pos < numFrames; pos += blockSize) {
+            const int frames = std::min(blockSize, numFrames - pos);
+            for (int i = 0; i < frames; ++i) {
+                const int frame = pos + i;
+                const bool audible =
+                    frame >= (int)sampleRate && frame < numFrames - (int)sampleRate;
+                const float value =
+                    audible ? 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f *
+                                              (float)frame / (float)sampleRate)
+                            : 0.0f;
+                block.setSample(0, i, value);
+                block.setSample(1, i, value);
+            }
+            if (!writer->writeFromAudioSampleBuffer(block, 0, frames))
+                return false;
+        }
+        return true;
+    }
+};
+
+static CompressedOutScanTest compressedOutScanTest;
@@ -0,0 +1,117 @@
+/**
+ * @file CutPointCurvesTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that curve-resolved cut points equal full scans for every Threshold.
+ */
+
+#include "BufferMockReader.h"
+#include "Utils/Config.h"
+#include "Workers/CutPointCurves.h"
+#include "Workers/EnvelopeStore.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * @class CutPointCurvesTest
+ * @brief Cross-checks CutPointCurves against SilenceAnalysisAlgorithms and covers persistence.
+ *
+ * @details Sources are streamed into the builder in the same chunk size the worker uses,
+ *          so records that straddle chunk boundaries and the suffix-stack merge are both
+ *          exercised. The ramp source produces more records than the breakpoint budget
+ *          allows, which checks that a capped curve never answers wrongly.
+ */
+class CutPointCurvesTest : public juce::UnitTest {
+  public:
+    CutPointCurvesTest() : juce::UnitTest("Cut Point Curves Test") {
+    }
+
+    void runTest() override {
+        auto random = getRandom();
+
+        beginTest("Curves equal full scans");
+        juce::AudioBuffer<float> noise(2, 700001);
+        for (int ch = 0; ch < noise.getNumChannels(); ++ch)
+            for (int i = 0; i < noise.getNumSamples(); ++i) {
+                const float envelope = std::sin(juce::MathConstants<float>::pi * (float)i /
+                                                (float)noise.getNumSamples());
+                noise.setSample(ch, i, envelope * (random.nextFloat() * 2.0f - 1.0f));
+            }
+        noise.setSample(1, 300000, 1.5f); // float data may exceed full scale
+
+        BufferMockReader noiseReader(noise);
+        const auto curves = buildCurves(noiseReader);
+        for (int i = 0; i <= 100; ++i)
+            expectCutsMatch(*curves, noiseReader, (float)i / 100.0f, true);
+        for (const float threshold : {0.0001f, 0.25f, 0.999999f, 1.2f, 2.0f})
+            expectCutsMatch(*curves, noiseReader, threshold, true);
+
+        beginTest("Capped curves answer exactly or not at all");
+        juce::AudioBuffer<float> ramps(1, 3 * Config::Audio::cutCurveMaxBreakpoints);
+        const int rampLength = ramps.getNumSamples() / 2;
+        for (int i = 0; i < ramps.getNumSamples(); ++i) {
+            const int distance = i < rampLength ? i : ramps.getNumSamples() - 1 - i;
+            ramps.setSample(0, i, (float)(distance + 1) / (float)rampLength);
+        }
+
+        BufferMockReader rampReader(ramps);
+        const auto capped = buildCurves(rampReader);
+        for (int i = 0; i <= 64; ++i)
+            expectCutsMatch(*capped, rampReader, (float)i / 64.0f, false);
+        expect(capped->findIn(0.1f).has_value(), "Low In thresholds stay answerable");
+        expect(!capped->findIn(0.9f).has_value(), "High In thresholds exceed the budget");
+        expect(capped->findOut(0.9f).has_value(), "High Out thresholds stay answerable");
+        expect(!capped->findOut(0.1f).has_value(), "Low Out thresholds exceed the budget");
+
+        beginTest("Serialization and store round trip");
+        juce::MemoryOutputStream output;
+        expect(curves->writeTo(output));
+        juce::MemoryInputStream input(output.getData(), output.getDataSize(), false);
+        const auto restored = CutPointCurves::readFrom(input);
+        expect(restored != nullptr);
+        if (restored != nullptr)
+            expectCutsMatch(*restored, noiseReader, 0.3f, true);
+
+        juce::MemoryInputStream truncated(output.getData(), output.getDataSize() / 2, false);
+        expect(CutPointCurves::readFrom(truncated) == nullptr, "Truncated data must be rejected");
+
+        const auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                             .getNonexistentChildFile("curves", "");
+        EnvelopeStore(dir, (juce::int64)1 << 30).store("abcd", nullptr, curves);
+        const auto loaded = EnvelopeStore(dir, (juce::int64)1 << 30).findCurves("abcd");
+        expect(loaded != nullptr);
+        if (loaded != nullptr)
+            expectCutsMatch(*loaded, noiseReader, 0.5f, true);
+        dir.deleteRecursively();
+    }
+
+  private:
+    static std::shared_ptr<const CutPointCurves> buildCurves(juce::AudioFormatReader &reader) {
+        CutPointCurves::Builder builder(reader.lengthInSamples, reader.sampleRate);
+        juce::AudioBuffer<float> buffer((int)reader.numChannels,
+                                        SilenceAnalysisAlgorithms::chunkSize);
+        for (juce::int64 pos = 0; pos < reader.lengthInSamples;) {
+            const int numThisTime = (int)std::min((juce::int64)buffer.getNumSamples(),
+                                                  reader.lengthInSamples - pos);
+            reader.read(&buffer, 0, numThisTime, pos, true, true);
+            builder.addChunk(buffer, numThisTime);
+            pos += numThisTime;
+        }
+        return builder.finish();
+    }
+
+    void expectCutsMatch(const CutPointCurves &curves, juce::AudioFormatReader &reader,
+                         float threshold, bool mustAnswer) {
+        const auto in = curves.findIn(threshold);
+        const auto out = curves.findOut(threshold);
+        expect(!mustAnswer || (in.has_value() && out.has_value()));
+        if (in.has_value())
+            expectEquals(*in, SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold));
+        if (out.has_value())
+            expectEquals(*out, SilenceAnalysisAlgorithms::findSilenceOut(reader, threshold));
+    }
+};
+
+static CutPointCurvesTest cutPointCurvesTest;
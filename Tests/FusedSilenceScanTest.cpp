@@ -0,0 +1,116 @@
+/**
+ * @file FusedSilenceScanTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that the fused In+Out pass agrees with the directional scans.
+ */
+
+#include "BufferMockReader.h"
+#include "TestAudioFiles.h"
+#include "Workers/AnalysisJobQueue.h"
+#include "Workers/FusedSilenceScan.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+/**
+ * @class FusedSilenceScanTest
+ * @brief Exercises both strategies of FusedSilenceScan and the queue's companion pairing.
+ *
+ * @details The WAV fixture takes the alternating front/back strategy, the mock reader
+ *          (non-seekable format name) the head-and-tail strategy. Impulses sit in different
+ *          chunks so the sides must walk several chunks before meeting their boundaries.
+ */
+class FusedSilenceScanTest : public juce::UnitTest {
+  public:
+    FusedSilenceScanTest() : juce::UnitTest("Fused Silence Scan Test") {
+    }
+
+    void runTest() override {
+        const ScanContext context;
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        juce::TemporaryFile tempFile(".wav");
+        TestAudioFiles::Spec spec;
+        spec.numFrames = 1 << 20;
+        spec.impulses = {{200000, 0.3f}, {500000, 0.8f}, {900000, -0.3f}};
+        expect(TestAudioFiles::writeWav(tempFile.getFile(), spec));
+        std::unique_ptr<juce::AudioFormatReader> wav(
+            formatManager.createReaderFor(tempFile.getFile()));
+        expect(wav != nullptr);
+        if (wav == nullptr)
+            return;
+
+        juce::AudioBuffer<float> samples(2, 1 << 20);
+        samples.clear();
+        for (const auto &impulse : spec.impulses)
+            for (int ch = 0; ch < samples.getNumChannels(); ++ch)
+                samples.setSample(ch, (int)impulse.first, impulse.second);
+        BufferMockReader mock(samples);
+
+        for (auto *reader : {wav.get(), (juce::AudioFormatReader *)&mock}) {
+            const juce::String kind = reader == wav.get() ? "seekable" : "forward-only";
+
+            beginTest("Equal Thresholds match the directional scans (" + kind + ")");
+            expectMatches(*reader, 0.1f, 0.1f, context);
+
+            beginTest("Different Thresholds match the directional scans (" + kind + ")");
+            expectMatches(*reader, 0.5f, 0.1f, context);
+            expectMatches(*reader, 0.1f, 0.5f, context);
+
+            beginTest("Silence reports no boundaries (" + kind + ")");
+            const auto none = FusedSilenceScan::findBoundaries(*reader, 0.9f, 0.9f, context, context);
+            expectEquals(none.in, (juce::int64)-1);
+            expectEquals(none.out, (juce::int64)-1);
+
+            beginTest("Cancelling one side leaves the other intact (" + kind + ")");
+            std::atomic<bool> cancelled{true};
+            ScanContext cancelledContext;
+            cancelledContext.cancelled = &cancelled;
+            auto outOnly = FusedSilenceScan::findBoundaries(*reader, 0.1f, 0.1f, cancelledContext,
+                                                            context);
+            expectEquals(outOnly.in, SilenceAnalysisAlgorithms::aborted);
+            expectEquals(outOnly.out, (juce::int64)900000);
+            auto inOnly = FusedSilenceScan::findBoundaries(*reader, 0.1f, 0.1f, context,
+                                                           cancelledContext);
+            expectEquals(inOnly.in, (juce::int64)200000);
+            expectEquals(inOnly.out, SilenceAnalysisAlgorithms::aborted);
+        }
+
+        beginTest("The queue pairs In and Out of the same file");
+        {
+            AnalysisJobQueue queue(8);
+            queue.push({"a.wav", true, 0.1f});
+            queue.push({"b.wav", true, 0.1f});
+            queue.push({"a.wav", false, 0.2f});
+
+            const auto first = queue.pop();
+            const auto companion = queue.popCompanion(*first);
+            expect(companion.has_value());
+            expect(!companion->request.detectingIn);
+            expectEquals(companion->request.threshold, 0.2f);
+            expect(queue.isCurrent(*companion));
+            expectEquals(queue.getNumPending(), 1);
+
+            const auto lone = queue.pop();
+            expect(!queue.popCompanion(*lone).has_value());
+
+            queue.finish(*first);
+            queue.finish(*companion);
+            queue.finish(*lone);
+            expect(queue.isIdle());
+        }
+    }
+
+  private:
+    void expectMatches(juce::AudioFormatReader &reader, float thresholdIn, float thresholdOut,
+                       const ScanContext &context) {
+        const auto fused =
+            FusedSilenceScan::findBoundaries(reader, thresholdIn, thresholdOut, context, context);
+        expectEquals(fused.in, SilenceAnalysisAlgorithms::findSilenceIn(reader, thresholdIn));
+        expectEquals(fused.out, SilenceAnalysisAlgorithms::findSilenceOut(reader, thresholdOut));
+    }
+};
+
+static FusedSilenceScanTest fusedSilenceScanTest;
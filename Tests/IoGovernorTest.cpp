@@ -0,0 +1,83 @@
+/**
+ * @file IoGovernorTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that background I/O is throttled only while playback is at risk.
+ */
+
+#include "Core/PlaybackHealth.h"
+#include "Utils/Config.h"
+#include "Workers/IoGovernor.h"
+#include <juce_core/juce_core.h>
+
+/**
+ * @class IoGovernorTest
+ * @brief Drives PlaybackHealth by hand and checks the governor's levels and accounting.
+ */
+class IoGovernorTest : public juce::UnitTest {
+  public:
+    IoGovernorTest() : juce::UnitTest("IO Governor Test") {
+    }
+
+    void runTest() override {
+        using Level = IoGovernor::Level;
+
+        beginTest("Stopped playback never throttles");
+        expect(IoGovernor::chooseLevel(false, 0.99f, 0.0f) == Level::Unthrottled);
+
+        beginTest("Healthy playback runs flat out");
+        expect(IoGovernor::chooseLevel(true, 0.1f, 1.0f) == Level::Unthrottled);
+        expectEquals(IoGovernor::getYieldMs(Level::Unthrottled), 0);
+
+        beginTest("The worse gauge picks the level");
+        expect(IoGovernor::chooseLevel(true, Config::Audio::ioGovernorLightLoad, 1.0f) ==
+               Level::Light);
+        expect(IoGovernor::chooseLevel(true, 0.1f, Config::Audio::ioGovernorModerateFill - 0.01f) ==
+               Level::Moderate);
+        expect(IoGovernor::chooseLevel(true, Config::Audio::ioGovernorModerateLoad, 1.0f) ==
+               Level::Moderate);
+        expect(IoGovernor::chooseLevel(true, 0.1f, Config::Audio::ioGovernorHeavyFill - 0.01f) ==
+               Level::Heavy);
+        expect(IoGovernor::getYieldMs(Level::Heavy) > IoGovernor::getYieldMs(Level::Light));
+
+        beginTest("Without playback gauges every chunk is admitted immediately");
+        {
+            IoGovernor governor(nullptr);
+            expectEquals(governor.admit(1000), 0);
+            expectEquals(governor.admit(24), 0);
+            expectEquals(governor.getSamplesProcessed(), (juce::int64)1024);
+        }
+
+        beginTest("A draining read-ahead buffer throttles analysis");
+        {
+            PlaybackHealth health;
+            IoGovernor governor(&health);
+            health.prepare(48000.0, Config::Audio::readAheadBufferSize);
+
+            health.recordReadAhead(10000 + Config::Audio::readAheadBufferSize);
+            health.recordCallback(juce::Time::getHighResolutionTicks(), 512, true, 10000, 1 << 24);
+            expectEquals(governor.admit(512), 0);
+            expect(governor.getLevel() == Level::Unthrottled);
+
+            health.recordCallback(juce::Time::getHighResolutionTicks(), 512, true,
+                                  10000 + Config::Audio::readAheadBufferSize - 100, 1 << 24);
+            expectEquals(governor.admit(512), Config::Audio::ioGovernorHeavyYieldMs);
+            expect(governor.getLevel() == Level::Heavy);
+
+            health.recordCallback(juce::Time::getHighResolutionTicks(), 512, false,
+                                  10000 + Config::Audio::readAheadBufferSize - 100, 1 << 24);
+            expectEquals(governor.admit(512), 0, "Stopping playback lifts the throttle");
+        }
+
+        beginTest("A buffered file end counts as a full buffer");
+        {
+            PlaybackHealth health;
+            health.prepare(48000.0, Config::Audio::readAheadBufferSize);
+            health.recordReadAhead(50000);
+            health.recordCallback(juce::Time::getHighResolutionTicks(), 512, true, 49900, 50000);
+            expectEquals(health.getReadAheadFill(), 1.0f);
+        }
+    }
+};
+
+static IoGovernorTest ioGovernorTest;
@@ -0,0 +1,71 @@
+#ifndef AUDIOFILER_LARGEFILEMOCKREADER_H
+#define AUDIOFILER_LARGEFILEMOCKREADER_H
+
+/**
+ * @file LargeFileMockReader.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Synthetic reader that simulates multi-billion-sample files without disk I/O.
+ */
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+/**
+ * @class LargeFileMockReader
+ * @brief Mock reader that is silent everywhere except for one full-scale sample.
+ *
+ * @details Shared by the silence-analysis correctness tests and the peak-scan
+ *          benchmarks. Every read produces silence, apart from a single 1.0f impulse
+ *          at `signalPosition` on every channel, so a scan's result is known in advance
+ *          and its cost is dominated by the analysis loop rather than by decoding.
+ */
+class LargeFileMockReader : public juce::AudioFormatReader {
+  public:
+    /** @brief The default impulse location, deliberately beyond INT_MAX. */
+    static constexpr juce::int64 defaultSignalPosition = 2500000000;
+
+    /**
+     * @brief Constructs the mock.
+     * @param length Simulated file length in samples.
+     * @param channels Simulated channel count.
+     * @param rate Simulated sample rate.
+     * @param signalPos Absolute sample index of the impulse.
+     */
+    LargeFileMockReader(juce::int64 length, int channels, double rate,
+                        juce::int64 signalPos = defaultSignalPosition)
+        : juce::AudioFormatReader(nullptr, "MockReader"), signalPosition(signalPos) {
+        lengthInSamples = length;
+        numChannels = (unsigned int)channels;
+        sampleRate = rate;
+        bitsPerSample = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int *const *destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override {
+        // Simulate silence everywhere except at specific points
+        for (int ch = 0; ch < numDestChannels; ++ch) {
+            if (destSamples[ch] != nullptr) {
+                // Fill with silence
+                juce::FloatVectorOperations::clear(
+                    (float *)destSamples[ch] + startOffsetInDestBuffer, numSamples);
+
+                // For a chunk, check if signalPosition falls within [startSampleInFile,
+                // startSampleInFile + numSamples)
+                if (signalPosition >= startSampleInFile &&
+                    signalPosition < startSampleInFile + numSamples) {
+                    int offset = (int)(signalPosition - startSampleInFile);
+                    float *buffer = (float *)destSamples[ch] + startOffsetInDestBuffer;
+                    buffer[offset] = 1.0f; // Full volume signal
+                }
+            }
+        }
+        return true;
+    }
+
+  private:
+    const juce::int64 signalPosition;
+};
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @file MappedPcmReaderTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the WAV/AIFF header probe and the exact sample conversion of the mapped path.
+ */
+
+#include "Workers/MappedPcmReader.h"
+#include <juce_core/juce_core.h>
+
+#include <string>
+
+/**
+ * @class MappedPcmReaderTest
+ * @brief Probes hand-built headers and converts hand-built frames.
+ */
+class MappedPcmReaderTest : public juce::UnitTest {
+  public:
+    MappedPcmReaderTest() : juce::UnitTest("Mapped PCM Reader Test") {
+    }
+
+    void runTest() override {
+        using Encoding = MappedPcmReader::Encoding;
+
+        beginTest("WAV data is located behind unrelated chunks");
+        {
+            std::string wav = "RIFF????WAVE";
+            wav += "JUNK" + le(3, 4) + "abc" + std::string(1, '\0'); // odd size is padded
+            wav += fmtChunk(1, 2, 24);
+            wav += "data" + le(600, 4);
+            const auto layout = probe(wav);
+            expect(layout.has_value());
+            if (layout.has_value()) {
+                expect(layout->encoding == Encoding::Int24);
+                expectEquals(layout->numChannels, 2);
+                expectEquals(layout->dataOffset, (juce::int64)wav.size());
+                expectEquals(layout->dataBytes, (juce::int64)600);
+                expectEquals(layout->getBytesPerFrame(), 6);
+                expect(!layout->bigEndian);
+            }
+        }
+
+        beginTest("Extensible float WAV and RF64 sizes are honoured");
+        {
+            std::string wav = "RIFF????WAVE" + fmtChunk(0xfffe, 1, 32, 3);
+            wav += "data" + le(400, 4);
+            const auto layout = probe(wav);
+            expect(layout.has_value() && layout->encoding == Encoding::Float32);
+
+            std::string rf64 = "RF64????WAVE";
+            rf64 += "ds64" + le(28, 4) + le(0, 8) + le(5000000000LL, 8) + le(0, 8) + le(0, 4);
+            rf64 += fmtChunk(1, 2, 16) + "data" + le(0xffffffffLL, 4);
+            const auto big = probe(rf64);
+            expect(big.has_value() && big->dataBytes == 5000000000LL);
+        }
+
+        beginTest("AIFF and little-endian AIFC are located");
+        {
+            std::string aiff = "FORM????AIFF" + commChunk(1, 16, "");
+            aiff += "SSND" + be(8 + 100 + 4, 4) + be(4, 4) + be(0, 4) + "pad!";
+            const auto layout = probe(aiff);
+            expect(layout.has_value());
+            if (layout.has_value()) {
+                expect(layout->bigEndian);
+                expectEquals(layout->dataOffset, (juce::int64)aiff.size());
+                expectEquals(layout->dataBytes, (juce::int64)100);
+            }
+
+            const auto sowt = probe("FORM????AIFC" + commChunk(2, 16, "sowt") + "SSND" +
+                                    be(8, 4) + be(0, 4) + be(0, 4));
+            expect(sowt.has_value() && !sowt->bigEndian);
+        }
+
+        beginTest("Compressed and unusual formats fall back to the decoder");
+        expect(!probe("ID3\x04" + std::string(40, '\0')).has_value());
+        expect(!probe("RIFF????WAVE" + fmtChunk(1, 1, 8) + "data" + le(8, 4)).has_value());
+        expect(!probe("RIFF????WAVE" + fmtChunk(0x55, 2, 16) + "data" + le(8, 4)).has_value());
+        expect(!probe("FORM????AIFC" + commChunk(1, 16, "ima4") + "SSND" + be(8, 4) +
+                      be(0, 4) + be(0, 4))
+                    .has_value());
+        expect(!probe("RIFF????WAVE" + fmtChunk(1, 2, 16)).has_value()); // no data chunk
+
+        beginTest("Conversion matches the decoders exactly");
+        {
+            MappedPcmReader::Layout layout;
+            layout.numChannels = 2;
+            layout.encoding = Encoding::Int16;
+            const std::string frames = le(16384, 2) + le(-32768, 2) + le(1, 2) + le(-1, 2);
+            float left[3] = {9.0f, 9.0f, 9.0f};
+            float right[3] = {9.0f, 9.0f, 9.0f};
+            float extra[3] = {9.0f, 9.0f, 9.0f};
+            float *dest[] = {left, right, extra};
+            MappedPcmReader::convertFrames(layout, frames.data(), 2, dest, 3, 1);
+            expectEquals(left[0], 9.0f);
+            expectEquals(left[1], 0.5f);
+            expectEquals(right[1], -1.0f);
+            expectEquals(left[2], 1.0f / 32768.0f);
+            expectEquals(right[2], -1.0f / 32768.0f);
+            expectEquals(extra[1], 0.0f);
+
+            layout.numChannels = 1;
+            layout.encoding = Encoding::Int24;
+            layout.bigEndian = true;
+            const std::string big24 = be(-4194304, 3) + be(8388607, 3);
+            float mono[2] = {};
+            float *monoDest[] = {mono};
+            MappedPcmReader::convertFrames(layout, big24.data(), 2, monoDest, 1, 0);
+            expectEquals(mono[0], -0.5f);
+            expectEquals(mono[1], 8388607.0f / 8388608.0f);
+        }
+    }
+
+  private:
+    static std::optional<MappedPcmReader::Layout> probe(const std::string &header) {
+        return MappedPcmReader::parseLayout(header.data(), header.size());
+    }
+
+    static std::string le(long long value, int numBytes) {
+        std::string bytes;
+        for (int i = 0; i < numBytes; ++i)
+            bytes.push_back((char)((unsigned long long)value >> (8 * i)));
+        return bytes;
+    }
+
+    static std::string be(long long value, int numBytes) {
+        std::string bytes;
+        for (int i = numBytes - 1; i >= 0; --i)
+            bytes.push_back((char)((unsigned long long)value >> (8 * i)));
+        return bytes;
+    }
+
+    static std::string fmtChunk(int formatTag, int channels, int bits, int subFormat = 0) {
+        const int blockAlign = channels * bits / 8;
+        std::string body = le(formatTag, 2) + le(channels, 2) + le(48000, 4) +
+                           le(48000 * blockAlign, 4) + le(blockAlign, 2) + le(bits, 2);
+        if (subFormat != 0)
+            body += le(22, 2) + le(bits, 2) + le(0, 4) + le(subFormat, 2) + std::string(14, '\0');
+        return "fmt " + le((long long)body.size(), 4) + body;
+    }
+
+    static std::string commChunk(int channels, int bits, const std::string &compression) {
+        std::string body = be(channels, 2) + be(1000, 4) + be(bits, 2) + std::string(10, '\0');
+        body += compression;
+        return "COMM" + be((long long)body.size(), 4) + body;
+    }
+};
+
+static MappedPcmReaderTest mappedPcmReaderTest;
@@ -0,0 +1,183 @@
+/**
+ * @file MipmapHandoffTest.cpp
+ * @ingroup Tests
+ * @brief Verifies that a waveform build is handed to exactly one decoder per file.
+ */
+
+#include "BufferMockReader.h"
+#include "Workers/AnalysisPipeline.h"
+#include "Workers/MipmapHandoff.h"
+#include "Workers/PeakMipmap.h"
+#include "Workers/ScanContext.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @class MipmapHandoffTest
+ * @brief Drives a handoff the way WaveformManager and a file-open pass do, without threads
+ *        except where a Feed has to wait.
+ */
+class MipmapHandoffTest : public juce::UnitTest {
+  public:
+    MipmapHandoffTest() : juce::UnitTest("Mipmap Handoff Test") {
+    }
+
+    void runTest() override {
+        constexpr int length = 200003;
+        juce::AudioBuffer<float> samples(2, length);
+        auto random = getRandom();
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < length; ++i)
+                samples.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        PeakMipmap reference;
+        reference.reset(length, 2, kSampleRate);
+        {
+            BufferMockReader reader(samples);
+            AnalysisPipeline<PeakMipmap::Builder> pipeline{PeakMipmap::Builder(reference)};
+            pipeline.run(reader, ScanContext());
+            pipeline.get<PeakMipmap::Builder>().finish();
+        }
+
+        PeakMipmap mipmap;
+        int chunks = 0;
+        std::vector<std::pair<juce::uint32, bool>> ends;
+        MipmapHandoff handoff(
+            mipmap, [&chunks]() { ++chunks; },
+            [&ends](juce::uint32 generation, bool complete) {
+                ends.emplace_back(generation, complete);
+            });
+        IdleJob job;
+
+        beginTest("A Feed builds the mipmap after a cache miss");
+        {
+            const auto generation = handoff.beginFile();
+            auto feed = handoff.claimFeed();
+            mipmap.reset(length, 2, kSampleRate);
+            handoff.publishLookup(generation, false);
+            expect(feed.waitForLookup(job));
+            expect(!handoff.claimDecode(generation));
+
+            BufferMockReader reader(samples);
+            AnalysisPipeline<MipmapHandoff::Feed> pipeline(std::move(feed));
+            expect(pipeline.run(reader, ScanContext()));
+            pipeline.get<MipmapHandoff::Feed>().finish();
+
+            expect(mipmap.isFullyLoaded());
+            expectGreaterThan(chunks, 1);
+            expectEquals((int)ends.size(), 1);
+            expect(ends.back() == std::make_pair(generation, true));
+            for (int q = 0; q < 100; ++q) {
+                const int start = random.nextInt(length);
+                const int end = start + 1 + random.nextInt(length - start);
+                const auto a = mipmap.getColumn(1, start, end);
+                const auto b = reference.getColumn(1, start, end);
+                expectEquals(a.minimum, b.minimum);
+                expectEquals(a.maximum, b.maximum);
+                expectEquals(a.rms, b.rms);
+            }
+        }
+
+        beginTest("A cache hit leaves the Feed inert");
+        {
+            ends.clear();
+            chunks = 0;
+            const auto generation = handoff.beginFile();
+            {
+                auto feed = handoff.claimFeed();
+                mipmap.reset(length, 2, kSampleRate);
+                handoff.publishLookup(generation, true);
+                expect(!feed.waitForLookup(job));
+                feed.addChunk(samples, SilenceAnalysisAlgorithms::chunkSize);
+                feed.finish();
+            }
+            expect(!handoff.claimFeed().waitForLookup(job));
+            expectEquals(mipmap.getNumSamplesFinished(), (juce::int64)0);
+            expectEquals(chunks, 0);
+            expect(ends.empty());
+        }
+
+        beginTest("Each generation has one decoder");
+        {
+            const auto first = handoff.beginFile();
+            expect(handoff.claimDecode(first));
+            expect(!handoff.claimDecode(first));
+            mipmap.reset(length, 2, kSampleRate);
+            handoff.publishLookup(first, false);
+            expect(!handoff.claimFeed().waitForLookup(job));
+
+            const auto second = handoff.beginFile();
+            expect(!handoff.isCurrent(first));
+            expect(!handoff.claimDecode(first));
+            auto feed = handoff.claimFeed();
+            expect(!handoff.claimDecode(second));
+            handoff.publishLookup(second, true);
+            expect(!feed.waitForLookup(job));
+            expect(ends.empty());
+        }
+
+        beginTest("A superseded Feed wakes and stops writing");
+        {
+            handoff.beginFile();
+            auto waiting = handoff.claimFeed();
+            bool builds = true;
+            std::thread waiter([&]() { builds = waiting.waitForLookup(job); });
+            handoff.beginFile();
+            waiter.join();
+            expect(!builds);
+
+            const auto generation = handoff.beginFile();
+            auto feed = handoff.claimFeed();
+            mipmap.reset(length, 2, kSampleRate);
+            handoff.publishLookup(generation, false);
+            expect(feed.waitForLookup(job));
+            feed.addChunk(samples, SilenceAnalysisAlgorithms::chunkSize);
+            const auto written = mipmap.getNumSamplesFinished();
+            expectGreaterThan(written, (juce::int64)0);
+
+            handoff.beginFile();
+            feed.addChunk(samples, SilenceAnalysisAlgorithms::chunkSize);
+            feed.finish();
+            expectEquals(mipmap.getNumSamplesFinished(), written);
+            expect(ends.empty());
+        }
+
+        beginTest("An unfinished Feed hands the build back");
+        {
+            const auto unused = handoff.beginFile();
+            { auto feed = handoff.claimFeed(); }
+            expectEquals((int)ends.size(), 1);
+            expect(ends.back() == std::make_pair(unused, false));
+
+            const auto partial = handoff.beginFile();
+            {
+                auto feed = handoff.claimFeed();
+                mipmap.reset(length, 2, kSampleRate);
+                handoff.publishLookup(partial, false);
+                expect(feed.waitForLookup(job));
+                feed.addChunk(samples, SilenceAnalysisAlgorithms::chunkSize);
+                auto moved = std::move(feed);
+                expectEquals((int)ends.size(), 1);
+            }
+            expectEquals((int)ends.size(), 2);
+            expect(ends.back() == std::make_pair(partial, false));
+        }
+    }
+
+  private:
+    static constexpr double kSampleRate = 44100.0;
+
+    /** @brief Stands in for the pass's job; it is never asked to exit. */
+    class IdleJob final : public juce::ThreadPoolJob {
+      public:
+        IdleJob() : juce::ThreadPoolJob("Idle") {
+        }
+        JobStatus runJob() override {
+            return jobHasFinished;
+        }
+    };
+};
+
+static MipmapHandoffTest mipmapHandoffTest;
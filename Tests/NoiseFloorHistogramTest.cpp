@@ -0,0 +1,115 @@
+/**
+ * @file NoiseFloorHistogramTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the level histogram and the Auto Threshold it suggests.
+ */
+
+#include "Utils/Config.h"
+#include "Workers/NoiseFloorHistogram.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * @class NoiseFloorHistogramTest
+ * @brief Feeds synthetic material with a known noise floor and checks the suggestion.
+ *
+ * @details The source is two seconds of hiss at about -60 dBFS, then six seconds of a
+ *          -12 dBFS tone, then two seconds of hiss again, which is the shape of a typical
+ *          recording with a quiet lead-in and tail.
+ */
+class NoiseFloorHistogramTest : public juce::UnitTest {
+  public:
+    NoiseFloorHistogramTest() : juce::UnitTest("Noise Floor Histogram Test") {
+    }
+
+    void runTest() override {
+        constexpr double sampleRate = 44100.0;
+        constexpr float hiss = 0.001f;
+        constexpr float tone = 0.25f;
+        auto random = getRandom();
+
+        juce::AudioBuffer<float> source(2, (int)(sampleRate * 10.0));
+        for (int i = 0; i < source.getNumSamples(); ++i) {
+            const bool loud = i >= (int)(sampleRate * 2.0) && i < (int)(sampleRate * 8.0);
+            for (int ch = 0; ch < source.getNumChannels(); ++ch) {
+                const float noise = hiss * (random.nextFloat() * 2.0f - 1.0f);
+                const float signal = loud ? tone * std::sin(0.05f * (float)i) : 0.0f;
+                source.setSample(ch, i, signal + noise);
+            }
+        }
+
+        beginTest("The suggestion sits between the hiss and the material");
+        const auto histogram = build(source, sampleRate, SilenceAnalysisAlgorithms::chunkSize);
+        expect(histogram != nullptr);
+        if (histogram == nullptr)
+            return;
+        const auto suggested = histogram->suggestThreshold();
+        expect(suggested.has_value());
+        if (suggested.has_value()) {
+            expect(*suggested > hiss, "The Threshold must clear the hiss peaks");
+            expect(*suggested < hiss * 4.0f, "The Threshold must stay near the noise floor");
+        }
+        expectEquals(histogram->getNumBlocks(), (juce::int64)1000);
+        expectEquals(histogram->getLengthInSamples(), (juce::int64)source.getNumSamples());
+
+        beginTest("Percentiles follow the level distribution");
+        const auto quiet = histogram->getPercentileLevel(0.3);
+        const auto loud = histogram->getPercentileLevel(0.5);
+        expect(quiet.has_value() && *quiet < hiss * 1.1f);
+        expect(loud.has_value() && *loud > tone * 0.9f && *loud < tone * 1.1f);
+
+        beginTest("Chunking does not change the histogram");
+        const auto oddChunks = build(source, sampleRate, 1237);
+        expect(oddChunks != nullptr && oddChunks->suggestThreshold() == suggested);
+        expect(oddChunks != nullptr &&
+               oddChunks->getPercentileLevel(0.5) == histogram->getPercentileLevel(0.5));
+
+        beginTest("Digital silence and empty input");
+        juce::AudioBuffer<float> silence(1, 4410);
+        silence.clear();
+        const auto silent = build(silence, sampleRate, 1000);
+        expect(silent != nullptr && silent->suggestThreshold().has_value());
+        if (silent != nullptr)
+            expect(*silent->suggestThreshold() <
+                   juce::Decibels::decibelsToGain(Config::Audio::noiseFloorMinDb + 12.0f));
+
+        NoiseFloorHistogram::Builder emptyBuilder(0, sampleRate);
+        const auto empty = emptyBuilder.finish();
+        expect(empty != nullptr && !empty->suggestThreshold().has_value());
+
+        beginTest("Serialization round trip");
+        juce::MemoryOutputStream output;
+        expect(histogram->writeTo(output));
+        juce::MemoryInputStream input(output.getData(), output.getDataSize(), false);
+        const auto restored = NoiseFloorHistogram::readFrom(input);
+        expect(restored != nullptr);
+        if (restored != nullptr) {
+            expectEquals(restored->getNumBlocks(), histogram->getNumBlocks());
+            expect(restored->suggestThreshold() == suggested);
+        }
+
+        juce::MemoryInputStream truncated(output.getData(), output.getDataSize() / 2, false);
+        expect(NoiseFloorHistogram::readFrom(truncated) == nullptr,
+               "Truncated data must be rejected");
+    }
+
+  private:
+    static std::unique_ptr<NoiseFloorHistogram> build(const juce::AudioBuffer<float> &source,
+                                                      double sampleRate, int chunkSize) {
+        NoiseFloorHistogram::Builder builder(source.getNumSamples(), sampleRate);
+        juce::AudioBuffer<float> chunk(source.getNumChannels(), chunkSize);
+        for (int pos = 0; pos < source.getNumSamples();) {
+            const int numThisTime = std::min(chunkSize, source.getNumSamples() - pos);
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                chunk.copyFrom(ch, 0, source, ch, pos, numThisTime);
+            builder.addChunk(chunk, numThisTime);
+            pos += numThisTime;
+        }
+        return builder.finish();
+    }
+};
+
+static NoiseFloorHistogramTest noiseFloorHistogramTest;
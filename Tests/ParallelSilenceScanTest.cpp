@@ -0,0 +1,158 @@
+/**
+ * @file ParallelSilenceScanTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that the segmented multi-threaded scan agrees with the sequential scan.
+ */
+
+#include "LargeFileMockReader.h"
+#include "TestAudioFiles.h"
+#include "Workers/ParallelSilenceScan.h"
+#include "Workers/ReaderPool.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ParallelSilenceScanTest
+ * @brief Exercises ParallelSilenceScan against real WAV fixtures and the mock reader.
+ *
+ * @details The WAV fixture is long enough to be split into many segments and carries
+ *          two impulses, so the In and Out answers live in different segments and the
+ *          frontier pruning of later/earlier ranges is exercised. Helper readers leased
+ *          from a ReaderPool must all be back in it when the scan returns. A pool whose
+ *          threads are all blocked must not delay the scan, which then runs on the calling
+ *          thread. The mock reader has a non-seekable format name and must take the
+ *          sequential fallback.
+ */
+class ParallelSilenceScanTest : public juce::UnitTest {
+  public:
+    ParallelSilenceScanTest() : juce::UnitTest("Parallel Silence Scan Test") {
+    }
+
+    void runTest() override {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        juce::ThreadPool pool(juce::ThreadPoolOptions{}.withNumberOfThreads(4));
+
+        juce::TemporaryFile tempFile(".wav");
+        TestAudioFiles::Spec spec;
+        spec.numFrames = 1 << 21;
+        spec.impulses = {{300000, 0.5f}, {1500000, -0.5f}};
+        expect(TestAudioFiles::writeWav(tempFile.getFile(), spec));
+
+        const ParallelSilenceScan::ReaderFactory openReader = [&] {
+            return std::unique_ptr<juce::AudioFormatReader>(
+                formatManager.createReaderFor(tempFile.getFile()));
+        };
+        auto primary = openReader();
+        expect((bool)primary);
+        if (!primary)
+            return;
+
+        beginTest("WAV readers support parallel seeking");
+        expect(ParallelSilenceScan::supportsParallelSeeking(*primary));
+
+        beginTest("Parallel In/Out match the sequential scan");
+        const ScanContext context;
+        expectEquals(ParallelSilenceScan::findSilenceIn(*primary, openReader, pool, 0.1f, context),
+                     (juce::int64)300000);
+        expectEquals(ParallelSilenceScan::findSilenceOut(*primary, openReader, pool, 0.1f, context),
+                     (juce::int64)1500000);
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(*primary, 0.1f), (juce::int64)300000);
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(*primary, 0.1f),
+                     (juce::int64)1500000);
+
+        beginTest("No signal above threshold");
+        expectEquals(ParallelSilenceScan::findSilenceIn(*primary, openReader, pool, 0.9f, context),
+                     (juce::int64)-1);
+        expectEquals(ParallelSilenceScan::findSilenceOut(*primary, openReader, pool, 0.9f, context),
+                     (juce::int64)-1);
+
+        beginTest("Cancellation aborts every task");
+        std::atomic<bool> cancelled{true};
+        ScanContext cancelledContext;
+        cancelledContext.cancelled = &cancelled;
+        expectEquals(
+            ParallelSilenceScan::findSilenceIn(*primary, openReader, pool, 0.1f, cancelledContext),
+            (juce::int64)-1);
+
+        beginTest("Helper readers are leased from and returned to a ReaderPool");
+        {
+            ReaderPool readers(
+                [&](const juce::File &file) {
+                    return std::unique_ptr<juce::AudioFormatReader>(
+                        formatManager.createReaderFor(file));
+                },
+                8, 8);
+            const ParallelSilenceScan::ReaderFactory leaseReader = [&] {
+                return readers.acquire(tempFile.getFile());
+            };
+            expectEquals(
+                ParallelSilenceScan::findSilenceOut(*primary, leaseReader, pool, 0.1f, context),
+                (juce::int64)1500000);
+            expectEquals(readers.getNumLeased(), 0);
+            expect(readers.getNumIdle() > 0);
+
+            const auto misses = readers.getStats().misses;
+            expectEquals(
+                ParallelSilenceScan::findSilenceIn(*primary, leaseReader, pool, 0.1f, context),
+                (juce::int64)300000);
+            expectEquals(readers.getStats().misses, misses, "The second scan reuses the readers");
+        }
+
+        beginTest("A busy pool does not hold up the scan");
+        {
+            juce::WaitableEvent release;
+            std::vector<std::unique_ptr<BlockingJob>> blockers;
+            for (int i = 0; i < pool.getNumThreads() + 2; ++i) {
+                blockers.push_back(std::make_unique<BlockingJob>(release));
+                pool.addJob(blockers.back().get(), false);
+            }
+
+            int readersOpened = 0;
+            const ParallelSilenceScan::ReaderFactory countingOpen = [&] {
+                ++readersOpened;
+                return openReader();
+            };
+            expectEquals(
+                ParallelSilenceScan::findSilenceIn(*primary, countingOpen, pool, 0.1f, context),
+                (juce::int64)300000);
+            expectEquals(
+                ParallelSilenceScan::findSilenceOut(*primary, countingOpen, pool, 0.1f, context),
+                (juce::int64)1500000);
+            expectEquals(readersOpened, 0, "No helper is queued behind busy threads");
+
+            release.signal();
+            for (auto &blocker : blockers)
+                pool.waitForJobToFinish(blocker.get(), -1);
+        }
+
+        beginTest("Non-seekable formats fall back to the sequential scan");
+        LargeFileMockReader mock(1 << 22, 2, 44100.0, 1 << 21);
+        expect(!ParallelSilenceScan::supportsParallelSeeking(mock));
+        expectEquals(ParallelSilenceScan::findSilenceOut(mock, nullptr, pool, 0.1f, context),
+                     (juce::int64)(1 << 21));
+    }
+
+  private:
+    /** @brief Occupies a pool thread until released, like a long whole-file pass. */
+    class BlockingJob final : public juce::ThreadPoolJob {
+      public:
+        explicit BlockingJob(juce::WaitableEvent &releaseEvent)
+            : juce::ThreadPoolJob("Blocking"), release(releaseEvent) {
+        }
+
+        JobStatus runJob() override {
+            release.wait(-1);
+            return jobHasFinished;
+        }
+
+      private:
+        juce::WaitableEvent &release;
+    };
+};
+
+static ParallelSilenceScanTest parallelSilenceScanTest;
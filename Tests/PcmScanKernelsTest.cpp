@@ -0,0 +1,175 @@
+/**
+ * @file PcmScanKernelsTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that raw integer scanning agrees exactly with the float path.
+ */
+
+#include "Workers/MappedPcmReader.h"
+#include "Workers/PcmScanKernels.h"
+#include "Workers/PeakScanKernels.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <vector>
+
+/**
+ * @class PcmScanKernelsTest
+ * @brief Cross-checks integer limits and kernels against float conversion.
+ *
+ * @details The reference for every check is MappedPcmReader::convertFrames() followed by
+ *          the float comparison PeakScanKernels makes, i.e. exactly what a scan did before
+ *          the integer path existed. Every 16-bit and 24-bit value is checked against the
+ *          limit for a set of awkward Thresholds; 32-bit values are checked around the
+ *          limit, where float rounding matters. The kernels are then fed random raw blocks
+ *          in every encoding, byte order and channel count. Throughput is measured by the
+ *          `analysis_bench` target.
+ */
+class PcmScanKernelsTest : public juce::UnitTest {
+  public:
+    PcmScanKernelsTest() : juce::UnitTest("PCM Scan Kernels Test") {
+    }
+
+    void runTest() override {
+        beginTest("Integer limits agree with float conversion");
+        checkLimits();
+
+        beginTest("Kernels match the float path");
+        checkRandomBlocks();
+    }
+
+  private:
+    using Encoding = MappedPcmReader::Encoding;
+    using Kernel = PcmScanKernels::Kernel;
+
+    static int bitsOf(Encoding encoding) {
+        return encoding == Encoding::Int16 ? 16 : encoding == Encoding::Int24 ? 24 : 32;
+    }
+
+    /** @brief The float value the decoders produce for one raw sample. */
+    static float toFloat(juce::int64 value, Encoding encoding) {
+        return (float)value * (1.0f / (float)((juce::int64)1 << (bitsOf(encoding) - 1)));
+    }
+
+    static bool crosses(juce::int64 value, juce::int64 limit) {
+        return value > limit || value < -limit;
+    }
+
+    void checkLimit(float threshold, Encoding encoding, juce::int64 value, int &mismatches) {
+        const auto limit = PcmScanKernels::toIntegerLimit(threshold, encoding);
+        if (crosses(value, limit) != (std::abs(toFloat(value, encoding)) > threshold))
+            ++mismatches;
+    }
+
+    void checkLimits() {
+        const float thresholds[] = {0.0f,
+                                    -0.25f,
+                                    1.0e-30f,
+                                    1.0f / 32768.0f,
+                                    std::nextafter(1.0f / 32768.0f, 1.0f),
+                                    0.001f,
+                                    0.1f,
+                                    0.5f,
+                                    std::nextafter(1.0f, 0.0f),
+                                    1.0f,
+                                    2.0f,
+                                    std::nanf("")};
+
+        int mismatches = 0;
+        for (auto threshold : thresholds)
+            for (juce::int64 v = -32768; v <= 32767; ++v)
+                checkLimit(threshold, Encoding::Int16, v, mismatches);
+        expectEquals(mismatches, 0, "16-bit");
+
+        mismatches = 0;
+        for (auto threshold : {0.001f, 0.1f, std::nextafter(1.0f, 0.0f)})
+            for (juce::int64 v = -8388608; v <= 8388607; ++v)
+                checkLimit(threshold, Encoding::Int24, v, mismatches);
+        expectEquals(mismatches, 0, "24-bit");
+
+        mismatches = 0;
+        auto random = getRandom();
+        for (auto threshold : thresholds) {
+            for (int i = 0; i < 2000; ++i)
+                checkLimit(threshold, Encoding::Int32, (juce::int32)random.nextInt(), mismatches);
+
+            const auto limit = PcmScanKernels::toIntegerLimit(threshold, Encoding::Int32);
+            if (limit >= 0 && limit <= 0x7fffffff)
+                for (juce::int64 v = limit - 300; v <= limit + 300; ++v)
+                    if (v >= -0x7fffffff - 1 && v <= 0x7fffffff) {
+                        checkLimit(threshold, Encoding::Int32, v, mismatches);
+                        checkLimit(threshold, Encoding::Int32, -v, mismatches);
+                    }
+        }
+        checkLimit(0.5f, Encoding::Int32, -0x7fffffffLL - 1, mismatches);
+        expectEquals(mismatches, 0, "32-bit");
+    }
+
+    /** @brief Writes one sample in the layout's byte order. */
+    static void put(std::vector<char> &bytes, juce::int64 value, int numBytes, bool bigEndian) {
+        for (int i = 0; i < numBytes; ++i) {
+            const int shift = 8 * (bigEndian ? numBytes - 1 - i : i);
+            bytes.push_back((char)((juce::uint64)value >> shift));
+        }
+    }
+
+    void checkRandomBlocks() {
+        auto random = getRandom();
+        const Kernel kernels[] = {Kernel::Scalar, Kernel::Sse2, Kernel::Avx2};
+        const Encoding encodings[] = {Encoding::Int16, Encoding::Int24, Encoding::Int32};
+
+        for (int iteration = 0; iteration < 3000; ++iteration) {
+            MappedPcmReader::Layout layout;
+            layout.encoding = encodings[random.nextInt(3)];
+            layout.numChannels = 1 + random.nextInt(5);
+            layout.bigEndian = random.nextInt(4) == 0;
+            const int numFrames = 1 + random.nextInt(90);
+            const juce::int64 fullScale = (juce::int64)1 << (bitsOf(layout.encoding) - 1);
+
+            std::vector<char> bytes;
+            for (int i = 0; i < numFrames * layout.numChannels; ++i) {
+                const bool loud = random.nextInt(60) == 0;
+                const juce::int64 magnitude = loud ? fullScale / 2 : fullScale / 1000;
+                const juce::int64 value =
+                    random.nextBool() ? magnitude : (loud ? -fullScale : -magnitude);
+                put(bytes, value, bitsOf(layout.encoding) / 8, layout.bigEndian);
+            }
+
+            juce::AudioBuffer<float> converted(layout.numChannels, numFrames);
+            MappedPcmReader::convertFrames(layout, bytes.data(), numFrames,
+                                           converted.getArrayOfWritePointers(),
+                                           layout.numChannels, 0);
+            const float threshold = 0.1f;
+            const auto limit = PcmScanKernels::toIntegerLimit(threshold, layout.encoding);
+            const int expectedFirst =
+                PeakScanKernels::findFirstAbove(Kernel::Scalar, converted.getArrayOfReadPointers(),
+                                                layout.numChannels, numFrames, threshold);
+            const int expectedLast =
+                PeakScanKernels::findLastAbove(Kernel::Scalar, converted.getArrayOfReadPointers(),
+                                               layout.numChannels, numFrames, threshold);
+
+            for (auto kernel : kernels) {
+                if (!PeakScanKernels::isSupported(kernel))
+                    continue;
+                expectEquals(PcmScanKernels::findFirstAbove(kernel, layout, bytes.data(), numFrames,
+                                                            limit),
+                             expectedFirst);
+                expectEquals(PcmScanKernels::findLastAbove(kernel, layout, bytes.data(), numFrames,
+                                                           limit),
+                             expectedLast);
+            }
+        }
+
+        MappedPcmReader::Layout stereo;
+        stereo.numChannels = 2;
+        std::vector<char> bytes;
+        for (int i = 0; i < 64; ++i)
+            put(bytes, i == 41 ? 3277 : 3276, 2, false); // 0.1 * 32768 = 3276.8
+        const auto limit = PcmScanKernels::toIntegerLimit(0.1f, Encoding::Int16);
+        expectEquals(PcmScanKernels::findFirstAbove(stereo, bytes.data(), 32, limit), 20,
+                     "The crossing channel's frame is reported");
+        expectEquals(PcmScanKernels::findLastAbove(stereo, bytes.data(), 32, limit), 20);
+    }
+};
+
+static PcmScanKernelsTest pcmScanKernelsTest;
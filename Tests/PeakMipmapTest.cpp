@@ -0,0 +1,254 @@
+/**
+ * @file PeakMipmapTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the waveform mipmap against brute-force level ranges.
+ */
+
+#include "BufferMockReader.h"
+#include "Workers/AnalysisPipeline.h"
+#include "Workers/PeakMipmap.h"
+#include "Workers/ScanContext.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * @class PeakMipmapTest
+ * @brief Builds mipmaps of noise with a swelling envelope and checks column queries.
+ *
+ * @details A column must never look quieter than the samples it covers, and must not look
+ *          louder than the samples within its documented overshoot (half the span, or the
+ *          enclosing block for spans under one block).
+ */
+class PeakMipmapTest : public juce::UnitTest {
+  public:
+    PeakMipmapTest() : juce::UnitTest("Peak Mipmap Test") {
+    }
+
+    void runTest() override {
+        // Deliberately not a whole number of blocks.
+        constexpr int length = 300001;
+        constexpr double sampleRate = 44100.0;
+        juce::AudioBuffer<float> samples(2, length);
+        auto random = getRandom();
+        for (int i = 0; i < length; ++i) {
+            const float envelope = (float)i / (float)length;
+            samples.setSample(0, i, envelope * (random.nextFloat() * 2.0f - 1.0f));
+            samples.setSample(1, i, 0.5f * envelope * (random.nextFloat() * 2.0f - 1.0f) - 0.1f);
+        }
+
+        PeakMipmap mipmap;
+        mipmap.reset(length, 2, sampleRate);
+
+        beginTest("Partially built mipmaps answer only for finished blocks");
+        {
+            PeakMipmap::Builder builder(mipmap);
+            const int chunk = SilenceAnalysisAlgorithms::chunkSize;
+            for (int pos = 0; pos < length; pos += chunk) {
+                const int n = std::min(chunk, length - pos);
+                juce::AudioBuffer<float> part(2, n);
+                for (int ch = 0; ch < 2; ++ch)
+                    part.copyFrom(ch, 0, samples, ch, pos, n);
+                builder.addChunk(part, n);
+                const auto done = mipmap.getNumSamplesFinished();
+                if (pos + n < length) {
+                    expectEquals(done, (juce::int64)(pos + n));
+                    expect(!mipmap.isFullyLoaded());
+                    const auto beyond = mipmap.getColumn(0, done, length);
+                    expectEquals(beyond.maximum, 0.0f);
+                    expectEquals(beyond.rms, 0.0f);
+                    for (int q = 0; q < 50; ++q)
+                        checkColumn(mipmap, samples, random.nextInt((int)done),
+                                    random.nextInt((int)done) + 1, done);
+
+                    float minima[64], maxima[64];
+                    float *mins[] = {minima};
+                    float *maxs[] = {maxima};
+                    mipmap.getColumns(0.0, length, 64, 0, 1, mins, maxs);
+                    for (int column = 0; column < 64; ++column) {
+                        const int a = (int)std::floor(column * (double)length / 64);
+                        const int b = (int)std::ceil((column + 1) * (double)length / 64);
+                        if (a >= done)
+                            expectEquals(maxima[column], 0.0f);
+                        else
+                            checkBounds(minima[column], maxima[column], samples, 0, a,
+                                        (int)std::min((juce::int64)b, done), done);
+                    }
+                }
+            }
+            builder.finish();
+            expect(mipmap.isFullyLoaded());
+        }
+
+        beginTest("Columns cover their span at every zoom");
+        {
+            for (int q = 0; q < 2000; ++q) {
+                // Spans from a single sample up to the whole file, evenly on a log scale.
+                const int span = juce::jmax(1, (int)std::pow((double)length,
+                                                             random.nextDouble()));
+                const int start = random.nextInt(length - span + 1);
+                checkColumn(mipmap, samples, start, start + span, length);
+            }
+            checkColumn(mipmap, samples, 0, length, length);
+            checkColumn(mipmap, samples, length - 1, length, length);
+        }
+
+        beginTest("Batched columns match the samples they cover");
+        {
+            constexpr int numColumns = 333;
+            std::vector<float> minima[2], maxima[2];
+            for (int ch = 0; ch < 2; ++ch) {
+                minima[ch].resize(numColumns);
+                maxima[ch].resize(numColumns);
+            }
+            float *mins[] = {minima[0].data(), minima[1].data()};
+            float *maxs[] = {maxima[0].data(), maxima[1].data()};
+            for (int q = 0; q < 40; ++q) {
+                // From several samples per column down to several columns per sample.
+                const double span = std::pow((double)length, random.nextDouble()) + 1.0;
+                const double start = random.nextDouble() * (length - span);
+                mipmap.getColumns(start, start + span, numColumns, 0, 2, mins, maxs);
+                const double perColumn = span / numColumns;
+                for (int column = 0; column < numColumns; ++column) {
+                    const int a = (int)std::floor(start + column * perColumn);
+                    const int b = std::max(a + 1, (int)std::ceil(start + (column + 1) * perColumn));
+                    for (int ch = 0; ch < 2; ++ch)
+                        checkBounds(minima[ch][column], maxima[ch][column], samples, ch, a,
+                                    std::min(b, length), length);
+                }
+            }
+
+            // Columns past the end of the file, and channels the file does not have, are silent.
+            mipmap.getColumns(length - 1000.0, length + 1000.0, 2, 1, 2, mins, maxs);
+            expectLessThan(minima[0][0], 0.0f);
+            expectEquals(maxima[0][1], 0.0f);
+            expectEquals(minima[1][0], 0.0f);
+            expectEquals(maxima[1][0], 0.0f);
+        }
+
+        beginTest("RMS and time-based queries");
+        {
+            for (int ch = 0; ch < 2; ++ch) {
+                double sumOfSquares = 0.0;
+                for (int i = 0; i < length; ++i)
+                    sumOfSquares += (double)samples.getSample(ch, i) * samples.getSample(ch, i);
+                expectWithinAbsoluteError(mipmap.getColumn(ch, 0, length).rms,
+                                          (float)std::sqrt(sumOfSquares / length), 1.0e-3f);
+            }
+
+            expectWithinAbsoluteError(mipmap.getTotalLength(), length / sampleRate, 1.0e-9);
+            float minValue = 0.0f, maxValue = 0.0f;
+            mipmap.getApproximateMinMax(1.0, 2.0, 1, minValue, maxValue);
+            const auto column = mipmap.getColumn(1, 44100, 88200);
+            expectEquals(minValue, column.minimum);
+            expectEquals(maxValue, column.maximum);
+
+            const auto none = mipmap.getColumn(2, 0, length);
+            expectEquals(none.minimum, 0.0f);
+            expectEquals(none.maximum, 0.0f);
+        }
+
+        beginTest("A pipeline pass builds the same mipmap");
+        {
+            PeakMipmap piped;
+            piped.reset(length, 2, sampleRate);
+            BufferMockReader reader(samples);
+            AnalysisPipeline<PeakMipmap::Builder> pipeline{PeakMipmap::Builder(piped)};
+            expect(pipeline.run(reader, ScanContext()));
+            pipeline.get<PeakMipmap::Builder>().finish();
+            for (int q = 0; q < 200; ++q) {
+                const int start = random.nextInt(length);
+                const int end = start + 1 + random.nextInt(length - start);
+                const auto a = piped.getColumn(0, start, end);
+                const auto b = mipmap.getColumn(0, start, end);
+                expectEquals(a.minimum, b.minimum);
+                expectEquals(a.maximum, b.maximum);
+                expectEquals(a.rms, b.rms);
+            }
+        }
+
+        beginTest("Tiny and empty files");
+        {
+            juce::AudioBuffer<float> tiny(1, 5);
+            for (int i = 0; i < 5; ++i)
+                tiny.setSample(0, i, (float)i * 0.1f - 0.2f);
+            PeakMipmap small;
+            small.reset(5, 1, sampleRate);
+            PeakMipmap::Builder builder(small);
+            builder.addChunk(tiny, 5);
+            builder.finish();
+            expectEquals(small.getNumLevels(), 1);
+            const auto column = small.getColumn(0, 0, 5);
+            expectWithinAbsoluteError(column.minimum, -0.2f, 1.0e-4f);
+            expectWithinAbsoluteError(column.maximum, 0.2f, 1.0e-4f);
+
+            PeakMipmap empty;
+            empty.reset(0, 2, sampleRate);
+            expect(empty.isFullyLoaded());
+            const auto resets = empty.getResetCount();
+            empty.reset(0, 2, sampleRate);
+            expect(empty.getResetCount() != resets, "Every reset must be visible to views");
+            expectEquals(empty.getNumChannels(), 0);
+            expectEquals(empty.getColumn(0, 0, 100).maximum, 0.0f);
+        }
+
+        beginTest("Memory cost per channel-hour");
+        {
+            PeakMipmap hour;
+            hour.reset((juce::int64)(3600.0 * sampleRate), 1, sampleRate);
+            const double megabytes = (double)hour.getMemoryUsage() / 1.0e6;
+            expectGreaterThan(megabytes, 14.0);
+            expectLessThan(megabytes, 16.0);
+        }
+    }
+
+  private:
+    /**
+     * @brief Checks one column against the exact range of its span and of its overshoot.
+     * @param done The number of finished samples the column may draw on.
+     */
+    void checkColumn(const PeakMipmap &mipmap, const juce::AudioBuffer<float> &samples,
+                     int start, int end, juce::int64 done) {
+        if (start >= end)
+            std::swap(start, end);
+        if (start >= end)
+            end = start + 1;
+        const int clampedEnd = (int)std::min((juce::int64)end, done);
+        if (start >= clampedEnd)
+            return;
+
+        for (int ch = 0; ch < 2; ++ch) {
+            const auto column = mipmap.getColumn(ch, start, end);
+            checkBounds(column.minimum, column.maximum, samples, ch, start, clampedEnd, done);
+        }
+    }
+
+    /** @brief Checks a column's range against the samples of [start, end) and its overshoot. */
+    void checkBounds(float minimum, float maximum, const juce::AudioBuffer<float> &samples,
+                     int channel, int start, int end, juce::int64 done) {
+        const int span = end - start;
+        const int slack = span / 2 + PeakMipmap::baseBlockSize;
+        constexpr float quantum = 1.0f / 32767.0f;
+        constexpr float rounding = 1.0e-6f;
+        const auto exact = range(samples, channel, start, end);
+        const auto widened = range(samples, channel, std::max(0, start - slack),
+                                   (int)std::min(done, (juce::int64)end + slack));
+        expect(minimum <= exact.getStart() + rounding && maximum >= exact.getEnd() - rounding,
+               "Column quieter than its span at " + juce::String(start) + ".." +
+                   juce::String(end));
+        expect(minimum >= widened.getStart() - quantum && maximum <= widened.getEnd() + quantum,
+               "Column louder than its overshoot at " + juce::String(start) + ".." +
+                   juce::String(end));
+    }
+
+    static juce::Range<float> range(const juce::AudioBuffer<float> &samples, int channel,
+                                    int start, int end) {
+        return juce::FloatVectorOperations::findMinAndMax(samples.getReadPointer(channel, start),
+                                                          end - start);
+    }
+};
+
+static PeakMipmapTest peakMipmapTest;
@@ -0,0 +1,116 @@
+/**
+ * @file PeakPyramidTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that pyramid-backed Threshold queries equal full scans and survive persistence.
+ */
+
+#include "BufferMockReader.h"
+#include "Utils/FileIdentity.h"
+#include "Workers/EnvelopeStore.h"
+#include "Workers/PeakPyramid.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <vector>
+
+/**
+ * @class PeakPyramidTest
+ * @brief Cross-checks PeakPyramid queries, serialization, FileIdentity and EnvelopeStore.
+ *
+ * @details The source buffer holds sparse impulses of varying amplitude on random
+ *          channels, including values that sit exactly on quantization steps, so the
+ *          conservative-candidate path (pyramid over-reports, leaf read rejects) is hit.
+ */
+class PeakPyramidTest : public juce::UnitTest {
+  public:
+    PeakPyramidTest() : juce::UnitTest("Peak Pyramid Test") {
+    }
+
+    void runTest() override {
+        auto random = getRandom();
+        juce::AudioBuffer<float> source(2, 1000003);
+        source.clear();
+        for (int i = 0; i < 40; ++i)
+            source.setSample(random.nextInt(2), random.nextInt(source.getNumSamples()),
+                             (random.nextBool() ? 1.0f : -1.0f) * random.nextFloat());
+        source.setSample(0, 12345, 0.25f);
+        source.setSample(1, 999000, 1.5f); // float data may exceed full scale
+
+        BufferMockReader reader(source);
+        const ScanContext context;
+        auto pyramid = PeakPyramid::build(reader, context);
+
+        beginTest("Pyramid queries equal full scans");
+        expect(pyramid != nullptr && pyramid->matches(reader));
+        if (pyramid == nullptr)
+            return;
+        for (const float threshold : {0.01f, 0.1f, 0.25f, 0.2500001f, 0.5f, 0.9f, 0.999f, 1.0f, 1.2f})
+            expectQueriesMatch(*pyramid, reader, threshold);
+
+        beginTest("Serialization round trip");
+        juce::MemoryOutputStream output;
+        expect(pyramid->writeTo(output));
+        juce::MemoryInputStream input(output.getData(), output.getDataSize(), false);
+        auto restored = PeakPyramid::readFrom(input);
+        expect(restored != nullptr);
+        if (restored != nullptr)
+            expectQueriesMatch(*restored, reader, 0.3f);
+
+        juce::MemoryInputStream truncated(output.getData(), output.getDataSize() / 2, false);
+        expect(PeakPyramid::readFrom(truncated) == nullptr, "Truncated data must be rejected");
+
+        beginTest("FileIdentity is stable and content-sensitive");
+        juce::TemporaryFile tempFile(".bin");
+        expect(tempFile.getFile().replaceWithText("first"));
+        const auto hash = FileIdentity::computeHash(tempFile.getFile());
+        expectEquals(hash.length(), 32);
+        expectEquals(FileIdentity::computeHash(tempFile.getFile()), hash);
+        expect(tempFile.getFile().replaceWithText("second"));
+        expect(FileIdentity::computeHash(tempFile.getFile()) != hash);
+        expect(FileIdentity::computeHash(tempFile.getFile().getSiblingFile("missing")).isEmpty());
+
+        beginTest("Store persists pyramids across instances");
+        const auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                             .getNonexistentChildFile("peaks", "");
+        {
+            EnvelopeStore store(dir, (juce::int64)1 << 30);
+            expect(store.tryBeginBuild(hash));
+            expect(!store.tryBeginBuild(hash));
+            store.store(hash, std::move(pyramid), nullptr);
+            store.endBuild(hash);
+        }
+        EnvelopeStore reopened(dir, (juce::int64)1 << 30);
+        const auto loaded = reopened.findPyramid(hash);
+        expect(loaded != nullptr);
+        if (loaded != nullptr)
+            expectQueriesMatch(*loaded, reader, 0.1f);
+        expect(reopened.findPyramid("0000") == nullptr);
+        expect(reopened.findCurves(hash) == nullptr);
+
+        beginTest("Store trims the folder to its size cap");
+        {
+            const auto oldest = dir.getChildFile(hash + ".peaks");
+            const juce::int64 entrySize = oldest.getSize();
+            const juce::int64 now = juce::Time::getCurrentTime().toMilliseconds();
+            expect(oldest.setLastModificationTime(juce::Time(now - 60000)));
+
+            EnvelopeStore capped(dir, entrySize);
+            capped.store("newer", loaded, nullptr);
+            expect(!oldest.existsAsFile(), "The least recently used entry must be evicted");
+            expect(dir.getChildFile("newer.peaks").existsAsFile());
+        }
+        dir.deleteRecursively();
+    }
+
+  private:
+    void expectQueriesMatch(const PeakPyramid &pyramid, juce::AudioFormatReader &reader,
+                            float threshold) {
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(pyramid, reader, threshold),
+                     SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold));
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(pyramid, reader, threshold),
+                     SilenceAnalysisAlgorithms::findSilenceOut(reader, threshold));
+    }
+};
+
+static PeakPyramidTest peakPyramidTest;
@@ -0,0 +1,91 @@
+/**
+ * @file PeakScanKernelsTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the vectorized peak-scan kernels against the scalar loop.
+ */
+
+#include "Workers/PeakScanKernels.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * @class PeakScanKernelsTest
+ * @brief Cross-checks every supported kernel against a reference loop.
+ *
+ * @details Randomized mono, stereo and multi-channel blocks with lengths that straddle
+ *          the 16-sample vector width exercise both the vector body and the scalar tail.
+ *          Throughput is measured by the `analysis_bench` target, not here.
+ */
+class PeakScanKernelsTest : public juce::UnitTest {
+  public:
+    PeakScanKernelsTest() : juce::UnitTest("Peak Scan Kernels Test") {
+    }
+
+    void runTest() override {
+        beginTest("Kernels match the reference loop");
+        checkRandomBlocks();
+    }
+
+  private:
+    using Kernel = PeakScanKernels::Kernel;
+
+    /** @brief The loop SilenceAnalysisAlgorithms used before the kernels existed. */
+    static int legacyFirst(const juce::AudioBuffer<float> &buffer, int numSamples,
+                           float threshold) {
+        for (int sample = 0; sample < numSamples; ++sample)
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                if (std::abs(buffer.getSample(channel, sample)) > threshold)
+                    return sample;
+        return -1;
+    }
+
+    static int legacyLast(const juce::AudioBuffer<float> &buffer, int numSamples,
+                          float threshold) {
+        for (int sample = numSamples - 1; sample >= 0; --sample)
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                if (std::abs(buffer.getSample(channel, sample)) > threshold)
+                    return sample;
+        return -1;
+    }
+
+    void checkRandomBlocks() {
+        auto random = getRandom();
+        const Kernel kernels[] = {Kernel::Scalar, Kernel::Sse2, Kernel::Avx2};
+
+        for (int iteration = 0; iteration < 2000; ++iteration) {
+            const int numChannels = 1 + random.nextInt(6);
+            const int numSamples = 1 + random.nextInt(80);
+            juce::AudioBuffer<float> buffer(numChannels, numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int s = 0; s < numSamples; ++s)
+                    buffer.setSample(ch, s,
+                                     random.nextInt(40) == 0 ? (random.nextBool() ? 0.5f : -0.5f)
+                                                             : 0.001f);
+
+            const int expectedFirst = legacyFirst(buffer, numSamples, 0.1f);
+            const int expectedLast = legacyLast(buffer, numSamples, 0.1f);
+
+            for (auto kernel : kernels) {
+                if (!PeakScanKernels::isSupported(kernel))
+                    continue;
+                expectEquals(PeakScanKernels::findFirstAbove(kernel, buffer.getArrayOfReadPointers(),
+                                                             numChannels, numSamples, 0.1f),
+                             expectedFirst);
+                expectEquals(PeakScanKernels::findLastAbove(kernel, buffer.getArrayOfReadPointers(),
+                                                            numChannels, numSamples, 0.1f),
+                             expectedLast);
+            }
+        }
+
+        juce::AudioBuffer<float> exact(1, 32);
+        exact.clear();
+        exact.setSample(0, 20, 0.1f);
+        expectEquals(PeakScanKernels::findFirstAbove(exact.getArrayOfReadPointers(), 1, 32, 0.1f),
+                     -1, "A sample equal to the threshold must not trigger");
+    }
+};
+
+static PeakScanKernelsTest peakScanKernelsTest;
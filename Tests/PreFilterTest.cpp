@@ -0,0 +1,189 @@
+/**
+ * @file PreFilterTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the scan pre-filter and the Auto-Cut scans that listen through it.
+ */
+
+#include "BufferMockReader.h"
+#include "Utils/Config.h"
+#include "Workers/PreFilter.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+/**
+ * @class PreFilterTest
+ * @brief Checks the frequency response, chunk continuity and kernel agreement of the
+ *        filter, then scans a tone whose lead-in and tail are buried in rumble.
+ */
+class PreFilterTest : public juce::UnitTest {
+  public:
+    PreFilterTest() : juce::UnitTest("Pre-Filter Test") {
+    }
+
+    void runTest() override {
+        using Filter = MainDomain::FilterMode;
+        using Kernel = PeakScanKernels::Kernel;
+        constexpr double sampleRate = 44100.0;
+
+        beginTest("High-pass keeps the tone and drops the rumble");
+        expectWithinAbsoluteError(gainAt(Filter::HighPass, 1000.0), 1.0f, 0.05f);
+        expectLessThan(gainAt(Filter::HighPass, 20.0), 0.01f);
+        expectGreaterThan(gainAt(Filter::HighPass, 15000.0), 0.95f);
+
+        beginTest("Band limit also drops the hiss");
+        expectWithinAbsoluteError(gainAt(Filter::BandLimit, 1000.0), 1.0f, 0.05f);
+        expectLessThan(gainAt(Filter::BandLimit, 20.0), 0.01f);
+        expectLessThan(gainAt(Filter::BandLimit, 18000.0), 0.1f);
+
+        beginTest("Off leaves the audio untouched");
+        {
+            PreFilter off(Filter::Off, sampleRate, 2);
+            expect(off.isBypassed());
+            auto buffer = makeNoise(2, 1000);
+            const auto original = buffer;
+            off.process(buffer, buffer.getNumSamples(), true);
+            expectEquals(maxDifference(buffer, original), 0.0f);
+        }
+
+        // Chunks longer than the warm-up pre-roll, like the scans' own, prime identically.
+        const auto noise = makeNoise(5, 20000);
+        for (const bool forward : {true, false}) {
+            beginTest(forward ? "Chunking is invisible in file order"
+                              : "Chunking is invisible to a backward scan");
+            const auto whole = filtered(noise, Kernel::Scalar, noise.getNumSamples(), forward);
+            const auto chunked = filtered(noise, Kernel::Scalar, 3001, forward);
+            expectEquals(maxDifference(whole, chunked), 0.0f);
+
+            beginTest(forward ? "The vectorized kernel matches the scalar one"
+                              : "The vectorized kernel matches the scalar one backwards");
+            const auto vectorized = filtered(noise, Kernel::Sse2, 3001, forward);
+            expectLessThan(maxDifference(whole, vectorized), 1.0e-5f);
+        }
+
+        beginTest("Every channel of a wide file is filtered alike");
+        {
+            juce::AudioBuffer<float> same(5, 4000);
+            for (int i = 0; i < same.getNumSamples(); ++i)
+                for (int ch = 0; ch < same.getNumChannels(); ++ch)
+                    same.setSample(ch, i, noise.getSample(0, i));
+            const auto result = filtered(same, Kernel::Sse2, 1000, true);
+            for (int ch = 1; ch < result.getNumChannels(); ++ch)
+                for (int i = 0; i < result.getNumSamples(); i += 97)
+                    expectEquals(result.getSample(ch, i), result.getSample(0, i));
+        }
+
+        beginTest("Filtered scans ignore a rumbling lead-in and tail");
+        {
+            constexpr int length = 200000;
+            constexpr int toneStart = 70000;
+            constexpr int toneEnd = 130000;
+            constexpr float threshold = 0.05f;
+            juce::AudioBuffer<float> samples(2, length);
+            for (int i = 0; i < length; ++i) {
+                const double t = (double)i / sampleRate;
+                const bool loud = i >= toneStart && i < toneEnd;
+                const double phase = juce::MathConstants<double>::twoPi * t;
+                const float rumble = 0.3f * (float)std::sin(25.0 * phase);
+                const float tone = loud ? 0.2f * (float)std::sin(1000.0 * phase) : 0.0f;
+                for (int ch = 0; ch < 2; ++ch)
+                    samples.setSample(ch, i, rumble + tone);
+            }
+            BufferMockReader reader(samples);
+            const ScanContext context;
+            // The Rms window may place the edge up to one window early.
+            const auto tolerance =
+                (juce::int64)(sampleRate * (Config::Audio::rmsWindowSeconds + 0.005));
+
+            using Mode = MainDomain::DetectionMode;
+            expectLessThan(
+                SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold, Mode::Peak, context),
+                (juce::int64)1000, "Unfiltered, the rumble counts as audio");
+            for (const auto mode : {Mode::Peak, Mode::Rms, Mode::PeakHold}) {
+                const auto in = SilenceAnalysisAlgorithms::findSilenceIn(
+                    reader, threshold, mode, context, Filter::HighPass);
+                const auto out = SilenceAnalysisAlgorithms::findSilenceOut(
+                    reader, threshold, mode, context, Filter::HighPass);
+                expect(std::abs(in - toneStart) <= tolerance, "In point " + juce::String(in));
+                expect(std::abs(out - toneEnd) <= tolerance, "Out point " + juce::String(out));
+            }
+        }
+
+        beginTest("A DC offset at the file's edges does not ring");
+        {
+            juce::AudioBuffer<float> offset(1, 20000);
+            for (int i = 0; i < offset.getNumSamples(); ++i)
+                offset.setSample(0, i, 0.5f);
+            BufferMockReader reader(offset);
+            const ScanContext context;
+            using Mode = MainDomain::DetectionMode;
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(reader, 0.01f, Mode::Peak,
+                                                                  context, Filter::HighPass),
+                         (juce::int64)-1);
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(reader, 0.01f, Mode::Peak,
+                                                                   context, Filter::HighPass),
+                         (juce::int64)-1);
+        }
+    }
+
+  private:
+    static juce::AudioBuffer<float> makeNoise(int numChannels, int numSamples) {
+        juce::Random random(42);
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+        return buffer;
+    }
+
+    static juce::AudioBuffer<float> filtered(const juce::AudioBuffer<float> &source,
+                                             PeakScanKernels::Kernel kernel, int chunkSize,
+                                             bool forward) {
+        PreFilter filter(MainDomain::FilterMode::BandLimit, 44100.0, source.getNumChannels());
+        juce::AudioBuffer<float> result(source.getNumChannels(), source.getNumSamples());
+        juce::AudioBuffer<float> chunk(source.getNumChannels(), chunkSize);
+        const int length = source.getNumSamples();
+        for (int done = 0; done < length;) {
+            const int numThisTime = std::min(chunkSize, length - done);
+            const int start = forward ? done : length - done - numThisTime;
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                chunk.copyFrom(ch, 0, source, ch, start, numThisTime);
+            filter.process(kernel, chunk, numThisTime, forward);
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                result.copyFrom(ch, start, chunk, ch, 0, numThisTime);
+            done += numThisTime;
+        }
+        return result;
+    }
+
+    /** @brief Steady-state peak gain for a unit sine, measured after a second of settling. */
+    static float gainAt(MainDomain::FilterMode mode, double frequency) {
+        constexpr double sampleRate = 44100.0;
+        juce::AudioBuffer<float> sine(1, (int)sampleRate * 2);
+        for (int i = 0; i < sine.getNumSamples(); ++i)
+            sine.setSample(0, i,
+                           (float)std::sin(juce::MathConstants<double>::twoPi * frequency * i /
+                                           sampleRate));
+        PreFilter filter(mode, sampleRate, 1);
+        filter.process(sine, sine.getNumSamples(), true);
+
+        float peak = 0.0f;
+        for (int i = (int)sampleRate; i < sine.getNumSamples(); ++i)
+            peak = std::max(peak, std::abs(sine.getSample(0, i)));
+        return peak;
+    }
+
+    static float maxDifference(const juce::AudioBuffer<float> &a,
+                               const juce::AudioBuffer<float> &b) {
+        float difference = 0.0f;
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                difference =
+                    std::max(difference, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+        return difference;
+    }
+};
+
+static PreFilterTest preFilterTest;
@@ -0,0 +1,151 @@
+/**
+ * @file ReaderPoolTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies reuse, keying and the bounds of the analysis reader pool.
+ */
+
+#include "BufferMockReader.h"
+#include "Workers/ReaderPool.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+#include <memory>
+
+/**
+ * @class ReaderPoolTest
+ * @brief Drives a ReaderPool whose opener counts opens, over small temporary files.
+ *
+ * @details The opener ignores the file's content and returns an in-memory reader, so the
+ *          tests only observe what the pool decides: when it opens, reuses and closes.
+ */
+class ReaderPoolTest : public juce::UnitTest {
+  public:
+    ReaderPoolTest() : juce::UnitTest("Reader Pool Test") {
+    }
+
+    void runTest() override {
+        juce::TemporaryFile first(".wav"), second(".wav"), third(".wav");
+        for (auto *temp : {&first, &second, &third})
+            expect(temp->getFile().replaceWithText("RIFF"));
+
+        beginTest("A returned reader serves the next lease of the same file");
+        {
+            ReaderPool pool(makeOpener(), 4, 8);
+            juce::AudioFormatReader *opened = nullptr;
+            {
+                auto lease = pool.acquire(first.getFile());
+                expect((bool)lease);
+                opened = lease.get();
+                expectEquals(pool.getNumLeased(), 1);
+            }
+            expectEquals(pool.getNumIdle(), 1);
+            auto again = pool.acquire(first.getFile());
+            expect(again.get() == opened, "The idle reader must be reused");
+            expectEquals(opens, 1);
+            expectEquals((int)pool.getStats().hits, 1);
+            expectEquals((int)pool.getStats().misses, 1);
+        }
+
+        beginTest("Concurrent leases of one file get separate readers");
+        {
+            ReaderPool pool(makeOpener(), 4, 8);
+            {
+                auto a = pool.acquire(first.getFile());
+                auto b = pool.acquire(first.getFile());
+                expect(a.get() != b.get());
+                expectEquals(pool.getNumLeased(), 2);
+            }
+            expectEquals(pool.getNumIdle(), 2);
+            expectEquals(pool.getNumLeased(), 0);
+            expectEquals(opens, 2);
+        }
+
+        beginTest("The least recently returned reader is evicted first");
+        {
+            ReaderPool pool(makeOpener(), 2, 8);
+            pool.acquire(first.getFile());
+            pool.acquire(second.getFile());
+            pool.acquire(third.getFile());
+            expectEquals(pool.getNumIdle(), 2);
+            expectEquals((int)pool.getStats().evictions, 1);
+
+            pool.acquire(third.getFile());
+            pool.acquire(second.getFile());
+            expectEquals(opens, 3);
+            pool.acquire(first.getFile());
+            expectEquals(opens, 4);
+        }
+
+        beginTest("A rewritten file is reopened and its stale reader closed");
+        {
+            ReaderPool pool(makeOpener(), 4, 8);
+            pool.acquire(first.getFile());
+            expect(first.getFile().replaceWithText("RIFF with more data"));
+            auto lease = pool.acquire(first.getFile());
+            expectEquals(opens, 2);
+            expectEquals(pool.getNumIdle(), 0);
+            expectEquals((int)pool.getStats().evictions, 1);
+        }
+
+        beginTest("Discarded and unopenable readers are never pooled");
+        {
+            ReaderPool pool(makeOpener(), 4, 8);
+            {
+                auto lease = pool.acquire(first.getFile());
+                lease.discard();
+                expect(!lease);
+                expectEquals(pool.getNumLeased(), 0);
+            }
+            expectEquals(pool.getNumIdle(), 0);
+
+            failOpens = true;
+            auto missing = pool.acquire(second.getFile());
+            failOpens = false;
+            expect(!missing);
+            expectEquals(pool.getNumLeased(), 0);
+        }
+
+        beginTest("Returns beyond the open limit close the reader");
+        {
+            ReaderPool pool(makeOpener(), 8, 2);
+            {
+                auto a = pool.acquire(first.getFile());
+                auto b = pool.acquire(second.getFile());
+                auto c = pool.acquire(third.getFile());
+                expect(a && b && c, "Leases are never refused");
+                expectEquals(pool.getNumLeased(), 3);
+            }
+            expectEquals(pool.getNumIdle(), 2);
+            expectEquals((int)pool.getStats().evictions, 1);
+        }
+
+        beginTest("A lease of an unpooled reader closes it on release");
+        {
+            ReaderPool::Lease lease(makeReader());
+            expect((bool)lease);
+            ReaderPool::Lease moved(std::move(lease));
+            expect(!lease && moved);
+        }
+    }
+
+  private:
+    ReaderPool::Opener makeOpener() {
+        opens = 0;
+        return [this](const juce::File &) -> std::unique_ptr<juce::AudioFormatReader> {
+            if (failOpens)
+                return nullptr;
+            ++opens;
+            return makeReader();
+        };
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> makeReader() {
+        return std::make_unique<BufferMockReader>(silence);
+    }
+
+    juce::AudioBuffer<float> silence{1, 16};
+    int opens = 0;
+    bool failOpens = false;
+};
+
+static ReaderPoolTest readerPoolTest;
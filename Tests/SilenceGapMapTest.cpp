@@ -0,0 +1,96 @@
+/**
+ * @file SilenceGapMapTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies that the streaming gap map finds every internal silence exactly once.
+ */
+
+#include "Utils/Config.h"
+#include "Workers/SilenceGapMap.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+/**
+ * @class SilenceGapMapTest
+ * @brief Builds maps over a synthetic take sequence with different chunkings.
+ */
+class SilenceGapMapTest : public juce::UnitTest {
+  public:
+    SilenceGapMapTest() : juce::UnitTest("Silence Gap Map Test") {
+    }
+
+    void runTest() override {
+        constexpr double sampleRate = 44100.0;
+        constexpr int length = 120000;
+        const auto minGap = (int)(sampleRate * Config::Audio::gapMinSeconds);
+
+        // Leading silence, take, long gap, take, short pause, take, noisy gap, take, tail.
+        juce::AudioBuffer<float> samples(2, length);
+        samples.clear();
+        const auto addTake = [&samples](int start, int end) {
+            for (int i = start; i < end; ++i)
+                samples.setSample(i % 2, i, (i % 4 < 2) ? 0.5f : -0.5f);
+        };
+        addTake(10000, 11000);
+        addTake(11000 + minGap + 100, 42000 + minGap);
+        addTake(52000 + minGap, 53000 + minGap);
+        for (int i = 53000 + minGap; i < 80000 + minGap; ++i)
+            samples.setSample(1, i, 0.05f);
+        addTake(80000 + minGap, 81000 + minGap);
+
+        beginTest("Internal gaps are found with exact edges and depth");
+        const auto map = build(samples, length, 65536);
+        const auto &gaps = map->getGaps();
+        expectEquals((int)gaps.size(), 2);
+        if (gaps.size() == 2) {
+            expectEquals(gaps[0].start, (juce::int64)11000);
+            expectEquals(gaps[0].end, (juce::int64)11000 + minGap + 100);
+            expectEquals(gaps[0].depth, 0.0f);
+            expectEquals(gaps[1].start, (juce::int64)53000 + minGap);
+            expectEquals(gaps[1].end, (juce::int64)80000 + minGap);
+            expectEquals(gaps[1].depth, 0.05f);
+        }
+        expect(!map->isTruncated());
+
+        beginTest("Chunk boundaries do not change the result");
+        for (int chunk : {1, 777, 22050}) {
+            const auto other = build(samples, length, chunk);
+            expectEquals(other->getGaps().size(), gaps.size());
+            for (size_t i = 0; i < std::min(gaps.size(), other->getGaps().size()); ++i) {
+                expectEquals(other->getGaps()[i].start, gaps[i].start);
+                expectEquals(other->getGaps()[i].end, gaps[i].end);
+            }
+        }
+
+        beginTest("Navigation finds the gap around or after a position");
+        expectEquals((int)map->findFirstEndingAfter(0), 0);
+        expectEquals((int)map->findFirstEndingAfter(11000 + minGap + 99), 0);
+        expectEquals((int)map->findFirstEndingAfter(11000 + minGap + 100), 1);
+        expectEquals((int)map->findFirstEndingAfter(length), 2);
+
+        beginTest("All-silent and all-loud files have no gaps");
+        juce::AudioBuffer<float> silent(1, length);
+        silent.clear();
+        expect(build(silent, length, 4096)->getGaps().empty());
+        juce::AudioBuffer<float> loud(1, length);
+        for (int i = 0; i < length; ++i)
+            loud.setSample(0, i, 0.9f);
+        expect(build(loud, length, 4096)->getGaps().empty());
+    }
+
+  private:
+    static std::unique_ptr<SilenceGapMap> build(const juce::AudioBuffer<float> &samples,
+                                                int length, int chunkSize) {
+        SilenceGapMap::Builder builder(0.1f, length, 44100.0);
+        juce::AudioBuffer<float> chunk(samples.getNumChannels(), chunkSize);
+        for (int pos = 0; pos < length; pos += chunkSize) {
+            const int numSamples = std::min(chunkSize, length - pos);
+            for (int ch = 0; ch < samples.getNumChannels(); ++ch)
+                chunk.copyFrom(ch, 0, samples, ch, pos, numSamples);
+            builder.addChunk(chunk, numSamples);
+        }
+        return builder.finish();
+    }
+};
+
+static SilenceGapMapTest silenceGapMapTest;
@@ -0,0 +1,110 @@
+#ifndef AUDIOFILER_TESTAUDIOFILES_H
+#define AUDIOFILER_TESTAUDIOFILES_H
+
+/**
+ * @file TestAudioFiles.h
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Deterministic WAV fixture generator for tests that need real files on disk.
+ */
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace TestAudioFiles
+ * @brief Writes canonical RIFF/WAVE files byte by byte.
+ *
+ * @details The fixtures are written without a `juce::AudioFormatWriter` so that their
+ *          exact bit pattern is known to the tests (e.g. integer-domain scans) and does
+ *          not depend on writer API revisions. Every file is digital silence plus a
+ *          list of impulses `(frame, amplitude)` applied to all channels.
+ */
+namespace TestAudioFiles {
+/** @brief On-disk sample encodings supported by the generator. */
+enum class SampleFormat { Int16, Int24, Int32, Float32 };
+
+/** @brief Description of one fixture. */
+struct Spec {
+    int numChannels = 2;
+    juce::int64 numFrames = 44100;
+    int sampleRate = 44100;
+    SampleFormat format = SampleFormat::Int16;
+    std::vector<std::pair<juce::int64, float>> impulses;
+};
+
+inline int bytesPerSample(SampleFormat format) {
+    switch (format) {
+    case SampleFormat::Int16:
+        return 2;
+    case SampleFormat::Int24:
+        return 3;
+    default:
+        return 4;
+    }
+}
+
+inline void encode(char *dest, SampleFormat format, float value) {
+    if (format == SampleFormat::Float32) {
+        std::memcpy(dest, &value, 4);
+        return;
+    }
+    const int bits = bytesPerSample(format) * 8;
+    const double scale = std::ldexp(1.0, bits - 1) - 1.0;
+    const auto sample = (juce::int64)std::lround(juce::jlimit(-1.0, 1.0, (double)value) * scale);
+    for (int b = 0; b < bits / 8; ++b)
+        dest[b] = (char)((sample >> (8 * b)) & 0xff);
+}
+
+/**
+ * @brief Writes the fixture described by `spec` to `file`, replacing any existing file.
+ * @param file Destination path.
+ * @param spec Channel count, length, encoding and impulse list.
+ * @return True on success.
+ */
+inline bool writeWav(const juce::File &file, const Spec &spec) {
+    const int bps = bytesPerSample(spec.format);
+    const int blockAlign = bps * spec.numChannels;
+    const juce::int64 dataBytes = spec.numFrames * blockAlign;
+
+    file.deleteFile();
+    juce::FileOutputStream out(file);
+    if (!out.openedOk())
+        return false;
+
+    out.write("RIFF", 4);
+    out.writeInt((int)(36 + dataBytes));
+    out.write("WAVEfmt ", 8);
+    out.writeInt(16);
+    out.writeShort((short)(spec.format == SampleFormat::Float32 ? 3 : 1));
+    out.writeShort((short)spec.numChannels);
+    out.writeInt(spec.sampleRate);
+    out.writeInt(spec.sampleRate * blockAlign);
+    out.writeShort((short)blockAlign);
+    out.writeShort((short)(bps * 8));
+    out.write("data", 4);
+    out.writeInt((int)dataBytes);
+
+    constexpr juce::int64 framesPerBlock = 65536;
+    juce::HeapBlock<char> block((size_t)(framesPerBlock * blockAlign), true);
+    for (juce::int64 pos = 0; pos < spec.numFrames; pos += framesPerBlock) {
+        const juce::int64 frames = std::min(framesPerBlock, spec.numFrames - pos);
+        std::memset(block.get(), 0, (size_t)(frames * blockAlign));
+        for (const auto &impulse : spec.impulses)
+            if (impulse.first >= pos && impulse.first < pos + frames)
+                for (int ch = 0; ch < spec.numChannels; ++ch)
+                    encode(block.get() + (impulse.first - pos) * blockAlign + ch * bps,
+                           spec.format, impulse.second);
+        if (!out.write(block.get(), (size_t)(frames * blockAlign)))
+            return false;
+    }
+    out.flush();
+    return !out.getStatus().failed();
+}
+} // namespace TestAudioFiles
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file WaveformCacheTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the round trip, validation and LRU eviction of the waveform disk cache.
+ */
+
+#include "Workers/PeakMipmap.h"
+#include "Workers/WaveformCache.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+/**
+ * @class WaveformCacheTest
+ * @brief Stores mipmaps of noise in a scratch folder and maps them back in.
+ */
+class WaveformCacheTest : public juce::UnitTest {
+  public:
+    WaveformCacheTest() : juce::UnitTest("Waveform Cache Test") {
+    }
+
+    void runTest() override {
+        constexpr int length = 200000;
+        constexpr double sampleRate = 48000.0;
+        const auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("audiofiler_waveform_cache_test");
+        folder.deleteRecursively();
+
+        juce::AudioBuffer<float> samples(2, length);
+        auto random = getRandom();
+        for (int i = 0; i < length; ++i)
+            for (int ch = 0; ch < 2; ++ch)
+                samples.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * (float)i / length);
+
+        PeakMipmap built;
+        built.reset(length, 2, sampleRate);
+        {
+            PeakMipmap::Builder builder(built);
+            builder.addChunk(samples, length);
+            builder.finish();
+        }
+
+        beginTest("A stored mipmap maps back identically");
+        {
+            WaveformCache cache(folder, (juce::int64)1 << 30);
+            expect(cache.store("first", built));
+
+            PeakMipmap loaded;
+            loaded.reset(length, 2, sampleRate);
+            expect(cache.load("first", loaded));
+            expect(loaded.isFullyLoaded());
+            for (int q = 0; q < 500; ++q) {
+                const int start = random.nextInt(length);
+                const int end = start + 1 + random.nextInt(length - start);
+                const int ch = random.nextInt(2);
+                const auto a = loaded.getColumn(ch, start, end);
+                const auto b = built.getColumn(ch, start, end);
+                expectEquals(a.minimum, b.minimum);
+                expectEquals(a.maximum, b.maximum);
+                expectEquals(a.rms, b.rms);
+            }
+            expect(!cache.load("unknown", loaded));
+        }
+
+        beginTest("A mipmap serialized ahead of time stores the same entry");
+        {
+            WaveformCache cache(folder, (juce::int64)1 << 30);
+            juce::MemoryBlock serialized;
+            {
+                juce::MemoryOutputStream output(serialized, false);
+                expect(built.writeTo(output));
+            }
+            expect(cache.store("copied", serialized));
+            expectEquals(entry(folder, "copied").getSize(), (juce::int64)serialized.getSize());
+
+            PeakMipmap loaded;
+            loaded.reset(length, 2, sampleRate);
+            expect(cache.load("copied", loaded));
+            const auto a = loaded.getColumn(1, 1000, 150000);
+            const auto b = built.getColumn(1, 1000, 150000);
+            expectEquals(a.minimum, b.minimum);
+            expectEquals(a.maximum, b.maximum);
+            expect(entry(folder, "copied").deleteFile());
+        }
+
+        beginTest("Unfinished, mismatched and corrupt entries are refused");
+        {
+            WaveformCache cache(folder, (juce::int64)1 << 30);
+            PeakMipmap partial;
+            partial.reset(length, 2, sampleRate);
+            PeakMipmap::Builder builder(partial);
+            expect(!cache.store("partial", partial));
+
+            PeakMipmap otherShape;
+            otherShape.reset(length + 1, 2, sampleRate);
+            expect(!cache.load("first", otherShape));
+            expect(!entry(folder, "first").existsAsFile(), "A stale entry must be deleted");
+
+            expect(entry(folder, "garbage").replaceWithText("not a waveform"));
+            PeakMipmap target;
+            target.reset(length, 2, sampleRate);
+            expect(!cache.load("garbage", target));
+            expect(!entry(folder, "garbage").existsAsFile());
+            expect(!target.isFullyLoaded());
+        }
+
+        beginTest("Eviction removes the least recently used entries");
+        {
+            WaveformCache sizing(folder, (juce::int64)1 << 30);
+            expect(sizing.store("size", built));
+            const juce::int64 entrySize = entry(folder, "size").getSize();
+            expect(entry(folder, "size").deleteFile());
+
+            // Room for two and a half entries.
+            WaveformCache cache(folder, entrySize * 5 / 2);
+            const juce::int64 now = juce::Time::getCurrentTime().toMilliseconds();
+            const char *const names[] = {"oldest", "older", "newer", "newest"};
+            for (int i = 0; i < 4; ++i) {
+                expect(cache.store(names[i], built));
+                const juce::Time stamp(now - (juce::int64)(4 - i) * 60000);
+                expect(entry(folder, names[i]).setLastModificationTime(stamp));
+            }
+
+            // Using the oldest entry makes it the most recent one.
+            PeakMipmap target;
+            target.reset(length, 2, sampleRate);
+            expect(cache.load("oldest", target));
+
+            expectEquals(cache.evict(), entrySize * 2);
+            expect(entry(folder, "oldest").existsAsFile());
+            expect(!entry(folder, "older").existsAsFile());
+            expect(!entry(folder, "newer").existsAsFile());
+            expect(entry(folder, "newest").existsAsFile());
+            expectEquals(cache.evict(), (juce::int64)0);
+        }
+
+        folder.deleteRecursively();
+    }
+
+  private:
+    static juce::File entry(const juce::File &folder, const juce::String &hash) {
+        return folder.getChildFile(hash + ".wave");
+    }
+};
+
+static WaveformCacheTest waveformCacheTest;
@@ -0,0 +1,115 @@
+/**
+ * @file WindowedDetectorTest.cpp
+ * @Source/Core/FileMetadata.h
+ * @ingroup Tests
+ * @brief Verifies the click-tolerant Rms and PeakHold detection modes of the Auto-Cut scans.
+ */
+
+#include "BufferMockReader.h"
+#include "Utils/Config.h"
+#include "Workers/SilenceAnalysisAlgorithms.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+/**
+ * @class WindowedDetectorTest
+ * @brief Scans a lead-in click followed by a sustained tone in every detection mode.
+ *
+ * @details The file is longer than one scan chunk and the tone straddles a chunk border,
+ *          so the detector's running state has to survive chunk boundaries.
+ */
+class WindowedDetectorTest : public juce::UnitTest {
+  public:
+    WindowedDetectorTest() : juce::UnitTest("Windowed Detector Test") {
+    }
+
+    void runTest() override {
+        using Mode = MainDomain::DetectionMode;
+        const ScanContext context;
+        const float threshold = 0.1f;
+
+        constexpr int length = 200000;
+        constexpr int click = 10000;
+        constexpr int toneStart = 60000;
+        constexpr int toneEnd = 80000;
+        constexpr int tailClick = 190000;
+
+        juce::AudioBuffer<float> samples(2, length);
+        samples.clear();
+        samples.setSample(1, click, 0.9f);
+        samples.setSample(0, tailClick, -0.9f);
+        for (int i = toneStart; i < toneEnd; ++i)
+            samples.setSample(0, i, (i % 2 == 0) ? 0.5f : -0.5f);
+        BufferMockReader reader(samples);
+
+        const int window = juce::roundToInt(reader.sampleRate * Config::Audio::rmsWindowSeconds);
+
+        beginTest("Peak mode matches the plain scans and trips on the clicks");
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold, Mode::Peak, context),
+                     SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold));
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold, Mode::Peak, context),
+                     (juce::int64)click);
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(reader, threshold, Mode::Peak, context),
+                     (juce::int64)tailClick);
+
+        beginTest("PeakHold skips the clicks and lands on the tone's edges");
+        expectEquals(
+            SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold, Mode::PeakHold, context),
+            (juce::int64)toneStart);
+        expectEquals(
+            SilenceAnalysisAlgorithms::findSilenceOut(reader, threshold, Mode::PeakHold, context),
+            (juce::int64)toneEnd - 1);
+
+        beginTest("Rms skips the clicks and keeps the whole window around the tone");
+        const auto rmsIn =
+            SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold, Mode::Rms, context);
+        const auto rmsOut =
+            SilenceAnalysisAlgorithms::findSilenceOut(reader, threshold, Mode::Rms, context);
+        expect(rmsIn > toneStart - window && rmsIn <= toneStart, "In is " + juce::String(rmsIn));
+        expect(rmsOut >= toneEnd - 1 && rmsOut < toneEnd - 1 + window,
+               "Out is " + juce::String(rmsOut));
+
+        beginTest("Both scan directions are mirror images");
+        juce::AudioBuffer<float> reversed(2, length);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < length; ++i)
+                reversed.setSample(ch, i, samples.getSample(ch, length - 1 - i));
+        BufferMockReader mirror(reversed);
+        for (auto mode : {Mode::Peak, Mode::Rms, Mode::PeakHold}) {
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(mirror, threshold, mode, context),
+                         (juce::int64)length - 1 -
+                             SilenceAnalysisAlgorithms::findSilenceOut(reader, threshold, mode,
+                                                                       context));
+        }
+
+        beginTest("Gaps shorter than the hold keep a PeakHold run alive");
+        {
+            juce::AudioBuffer<float> sparse(1, length);
+            sparse.clear();
+            const int gap = (int)(reader.sampleRate * Config::Audio::peakHoldSeconds) / 2;
+            const int span = (int)(reader.sampleRate * Config::Audio::peakHoldMinSeconds) * 2;
+            for (int i = 0; i <= span; i += gap)
+                sparse.setSample(0, toneStart + i, 0.5f);
+            BufferMockReader sparseReader(sparse);
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(sparseReader, threshold,
+                                                                  Mode::PeakHold, context),
+                         (juce::int64)toneStart);
+            expectEquals(SilenceAnalysisAlgorithms::findSilenceIn(sparseReader, threshold,
+                                                                  Mode::Rms, context),
+                         (juce::int64)-1, "Isolated peaks never lift a window's RMS");
+        }
+
+        beginTest("Cancellation aborts the windowed scans");
+        std::atomic<bool> cancelled{true};
+        ScanContext cancelledContext;
+        cancelledContext.cancelled = &cancelled;
+        expectEquals(
+            SilenceAnalysisAlgorithms::findSilenceIn(reader, threshold, Mode::Rms, cancelledContext),
+            SilenceAnalysisAlgorithms::aborted);
+        expectEquals(SilenceAnalysisAlgorithms::findSilenceOut(reader, threshold, Mode::PeakHold,
+                                                               cancelledContext),
+                     SilenceAnalysisAlgorithms::aborted);
+    }
+};
+
+static WindowedDetectorTest windowedDetectorTest;